@@ -51,8 +51,14 @@
  * functionality. They can be thought of as composed services.
  *
  * - @link libbitcoin::poller poller @endlink
+ * - @link libbitcoin::compact_block_relay compact_block_relay @endlink
  * - @link libbitcoin::transaction_pool transaction_pool @endlink
  * - @link libbitcoin::session session @endlink
+ * - @link libbitcoin::peer_cost peer_cost @endlink
+ * - @link libbitcoin::tx_request_tracker tx_request_tracker @endlink
+ * - @link libbitcoin::query_server query_server @endlink /
+ *   @link libbitcoin::query_client query_client @endlink
+ * - @link libbitcoin::postgresql_exporter postgresql_exporter @endlink
  *
  * @section message Message
  *
@@ -83,10 +89,12 @@
  * - @link libbitcoin::elliptic_curve_key elliptic_curve_key @endlink
  * - @link libbitcoin::big_number big_number @endlink
  * - @link libbitcoin::async_service async_service @endlink
+ * - @link libbitcoin::token_bucket token_bucket @endlink
  *
  * @subsection wallet Wallet
  *
  * - @link libbitcoin::deterministic_wallet deterministic_wallet @endlink
+ * - @link libbitcoin::transaction_signer transaction_signer @endlink
  * - @link libbitcoin::secret_to_wif secret_to_wif @endlink
  * - @link libbitcoin::wif_to_secret wif_to_secret @endlink
  * - @link libbitcoin::minikey_to_secret minikey_to_secret @endlink
@@ -152,8 +160,11 @@
 #include <bitcoin/network/hosts.hpp>
 #include <bitcoin/network/handshake.hpp>
 #include <bitcoin/block.hpp>
+#include <bitcoin/peer_cost.hpp>
 #include <bitcoin/session.hpp>
+#include <bitcoin/tx_request_tracker.hpp>
 #include <bitcoin/poller.hpp>
+#include <bitcoin/compact_block_relay.hpp>
 #include <bitcoin/format.hpp>
 #include <bitcoin/validate.hpp>
 #include <bitcoin/constants.hpp>
@@ -162,6 +173,7 @@
 #include <bitcoin/messages.hpp>
 #include <bitcoin/blockchain/organizer.hpp>
 #include <bitcoin/blockchain/blockchain.hpp>
+#include <bitcoin/blockchain/scan_visitor.hpp>
 #include <bitcoin/utility/elliptic_curve_key.hpp>
 #include <bitcoin/utility/assert.hpp>
 #include <bitcoin/utility/ripemd.hpp>
@@ -172,14 +184,24 @@
 #include <bitcoin/utility/serializer.hpp>
 #include <bitcoin/utility/subscriber.hpp>
 #include <bitcoin/utility/weak_bind.hpp>
+#include <bitcoin/utility/async_frame.hpp>
+#include <bitcoin/utility/small_chunk.hpp>
+#include <bitcoin/utility/token_bucket.hpp>
 #include <bitcoin/utility/key_formats.hpp>
 #include <bitcoin/script.hpp>
 #include <bitcoin/transaction.hpp>
+#include <bitcoin/transaction_signer.hpp>
 #include <bitcoin/network/protocol.hpp>
 #include <bitcoin/async_service.hpp>
+#include <bitcoin/query/query_protocol.hpp>
+#include <bitcoin/query/query_server.hpp>
+#include <bitcoin/query/query_client.hpp>
 #ifdef BDB_ENABLED
     #include <bitcoin/blockchain/bdb_blockchain.hpp>
 #endif
+#ifdef POSTGRES_ENABLED
+    #include <bitcoin/blockchain/postgresql_exporter.hpp>
+#endif
 #ifdef KYOTO_ENABLED
     #include <bitcoin/blockchain/kyoto_blockchain.hpp>
 #endif
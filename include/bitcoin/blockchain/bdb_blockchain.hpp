@@ -6,6 +6,7 @@
 #include <boost/interprocess/sync/file_lock.hpp>
 
 #include <bitcoin/blockchain/organizer.hpp>
+#include <bitcoin/blockchain/scan_visitor.hpp>
 #include <bitcoin/utility/subscriber.hpp>
 #include <bitcoin/async_service.hpp>
 
@@ -27,10 +28,21 @@ public:
             reorganize_subscriber_type;
 
     typedef std::function<void (const std::error_code)> start_handler;
+    typedef std::function<void (const std::error_code&, uint64_t)>
+        fetch_handler_sequence;
+    typedef std::function<void (size_t, size_t)> scan_progress_handler;
+    typedef std::function<void (const std::error_code&)> scan_handler;
 
     static bool setup(const std::string& prefix);
 
-    bdb_blockchain(async_service& service);
+    /**
+     * prune_window is the number of most recent blocks kept in full.
+     * Transactions below it are deleted once all their outputs are
+     * spent below it, and reorganizations forking below it are rejected.
+     * Fetching pruned data fails with error::pruned.
+     * Zero disables pruning. Use the same value for each start().
+     */
+    bdb_blockchain(async_service& service, size_t prune_window=0);
     ~bdb_blockchain();
 
     // Non-copyable
@@ -38,6 +50,16 @@ public:
     void operator=(const bdb_blockchain&) = delete;
 
     void start(const std::string& prefix, start_handler handle_start);
+    /**
+     * Open the database of a node running in another process.
+     * Any number of readers can run alongside the one writer. Every
+     * fetch reads a consistent snapshot and store() fails with
+     * error::read_only. The writer must be started first since it
+     * runs recovery. Reorganize notifications only happen in the
+     * writer so readers should poll fetch_sequence() instead.
+     */
+    void start_read_only(const std::string& prefix,
+        start_handler handle_start);
     void stop();
 
     void store(const message::block& stored_block,
@@ -72,11 +94,53 @@ public:
     // fetch outputs associated with an address
     void fetch_outputs(const payment_address& address,
         fetch_handler_outputs handle_fetch);
+    // fetch counter incremented with every change to the chain
+    void fetch_sequence(fetch_handler_sequence handle_fetch);
 
     void subscribe_reorganize(reorganize_handler handle_reorganize);
 
+    /**
+     * Visit every block and transaction in the chain.
+     *
+     * The depths are split into number_partitions contiguous ranges
+     * which are each read sequentially with a database cursor by a job
+     * posted to scan_service. Give the scan its own service so it
+     * doesn't hold up other work. Pruned transactions are skipped.
+     *
+     * Blocks added after the scan starts are not visited.
+     * Don't stop() the blockchain while a scan is running.
+     *
+     * Each partition reads under a series of short snapshots so it
+     * isn't refused by concurrent writers. The visitor is called from
+     * the scan_service threads concurrently; see scan_visitor.
+     *
+     * @param[in]   handle_progress Called every few thousand blocks.
+     *                              Calls are serialised but may come
+     *                              from any of the scan_service threads.
+     * @code
+     *  void handle_progress(
+     *      size_t scanned,     // Blocks visited so far
+     *      size_t total        // Blocks in the scan
+     *  );
+     * @endcode
+     * @param[in]   handle_scan     Called once after every partition ends.
+     * @code
+     *  void handle_scan(
+     *      const std::error_code& ec   // service_stopped if the visitor
+     *                                  // stopped early, not_found if
+     *                                  // a block or tx couldn't be read
+     *  );
+     * @endcode
+     */
+    void scan(async_service& scan_service, size_t number_partitions,
+        scan_visitor& visitor, scan_progress_handler handle_progress,
+        scan_handler handle_scan);
+
 private:
-    bool initialize(const std::string& prefix);
+    struct scan_state;
+    typedef std::shared_ptr<scan_state> scan_state_ptr;
+
+    bool initialize(const std::string& prefix, bool read_only);
     void shutdown();
 
     void do_store(const message::block& store_block,
@@ -97,6 +161,13 @@ private:
         fetch_handler_spend handle_fetch);
     void do_fetch_outputs(const payment_address& address,
         fetch_handler_outputs handle_fetch);
+    void do_fetch_sequence(fetch_handler_sequence handle_fetch);
+
+    void do_scan(async_service& scan_service, size_t number_partitions,
+        scan_visitor& visitor, scan_progress_handler handle_progress,
+        scan_handler handle_scan);
+    void scan_partition(scan_state_ptr state, size_t begin, size_t end);
+    void scan_range(scan_state_ptr state, size_t begin, size_t end);
 
     boost::interprocess::file_lock flock_;
 
@@ -105,18 +176,26 @@ private:
     Db* db_blocks_ = nullptr;
     Db* db_blocks_hash_ = nullptr;
     Db* db_txs_ = nullptr;
+    Db* db_tx_numbers_ = nullptr;
+    Db* db_tx_numbers_hash_ = nullptr;
     Db* db_spends_ = nullptr;
     Db* db_address_ = nullptr;
+    Db* db_sequence_ = nullptr;
 #else
     DbEnv* env_;
     Db* db_blocks_;
     Db* db_blocks_hash_;
     Db* db_txs_;
+    Db* db_tx_numbers_;
+    Db* db_tx_numbers_hash_;
     Db* db_spends_;
     Db* db_address_;
+    Db* db_sequence_;
 #endif
 
     bdb_common_ptr common_;
+    size_t prune_window_;
+    bool read_only_;
 
     // Organize stuff
     orphans_pool_ptr orphans_;
@@ -0,0 +1,124 @@
+#ifndef LIBBITCOIN_BLOCKCHAIN_POSTGRESQL_EXPORTER_H
+#define LIBBITCOIN_BLOCKCHAIN_POSTGRESQL_EXPORTER_H
+
+#include <boost/asio.hpp>
+
+#include <bitcoin/async_service.hpp>
+#include <bitcoin/messages.hpp>
+#include <bitcoin/types.hpp>
+#include <bitcoin/blockchain/bdb_blockchain.hpp>
+#include <bitcoin/blockchain/scan_visitor.hpp>
+
+typedef struct pg_conn PGconn;
+
+namespace libbitcoin {
+
+class postgresql_copy_batch;
+typedef std::shared_ptr<postgresql_copy_batch> postgresql_copy_batch_ptr;
+
+/**
+ * Mirrors the main chain into the schema from bitcoin.sql.
+ *
+ * Rows are buffered and written with binary COPY into per connection
+ * staging tables, then merged into the schema tables in one statement
+ * per table. Blocks and transactions which are already present are
+ * left alone, so the same block can safely be exported twice.
+ *
+ * Only the main chain is kept, so every block is in space 0.
+ * Blocks replaced by a reorganization are deleted along with their
+ * transactions_parents rows. Their transactions stay in the
+ * transactions table since they usually reappear in the new chain.
+ *
+ * @code
+ *  postgresql_exporter exporter(service, chain,
+ *      "dbname=bitcoin", 2000);
+ *  exporter.start(handle_start);
+ *  // ... then to fill in the existing chain
+ *  exporter.backfill(scan_service, 4, handle_backfill);
+ * @endcode
+ */
+class postgresql_exporter
+{
+public:
+    typedef std::function<void (const std::error_code&)> completion_handler;
+
+    /**
+     * @param[in]   connection_info libpq connection string
+     * @param[in]   flush_size      Number of transactions buffered
+     *                              before a batch is written.
+     */
+    postgresql_exporter(async_service& service, bdb_blockchain& chain,
+        const std::string& connection_info, size_t flush_size=5000);
+    ~postgresql_exporter();
+
+    postgresql_exporter(const postgresql_exporter&) = delete;
+    void operator=(const postgresql_exporter&) = delete;
+
+    /**
+     * Connect and begin following reorganizations of the chain.
+     * A partial batch is written once new blocks stop arriving for
+     * a couple of seconds.
+     *
+     * @code
+     *  void handle_start(
+     *      const std::error_code& ec   // Status of operation
+     *  );
+     * @endcode
+     */
+    void start(completion_handler handle_start);
+
+    /**
+     * Write the blocks the chain already has using a parallel
+     * bdb_blockchain::scan(). Every partition gets its own connection.
+     *
+     * Call start() first so blocks arriving during the backfill
+     * are not missed. If the chain reorganizes during the backfill then
+     * a replaced block already read by the scan can be written after
+     * it was deleted, so backfill before the node begins syncing.
+     *
+     * @code
+     *  void handle_backfill(
+     *      const std::error_code& ec   // Status of operation
+     *  );
+     * @endcode
+     */
+    void backfill(async_service& scan_service, size_t number_partitions,
+        completion_handler handle_backfill);
+
+    /**
+     * Write any buffered rows and disconnect.
+     *
+     * @code
+     *  void handle_stop(
+     *      const std::error_code& ec   // Status of final write
+     *  );
+     * @endcode
+     */
+    void stop(completion_handler handle_stop);
+
+private:
+    class backfill_visitor;
+
+    void reorganize(const std::error_code& ec, size_t fork_point,
+        const blockchain::block_list& arrivals,
+        const blockchain::block_list& replaced);
+    bool delete_blocks(const blockchain::block_list& replaced);
+    void reset_timer();
+    void handle_timer(const boost::system::error_code& ec);
+
+    io_service::strand strand_;
+    boost::asio::deadline_timer timer_;
+    bdb_blockchain& chain_;
+    const std::string connection_info_;
+    const size_t flush_size_;
+    bool stopped_;
+
+    // The live feed gets its own connection
+    PGconn* connection_;
+    postgresql_copy_batch_ptr batch_;
+};
+
+} // namespace libbitcoin
+
+#endif
+
@@ -0,0 +1,49 @@
+#ifndef LIBBITCOIN_BLOCKCHAIN_SCAN_VISITOR_H
+#define LIBBITCOIN_BLOCKCHAIN_SCAN_VISITOR_H
+
+#include <bitcoin/messages.hpp>
+#include <bitcoin/types.hpp>
+
+namespace libbitcoin {
+
+/**
+ * Receives the contents of the chain during a full chain scan.
+ *
+ * The depth range is split between several threads so methods are
+ * called concurrently. Within one thread blocks arrive in depth order
+ * and each block is followed by its transactions, and each transaction
+ * by its inputs then outputs.
+ *
+ * Arguments are only valid for the duration of the call.
+ * Return false from any method to stop the whole scan early.
+ */
+class scan_visitor
+{
+public:
+    virtual ~scan_visitor() {}
+
+    virtual bool visit_block(size_t depth, const message::block& header)
+    {
+        return true;
+    }
+    virtual bool visit_transaction(size_t depth, size_t index_in_block,
+        const hash_digest& tx_hash, const message::transaction& tx)
+    {
+        return true;
+    }
+    virtual bool visit_input(const hash_digest& tx_hash,
+        size_t input_index, const message::transaction_input& input)
+    {
+        return true;
+    }
+    virtual bool visit_output(const hash_digest& tx_hash,
+        size_t output_index, const message::transaction_output& output)
+    {
+        return true;
+    }
+};
+
+} // namespace libbitcoin
+
+#endif
+
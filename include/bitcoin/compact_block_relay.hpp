@@ -0,0 +1,109 @@
+#ifndef LIBBITCOIN_COMPACT_BLOCK_RELAY_H
+#define LIBBITCOIN_COMPACT_BLOCK_RELAY_H
+
+#include <map>
+#include <vector>
+
+#include <bitcoin/blockchain/blockchain.hpp>
+#include <bitcoin/network/channel.hpp>
+#include <bitcoin/transaction_pool.hpp>
+
+namespace libbitcoin {
+
+/**
+ * Relays new blocks as compact_block messages between peers which both
+ * advertise node_compact_blocks in their version.
+ *
+ * A compact block is the header plus a 6 byte short id for every
+ * transaction except the coinbase, which is sent in full. The receiver
+ * rebuilds the block from its transaction_pool, asks the sender with
+ * get_block_transactions for anything it's missing, then stores the
+ * block. If the rebuilt block doesn't match the header's merkle root,
+ * the whole block is requested with getdata instead.
+ *
+ * Short ids are the first 6 bytes of
+ * sha256(block_hash || nonce || tx_hash) where nonce is picked at random
+ * for each compact block.
+ *
+ * @code
+ *  compact_block_relay relay(service, chain, txpool);
+ *  session_params params{handshake, protocol, chain, poller, txpool,
+ *      &relay};
+ * @endcode
+ */
+class compact_block_relay
+{
+public:
+    compact_block_relay(async_service& service,
+        blockchain& chain, transaction_pool& txpool);
+
+    compact_block_relay(const compact_block_relay&) = delete;
+    void operator=(const compact_block_relay&) = delete;
+
+    /**
+     * Start relaying with this node if it advertised
+     * node_compact_blocks. Call after the handshake completes.
+     */
+    void monitor(channel_ptr node);
+
+    /**
+     * Send a new block to every compact peer.
+     */
+    void announce(const message::block& blk);
+
+    /**
+     * Is this node receiving our blocks as compact_block messages?
+     */
+    static bool is_compact_peer(channel_ptr node);
+
+private:
+    struct pending_block
+    {
+        message::block blk;
+        index_list missing;
+        channel_ptr node;
+        // Insertion order, so the oldest can be dropped when full
+        uint64_t sequence;
+    };
+    typedef std::map<hash_digest, pending_block> pending_block_map;
+    typedef std::vector<channel_ptr> channel_ptr_list;
+
+    void do_monitor(channel_ptr node);
+    void remove_peer(const std::error_code& ec, channel_ptr node);
+
+    void do_announce(const message::block& blk);
+
+    void receive_compact_block(const std::error_code& ec,
+        const message::compact_block& packet, channel_ptr node);
+    void reconstruct(const pool_buffer& pool,
+        const message::compact_block& packet, channel_ptr node);
+    void handle_reconstruct(const message::block& blk,
+        const index_list& missing, channel_ptr node);
+
+    void receive_get_block_transactions(const std::error_code& ec,
+        const message::get_block_transactions& packet, channel_ptr node);
+    void send_block_transactions(const std::error_code& ec,
+        const message::block& blk, const index_list& indexes,
+        channel_ptr node);
+
+    void receive_block_transactions(const std::error_code& ec,
+        const message::block_transactions& packet, channel_ptr node);
+
+    void verify_and_store(const message::block& blk, channel_ptr node);
+    void handle_store(const std::error_code& ec, block_info info,
+        const hash_digest& block_hash, channel_ptr node);
+
+    io_service::strand strand_;
+    blockchain& chain_;
+    transaction_pool& tx_pool_;
+
+    channel_ptr_list peers_;
+    // Compact blocks waiting on a block_transactions reply
+    pending_block_map pending_;
+    uint64_t next_pending_sequence_ = 0;
+};
+
+} // namespace libbitcoin
+
+#endif
+
@@ -17,6 +17,11 @@ constexpr size_t coinbase_maturity = 100;
 
 constexpr uint32_t magic_value = 0xd9b4bef9;
 
+// Version services bits
+constexpr uint64_t node_network = 1;
+// Experimental range. Peers relay blocks as compact_block messages.
+constexpr uint64_t node_compact_blocks = 1 << 24;
+
 // Threshold for nLockTime: below this value it is
 // interpreted as block number, otherwise as UNIX timestamp.
 // Tue Nov 5 00:53:20 1985 UTC
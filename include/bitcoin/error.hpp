@@ -17,6 +17,8 @@ namespace error
         unspent_output,
         unsupported_payment_type,
         start_failed,
+        pruned,
+        read_only,
         // network errors
         resolve_failed,
         network_unreachable,
@@ -54,7 +56,13 @@ namespace error
         duplicate_or_spent,
         validate_inputs_failed,
         fees_out_of_range,
-        coinbase_too_large
+        coinbase_too_large,
+        // query
+        server_busy,
+        // exporter
+        export_failed,
+        // transaction pool
+        pool_save_failed
     };
 
     enum error_condition_t
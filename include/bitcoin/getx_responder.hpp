@@ -20,7 +20,7 @@ private:
     void receive_get_data(const std::error_code& ec,
         const message::get_data packet, channel_ptr node);
 
-    void pool_tx(const std::error_code& ec, const message::transaction& tx,
+    void pool_tx(const std::error_code& ec, const data_chunk& raw_tx,
         const hash_digest& tx_hash, channel_ptr node);
     void chain_tx(const std::error_code& ec,
         const message::transaction& tx, channel_ptr node);
@@ -141,6 +141,41 @@ struct inventory
     inventory_list inventories;
 };
 
+// Compact block relay. Only exchanged with peers advertising
+// node_compact_blocks in their version.
+typedef std::vector<uint64_t> short_id_list;
+
+struct prefilled_transaction
+{
+    // Position of the transaction in the block. As wide as the wire
+    // value so nothing is lost before it's checked against the block.
+    uint64_t index;
+    transaction tx;
+};
+typedef std::vector<prefilled_transaction> prefilled_transaction_list;
+
+struct compact_block
+{
+    // Transactions are left empty
+    block header;
+    // Salt for the short transaction ids
+    uint64_t nonce;
+    short_id_list short_ids;
+    prefilled_transaction_list prefilled;
+};
+
+struct get_block_transactions
+{
+    hash_digest block_hash;
+    index_list indexes;
+};
+
+struct block_transactions
+{
+    hash_digest block_hash;
+    transaction_list transactions;
+};
+
 struct ping
 {
     uint64_t nonce;
@@ -5,11 +5,14 @@
 #include <boost/array.hpp>
 #include <boost/utility.hpp>
 #include <boost/asio/streambuf.hpp>
+#include <array>
 #include <atomic>
 #include <cstdint>
+#include <list>
 #include <memory>
 #include <mutex>
 #include <stack>
+#include <unordered_map>
 
 #include <bitcoin/network/network.hpp>
 #include <bitcoin/network/shared_const_buffer.hpp>
@@ -46,60 +49,63 @@ data_chunk create_raw_message(const Message& packet)
     return whole_message;
 }
 
-class channel_loader_module_base
+// Each channel queues outgoing messages by class and writes higher
+// classes first, so a big block or a burst of tx relays doesn't hold
+// up a getdata or a block inv behind it.
+enum class send_priority
 {
-public:
-    virtual ~channel_loader_module_base() {}
-    virtual void attempt_load(const data_chunk& stream) const = 0;
-    virtual const std::string lookup_symbol() const = 0;
+    // Handshake, pings and requests (getdata, getblocks...)
+    control,
+    // Block announcements, blocks and compact block messages
+    block,
+    // Transaction relay
+    transaction,
+    // Address gossip
+    address,
+    // Old blocks served to peers catching up. Never the default.
+    historical
 };
+constexpr size_t send_priority_count = 5;
 
+// Class a message goes in by default, based on its command.
+// inv announcing any blocks is a block message, otherwise transaction.
+send_priority message_priority(const std::string& command);
+send_priority message_priority(const message::inventory& packet);
 template <typename Message>
-class channel_loader_module
-  : public channel_loader_module_base
+send_priority message_priority(const Message& packet)
 {
-public:
-    typedef std::function<
-        void (const std::error_code&, const Message&)> load_handler;
-
-    channel_loader_module(load_handler handle_load)
-      : handle_load_(handle_load) {}
-
-    void attempt_load(const data_chunk& stream) const
-    {
-        Message result;
-        try
-        {
-            satoshi_load(stream.begin(), stream.end(), result);
-            handle_load_(std::error_code(), result);
-        }
-        catch (end_of_stream)
-        {
-            handle_load_(error::bad_stream, Message());
-        }
-    }
+    return message_priority(satoshi_command(packet));
+}
 
-    const std::string lookup_symbol() const
-    {
-        return satoshi_command(Message());
-    }
-private:
-    load_handler handle_load_;
+// Time spent by messages of one class from send() to being written.
+struct send_queue_stats
+{
+    size_t messages = 0;
+    boost::posix_time::time_duration total_wait;
+    boost::posix_time::time_duration max_wait;
 };
 
-class channel_stream_loader
+// Upload rate limits in bytes per second. 0 is unlimited.
+struct upload_limits
 {
-public:
-    ~channel_stream_loader();
-    void add(channel_loader_module_base* module);
-    void load_lookup(const std::string& symbol,
-        const data_chunk& stream) const;
-private:
-    typedef std::vector<channel_loader_module_base*> module_list;
-
-    module_list modules_;
+    // Across every channel
+    uint64_t global = 0;
+    // Each channel
+    uint64_t peer = 0;
+    // Each channel, by send_priority
+    std::array<uint64_t, send_priority_count> priority = {{}};
 };
 
+/**
+ * Limit how fast channels write. Takes effect on every channel from its
+ * next write.
+ *
+ * send_priority::historical messages only go out while the global and
+ * peer buckets are at least half full, so serving old blocks is the
+ * first thing to slow down once the link saturates.
+ */
+void set_upload_limits(const upload_limits& limits);
+
 class channel_proxy
   : public std::enable_shared_from_this<channel_proxy>
 {
@@ -133,6 +139,17 @@ public:
     typedef std::function<void (const std::error_code&,
         const message::block&)> receive_block_handler;
 
+    typedef std::function<void (const std::error_code&,
+        const message::compact_block&)> receive_compact_block_handler;
+
+    typedef std::function<void (const std::error_code&,
+        const message::get_block_transactions&)>
+            receive_get_block_transactions_handler;
+
+    typedef std::function<void (const std::error_code&,
+        const message::block_transactions&)>
+            receive_block_transactions_handler;
+
     typedef std::function<void (const std::error_code&,
         const message::header&, const data_chunk&)> receive_raw_handler;
 
@@ -148,6 +165,12 @@ public:
     void stop();
     bool stopped() const;
 
+    // Services bits from the peer's version message
+    void set_peer_services(uint64_t services);
+    uint64_t peer_services() const;
+    // The peer's address in wire form, IPv4 mapped into IPv6
+    const message::ip_address& remote_ip() const;
+
     // List of bitcoin messages
     // version
     // verack
@@ -165,26 +188,38 @@ public:
     // reply        [deprecated]
     // ping         [internal]
     // alert        [not supported]
+    // cmpctblock   [node_compact_blocks]
+    // getblocktxn  [node_compact_blocks]
+    // blocktxn     [node_compact_blocks]
 
     template <typename Message>
     void send(const Message& packet, send_handler handle_send)
+    {
+        send(packet, handle_send, message_priority(packet));
+    }
+    template <typename Message>
+    void send(const Message& packet, send_handler handle_send,
+        send_priority priority)
     {
         if (stopped_)
             handle_send(error::service_stopped);
         else
         {
             auto this_ptr = shared_from_this();
+            const boost::posix_time::ptime queued = now();
             strand_.post(
-                [this, this_ptr, packet, handle_send]
+                [this, this_ptr, packet, handle_send, priority, queued]
                 {
-                    do_send_common(create_raw_message(packet),
-                        handle_send);
+                    queue_send(create_raw_message(packet), handle_send,
+                        priority, queued);
                 });
         }
     }
     void send_raw(const message::header& packet_header,
         const data_chunk& payload, send_handler handle_send);
 
+    send_queue_stats queue_stats(send_priority priority) const;
+
     void subscribe_version(receive_version_handler handle_receive);
     void subscribe_verack(receive_verack_handler handle_receive);
     void subscribe_address(receive_address_handler handle_receive);
@@ -194,6 +229,12 @@ public:
     void subscribe_get_blocks(receive_get_blocks_handler handle_receive);
     void subscribe_transaction(receive_transaction_handler handle_receive);
     void subscribe_block(receive_block_handler handle_receive);
+    void subscribe_compact_block(
+        receive_compact_block_handler handle_receive);
+    void subscribe_get_block_transactions(
+        receive_get_block_transactions_handler handle_receive);
+    void subscribe_block_transactions(
+        receive_block_transactions_handler handle_receive);
     void subscribe_raw(receive_raw_handler handle_receive);
 
     void subscribe_stop(stop_handler handle_stop);
@@ -217,25 +258,112 @@ private:
         transaction_subscriber_type;
     typedef subscriber<const std::error_code&, const message::block&>
         block_subscriber_type;
+    typedef subscriber<const std::error_code&,
+        const message::compact_block&> compact_block_subscriber_type;
+    typedef subscriber<const std::error_code&,
+        const message::get_block_transactions&>
+            get_block_transactions_subscriber_type;
+    typedef subscriber<const std::error_code&,
+        const message::block_transactions&>
+            block_transactions_subscriber_type;
 
     typedef subscriber<const std::error_code&,
         const message::header&, const data_chunk&> raw_subscriber_type;
     typedef subscriber<const std::error_code&> stop_subscriber_type;
 
+    // Decodes a payload and relays it to the proxy's subscribers
+    typedef void (*message_loader)(
+        channel_proxy& proxy, const data_chunk& payload);
+    typedef std::unordered_map<std::string, message_loader> loader_map;
+
+    // One table of loaders keyed by command, shared by every channel.
+    static const loader_map& loaders();
+    static loader_map make_loaders();
+
+    struct queued_message
+    {
+        data_chunk whole_message;
+        send_handler handle_send;
+        boost::posix_time::ptime queued;
+    };
+    // std::list because a deque allocates even when empty
+    typedef std::list<queued_message> send_queue;
+
+    static boost::posix_time::ptime now();
+
     void do_send_raw(const message::header& packet_header,
-        const data_chunk& payload, send_handler handle_send);
-    void do_send_common(const data_chunk& whole_message,
+        const data_chunk& payload, send_handler handle_send,
+        boost::posix_time::ptime queued);
+    // Everything below runs in the strand
+    void queue_send(data_chunk&& whole_message, send_handler handle_send,
+        send_priority priority, boost::posix_time::ptime queued);
+    size_t next_send_queue() const;
+    void count_passed_over(size_t sent);
+    // Returns send_priority_count and waits if every queue is limited
+    size_t unthrottled_send_queue(size_t preferred);
+    boost::posix_time::time_duration upload_wait(size_t index);
+    void handle_throttle(const boost::system::error_code& ec);
+    void write_next();
+    void handle_write(const boost::system::error_code& ec,
         send_handler handle_send);
+    void flush_send_queues();
+
+    // Subscribers are only created once someone subscribes, so channels
+    // only pay for the messages they're asked about.
+    template <typename SubscriberPtr>
+    SubscriberPtr existing_subscriber(const SubscriberPtr& message_subscribe)
+    {
+        std::lock_guard<std::mutex> lock(subscribe_mutex_);
+        return message_subscribe;
+    }
+    template <typename SubscriberPtr>
+    SubscriberPtr create_subscriber(SubscriberPtr& message_subscribe)
+    {
+        typedef typename SubscriberPtr::element_type subscriber_type;
+        std::lock_guard<std::mutex> lock(subscribe_mutex_);
+        if (!message_subscribe)
+            message_subscribe = std::make_shared<subscriber_type>(service_);
+        return message_subscribe;
+    }
 
     template <typename Message, typename Callback, typename SubscriberPtr>
     void generic_subscribe(Callback handle_message,
-        SubscriberPtr message_subscribe)
+        SubscriberPtr& message_subscribe)
     {
         // Subscribing must be immediate. We cannot switch thread contexts
         if (stopped_)
             handle_message(error::service_stopped, Message());
         else
-            message_subscribe->subscribe(handle_message);
+            create_subscriber(message_subscribe)->subscribe(handle_message);
+    }
+
+    template <typename Message, typename SubscriberPtr>
+    void load_message(const data_chunk& payload,
+        const SubscriberPtr& message_subscribe)
+    {
+        SubscriberPtr subscribe = existing_subscriber(message_subscribe);
+        // Nobody ever asked for this message so don't bother decoding it
+        if (!subscribe)
+            return;
+        Message result;
+        try
+        {
+            satoshi_load(payload.begin(), payload.end(), result);
+        }
+        catch (const end_of_stream&)
+        {
+            subscribe->relay(error::bad_stream, Message());
+            return;
+        }
+        subscribe->relay(std::error_code(), result);
+    }
+
+    template <typename Message, typename SubscriberPtr>
+    void relay_stopped(const SubscriberPtr& message_subscribe)
+    {
+        SubscriberPtr subscribe = existing_subscriber(message_subscribe);
+        if (subscribe)
+            subscribe->relay(error::service_stopped, Message());
     }
 
     void read_header();
@@ -249,11 +377,6 @@ private:
     void handle_read_payload(const boost::system::error_code& ec,
         size_t bytes_transferred, const message::header& header_msg);
 
-    // Calls the send handler after a successful send, translating
-    // the boost error_code to std::error_code
-    void call_handle_send(const boost::system::error_code& ec,
-        send_handler handle_send);
-
     void handle_timeout(const boost::system::error_code& ec);
     void handle_heartbeat(const boost::system::error_code& ec);
     
@@ -265,14 +388,16 @@ private:
     void stop_impl();
     void clear_subscriptions();
 
+    async_service& service_;
     // We keep the service alive for lifetime rules
     io_service::strand strand_;
     boost::asio::deadline_timer timeout_, heartbeat_;
 
     std::atomic<bool> stopped_;
+    std::atomic<uint64_t> peer_services_;
 
     socket_ptr socket_;
-    channel_stream_loader loader_;
+    const message::ip_address remote_ip_;
 
     // Header minus checksum is 4 + 12 + 4 = 20 bytes
     static constexpr size_t header_chunk_size = 20;
@@ -283,6 +408,21 @@ private:
     boost::array<uint8_t, header_checksum_size> inbound_checksum_;
     std::vector<uint8_t> inbound_payload_;
 
+    // One queue per send_priority with a single write in flight
+    std::array<send_queue, send_priority_count> send_queues_;
+    // Times each queue was skipped for a higher one while non-empty
+    std::array<size_t, send_priority_count> passed_over_;
+    data_chunk outbound_message_;
+    bool writing_;
+    // Only created once upload limits are set
+    struct upload_throttle;
+    std::unique_ptr<upload_throttle> throttle_;
+
+    mutable std::mutex stats_mutex_;
+    std::array<send_queue_stats, send_priority_count> queue_stats_;
+
+    // Guards creating the subscribers below
+    std::mutex subscribe_mutex_;
     // We should be using variadic templates for these
     version_subscriber_type::ptr version_subscriber_;
     verack_subscriber_type::ptr verack_subscriber_;
@@ -293,6 +433,10 @@ private:
     get_blocks_subscriber_type::ptr get_blocks_subscriber_;
     transaction_subscriber_type::ptr transaction_subscriber_;
     block_subscriber_type::ptr block_subscriber_;
+    compact_block_subscriber_type::ptr compact_block_subscriber_;
+    get_block_transactions_subscriber_type::ptr
+        get_block_transactions_subscriber_;
+    block_transactions_subscriber_type::ptr block_transactions_subscriber_;
 
     raw_subscriber_type::ptr raw_subscriber_;
     stop_subscriber_type::ptr stop_subscriber_;
@@ -307,6 +451,11 @@ public:
     void stop();
     bool stopped() const;
 
+    void set_peer_services(uint64_t services);
+    uint64_t peer_services() const;
+    // All zeros once the channel has stopped
+    message::ip_address remote_ip() const;
+
     template <typename Message>
     void send(const Message& packet,
         channel_proxy::send_handler handle_send)
@@ -317,10 +466,22 @@ public:
         else
             proxy->send(packet, handle_send);
     }
+    template <typename Message>
+    void send(const Message& packet,
+        channel_proxy::send_handler handle_send, send_priority priority)
+    {
+        channel_proxy_ptr proxy = weak_proxy_.lock();
+        if (!proxy)
+            handle_send(error::service_stopped);
+        else
+            proxy->send(packet, handle_send, priority);
+    }
 
     void send_raw(const message::header& packet_header,
         const data_chunk& payload, channel_proxy::send_handler handle_send);
 
+    send_queue_stats queue_stats(send_priority priority) const;
+
     void subscribe_version(
         channel_proxy::receive_version_handler handle_receive);
     void subscribe_verack(
@@ -339,6 +500,12 @@ public:
         channel_proxy::receive_transaction_handler handle_receive);
     void subscribe_block(
         channel_proxy::receive_block_handler handle_receive);
+    void subscribe_compact_block(
+        channel_proxy::receive_compact_block_handler handle_receive);
+    void subscribe_get_block_transactions(
+        channel_proxy::receive_get_block_transactions_handler handle_receive);
+    void subscribe_block_transactions(
+        channel_proxy::receive_block_transactions_handler handle_receive);
     void subscribe_raw(
         channel_proxy::receive_raw_handler handle_receive);
 
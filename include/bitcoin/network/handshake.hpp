@@ -2,6 +2,9 @@
 #define LIBBITCOIN_NETWORK_HANDSHAKE_H
 
 #include <atomic>
+#include <deque>
+#include <map>
+#include <set>
 
 #include <bitcoin/messages.hpp>
 #include <bitcoin/network/network.hpp>
@@ -33,14 +36,45 @@ public:
 
     void start(start_handler handle_start);
 
-    void ready(channel_ptr node, handshake_handler handle_handshake);
-
+    /**
+     * Exchange version messages with a newly opened channel. Set
+     * outbound when we opened it. Only those peers get a vote on our
+     * external address: anyone can connect in to us and claim we're
+     * somewhere else. connect() sets it.
+     */
+    void ready(channel_ptr node, handshake_handler handle_handshake,
+        bool outbound=false);
+
+    /**
+     * Our external address as seen by peers.
+     *
+     * Each outbound peer reports the address it sees us at in its
+     * version message. These are tallied as votes which decay as new
+     * ones arrive, so a change of network is picked up. Recent voters
+     * are remembered by netgroup (/16 for IPv4, /32 for IPv6) and a
+     * netgroup only votes once, so one host reconnecting can't outvote
+     * the rest. Fails with
+     * error::not_found until enough peers agree, unless an address was
+     * configured with set_external_ip().
+     *
+     * @code
+     *  void handle_discover(
+     *      const std::error_code& ec,      // Status of operation
+     *      const message::ip_address& ip   // Our external address
+     *  );
+     * @endcode
+     */
     void discover_external_ip(discover_ip_handler handle_discover);
     void fetch_network_address(fetch_network_address_handler handle_fetch);
+    // Use a fixed external address and ignore what peers report.
+    void set_external_ip(const message::ip_address& ip,
+        setter_handler handle_set);
     void set_port(uint16_t port, setter_handler handle_set);
     void set_user_agent(const std::string& user_agent,
         setter_handler handle_set);
     void set_start_depth(uint32_t depth, setter_handler handle_set);
+    // Services bits we advertise, e.g. node_network | node_compact_blocks
+    void set_services(uint64_t services, setter_handler handle_set);
 
 private:
     void handle_connect(const std::error_code& ec,
@@ -51,30 +85,48 @@ private:
         handshake::handshake_handler completion_callback);
 
     void receive_version(const std::error_code& ec,
-        const message::version&, channel_ptr node, atomic_counter_ptr counter,
+        const message::version& version, channel_ptr node,
+        bool outbound, atomic_counter_ptr counter,
         handshake::handshake_handler completion_callback);
 
     void receive_verack(const std::error_code& ec,
         const message::verack&, atomic_counter_ptr counter,
         handshake::handshake_handler completion_callback);
 
-    bool lookup_external(const std::string& website,
-        message::ip_address& ip);
+    typedef std::map<message::ip_address, double> ip_vote_map;
+
+    void vote_external_ip(const message::ip_address& ip,
+        const message::ip_address& voter);
     message::ip_address localhost_ip();
     void do_discover_external_ip(discover_ip_handler handler_discover);
     void do_fetch_network_address(fetch_network_address_handler handle_fetch);
+    void do_set_external_ip(const message::ip_address& ip,
+        setter_handler handle_set);
     void do_set_port(uint16_t port, setter_handler handle_set);
     void do_set_user_agent(const std::string& user_agent,
         setter_handler handle_set);
     void do_set_start_depth(uint32_t depth, setter_handler handle_set);
+    void do_set_services(uint64_t services, setter_handler handle_set);
 
     io_service::strand strand_;
     message::version template_version_;
+
+    // Decaying score for each address peers have seen us at
+    ip_vote_map ip_votes_;
+    // Netgroups of recent voters, oldest first
+    std::deque<message::ip_address> voter_order_;
+    std::set<message::ip_address> voters_;
+    size_t total_votes_;
+    bool external_ip_known_;
+    bool external_ip_fixed_;
 };
 
 void connect(handshake& shake, network& net,
     const std::string& hostname, uint16_t port,
     network::connect_handler handle_connect);
+void connect(handshake& shake, network& net,
+    const message::network_address& address,
+    network::connect_handler handle_connect);
 
 } // namespace libbitcoin
 
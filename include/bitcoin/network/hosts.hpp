@@ -43,6 +43,9 @@ public:
         remove_handler handle_remove);
     void fetch_address(fetch_address_handler handle_fetch);
     void fetch_count(fetch_count_handler handle_fetch);
+    // Number of hosts stored or seen no earlier than timestamp
+    void fetch_count_since(uint32_t timestamp,
+        fetch_count_handler handle_fetch);
 
 private:
     struct hosts_field
@@ -50,6 +53,8 @@ private:
         bool operator==(const hosts_field& other);
         message::ip_address ip;
         uint16_t port;
+        // Last time this host was known to be up
+        uint32_t timestamp;
     };
 
     void do_load(const std::string& filename, load_handler handle_load);
@@ -59,6 +64,8 @@ private:
         remove_handler handle_remove);
     void do_fetch_address(fetch_address_handler handle_fetch_address);
     void do_fetch_count(fetch_count_handler handle_fetch);
+    void do_fetch_count_since(uint32_t timestamp,
+        fetch_count_handler handle_fetch);
 
     boost::circular_buffer<hosts_field> buffer_;
 };
@@ -3,7 +3,10 @@
 
 #include <boost/asio.hpp>
 #include <boost/utility.hpp>
+#include <ctime>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <thread>
 
 #include <bitcoin/messages.hpp>
@@ -49,21 +52,53 @@ public:
     void operator=(const network&) = delete;
 
     void listen(uint16_t port, listen_handler handle_listen);
+
+    /**
+     * Connect to a host by name. Numeric addresses connect straight
+     * away. Names are resolved and the result kept for
+     * resolve_cache_lifetime seconds.
+     */
     void connect(const std::string& hostname, uint16_t port, 
         connect_handler handle_connect);
+    /**
+     * Connect to an address from the hosts list or an addr message
+     * without going through the resolver.
+     */
+    void connect(const message::network_address& address,
+        connect_handler handle_connect);
+    void connect(const tcp::endpoint& endpoint,
+        connect_handler handle_connect);
 
 private:
     typedef std::shared_ptr<tcp::resolver> resolver_ptr;
     typedef std::shared_ptr<tcp::resolver::query> query_ptr;
+    typedef std::vector<tcp::endpoint> endpoint_list;
+    typedef std::shared_ptr<endpoint_list> endpoint_list_ptr;
+
+    struct resolved_host
+    {
+        endpoint_list_ptr endpoints;
+        time_t expires;
+    };
+    // Keyed by hostname:port
+    typedef std::map<std::string, resolved_host> resolve_cache;
+
+    endpoint_list_ptr cached_endpoints(const std::string& key);
+    void cache_endpoints(const std::string& key,
+        endpoint_list_ptr endpoints);
 
     void resolve_handler(const boost::system::error_code& ec,
-        tcp::resolver::iterator endpoint_iterator,
+        tcp::resolver::iterator endpoint_iterator, const std::string& key,
         connect_handler handle_connect, resolver_ptr, query_ptr);
-    void call_connect_handler(const boost::system::error_code& ec, 
-        tcp::resolver::iterator, socket_ptr socket,
+    void connect_endpoints(endpoint_list_ptr endpoints,
         connect_handler handle_connect);
+    void call_connect_handler(const boost::system::error_code& ec, 
+        socket_ptr socket, connect_handler handle_connect);
 
     async_service& service_;
+
+    std::mutex resolve_cache_mutex_;
+    resolve_cache resolve_cache_;
 };
 
 } // namespace libbitcoin
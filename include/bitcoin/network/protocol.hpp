@@ -20,6 +20,7 @@ public:
     typedef std::function<void (const std::error_code&, size_t)>
         fetch_connection_count_handler;
     typedef std::function<void (channel_ptr)> channel_handler;
+    typedef std::function<bool (channel_ptr)> channel_filter;
 
     protocol(async_service& service, hosts& hsts,
         handshake& shake, network& net);
@@ -44,6 +45,14 @@ public:
             std::bind(&protocol::do_broadcast<Message>,
                 this, packet));
     }
+    // Only send to channels for which filter returns true
+    template <typename Message>
+    void broadcast(const Message& packet, channel_filter filter)
+    {
+        strand_.post(
+            std::bind(&protocol::do_filtered_broadcast<Message>,
+                this, packet, filter));
+    }
 
 private:
     struct connection_info
@@ -70,10 +79,11 @@ private:
     // bootstrap sequence
     void load_hosts(const std::error_code& ec,
         completion_handler handle_complete);
-    void if_0_seed(const std::error_code& ec, size_t hosts_count,
+    void if_stale_seed(const std::error_code& ec, size_t fresh_count,
         completion_handler handle_complete);
 
-    // seed addresses from dns seeds
+    // Seed addresses by resolving every dns seed at once. Finishes at
+    // a deadline or once enough addresses came back.
     class seeds
       : public std::enable_shared_from_this<seeds>
     {
@@ -81,26 +91,29 @@ private:
         seeds(protocol* parent);
         void start(completion_handler handle_complete);
     private:
-        void error_case(const std::error_code& ec);
-
-        void connect_dns_seed(const std::string& hostname);
-        void request_addresses(const std::error_code& ec,
-            channel_ptr dns_seed_node);
-        void handle_send_get_address(const std::error_code& ec);
+        typedef std::shared_ptr<tcp::resolver> resolver_ptr;
+        typedef std::vector<resolver_ptr> resolver_list;
 
-        void save_addresses(const std::error_code& ec,
-            const message::address& packet, channel_ptr);
+        void resolve_dns_seed(const std::string& hostname);
+        void save_addresses(const boost::system::error_code& ec,
+            tcp::resolver::iterator endpoint_iterator,
+            const std::string& hostname, resolver_ptr resolver);
         void handle_store(const std::error_code& ec);
+        void handle_deadline(const boost::system::error_code& ec);
+        void finish();
 
         completion_handler handle_complete_;
         size_t ended_paths_;
+        size_t stored_count_;
         bool finished_;
 
+        resolver_list resolvers_;
+        boost::asio::deadline_timer deadline_;
+
         // From parent
+        async_service& service_;
         io_service::strand& strand_;
         hosts& hosts_;
-        handshake& handshake_;
-        network& network_;
     };
     std::shared_ptr<seeds> load_seeds_;
     friend class seeds;
@@ -141,7 +154,19 @@ private:
         for (channel_ptr node: accepted_channels_)
             node->send(packet, null_handle);
     }
+    template <typename Message>
+    void do_filtered_broadcast(const Message& packet, channel_filter filter)
+    {
+        auto null_handle = [](const std::error_code&) { };
+        for (const connection_info& connection: connections_)
+            if (filter(connection.node))
+                connection.node->send(packet, null_handle);
+        for (channel_ptr node: accepted_channels_)
+            if (filter(node))
+                node->send(packet, null_handle);
+    }
 
+    async_service& service_;
     io_service::strand strand_;
 
     const std::string hosts_filename_;
@@ -0,0 +1,111 @@
+#ifndef LIBBITCOIN_PEER_COST_H
+#define LIBBITCOIN_PEER_COST_H
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+
+namespace libbitcoin {
+
+// What validating one transaction cost us.
+struct validation_cost
+{
+    // Time spent validating on our own threads, so not counting the
+    // wait for the blockchain to answer.
+    boost::posix_time::time_duration cpu_time;
+    size_t storage_lookups = 0;
+    size_t bytes = 0;
+};
+
+typedef std::shared_ptr<validation_cost> validation_cost_ptr;
+
+// How session treats a peer's transactions, from cheapest to worst.
+enum class peer_standing
+{
+    normal,
+    // One transaction from the peer being validated at a time
+    deprioritized,
+    // Transactions from the peer are dropped unvalidated
+    throttled,
+    disconnect
+};
+
+struct peer_cost_policy
+{
+    // Storage lookups and bytes are charged as CPU time
+    boost::posix_time::time_duration lookup_cost =
+        boost::posix_time::microseconds(100);
+    size_t bytes_per_millisecond = 100000;
+    // Cost any peer can run up before being judged
+    boost::posix_time::time_duration allowance =
+        boost::posix_time::seconds(1);
+    // Peers are judged by cost / (value + allowance), where value is
+    // the cost of transactions we went on to accept.
+    double deprioritize_ratio = 1;
+    double throttle_ratio = 4;
+    double disconnect_ratio = 16;
+    // Cost and value halve over this time so peers can recover
+    boost::posix_time::time_duration half_life =
+        boost::posix_time::minutes(10);
+};
+
+/**
+ * Running account of what a peer's transactions cost us to validate
+ * and how much of that work was worth doing.
+ *
+ * A peer sending valid transactions has about as much value as cost.
+ * One sending transactions we reject after expensive checks (bad
+ * scripts, double spends...) builds up cost with no value and slides
+ * from normal to disconnect.
+ *
+ * @code
+ *  peer_cost_ptr cost = std::make_shared<peer_cost>();
+ *  txpool.store(tx, handle_confirm, handle_store, cost);
+ *  // later
+ *  if (cost->standing() == peer_standing::disconnect)
+ *      node->stop();
+ * @endcode
+ *
+ * Thread safe.
+ */
+class peer_cost
+{
+public:
+    peer_cost(const peer_cost_policy& policy=peer_cost_policy());
+
+    /**
+     * Charge a validation to the peer. accepted says whether the
+     * transaction made it into the pool.
+     */
+    void add(const validation_cost& cost, bool accepted);
+
+    // Undecayed totals since the peer connected
+    validation_cost totals() const;
+    size_t accepted() const;
+    size_t rejected() const;
+
+    double ratio();
+    peer_standing standing();
+
+private:
+    typedef boost::posix_time::ptime ptime;
+
+    void decay(ptime now);
+
+    const peer_cost_policy policy_;
+    mutable std::mutex mutex_;
+    validation_cost totals_;
+    size_t accepted_ = 0, rejected_ = 0;
+    // Decayed, in microseconds
+    double cost_ = 0, value_ = 0;
+    ptime last_decay_;
+};
+
+typedef std::shared_ptr<peer_cost> peer_cost_ptr;
+
+} // namespace libbitcoin
+
+#endif
+
@@ -0,0 +1,138 @@
+#ifndef LIBBITCOIN_QUERY_CLIENT_H
+#define LIBBITCOIN_QUERY_CLIENT_H
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <map>
+
+#include <boost/array.hpp>
+#include <boost/asio.hpp>
+
+#include <bitcoin/address.hpp>
+#include <bitcoin/async_service.hpp>
+#include <bitcoin/messages.hpp>
+#include <bitcoin/types.hpp>
+#include <bitcoin/blockchain/blockchain.hpp>
+#include <bitcoin/query/query_protocol.hpp>
+
+namespace libbitcoin {
+
+/**
+ * Client for query_server. Fetches mirror the blockchain interface
+ * and use the same handler types, so code written against a local
+ * blockchain can run against a node in another process.
+ *
+ * Any number of requests may be outstanding at once. They are
+ * pipelined over a single connection.
+ *
+ * @code
+ *  query_client client(service);
+ *  client.connect("/tmp/bitcoin-query", handle_connect);
+ *  // ... then
+ *  client.fetch_last_depth(handle_last_depth);
+ * @endcode
+ */
+class query_client
+{
+public:
+    typedef std::function<void (const std::error_code&)> connect_handler;
+
+    typedef std::vector<message::block> block_header_list;
+    typedef std::function<void (const std::error_code&,
+        const block_header_list&, bool)> fetch_handler_block_headers;
+
+    query_client(async_service& service);
+    ~query_client();
+
+    query_client(const query_client&) = delete;
+    void operator=(const query_client&) = delete;
+
+    void connect(const std::string& socket_path,
+        connect_handler handle_connect);
+    // Outstanding requests fail with error::service_stopped
+    void stop();
+
+    void fetch_block_header(size_t depth,
+        blockchain::fetch_handler_block_header handle_fetch);
+    void fetch_block_header(const hash_digest& block_hash,
+        blockchain::fetch_handler_block_header handle_fetch);
+    void fetch_block_transaction_hashes(size_t depth,
+        blockchain::fetch_handler_block_transaction_hashes handle_fetch);
+    void fetch_block_transaction_hashes(const hash_digest& block_hash,
+        blockchain::fetch_handler_block_transaction_hashes handle_fetch);
+    void fetch_block_depth(const hash_digest& block_hash,
+        blockchain::fetch_handler_block_depth handle_fetch);
+    void fetch_last_depth(blockchain::fetch_handler_last_depth handle_fetch);
+    void fetch_transaction(const hash_digest& transaction_hash,
+        blockchain::fetch_handler_transaction handle_fetch);
+    void fetch_transaction_index(const hash_digest& transaction_hash,
+        blockchain::fetch_handler_transaction_index handle_fetch);
+    void fetch_spend(const message::output_point& outpoint,
+        blockchain::fetch_handler_spend handle_fetch);
+    // The server streams the history, the handler is called once
+    // it has all arrived.
+    void fetch_outputs(const payment_address& address,
+        blockchain::fetch_handler_outputs handle_fetch);
+    // fetch transaction from the memory pool
+    void fetch_pool_transaction(const hash_digest& transaction_hash,
+        blockchain::fetch_handler_transaction handle_fetch);
+
+    /**
+     * Fetch count block headers starting at depth.
+     *
+     * handle_fetch is called as each batch of headers arrives. The
+     * last argument is true while more batches will follow.
+     * Running past the end of the chain finishes with error::not_found
+     * after the headers that do exist.
+     *
+     * @code
+     *  void handle_fetch(
+     *      const std::error_code& ec,          // Status of operation
+     *      const block_header_list& headers,   // Next batch of headers
+     *      bool more                           // More batches to come
+     *  );
+     * @endcode
+     */
+    void fetch_block_headers(size_t depth, size_t count,
+        fetch_handler_block_headers handle_fetch);
+
+private:
+    typedef boost::asio::local::stream_protocol::socket local_socket;
+    // Called with the payload of each frame replying to a request,
+    // and whether more frames follow.
+    typedef std::function<void (const std::error_code&, const data_chunk&,
+        bool)> frame_handler;
+    typedef std::map<uint32_t, frame_handler> frame_handler_map;
+
+    void send_request(query_command command, const data_chunk& payload,
+        frame_handler handle_frame);
+    void do_send_request(query_command command, const data_chunk& payload,
+        frame_handler handle_frame);
+    void write_next();
+    void handle_write(const boost::system::error_code& ec);
+
+    void read_header();
+    void handle_read_header(const boost::system::error_code& ec,
+        size_t bytes_transferred);
+    void handle_read_payload(const boost::system::error_code& ec,
+        size_t bytes_transferred, const query_frame_header& head);
+
+    void do_stop();
+
+    io_service::strand strand_;
+    local_socket socket_;
+    std::atomic<bool> stopped_;
+
+    uint32_t last_id_;
+    frame_handler_map pending_;
+    std::deque<data_chunk> outbound_;
+
+    boost::array<uint8_t, query_frame_header_size> inbound_header_;
+    data_chunk inbound_payload_;
+};
+
+} // namespace libbitcoin
+
+#endif
+
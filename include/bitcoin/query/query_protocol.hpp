@@ -0,0 +1,94 @@
+#ifndef LIBBITCOIN_QUERY_PROTOCOL_H
+#define LIBBITCOIN_QUERY_PROTOCOL_H
+
+#include <system_error>
+
+#include <bitcoin/messages.hpp>
+#include <bitcoin/types.hpp>
+#include <bitcoin/utility/serializer.hpp>
+
+namespace libbitcoin {
+
+/**
+ * Binary framing spoken between query_server and query_client.
+ *
+ * Each frame is a 10 byte header followed by the payload:
+ *
+ * @code
+ *  [ payload length:4 ][ request id:4 ][ command:1 ][ flags:1 ][ payload ]
+ * @endcode
+ *
+ * Clients may pipeline any number of requests. Replies carry the id
+ * of their request and can arrive in any order. Reply payloads begin
+ * with a 4 byte error code which is zero on success.
+ *
+ * Large results are streamed as several frames with query_flags::more
+ * set on every frame except the last one.
+ */
+enum class query_command : uint8_t
+{
+    // [ depth:4 ] -> [ header ]
+    block_header_by_depth = 1,
+    // [ hash:32 ] -> [ header ]
+    block_header_by_hash,
+    // [ depth:4 ] -> [ count:4 ][ hash:32 ]...
+    block_transaction_hashes_by_depth,
+    // [ hash:32 ] -> [ count:4 ][ hash:32 ]...
+    block_transaction_hashes_by_hash,
+    // [ hash:32 ] -> [ depth:4 ]
+    block_depth,
+    // [] -> [ depth:4 ]
+    last_depth,
+    // [ hash:32 ] -> [ tx ]
+    transaction,
+    // [ hash:32 ] -> [ depth:4 ][ index:4 ]
+    transaction_index,
+    // [ hash:32 ][ index:4 ] -> [ hash:32 ][ index:4 ]
+    spend,
+    // [ version:1 ][ short hash:20 ] -> stream of [ count:4 ][ point ]...
+    outputs,
+    // [ hash:32 ] -> [ tx ]
+    pool_transaction,
+    // [ depth:4 ][ count:4 ] -> stream of [ count:4 ][ header ]...
+    block_headers
+};
+
+namespace query_flags
+{
+    enum : uint8_t
+    {
+        // More frames follow for this request
+        more = 0x01
+    };
+}
+
+struct query_frame_header
+{
+    uint32_t payload_length;
+    uint32_t id;
+    query_command command;
+    uint8_t flags;
+};
+
+constexpr size_t query_frame_header_size = 10;
+// Anything larger is treated as a broken stream
+constexpr uint32_t query_max_payload_length = 16 * 1024 * 1024;
+
+bool is_query_command(uint8_t raw_command);
+
+// payload_length is taken from the payload
+data_chunk create_query_frame(uint32_t id, query_command command,
+    uint8_t flags, const data_chunk& payload);
+query_frame_header read_query_frame_header(const data_chunk& raw_header);
+
+void write_error_code(serializer& serial, const std::error_code& ec);
+std::error_code read_error_code(deserializer& deserial);
+
+// Serialized like the network block header with no transactions
+void write_block_header(serializer& serial, const message::block& blk);
+message::block read_block_header(deserializer& deserial);
+
+} // namespace libbitcoin
+
+#endif
+
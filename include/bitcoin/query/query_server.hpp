@@ -0,0 +1,123 @@
+#ifndef LIBBITCOIN_QUERY_SERVER_H
+#define LIBBITCOIN_QUERY_SERVER_H
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <boost/asio.hpp>
+
+#include <bitcoin/async_service.hpp>
+#include <bitcoin/messages.hpp>
+#include <bitcoin/types.hpp>
+#include <bitcoin/query/query_protocol.hpp>
+
+namespace libbitcoin {
+
+class query_connection;
+typedef std::shared_ptr<query_connection> query_connection_ptr;
+
+/**
+ * Serves the blockchain and transaction_pool fetch operations to other
+ * processes on the same machine over a Unix domain socket.
+ * See query_protocol.hpp for the wire format and query_client for
+ * the other side.
+ *
+ * Clients can pipeline requests, up to 100 at a time each. Past that,
+ * or past 1000 requests waiting on the same lookup, requests are
+ * answered with error::server_busy. Clients that leave more than 64MB
+ * of replies unread are dropped. Identical lookups in flight at the
+ * same time, from one or many clients, are batched into a single
+ * fetch whose result is sent to every requester. Address histories
+ * and block header ranges are streamed in several frames.
+ *
+ * @code
+ *  query_server server(service, chain, txpool);
+ *  server.start("/tmp/bitcoin-query", handle_start);
+ * @endcode
+ */
+class query_server
+{
+public:
+    typedef std::function<void (const std::error_code&)> start_handler;
+
+    query_server(async_service& service,
+        blockchain& chain, transaction_pool& txpool);
+    ~query_server();
+
+    query_server(const query_server&) = delete;
+    void operator=(const query_server&) = delete;
+
+    /**
+     * Listen for clients. Any stale socket file at socket_path
+     * left by a previous run is replaced.
+     *
+     * @param[in]   socket_path     Filesystem path of the socket
+     * @param[in]   handle_start    Completion handler for start operation.
+     * @code
+     *  void handle_start(
+     *      const std::error_code& ec   // Status of operation
+     *  );
+     * @endcode
+     */
+    void start(const std::string& socket_path, start_handler handle_start);
+    void stop();
+
+private:
+    friend class query_connection;
+
+    typedef boost::asio::local::stream_protocol::acceptor local_acceptor;
+    typedef std::function<void (const data_chunk&)> reply_handler;
+
+    struct waiter
+    {
+        query_connection_ptr connection;
+        uint32_t id;
+    };
+    typedef std::vector<waiter> waiter_list;
+    // Keyed by command + request payload
+    typedef std::map<data_chunk, waiter_list> pending_map;
+
+    struct header_stream;
+    typedef std::shared_ptr<header_stream> header_stream_ptr;
+
+    void accept_next();
+    void handle_accept(const boost::system::error_code& ec,
+        query_connection_ptr connection);
+
+    // Called by connections for every request frame
+    void request(query_connection_ptr connection,
+        const query_frame_header& head, const data_chunk& payload);
+    void do_request(query_connection_ptr connection,
+        const query_frame_header& head, const data_chunk& payload);
+    void fetch(query_command command, const data_chunk& payload,
+        reply_handler handle_reply);
+    void complete(const data_chunk& key, query_command command,
+        const data_chunk& reply);
+
+    void stream_outputs(query_connection_ptr connection,
+        uint32_t id, const data_chunk& payload);
+    void stream_block_headers(query_connection_ptr connection,
+        uint32_t id, const data_chunk& payload);
+    void next_block_header(header_stream_ptr stream);
+    void handle_block_header(const std::error_code& ec,
+        const message::block& blk, header_stream_ptr stream);
+
+    async_service& service_;
+    io_service::strand strand_;
+    blockchain& chain_;
+    transaction_pool& txpool_;
+    local_acceptor acceptor_;
+    std::string socket_path_;
+
+    pending_map pending_;
+
+    std::mutex connections_mutex_;
+    std::vector<std::weak_ptr<query_connection>> connections_;
+};
+
+} // namespace libbitcoin
+
+#endif
+
@@ -278,18 +278,16 @@ void satoshi_load(Iterator first, Iterator last, transaction& packet)
     BITCOIN_ASSERT(satoshi_raw_size(packet) == stream.size());
 }
 
+void save_block_header(serializer& serial, const message::block& packet);
+void read_block_header(deserializer& deserial, message::block& packet);
+
 const std::string satoshi_command(const block&);
 size_t satoshi_raw_size(const block& packet);
 template <typename Iterator>
 void satoshi_save(const block& packet, Iterator result)
 {
     serializer serial;
-    serial.write_4_bytes(packet.version);
-    serial.write_hash(packet.previous_block_hash);
-    serial.write_hash(packet.merkle);
-    serial.write_4_bytes(packet.timestamp);
-    serial.write_4_bytes(packet.bits);
-    serial.write_4_bytes(packet.nonce);
+    save_block_header(serial, packet);
     serial.write_variable_uint(packet.transactions.size());
     for (const message::transaction& tx: packet.transactions)
         save_transaction(serial, tx);
@@ -302,12 +300,7 @@ void satoshi_load(Iterator first, Iterator last, block& packet)
 {
     data_chunk stream(first, last);
     deserializer deserial(stream);
-    packet.version = deserial.read_4_bytes();
-    packet.previous_block_hash = deserial.read_hash();
-    packet.merkle = deserial.read_hash();
-    packet.timestamp = deserial.read_4_bytes();
-    packet.bits = deserial.read_4_bytes();
-    packet.nonce = deserial.read_4_bytes();
+    read_block_header(deserial, packet);
     uint64_t tx_count = deserial.read_variable_uint();
     for (size_t tx_i = 0; tx_i < tx_count; ++tx_i)
     {
@@ -318,6 +311,116 @@ void satoshi_load(Iterator first, Iterator last, block& packet)
     BITCOIN_ASSERT(satoshi_raw_size(packet) == stream.size());
 }
 
+// Short ids are 6 bytes on the wire
+constexpr size_t short_id_size = 6;
+
+const std::string satoshi_command(const compact_block&);
+size_t satoshi_raw_size(const compact_block& packet);
+template <typename Iterator>
+void satoshi_save(const compact_block& packet, Iterator result)
+{
+    serializer serial;
+    save_block_header(serial, packet.header);
+    serial.write_8_bytes(packet.nonce);
+    serial.write_variable_uint(packet.short_ids.size());
+    for (uint64_t short_id: packet.short_ids)
+    {
+        serial.write_4_bytes(short_id);
+        serial.write_2_bytes(short_id >> 32);
+    }
+    serial.write_variable_uint(packet.prefilled.size());
+    for (const prefilled_transaction& prefilled: packet.prefilled)
+    {
+        serial.write_variable_uint(prefilled.index);
+        save_transaction(serial, prefilled.tx);
+    }
+    data_chunk raw_data = serial.data();
+    BITCOIN_ASSERT(satoshi_raw_size(packet) == raw_data.size());
+    std::copy(raw_data.begin(), raw_data.end(), result);
+}
+template <typename Iterator>
+void satoshi_load(Iterator first, Iterator last, compact_block& packet)
+{
+    data_chunk stream(first, last);
+    deserializer deserial(stream);
+    read_block_header(deserial, packet.header);
+    packet.nonce = deserial.read_8_bytes();
+    uint64_t short_ids_count = deserial.read_variable_uint();
+    for (size_t i = 0; i < short_ids_count; ++i)
+    {
+        uint64_t short_id = deserial.read_4_bytes();
+        short_id |= static_cast<uint64_t>(deserial.read_2_bytes()) << 32;
+        packet.short_ids.push_back(short_id);
+    }
+    uint64_t prefilled_count = deserial.read_variable_uint();
+    for (size_t i = 0; i < prefilled_count; ++i)
+    {
+        prefilled_transaction prefilled;
+        prefilled.index = deserial.read_variable_uint();
+        read_transaction(deserial, prefilled.tx);
+        packet.prefilled.push_back(std::move(prefilled));
+    }
+    BITCOIN_ASSERT(satoshi_raw_size(packet) == stream.size());
+}
+
+const std::string satoshi_command(const get_block_transactions&);
+size_t satoshi_raw_size(const get_block_transactions& packet);
+template <typename Iterator>
+void satoshi_save(const get_block_transactions& packet, Iterator result)
+{
+    serializer serial;
+    serial.write_hash(packet.block_hash);
+    serial.write_variable_uint(packet.indexes.size());
+    for (size_t index: packet.indexes)
+        serial.write_variable_uint(index);
+    data_chunk raw_data = serial.data();
+    BITCOIN_ASSERT(satoshi_raw_size(packet) == raw_data.size());
+    std::copy(raw_data.begin(), raw_data.end(), result);
+}
+template <typename Iterator>
+void satoshi_load(Iterator first, Iterator last,
+    get_block_transactions& packet)
+{
+    data_chunk stream(first, last);
+    deserializer deserial(stream);
+    packet.block_hash = deserial.read_hash();
+    uint64_t count = deserial.read_variable_uint();
+    for (size_t i = 0; i < count; ++i)
+        packet.indexes.push_back(deserial.read_variable_uint());
+    BITCOIN_ASSERT(satoshi_raw_size(packet) == stream.size());
+}
+
+const std::string satoshi_command(const block_transactions&);
+size_t satoshi_raw_size(const block_transactions& packet);
+template <typename Iterator>
+void satoshi_save(const block_transactions& packet, Iterator result)
+{
+    serializer serial;
+    serial.write_hash(packet.block_hash);
+    serial.write_variable_uint(packet.transactions.size());
+    for (const message::transaction& tx: packet.transactions)
+        save_transaction(serial, tx);
+    data_chunk raw_data = serial.data();
+    BITCOIN_ASSERT(satoshi_raw_size(packet) == raw_data.size());
+    std::copy(raw_data.begin(), raw_data.end(), result);
+}
+template <typename Iterator>
+void satoshi_load(Iterator first, Iterator last,
+    block_transactions& packet)
+{
+    data_chunk stream(first, last);
+    deserializer deserial(stream);
+    packet.block_hash = deserial.read_hash();
+    uint64_t count = deserial.read_variable_uint();
+    for (size_t i = 0; i < count; ++i)
+    {
+        message::transaction tx;
+        read_transaction(deserial, tx);
+        packet.transactions.push_back(std::move(tx));
+    }
+    BITCOIN_ASSERT(satoshi_raw_size(packet) == stream.size());
+}
+
 const std::string satoshi_command(const ping&);
 size_t satoshi_raw_size(const ping& packet);
 template <typename Iterator>
@@ -1,10 +1,12 @@
 #ifndef LIBBITCOIN_SCRIPT_H
 #define LIBBITCOIN_SCRIPT_H
 
+#include <array>
 #include <vector>
 
 #include <bitcoin/types.hpp>
 #include <bitcoin/utility/big_number.hpp>
+#include <bitcoin/utility/small_chunk.hpp>
 
 namespace libbitcoin {
 
@@ -159,6 +161,12 @@ enum class payment_type
     non_standard
 };
 
+/**
+ * A parsed script. run() compiles the operations once into a table of
+ * handlers, checking the size limits and disabled opcodes up front, so
+ * executing a script is a straight walk through that table. Changing
+ * the script with push_operation() or join() drops the compiled form.
+ */
 class script
 {
 public:
@@ -176,7 +184,10 @@ public:
         const script& script_code, uint32_t hash_type);
 
 private:
-    typedef std::vector<data_chunk> data_stack;
+    // Items up to small_chunk::inline_capacity bytes live inside the
+    // stack's own storage, so stack operations don't allocate.
+    typedef std::vector<small_chunk> data_stack;
+    class stack_lease;
 
     class conditional_stack
     {
@@ -191,12 +202,29 @@ private:
     private:
         typedef std::vector<bool> bool_stack;
         bool_stack stack_;
+        // Number of false entries in stack_
+        size_t failed_ = 0;
     };
 
-    bool run(const message::transaction& parent_tx, uint32_t input_index);
-    bool next_step(operation_stack::iterator it,
+    typedef bool (*operation_handler)(script& self,
+        operation_stack::iterator it,
         const message::transaction& parent_tx, uint32_t input_index);
-    bool run_operation(const operation& op, 
+    typedef std::vector<operation_handler> operation_program;
+
+    enum class compile_state
+    {
+        none,
+        valid,
+        invalid
+    };
+
+    // Indexed by opcode. Built once on first use.
+    static const operation_handler* dispatch_table();
+    static std::array<operation_handler, 256> make_dispatch_table();
+
+    bool compile();
+    bool run(const message::transaction& parent_tx, uint32_t input_index);
+    bool next_step(operation_stack::iterator it, operation_handler handler,
         const message::transaction& parent_tx, uint32_t input_index);
 
     // Used by add, sub, mul, div, mod, lshift, rshift, booland, boolor,
@@ -270,11 +298,18 @@ private:
     bool op_checkmultisigverify(
         const message::transaction& parent_tx, uint32_t input_index);
 
-    data_chunk pop_stack();
+    small_chunk pop_stack();
 
     operation_stack operations_;
+    // One handler for each entry in operations_, filled by compile()
+    operation_program program_;
+    compile_state compile_state_ = compile_state::none;
+    // Non-push operations, counted by compile()
+    size_t compiled_operation_count_ = 0;
     // Used when executing the script
     data_stack stack_, alternate_stack_;
+    // Checkmultisig adds its public keys to the compiled count
+    size_t operation_count_ = 0;
     operation_stack::iterator codehash_begin_;
     conditional_stack conditional_stack_;
 };
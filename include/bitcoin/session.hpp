@@ -1,15 +1,21 @@
 #ifndef LIBBITCOIN_SESSION_H
 #define LIBBITCOIN_SESSION_H
 
+#include <deque>
+#include <map>
 #include <set>
+#include <string>
 
 #include <bitcoin/network/hosts.hpp>
 #include <bitcoin/network/handshake.hpp>
 #include <bitcoin/network/network.hpp>
 #include <bitcoin/network/protocol.hpp>
 #include <bitcoin/blockchain/blockchain.hpp>
+#include <bitcoin/compact_block_relay.hpp>
+#include <bitcoin/peer_cost.hpp>
 #include <bitcoin/poller.hpp>
 #include <bitcoin/transaction_pool.hpp>
+#include <bitcoin/tx_request_tracker.hpp>
 
 namespace libbitcoin {
 
@@ -20,6 +26,9 @@ struct session_params
     blockchain& blockchain_;
     poller& poller_;
     transaction_pool& transaction_pool_;
+    // Optional. When set we advertise node_compact_blocks and relay
+    // new blocks through it to peers that do too.
+    compact_block_relay* compact_block_relay_;
 };
 
 /**
@@ -86,10 +95,37 @@ public:
     typedef std::function<void (const std::error_code&)> completion_handler;
 
     session(async_service& service, const session_params& params);
+    // Reloads the transaction pool that stop() saved to "mempool".
+    // The pool must already be started.
     void start(completion_handler handle_complete);
     void stop(completion_handler handle_complete);
 
+    /**
+     * Have the session validate transactions from peers into the
+     * transaction pool itself, charging each peer for the work. Peers
+     * whose transactions cost a lot more than they're worth get one
+     * validation at a time, then have their transactions dropped, then
+     * get disconnected. Call before start().
+     *
+     * Until this is called, storing transactions is left to the
+     * application, which subscribes to them on each channel.
+     */
+    void set_cost_policy(const peer_cost_policy& policy);
+
 private:
+    struct peer_account
+    {
+        peer_cost_ptr cost;
+        size_t validating = 0;
+        // Deprioritized peers wait here for their turn
+        std::deque<message::transaction> waiting;
+    };
+    typedef std::map<channel_ptr, peer_account> peer_account_map;
+
+    void handle_load_pool(const std::error_code& ec, size_t accepted);
+    void handle_save_pool(const std::error_code& ec,
+        completion_handler handle_complete);
+
     void new_channel(channel_ptr node);
     void set_start_depth(const std::error_code& ec, size_t fork_point,
         const blockchain::block_list& new_blocks,
@@ -102,6 +138,18 @@ private:
     void get_blocks(const std::error_code& ec,
         const message::get_blocks& packet, channel_ptr node);
 
+    void transaction(const std::error_code& ec,
+        const message::transaction& tx, channel_ptr node);
+    void channel_stopped(channel_ptr node);
+    void handle_transaction(const message::transaction& tx,
+        channel_ptr node);
+    void store_transaction(const message::transaction& tx,
+        const hash_digest& tx_hash, channel_ptr node,
+        peer_account& account);
+    void handle_store(const std::error_code& ec,
+        const hash_digest& tx_hash, channel_ptr node);
+    void apply_policy(channel_ptr node, peer_standing standing);
+
     void new_tx_inventory(const hash_digest& tx_hash, channel_ptr node);
     void request_tx_data(bool tx_exists,
         const hash_digest& tx_hash, channel_ptr node);
@@ -113,8 +161,19 @@ private:
     blockchain& chain_;
     poller& poll_;
     transaction_pool& tx_pool_;
+    compact_block_relay* compact_relay_;
+    // The transaction pool is kept here between runs
+    const std::string tx_pool_filename_;
 
+    // Transactions which recently arrived, so we don't ask again
     pumpkin_buffer<hash_digest> grabbed_invs_;
+    tx_request_tracker tx_requests_;
+
+    // Set by set_cost_policy()
+    bool store_transactions_;
+    peer_cost_policy cost_policy_;
+    // Only touched in strand_
+    peer_account_map accounts_;
 };
 
 } // namespace libbitcoin
@@ -27,5 +27,31 @@ bool is_final(const message::transaction& tx,
 
 } // namespace libbitcoin
 
+// Make output_point usable as a std::unordered_* key
+namespace std
+{
+    template <>
+    struct hash<libbitcoin::message::output_point>
+    {
+        size_t operator()(
+            const libbitcoin::message::output_point& outpoint) const
+        {
+            return hash<libbitcoin::hash_digest>()(outpoint.hash) ^
+                (outpoint.index * 0x9e3779b9u);
+        }
+    };
+
+    // operator== lives in libbitcoin, out of reach of lookup from here
+    template <>
+    struct equal_to<libbitcoin::message::output_point>
+    {
+        bool operator()(const libbitcoin::message::output_point& a,
+            const libbitcoin::message::output_point& b) const
+        {
+            return libbitcoin::operator==(a, b);
+        }
+    };
+} // namespace std
+
 #endif
 
@@ -1,26 +1,82 @@
 #ifndef LIBBITCOIN_TRANSACTION_POOL_H
 #define LIBBITCOIN_TRANSACTION_POOL_H
 
+#include <array>
+#include <ctime>
 #include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <boost/circular_buffer.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
 
 #include <bitcoin/async_service.hpp>
 #include <bitcoin/types.hpp>
 #include <bitcoin/messages.hpp>
+#include <bitcoin/peer_cost.hpp>
+#include <bitcoin/transaction.hpp>
 #include <bitcoin/blockchain/blockchain.hpp>
 
 namespace libbitcoin {
 
+class validate_transaction;
+
+// Transactions are kept in their wire form, a fraction of the size of
+// a parsed message::transaction, and only parsed when asked for.
 struct transaction_entry_info
 {
     typedef std::function<void (const std::error_code&)> confirm_handler;
     hash_digest hash;
-    message::transaction tx;
+    data_chunk raw_tx;
+    // Previous output of each input, for double spend checks
+    message::output_point_list spent;
     confirm_handler handle_confirm;
+    // When we first saw it, kept across restarts by save() and load()
+    time_t arrival_time;
+    uint64_t fee;
+
+    message::transaction tx() const;
 };
 
 typedef boost::circular_buffer<transaction_entry_info> pool_buffer;
 
+// What's in a pool_buffer by hash and by spent outpoint, so checking a
+// new transaction for conflicts doesn't walk the whole pool.
+struct pool_index
+{
+    std::unordered_set<hash_digest> hashes;
+    std::unordered_set<message::output_point> spent;
+
+    void add(const transaction_entry_info& entry);
+    void remove(const transaction_entry_info& entry);
+};
+
+// error::duplicate or error::double_spend if the transaction is already
+// in the pool or spends an outpoint that a pool transaction spends.
+std::error_code pool_conflict(const pool_index& index,
+    const hash_digest& tx_hash, const message::output_point_list& spent);
+
+// Checks in the order validate_transaction runs them, cheapest first.
+// Everything before chain_duplicate runs without touching storage.
+enum class validation_stage
+{
+    format,
+    standard,
+    sigops,
+    dust,
+    pool_conflict,
+    chain_duplicate,
+    inputs,
+    // Passed every check
+    accepted
+};
+
+constexpr size_t validation_stage_count = 8;
+
+// Transactions that stopped at each validation_stage
+typedef std::array<uint64_t, validation_stage_count> validation_stage_counts;
+
 /**
  * Before bitcoin transactions make it into a block, they go into
  * a transaction memory pool. This class encapsulates that functionality
@@ -33,6 +89,15 @@ typedef boost::circular_buffer<transaction_entry_info> pool_buffer;
  * use of store's handle_store and handle_confirm to manage changes in the
  * state of memory pool transactions.
  *
+ * Transactions spending a parent we don't have yet are kept aside as
+ * orphans, indexed by the missing parent. When that parent enters the
+ * pool or a block, its orphans are stored again automatically. At most
+ * 100 orphans are kept for up to 20 minutes each.
+ *
+ * Validation runs its cheap checks (format, standardness, sigops, dust
+ * and conflicts with the pool) before going anywhere near storage.
+ * validation_counts() shows at which stage transactions are rejected.
+ *
  * @code
  *  async_service service(1);
  *  // transaction_pool needs access to the blockchain
@@ -51,8 +116,19 @@ public:
         void (const std::error_code&, const message::transaction&)>
             fetch_handler;
 
+    typedef std::function<
+        void (const std::error_code&, const data_chunk&)>
+            fetch_raw_handler;
+
     typedef std::function<void (bool)> exists_handler;
 
+    typedef std::function<void (const pool_buffer&)> visit_handler;
+
+    typedef std::function<void (const std::error_code&)> save_handler;
+
+    typedef std::function<void (const std::error_code&, size_t)>
+        load_handler;
+
     typedef transaction_entry_info::confirm_handler confirm_handler;
 
     transaction_pool(async_service& service, blockchain& chain);
@@ -72,7 +148,9 @@ public:
      * that is not in the blockchain and is currently in the memory pool.
      *
      * In the case where store results in error::input_not_found, the
-     * unconfirmed field refers to the single problematic input.
+     * unconfirmed field refers to the single problematic input. The
+     * transaction is kept as an orphan and stored again once the
+     * parent it needs turns up; handle_confirm is kept for that.
      *
      * @param[in]   stored_transaction  Transaction to store
      * @param[in]   handle_confirm      Handler for when transaction
@@ -90,9 +168,20 @@ public:
      *      const index_list& unconfirmed   // Unconfirmed input indexes
      *  );
      * @endcode
+     * @param[in]   cost                Optional. Charged with what
+     *                                  validating the transaction cost,
+     *                                  shortly after handle_store.
      */
     void store(const message::transaction& stored_transaction,
-        confirm_handler handle_confirm, store_handler handle_store);
+        confirm_handler handle_confirm, store_handler handle_store,
+        peer_cost_ptr cost=peer_cost_ptr());
+
+    /**
+     * How many transactions stopped at each validation_stage since the
+     * pool was created. Transactions that went in count as accepted.
+     * Safe to call from any thread.
+     */
+    validation_stage_counts validation_counts() const;
 
     /**
      * Fetch transaction by hash.
@@ -109,6 +198,22 @@ public:
     void fetch(const hash_digest& transaction_hash,
         fetch_handler handle_fetch);
 
+    /**
+     * Fetch transaction by hash in its wire form, ready to relay
+     * without parsing and serializing it again.
+     *
+     * @param[in]   transaction_hash  Transaction's hash
+     * @param[in]   handle_fetch      Completion handler for fetch operation.
+     * @code
+     *  void handle_fetch(
+     *      const std::error_code& ec,  // Status of operation
+     *      const data_chunk& raw_tx    // Serialized transaction
+     *  );
+     * @endcode
+     */
+    void fetch_raw(const hash_digest& transaction_hash,
+        fetch_raw_handler handle_fetch);
+
     /**
      * Is this transaction in the pool?
      *
@@ -121,14 +226,111 @@ public:
     void exists(const hash_digest& transaction_hash,
         exists_handler handle_exists);
 
+    /**
+     * Look over every transaction in the pool at once.
+     *
+     * handle_visit runs inside the pool's strand so the pool cannot
+     * change during the call. The reference is only valid until
+     * handle_visit returns; copy out anything needed later.
+     *
+     * @param[in]   handle_visit      Called with the pool's contents.
+     * @code
+     *  void handle_visit(const pool_buffer& pool);
+     * @endcode
+     */
+    void visit(visit_handler handle_visit);
+
+    /**
+     * Write every transaction in the pool to a file, so load() can
+     * bring them back after a restart. Call on shutdown.
+     *
+     * Each transaction is saved in its wire format with its arrival
+     * time and fee. The file is written next to path and renamed into
+     * place so a crash never leaves half a file.
+     *
+     * @param[in]   path            File to write.
+     * @param[in]   handle_save     Completion handler for save operation.
+     * @code
+     *  void handle_save(
+     *      const std::error_code& ec   // Status of operation
+     *  );
+     * @endcode
+     */
+    void save(const std::string& path, save_handler handle_save);
+
+    /**
+     * Store every transaction from a file written by save(). They are
+     * validated again against the current chain parents first: every
+     * transaction whose parents are already stored is validated at
+     * once, then the next generation. They keep their original arrival
+     * times. Call after start().
+     *
+     * @param[in]   path            File to read.
+     * @param[in]   handle_load     Called once every transaction has
+     *                              been validated.
+     * @code
+     *  void handle_load(
+     *      const std::error_code& ec,  // Status of operation
+     *      size_t accepted             // Transactions stored
+     *  );
+     * @endcode
+     */
+    void load(const std::string& path, load_handler handle_load);
+
 private:
     void do_store(const message::transaction& stored_transaction,
-        confirm_handler handle_confirm, store_handler handle_store);
+        confirm_handler handle_confirm, store_handler handle_store,
+        peer_cost_ptr cost, time_t arrival_time);
     void handle_delegate(
         const std::error_code& ec, const index_list& unconfirmed,
-        const transaction_entry_info& tx_entry, store_handler handle_store);
+        transaction_entry_info& tx_entry, store_handler handle_store,
+        std::weak_ptr<validate_transaction> validate,
+        validation_cost_ptr validate_cost, peer_cost_ptr cost);
+
+    struct loaded_entry
+    {
+        message::transaction tx;
+        time_t arrival_time;
+    };
+    // Entries spending each other end up in different batches
+    typedef std::vector<loaded_entry> loaded_batch;
+    struct load_state
+    {
+        std::vector<loaded_batch> batches;
+        size_t batch = 0, pending = 0, accepted = 0;
+        load_handler handle_load;
+    };
+    typedef std::shared_ptr<load_state> load_state_ptr;
+
+    void do_save(const std::string& path, save_handler handle_save);
+    void do_load(const std::string& path, load_handler handle_load);
+    void load_batch(load_state_ptr state);
+    void handle_load_store(const std::error_code& ec,
+        load_state_ptr state);
 
     bool tx_exists(const hash_digest& tx_hash);
+    // Keeps index_ in step, dropping the oldest entry if the pool is full
+    void add_entry(const transaction_entry_info& tx_entry);
+    void count_stage(validation_stage stage);
+
+    struct orphan_entry
+    {
+        transaction_entry_info entry;
+        peer_cost_ptr cost;
+        hash_digest missing_parent;
+        boost::posix_time::ptime added;
+    };
+    typedef std::unordered_map<hash_digest, orphan_entry> orphan_map;
+    // Missing parent hash to the hashes of orphans waiting on it
+    typedef std::unordered_multimap<hash_digest, hash_digest>
+        orphan_parent_map;
+
+    void add_orphan(const transaction_entry_info& tx_entry,
+        size_t missing_input, peer_cost_ptr cost);
+    void remove_orphan(orphan_map::iterator it);
+    void expire_orphans();
+    // Store again every orphan waiting on this parent
+    void resubmit_orphans(const hash_digest& parent_hash);
 
     void reorganize(const std::error_code& ec,
         size_t fork_point,
@@ -141,8 +343,62 @@ private:
     io_service::strand strand_;
     blockchain& chain_;
     pool_buffer pool_;
+    pool_index index_;
+    mutable std::mutex counts_mutex_;
+    validation_stage_counts counts_;
+    orphan_map orphans_;
+    orphan_parent_map orphans_by_parent_;
 };
 
+/**
+ * Fetch a transaction from the memory pool, or from the blockchain if
+ * it isn't in the pool.
+ *
+ * Like fetch_block(), this runs as a single async_frame so composing it
+ * into other queries costs no allocation per step.
+ *
+ * @param[in]   pool            Memory pool to look in first
+ * @param[in]   chain           Blockchain to fall back on
+ * @param[in]   tx_hash         Hash of transaction to fetch.
+ * @param[in]   handle_fetch    Completion handler for fetch operation.
+ * @code
+ *  void handle_fetch(
+ *      const std::error_code& ec,      // Status of operation
+ *      const message::transaction& tx  // Transaction
+ *  );
+ * @endcode
+ */
+void fetch_transaction(transaction_pool& pool, blockchain& chain,
+    const hash_digest& tx_hash, transaction_pool::fetch_handler handle_fetch);
+
+typedef std::function<
+    void (const std::error_code&, const message::transaction_output_list&)>
+        transaction_pool_fetch_handler_outputs;
+
+/**
+ * Fetch the previous output spent by every input of a transaction,
+ * looking in the memory pool and then the blockchain for each one.
+ * The lookups for all inputs run at once.
+ *
+ * Fails with error::input_not_found if an input's previous transaction
+ * can't be found or has no such output.
+ *
+ * @param[in]   pool            Memory pool to look in first
+ * @param[in]   chain           Blockchain to fall back on
+ * @param[in]   tx              Transaction whose inputs to follow.
+ * @param[in]   handle_fetch    Completion handler for fetch operation.
+ * @code
+ *  void handle_fetch(
+ *      const std::error_code& ec,  // Status of operation
+ *      const message::transaction_output_list& outputs
+ *                                  // One for each input, in order
+ *  );
+ * @endcode
+ */
+void fetch_previous_outputs(transaction_pool& pool, blockchain& chain,
+    const message::transaction& tx,
+    transaction_pool_fetch_handler_outputs handle_fetch);
+
 } // namespace libbitcoin
 
 #endif
@@ -0,0 +1,98 @@
+#ifndef LIBBITCOIN_TRANSACTION_SIGNER_H
+#define LIBBITCOIN_TRANSACTION_SIGNER_H
+
+#include <vector>
+
+#include <bitcoin/messages.hpp>
+#include <bitcoin/script.hpp>
+#include <bitcoin/utility/elliptic_curve_key.hpp>
+
+namespace libbitcoin {
+
+struct signing_input
+{
+    // Private key for the output being spent
+    elliptic_curve_key key;
+    // Script of the output being spent
+    script previous_output_script;
+};
+
+typedef std::vector<signing_input> signing_input_list;
+
+/**
+ * Signs every input of a transaction in one go.
+ *
+ * The parts of the transaction shared by every signature hash (version,
+ * outpoints, sequences, outputs and locktime) are serialized once when
+ * the signer is created. Each sighash then only splices in the script
+ * of the input being signed, instead of copying and reserializing the
+ * whole transaction like script::generate_signature_hash() does.
+ *
+ * Signing runs across several threads. The input scripts are written
+ * into the transaction once every input is signed.
+ *
+ * @code
+ *  signing_input_list keys(tx.inputs.size());
+ *  for (size_t i = 0; i < keys.size(); ++i)
+ *  {
+ *      keys[i].key.set_secret(secrets[i]);
+ *      keys[i].previous_output_script = previous_scripts[i];
+ *  }
+ *  transaction_signer signer(tx);
+ *  if (!signer.sign(keys))
+ *      // Some input couldn't be signed. tx is left unchanged.
+ * @endcode
+ *
+ * Inputs spending pay-to-pubkey-hash outputs get a <signature> <pubkey>
+ * input script and pay-to-pubkey outputs get just <signature>.
+ */
+class transaction_signer
+{
+public:
+    /**
+     * The transaction must outlive the signer. Changing anything
+     * except its input scripts invalidates the signer.
+     */
+    transaction_signer(message::transaction& tx);
+
+    transaction_signer(const transaction_signer&) = delete;
+    void operator=(const transaction_signer&) = delete;
+
+    /**
+     * Same result as script::generate_signature_hash() for this
+     * transaction.
+     */
+    hash_digest signature_hash(uint32_t input_index,
+        const script& script_code, uint32_t hash_type) const;
+
+    /**
+     * Sign every input, one signing_input for each input.
+     * number_threads of 0 uses one thread per core.
+     *
+     * @return false if any input couldn't be signed, in which case the
+     * transaction isn't modified.
+     */
+    bool sign(const signing_input_list& inputs,
+        uint32_t hash_type=sighash::all, size_t number_threads=0);
+
+private:
+    hash_digest signature_hash(uint32_t input_index,
+        const script& script_code, uint32_t hash_type,
+        data_chunk& preimage) const;
+    bool sign_input(uint32_t input_index, const signing_input& input,
+        uint32_t hash_type, data_chunk& preimage,
+        script& input_script) const;
+
+    message::transaction& tx_;
+    // version and input count
+    data_chunk head_;
+    // Each input's outpoint followed by its sequence
+    data_chunk inputs_;
+    // outputs and locktime
+    data_chunk tail_;
+};
+
+} // namespace libbitcoin
+
+#endif
+
@@ -0,0 +1,103 @@
+#ifndef LIBBITCOIN_TX_REQUEST_TRACKER_H
+#define LIBBITCOIN_TX_REQUEST_TRACKER_H
+
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/asio/deadline_timer.hpp>
+
+#include <bitcoin/async_service.hpp>
+#include <bitcoin/network/channel.hpp>
+#include <bitcoin/types.hpp>
+
+namespace libbitcoin {
+
+/**
+ * Tracks getdata requests for announced transactions.
+ *
+ * Every peer announcing a hash is remembered. The transaction is asked
+ * for from one of them at a time. If that peer hasn't sent it before
+ * the timeout, or disconnects, the next announcer is asked instead.
+ * Each peer has a cap on requests in flight so one slow peer can't
+ * hold up everything; hashes wait for another announcer or a free slot.
+ * Entries are forgotten as soon as the transaction arrives from anyone.
+ *
+ * Not thread safe. Every call must come from the strand passed in,
+ * which the timeout timer also runs in.
+ *
+ * @code
+ *  tx_request_tracker requests(service, strand_);
+ *  requests.start();
+ *  // inv from node
+ *  requests.announced(tx_hash, node);
+ *  // tx from node
+ *  requests.received(tx_hash, node);
+ *  // node stopped
+ *  requests.remove_peer(node);
+ * @endcode
+ */
+class tx_request_tracker
+{
+public:
+    tx_request_tracker(async_service& service,
+        io_service::strand& async_strand);
+
+    tx_request_tracker(const tx_request_tracker&) = delete;
+    void operator=(const tx_request_tracker&) = delete;
+
+    void start();
+    void stop();
+
+    /**
+     * node has the transaction. Requests it unless a request to
+     * another peer is already in flight.
+     */
+    void announced(const hash_digest& tx_hash, channel_ptr node);
+
+    /**
+     * The transaction arrived. Forgets it and frees up the slot of the
+     * peer it was requested from.
+     */
+    void received(const hash_digest& tx_hash, channel_ptr node);
+
+    /**
+     * Requests in flight to node go to the next announcer.
+     */
+    void remove_peer(channel_ptr node);
+
+    // Hashes waiting or in flight
+    size_t size() const;
+
+private:
+    typedef boost::posix_time::ptime ptime;
+    typedef std::vector<channel_ptr> channel_ptr_list;
+
+    struct tx_request
+    {
+        // Not yet asked, in the order they announced
+        channel_ptr_list announcers;
+        // Empty while waiting for an announcer with a free slot
+        channel_ptr requested_from;
+        ptime expires;
+    };
+    typedef std::unordered_map<hash_digest, tx_request> tx_request_map;
+
+    // Asks the first announcer with a free slot. false if none have one.
+    bool request(const hash_digest& tx_hash, tx_request& entry);
+    void release(channel_ptr node);
+    void set_timer();
+    void handle_timer(const boost::system::error_code& ec);
+
+    io_service::strand& strand_;
+    boost::asio::deadline_timer timer_;
+    bool stopped_;
+
+    tx_request_map requests_;
+    std::map<channel_ptr, size_t> in_flight_;
+};
+
+} // namespace libbitcoin
+
+#endif
+
@@ -0,0 +1,194 @@
+#ifndef LIBBITCOIN_UTILITY_ASYNC_FRAME_HPP
+#define LIBBITCOIN_UTILITY_ASYNC_FRAME_HPP
+
+#include <atomic>
+#include <system_error>
+
+#include <boost/asio/coroutine.hpp>
+
+namespace libbitcoin {
+
+template <typename Frame>
+struct frame_resume_impl
+{
+    Frame* frame;
+
+    template <typename... Args>
+    void operator()(const std::error_code& ec, Args&&...) const
+    {
+        frame->resume_with(ec);
+    }
+};
+
+template <typename Frame, typename T>
+struct frame_resume_slot_impl
+{
+    Frame* frame;
+    T* slot;
+
+    // Results after the first are dropped
+    template <typename... Rest>
+    void operator()(const std::error_code& ec, const T& value,
+        const Rest&...) const
+    {
+        if (!ec)
+            *slot = value;
+        frame->resume_with(ec);
+    }
+};
+
+template <typename Frame, typename T>
+struct frame_join_slot_impl
+{
+    Frame* frame;
+    T* slot;
+
+    template <typename... Rest>
+    void operator()(const std::error_code& ec, const T& value,
+        const Rest&...) const
+    {
+        if (!ec)
+            *slot = value;
+        frame->join_with(ec);
+    }
+};
+
+/**
+ * A heap allocated stackless coroutine for composing several
+ * asynchronous calls into one operation.
+ *
+ * Derived implements operator()() with its body inside reenter (this)
+ * from <boost/asio/yield.hpp>. Each step passes resume() or join() as the
+ * completion handler. These are just a frame pointer and a result slot,
+ * small enough for std::function to store without allocating, so the
+ * whole operation costs one allocation for the frame.
+ *
+ * @code
+ *  yield chain_.fetch_last_depth(resume(last_depth_));
+ *  if (error())
+ *      ...
+ *  yield
+ *  {
+ *      begin_join(count);
+ *      for (size_t i = 0; i < count; ++i)
+ *          chain_.fetch_block_header(i, join(headers_[i]));
+ *      end_join();
+ *  }
+ * @endcode
+ *
+ * Resumptions never overlap, even when a handler is called inline or
+ * from another thread before the yield finished. The frame deletes
+ * itself once the body completes.
+ */
+template <typename Derived>
+class async_frame
+  : protected boost::asio::coroutine
+{
+public:
+    async_frame()
+      : active_(0), pending_(0), join_failed_(false) {}
+
+    async_frame(const async_frame&) = delete;
+    void operator=(const async_frame&) = delete;
+
+    // Runs the body up to its first yield.
+    void start()
+    {
+        wake();
+    }
+
+protected:
+    virtual ~async_frame() {}
+
+    // Status of the last step, or the first failure of a join.
+    const std::error_code& error() const
+    {
+        return ec_;
+    }
+
+    // Handler for calls completing with just an error_code, or whose
+    // results aren't needed.
+    frame_resume_impl<Derived> resume()
+    {
+        return {derived()};
+    }
+    // Handler storing the result in slot before resuming. Only the
+    // first result is kept when the call passes back several.
+    template <typename T>
+    frame_resume_slot_impl<Derived, T> resume(T& slot)
+    {
+        return {derived(), &slot};
+    }
+
+    // Fan out to count calls and resume once all of them complete.
+    void begin_join(size_t count)
+    {
+        ec_ = std::error_code();
+        join_failed_ = false;
+        // Held until end_join() so an early finish can't resume us
+        // before every call has been issued.
+        pending_ = count + 1;
+    }
+    template <typename T>
+    frame_join_slot_impl<Derived, T> join(T& slot)
+    {
+        return {derived(), &slot};
+    }
+    void end_join()
+    {
+        if (--pending_ == 0)
+            wake();
+    }
+
+private:
+    template <typename Frame>
+    friend struct frame_resume_impl;
+    template <typename Frame, typename T>
+    friend struct frame_resume_slot_impl;
+    template <typename Frame, typename T>
+    friend struct frame_join_slot_impl;
+
+    Derived* derived()
+    {
+        return static_cast<Derived*>(this);
+    }
+
+    void resume_with(const std::error_code& ec)
+    {
+        ec_ = ec;
+        wake();
+    }
+    void join_with(const std::error_code& ec)
+    {
+        if (ec && !join_failed_.exchange(true))
+            ec_ = ec;
+        end_join();
+    }
+
+    // Whoever finds the frame idle runs the body. Anyone arriving
+    // while it runs leaves the next step for that thread.
+    void wake()
+    {
+        if (active_++ != 0)
+            return;
+        bool complete;
+        do
+        {
+            (*derived())();
+            complete = is_complete();
+        }
+        while (--active_ != 0);
+        if (complete)
+            delete this;
+    }
+
+    std::atomic<size_t> active_;
+    std::atomic<size_t> pending_;
+    std::atomic<bool> join_failed_;
+    std::error_code ec_;
+};
+
+} // namespace libbitcoin
+
+#endif
+
@@ -22,6 +22,8 @@ public:
 
     bool set_public_key(const data_chunk& pubkey);
     data_chunk public_key() const;
+    // Choose 33 byte compressed or 65 byte uncompressed public_key()
+    void set_compressed(bool compressed);
     bool verify(hash_digest hash, const data_chunk& signature);
 
     bool new_key_pair();
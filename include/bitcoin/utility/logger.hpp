@@ -15,7 +15,8 @@ enum class log_domain
     validation,
     protocol,
     poller,
-    session
+    session,
+    query
 };
 
 enum class log_level
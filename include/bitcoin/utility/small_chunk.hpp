@@ -0,0 +1,122 @@
+#ifndef LIBBITCOIN_UTILITY_SMALL_CHUNK_HPP
+#define LIBBITCOIN_UTILITY_SMALL_CHUNK_HPP
+
+#include <algorithm>
+#include <array>
+#include <iterator>
+
+#include <bitcoin/types.hpp>
+
+namespace libbitcoin {
+
+/**
+ * A byte string which keeps up to inline_capacity bytes in place and
+ * only goes to the heap for anything longer.
+ *
+ * Used for script stack items. Signatures (up to 73 bytes), public
+ * keys (33 or 65) and hashes all fit inline, so pushing, copying and
+ * popping them never allocates.
+ */
+class small_chunk
+{
+public:
+    static constexpr size_t inline_capacity = 75;
+
+    typedef uint8_t value_type;
+    typedef const uint8_t* const_iterator;
+
+    small_chunk()
+      : size_(0) {}
+
+    // Implicit so a data_chunk can be pushed straight onto a stack
+    small_chunk(const data_chunk& data)
+    {
+        assign(data.begin(), data.end());
+    }
+    template <typename Iterator>
+    small_chunk(Iterator first, Iterator last)
+    {
+        assign(first, last);
+    }
+
+    template <typename Iterator>
+    void assign(Iterator first, Iterator last)
+    {
+        size_ = std::distance(first, last);
+        if (size_ <= inline_capacity)
+        {
+            std::copy(first, last, inline_.begin());
+            heap_.clear();
+        }
+        else
+            heap_.assign(first, last);
+    }
+
+    const uint8_t* data() const
+    {
+        return size_ <= inline_capacity ? inline_.data() : heap_.data();
+    }
+    const_iterator begin() const
+    {
+        return data();
+    }
+    const_iterator end() const
+    {
+        return data() + size_;
+    }
+
+    size_t size() const
+    {
+        return size_;
+    }
+    bool empty() const
+    {
+        return size_ == 0;
+    }
+
+    uint8_t operator[](size_t index) const
+    {
+        return data()[index];
+    }
+    uint8_t back() const
+    {
+        return data()[size_ - 1];
+    }
+
+    // Copy out for interfaces taking a data_chunk.
+    data_chunk chunk() const
+    {
+        return data_chunk(begin(), end());
+    }
+
+    bool operator==(const small_chunk& other) const
+    {
+        return size_ == other.size_ &&
+            std::equal(begin(), end(), other.begin());
+    }
+    bool operator!=(const small_chunk& other) const
+    {
+        return !(*this == other);
+    }
+
+private:
+    size_t size_;
+    std::array<uint8_t, inline_capacity> inline_;
+    // Only used above inline_capacity. Empty otherwise so copies of
+    // short items never touch the heap.
+    data_chunk heap_;
+};
+
+inline bool operator==(const small_chunk& a, const data_chunk& b)
+{
+    return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin());
+}
+inline bool operator==(const data_chunk& a, const small_chunk& b)
+{
+    return b == a;
+}
+
+} // namespace libbitcoin
+
+#endif
+
@@ -0,0 +1,71 @@
+#ifndef LIBBITCOIN_UTILITY_TOKEN_BUCKET_HPP
+#define LIBBITCOIN_UTILITY_TOKEN_BUCKET_HPP
+
+#include <cstdint>
+#include <mutex>
+
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+
+namespace libbitcoin {
+
+/**
+ * Rate limiter. Fills at rate bytes per second up to burst bytes.
+ *
+ * Sends are allowed whenever the bucket isn't in debt and take their
+ * whole size, so a message bigger than the burst still goes through and
+ * later sends wait for the bucket to refill. A reserve holds back
+ * low priority traffic while the bucket is nearly empty.
+ *
+ * @code
+ *  token_bucket upload(100000);
+ *  time_duration wait = upload.wait_time();
+ *  if (wait.is_zero())
+ *  {
+ *      upload.consume(message.size());
+ *      // write message
+ *  }
+ *  else
+ *      // try again after wait
+ * @endcode
+ *
+ * Thread safe.
+ */
+class token_bucket
+{
+public:
+    /**
+     * A rate of 0 is unlimited. A burst of 0 is one second's worth.
+     */
+    token_bucket(uint64_t rate=0, uint64_t burst=0);
+
+    token_bucket(const token_bucket&) = delete;
+    void operator=(const token_bucket&) = delete;
+
+    void set_rate(uint64_t rate, uint64_t burst=0);
+    bool unlimited() const;
+    uint64_t burst() const;
+
+    /**
+     * How long until the bucket holds at least reserve bytes.
+     * Zero when there's no need to wait.
+     */
+    boost::posix_time::time_duration wait_time(uint64_t reserve=0);
+
+    void consume(uint64_t bytes);
+
+private:
+    typedef boost::posix_time::ptime ptime;
+
+    void refill(ptime now);
+
+    mutable std::mutex mutex_;
+    uint64_t rate_, burst_;
+    // Can go negative after a send larger than what's left
+    int64_t tokens_;
+    ptime last_refill_;
+};
+
+} // namespace libbitcoin
+
+#endif
+
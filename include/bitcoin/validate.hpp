@@ -7,6 +7,7 @@
 
 #include <bitcoin/messages.hpp>
 #include <bitcoin/types.hpp>
+#include <bitcoin/peer_cost.hpp>
 #include <bitcoin/transaction_pool.hpp>
 
 namespace libbitcoin {
@@ -20,9 +21,17 @@ public:
 
     validate_transaction(
         blockchain& chain, const message::transaction& tx,
-        const pool_buffer& pool, io_service::strand& async_strand);
+        const pool_buffer& pool, const pool_index& index,
+        io_service::strand& async_strand);
     void start(validate_handler handle_validate);
 
+    // Filled in as validation goes. Complete once handle_validate runs.
+    validation_cost_ptr cost() const;
+    // Only set once validation succeeds
+    uint64_t fee() const;
+    // Where a rejected transaction stopped, or accepted
+    validation_stage stage() const;
+
     static std::error_code check_transaction(
         const message::transaction& tx);
     static bool connect_input(
@@ -33,30 +42,14 @@ public:
         uint64_t value_in, uint64_t& fees);
 
 private:
-    std::error_code basic_checks() const;
+    // Every check that doesn't need storage, cheapest first
+    std::error_code basic_checks();
     bool is_standard() const;
-    const message::transaction* fetch(const hash_digest& tx_hash) const;
-
-    void handle_duplicate_check(const std::error_code& ec);
-    bool is_spent(const message::output_point outpoint) const;
-
-    // Used for checking coinbase maturity
-    void set_last_depth(const std::error_code& ec, size_t last_depth);
-    // Begin looping through the inputs, fetching the previous tx
-    void next_previous_transaction();
-    void previous_tx_index(const std::error_code& ec, size_t parent_depth);
-    // If previous_tx_index didn't find it then check in pool instead
-    void search_pool_previous_tx();
-    void handle_previous_tx(const std::error_code& ec,
-        const message::transaction& previous_tx, size_t parent_depth);
-    // After running connect_input, we check whether this
-    // validated previous output wasn't already spent by
-    // another input in the blockchain.
-    // is_spent() earlier already checked in the pool.
-    void check_double_spend(const std::error_code& ec);
-    // next_previous_transaction();
-
-    void check_fees();
+    bool fetch(const hash_digest& tx_hash, message::transaction& tx) const;
+
+    // The checks against storage, run as an async_frame once
+    // basic_checks() passes
+    class validate_frame;
 
     io_service::strand& strand_;
     blockchain& chain_;
@@ -64,11 +57,11 @@ private:
     const message::transaction tx_;
     const hash_digest tx_hash_;
     const pool_buffer& pool_;
-    size_t last_block_depth_;
-    uint64_t value_in_;
-    size_t current_input_;
-    index_list unconfirmed_;
+    const pool_index& index_;
+    validation_stage stage_;
+    uint64_t fee_;
     validate_handler handle_validate_;
+    const validation_cost_ptr cost_;
 };
 
 typedef std::shared_ptr<validate_transaction> validate_transaction_ptr;
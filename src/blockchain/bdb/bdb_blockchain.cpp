@@ -1,6 +1,9 @@
 #include <bitcoin/blockchain/bdb_blockchain.hpp>
 
+#include <algorithm>
+#include <atomic>
 #include <fstream>
+#include <mutex>
 
 #include <boost/filesystem.hpp>
 
@@ -21,27 +24,43 @@
 
 namespace libbitcoin {
 
+// DB_REGISTER only runs recovery when no other process is attached
 constexpr uint32_t env_flags =
     DB_CREATE|
     DB_RECOVER|
+    DB_REGISTER|
     DB_INIT_LOCK|
     DB_INIT_LOG|
     DB_INIT_TXN|
     DB_INIT_MPOOL|
     DB_THREAD;
 
-constexpr uint32_t db_flags = DB_CREATE|DB_THREAD;
+// Readers join the writer's environment
+constexpr uint32_t read_only_env_flags =
+    DB_REGISTER|
+    DB_INIT_LOCK|
+    DB_INIT_LOG|
+    DB_INIT_TXN|
+    DB_INIT_MPOOL|
+    DB_THREAD;
+
+// Multiversion so snapshot reads don't block the writer
+constexpr uint32_t db_flags = DB_CREATE|DB_THREAD|DB_MULTIVERSION;
+constexpr uint32_t read_only_db_flags = DB_RDONLY|DB_THREAD|DB_MULTIVERSION;
 
-bdb_blockchain::bdb_blockchain(async_service& service)
-  : async_strand(service)
+bdb_blockchain::bdb_blockchain(async_service& service, size_t prune_window)
+  : async_strand(service), prune_window_(prune_window), read_only_(false)
 {
 #ifndef CXX_COMPAT
     env_ = nullptr;
     db_blocks_ = nullptr;
     db_blocks_hash_ = nullptr;
     db_txs_ = nullptr;
+    db_tx_numbers_ = nullptr;
+    db_tx_numbers_hash_ = nullptr;
     db_spends_ = nullptr;
     db_address_ = nullptr;
+    db_sequence_ = nullptr;
 #endif
     reorganize_subscriber_ =
         std::make_shared<reorganize_subscriber_type>(service);
@@ -57,7 +76,19 @@ void bdb_blockchain::start(const std::string& prefix,
     queue(
         [this, prefix, handle_start]
         {
-            if (initialize(prefix))
+            if (initialize(prefix, false))
+                handle_start(std::error_code());
+            else
+                handle_start(error::start_failed);
+        });
+}
+void bdb_blockchain::start_read_only(const std::string& prefix,
+    start_handler handle_start)
+{
+    queue(
+        [this, prefix, handle_start]
+        {
+            if (initialize(prefix, true))
                 handle_start(std::error_code());
             else
                 handle_start(error::start_failed);
@@ -84,11 +115,14 @@ void bdb_blockchain::shutdown()
         return;
     // Close secondaries before primaries
     shutdown_database(db_blocks_hash_);
+    shutdown_database(db_tx_numbers_hash_);
     // Close primaries
     shutdown_database(db_blocks_);
     shutdown_database(db_txs_);
+    shutdown_database(db_tx_numbers_);
     shutdown_database(db_spends_);
     shutdown_database(db_address_);
+    shutdown_database(db_sequence_);
     shutdown_database(env_);
     // delete
     google::protobuf::ShutdownProtobufLibrary();
@@ -98,12 +132,14 @@ bool bdb_blockchain::setup(const std::string& prefix)
 {
     async_service fake_service;
     bdb_blockchain handle(fake_service);
-    if (!handle.initialize(prefix))
+    if (!handle.initialize(prefix, false))
         return false;
     handle.db_blocks_->truncate(nullptr, 0, 0);
     handle.db_txs_->truncate(nullptr, 0, 0);
+    handle.db_tx_numbers_->truncate(nullptr, 0, 0);
     handle.db_spends_->truncate(nullptr, 0, 0);
     handle.db_address_->truncate(nullptr, 0, 0);
+    handle.db_sequence_->truncate(nullptr, 0, 0);
     // Save genesis block
     txn_guard_ptr txn = std::make_shared<txn_guard>(handle.env_);
     if (!handle.common_->save_block(txn, 0, genesis_block()))
@@ -132,7 +168,16 @@ int get_block_hash(Db*, const Dbt*, const Dbt* data, Dbt* second_key)
     return 0;
 }
 
-int bt_compare_blocks(DB*, const DBT* dbt1, const DBT* dbt2)
+int get_tx_number_hash(Db*, const Dbt*, const Dbt* data, Dbt* second_key)
+{
+    // Value is the transaction hash itself
+    second_key->set_data(data->get_data());
+    second_key->set_size(data->get_size());
+    return 0;
+}
+
+// Compares block depths and transaction numbers
+int bt_compare_uint32(DB*, const DBT* dbt1, const DBT* dbt2)
 {
     data_chunk key_data1(dbt1->size), key_data2(dbt2->size);
     memcpy(key_data1.data(), dbt1->data, dbt1->size);
@@ -146,18 +191,23 @@ int bt_compare_blocks(DB*, const DBT* dbt1, const DBT* dbt2)
     return 0;
 }
 
-bool bdb_blockchain::initialize(const std::string& prefix)
+bool bdb_blockchain::initialize(const std::string& prefix, bool read_only)
 {
-    // Try to lock the directory first
-    boost::filesystem::path lock_path = prefix;
-    lock_path = lock_path / "db-lock";
-    std::ofstream touch_file(lock_path.native(), std::ios::app);
-    touch_file.close();
-    flock_ = lock_path.c_str();
-    if (!flock_.try_lock())
+    read_only_ = read_only;
+    // Only one writer at a time
+    if (!read_only_)
     {
-        // Database already opened elsewhere
-        return false;
+        // Try to lock the directory first
+        boost::filesystem::path lock_path = prefix;
+        lock_path = lock_path / "db-lock";
+        std::ofstream touch_file(lock_path.native(), std::ios::app);
+        touch_file.close();
+        flock_ = lock_path.c_str();
+        if (!flock_.try_lock())
+        {
+            // Database already opened elsewhere
+            return false;
+        }
     }
     // Continue on
     GOOGLE_PROTOBUF_VERIFY_VERSION;
@@ -165,7 +215,8 @@ bool bdb_blockchain::initialize(const std::string& prefix)
     env_->set_lk_max_locks(10000);
     env_->set_lk_max_objects(10000);
     env_->set_cachesize(1, 0, 1);
-    if (env_->open(prefix.c_str(), env_flags, 0) != 0)
+    if (env_->open(prefix.c_str(),
+            read_only_ ? read_only_env_flags : env_flags, 0) != 0)
         return false;
     if (env_->set_flags(DB_TXN_NOSYNC, 1) != 0)
         return false;
@@ -173,41 +224,63 @@ bool bdb_blockchain::initialize(const std::string& prefix)
     db_blocks_ = new Db(env_, 0);
     db_blocks_hash_ = new Db(env_, 0);
     db_txs_ = new Db(env_, 0);
+    db_tx_numbers_ = new Db(env_, 0);
+    db_tx_numbers_hash_ = new Db(env_, 0);
     db_spends_ = new Db(env_, 0);
     db_address_ = new Db(env_, 0);
-    if (db_blocks_->set_bt_compare(bt_compare_blocks) != 0)
+    db_sequence_ = new Db(env_, 0);
+    if (db_blocks_->set_bt_compare(bt_compare_uint32) != 0 ||
+        db_tx_numbers_->set_bt_compare(bt_compare_uint32) != 0)
     {
         log_fatal() << "Internal error setting BTREE comparison function";
         return false;
     }
+    const uint32_t open_flags = read_only_ ? read_only_db_flags : db_flags;
     txn_guard txn(env_);
     if (db_blocks_->open(txn.get(), "blocks", "block-data",
-            DB_BTREE, db_flags, 0) != 0)
+            DB_BTREE, open_flags, 0) != 0)
         return false;
     if (db_blocks_hash_->open(txn.get(), "blocks", "block-hash", 
-            DB_BTREE, db_flags, 0) != 0)
+            DB_BTREE, open_flags, 0) != 0)
         return false;
     db_blocks_->associate(txn.get(), db_blocks_hash_, get_block_hash, 0);
     if (db_txs_->open(txn.get(), "transactions", "tx",
-            DB_BTREE, db_flags, 0) != 0)
+            DB_BTREE, open_flags, 0) != 0)
+        return false;
+    if (db_tx_numbers_->open(txn.get(), "transactions", "tx-number",
+            DB_BTREE, open_flags, 0) != 0)
         return false;
+    if (db_tx_numbers_hash_->open(txn.get(), "transactions",
+            "tx-number-hash", DB_BTREE, open_flags, 0) != 0)
+        return false;
+    db_tx_numbers_->associate(txn.get(), db_tx_numbers_hash_,
+        get_tx_number_hash, 0);
     if (db_spends_->open(txn.get(), "transactions", "spends",
-            DB_BTREE, db_flags, 0) != 0)
+            DB_BTREE, open_flags, 0) != 0)
         return false;
     if (db_address_->set_flags(DB_DUP) != 0)
         return false;
     if (db_address_->open(txn.get(), "address", "address",
-            DB_BTREE, db_flags, 0) != 0)
+            DB_BTREE, open_flags, 0) != 0)
+        return false;
+    if (db_sequence_->open(txn.get(), "meta", "sequence",
+            DB_BTREE, open_flags, 0) != 0)
         return false;
     txn.commit();
 
     common_ = std::make_shared<bdb_common>(env_,
-        db_blocks_, db_blocks_hash_, db_txs_, db_spends_, db_address_);
+        db_blocks_, db_blocks_hash_, db_txs_,
+        db_tx_numbers_, db_tx_numbers_hash_, db_spends_, db_address_,
+        db_sequence_);
+    // Blocks are only organized by the writer
+    if (read_only_)
+        return true;
 
     orphans_ = std::make_shared<orphans_pool>(20);
     bdb_chain_keeper_ptr chainkeeper = 
         std::make_shared<bdb_chain_keeper>(common_, env_,
-            db_blocks_, db_blocks_hash_, db_txs_, db_spends_, db_address_);
+            db_blocks_, db_blocks_hash_, db_txs_, db_spends_, db_address_,
+            prune_window_);
     chain_ = chainkeeper;
     organize_ = std::make_shared<bdb_organizer>(
         common_, orphans_, chainkeeper, reorganize_subscriber_);
@@ -218,6 +291,12 @@ bool bdb_blockchain::initialize(const std::string& prefix)
 void bdb_blockchain::store(const message::block& stored_block, 
     store_block_handler handle_store)
 {
+    if (read_only_)
+    {
+        handle_store(error::read_only,
+            block_info{block_status::rejected, 0});
+        return;
+    }
     queue(
         std::bind(&bdb_blockchain::do_store,
             this, stored_block, handle_store));
@@ -272,7 +351,7 @@ void bdb_blockchain::fetch_block_header(size_t depth,
 void bdb_blockchain::fetch_block_header_by_depth(size_t depth,
     fetch_handler_block_header handle_fetch)
 {
-    txn_guard_ptr txn = std::make_shared<txn_guard>(env_);
+    txn_guard_ptr txn = std::make_shared<txn_guard>(env_, txn_snapshot);
     message::block serial_block;
     if (!fetch_block_header_impl(txn, depth, common_, serial_block))
     {
@@ -295,7 +374,7 @@ void bdb_blockchain::fetch_block_header(const hash_digest& block_hash,
 void bdb_blockchain::fetch_block_header_by_hash(
     const hash_digest& block_hash, fetch_handler_block_header handle_fetch)
 {
-    txn_guard_ptr txn = std::make_shared<txn_guard>(env_);
+    txn_guard_ptr txn = std::make_shared<txn_guard>(env_, txn_snapshot);
     message::block serial_block;
     if (!fetch_block_header_impl(txn, block_hash, common_, serial_block))
     {
@@ -311,7 +390,7 @@ template<typename Index, typename Handler>
 void fetch_blk_tx_hashes_impl(const Index& index, DbEnv* env,
     bdb_common_ptr common, Handler handle_fetch)
 {
-    txn_guard_ptr txn = std::make_shared<txn_guard>(env);
+    txn_guard_ptr txn = std::make_shared<txn_guard>(env, txn_snapshot);
     protobuf::Block proto_block = common->fetch_proto_block(txn, index);
     if (!proto_block.IsInitialized())
     {
@@ -319,17 +398,20 @@ void fetch_blk_tx_hashes_impl(const Index& index, DbEnv* env,
         handle_fetch(error::not_found, message::inventory_list());
         return;
     }
-    txn->commit();
     message::inventory_list tx_hashes;
-    for (const std::string& raw_tx_hash: proto_block.transactions())
+    for (uint32_t tx_number: proto_block.transactions())
     {
         message::inventory_vector tx_inv;
         tx_inv.type = message::inventory_type::transaction;
-        BITCOIN_ASSERT(raw_tx_hash.size() == tx_inv.hash.size());
-        std::copy(raw_tx_hash.begin(), raw_tx_hash.end(),
-            tx_inv.hash.begin());
+        if (!common->fetch_tx_hash(txn, tx_number, tx_inv.hash))
+        {
+            txn->abort();
+            handle_fetch(error::not_found, message::inventory_list());
+            return;
+        }
         tx_hashes.push_back(tx_inv);
     }
+    txn->commit();
     handle_fetch(std::error_code(), tx_hashes);
 }
 
@@ -368,7 +450,7 @@ void bdb_blockchain::do_fetch_block_depth(const hash_digest& block_hash,
     key.set(block_hash);
     writable_data_type primary_key;
     empty_data_type ignore_data;
-    txn_guard_ptr txn = std::make_shared<txn_guard>(env_);
+    txn_guard_ptr txn = std::make_shared<txn_guard>(env_, txn_snapshot);
     if (db_blocks_hash_->pget(txn->get(), key.get(),
         primary_key.get(), ignore_data.get(), 0) != 0)
     {
@@ -389,7 +471,7 @@ void bdb_blockchain::fetch_last_depth(fetch_handler_last_depth handle_fetch)
 }
 void bdb_blockchain::do_fetch_last_depth(fetch_handler_last_depth handle_fetch)
 {
-    txn_guard_ptr txn = std::make_shared<txn_guard>(env_);
+    txn_guard_ptr txn = std::make_shared<txn_guard>(env_, txn_snapshot);
     uint32_t last_depth = common_->find_last_block_depth(txn);
     txn->commit();
     if (last_depth == std::numeric_limits<uint32_t>::max())
@@ -410,15 +492,18 @@ void bdb_blockchain::fetch_transaction(const hash_digest& transaction_hash,
 void bdb_blockchain::do_fetch_transaction(const hash_digest& transaction_hash,
     fetch_handler_transaction handle_fetch)
 {
-    txn_guard_ptr txn = std::make_shared<txn_guard>(env_);
+    txn_guard_ptr txn = std::make_shared<txn_guard>(env_, txn_snapshot);
     protobuf::Transaction proto_tx =
         common_->fetch_proto_transaction(txn, transaction_hash);
-    txn->commit();
     if (!proto_tx.IsInitialized())
     {
-        handle_fetch(error::not_found, message::transaction());
+        bool pruned = common_->transaction_pruned(txn, transaction_hash);
+        txn->commit();
+        handle_fetch(pruned ? error::pruned : error::not_found,
+            message::transaction());
         return;
     }
+    txn->commit();
     message::transaction tx = protobuf_to_transaction(proto_tx);
     handle_fetch(std::error_code(), tx);
 }
@@ -435,15 +520,17 @@ void bdb_blockchain::do_fetch_transaction_index(
     const hash_digest& transaction_hash,
     fetch_handler_transaction_index handle_fetch)
 {
-    txn_guard_ptr txn = std::make_shared<txn_guard>(env_);
+    txn_guard_ptr txn = std::make_shared<txn_guard>(env_, txn_snapshot);
     protobuf::Transaction proto_tx =
         common_->fetch_proto_transaction(txn, transaction_hash);
-    txn->commit();
     if (!proto_tx.IsInitialized())
     {
-        handle_fetch(error::not_found, 0, 0);
+        bool pruned = common_->transaction_pruned(txn, transaction_hash);
+        txn->commit();
+        handle_fetch(pruned ? error::pruned : error::not_found, 0, 0);
         return;
     }
+    txn->commit();
     size_t parent_block_depth = 0, index_in_parent = 0;
     for (auto parent: proto_tx.parent())
     {
@@ -466,12 +553,15 @@ void bdb_blockchain::fetch_spend(const message::output_point& outpoint,
 void bdb_blockchain::do_fetch_spend(const message::output_point& outpoint,
     fetch_handler_spend handle_fetch)
 {
-    txn_guard_ptr txn = std::make_shared<txn_guard>(env_);
+    txn_guard_ptr txn = std::make_shared<txn_guard>(env_, txn_snapshot);
     message::input_point input_spend;
     if (!common_->fetch_spend(txn, outpoint, input_spend))
     {
+        // Spends of pruned transactions are deleted with them
+        bool pruned = common_->transaction_pruned(txn, outpoint.hash);
         txn->abort();
-        handle_fetch(error::unspent_output, message::input_point());
+        handle_fetch(pruned ? error::pruned : error::unspent_output,
+            message::input_point());
         return;
     }
     txn->commit();
@@ -494,7 +584,7 @@ void bdb_blockchain::do_fetch_outputs(const payment_address& address,
 {
     // Associated outputs
     message::output_point_list assoc_outs;
-    txn_guard_ptr txn = std::make_shared<txn_guard>(env_);
+    txn_guard_ptr txn = std::make_shared<txn_guard>(env_, txn_snapshot);
     Dbc* cursor;
     db_address_->cursor(txn->get(), &cursor, 0);
     BITCOIN_ASSERT(cursor != nullptr);
@@ -513,8 +603,15 @@ void bdb_blockchain::do_fetch_outputs(const payment_address& address,
         data_chunk raw_outpoint(value.data());
         // Then read the value off
         deserializer deserial(raw_outpoint);
-        outpoint.hash = deserial.read_hash();
+        uint32_t tx_number = deserial.read_4_bytes();
         outpoint.index = deserial.read_4_bytes();
+        if (!common_->fetch_tx_hash(txn, tx_number, outpoint.hash))
+        {
+            cursor->close();
+            txn->abort();
+            handle_fetch(error::not_found, message::output_point_list());
+            return;
+        }
         assoc_outs.push_back(outpoint);
         ret = cursor->get(key.get(), value.get(), DB_NEXT_DUP);
     }
@@ -523,6 +620,198 @@ void bdb_blockchain::do_fetch_outputs(const payment_address& address,
     handle_fetch(std::error_code(), assoc_outs);
 }
 
+void bdb_blockchain::fetch_sequence(fetch_handler_sequence handle_fetch)
+{
+    queue(
+        std::bind(&bdb_blockchain::do_fetch_sequence,
+            this, handle_fetch));
+}
+void bdb_blockchain::do_fetch_sequence(fetch_handler_sequence handle_fetch)
+{
+    txn_guard_ptr txn = std::make_shared<txn_guard>(env_, txn_snapshot);
+    uint64_t sequence = common_->fetch_sequence(txn);
+    txn->commit();
+    handle_fetch(std::error_code(), sequence);
+}
+
+struct bdb_blockchain::scan_state
+{
+    scan_state(scan_visitor& visitor, size_t total,
+        size_t number_partitions, scan_progress_handler handle_progress,
+        scan_handler handle_scan)
+      : visitor(visitor), total(total), scanned(0),
+        remaining_partitions(number_partitions), stopped(false),
+        failed(false), handle_progress(handle_progress),
+        handle_scan(handle_scan)
+    {
+    }
+
+    scan_visitor& visitor;
+    const size_t total;
+    std::atomic<size_t> scanned;
+    std::atomic<size_t> remaining_partitions;
+    // Set when the visitor asks to finish early
+    std::atomic<bool> stopped;
+    std::atomic<bool> failed;
+    // Partitions report progress from different threads
+    std::mutex progress_mutex;
+    scan_progress_handler handle_progress;
+    scan_handler handle_scan;
+};
+
+constexpr size_t scan_progress_interval = 2000;
+// Blocks read under one snapshot before a fresh one is taken
+constexpr size_t scan_snapshot_blocks = 1000;
+
+void bdb_blockchain::scan(async_service& scan_service,
+    size_t number_partitions, scan_visitor& visitor,
+    scan_progress_handler handle_progress, scan_handler handle_scan)
+{
+    queue(
+        std::bind(&bdb_blockchain::do_scan,
+            this, std::ref(scan_service), number_partitions,
+            std::ref(visitor), handle_progress, handle_scan));
+}
+void bdb_blockchain::do_scan(async_service& scan_service,
+    size_t number_partitions, scan_visitor& visitor,
+    scan_progress_handler handle_progress, scan_handler handle_scan)
+{
+    txn_guard_ptr txn = std::make_shared<txn_guard>(env_, txn_snapshot);
+    uint32_t last_depth = common_->find_last_block_depth(txn);
+    txn->commit();
+    if (last_depth == std::numeric_limits<uint32_t>::max())
+    {
+        handle_scan(error::not_found);
+        return;
+    }
+    // Fix the range now so blocks arriving during the scan are left out
+    const size_t total = last_depth + 1;
+    if (number_partitions == 0)
+        number_partitions = 1;
+    if (number_partitions > total)
+        number_partitions = total;
+    auto state = std::make_shared<scan_state>(visitor, total,
+        number_partitions, handle_progress, handle_scan);
+    const size_t partition_size = total / number_partitions;
+    size_t begin = 0;
+    for (size_t i = 0; i < number_partitions; ++i)
+    {
+        // Spread the remainder over the first partitions
+        size_t end = begin + partition_size +
+            (i < total % number_partitions ? 1 : 0);
+        scan_service.get_service().post(
+            std::bind(&bdb_blockchain::scan_partition,
+                this, state, begin, end));
+        begin = end;
+    }
+    BITCOIN_ASSERT(begin == total);
+}
+
+enum class scan_result
+{
+    next,
+    stopped,
+    failed
+};
+
+static scan_result scan_block(txn_guard_ptr txn, bdb_common_ptr common,
+    scan_visitor& visitor, size_t depth, const protobuf::Block& proto_block)
+{
+    if (!visitor.visit_block(depth, protobuf_to_block_header(proto_block)))
+        return scan_result::stopped;
+    for (size_t i = 0; i < (size_t)proto_block.transactions_size(); ++i)
+    {
+        hash_digest tx_hash;
+        if (!common->fetch_tx_hash(txn, proto_block.transactions(i), tx_hash))
+        {
+            log_error(log_domain::blockchain)
+                << "Scan failed reading transaction " << i
+                << " of block " << depth;
+            return scan_result::failed;
+        }
+        protobuf::Transaction proto_tx =
+            common->fetch_proto_transaction(txn, tx_hash);
+        // Pruned
+        if (!proto_tx.IsInitialized())
+            continue;
+        const message::transaction tx = protobuf_to_transaction(proto_tx);
+        if (!visitor.visit_transaction(depth, i, tx_hash, tx))
+            return scan_result::stopped;
+        for (size_t j = 0; j < tx.inputs.size(); ++j)
+            if (!visitor.visit_input(tx_hash, j, tx.inputs[j]))
+                return scan_result::stopped;
+        for (size_t j = 0; j < tx.outputs.size(); ++j)
+            if (!visitor.visit_output(tx_hash, j, tx.outputs[j]))
+                return scan_result::stopped;
+    }
+    return scan_result::next;
+}
+
+void bdb_blockchain::scan_range(scan_state_ptr state,
+    size_t begin, size_t end)
+{
+    txn_guard_ptr txn = std::make_shared<txn_guard>(env_, txn_snapshot);
+    Dbc* cursor;
+    db_blocks_->cursor(txn->get(), &cursor, 0);
+    BITCOIN_ASSERT(cursor != nullptr);
+    readable_data_type key;
+    key.set(begin);
+    writable_data_type_ptr value = std::make_shared<writable_data_type>();
+    int ret = cursor->get(key.get(), value->get(), DB_SET);
+    for (size_t depth = begin; depth < end && !state->stopped; ++depth)
+    {
+        if (ret != 0)
+        {
+            log_error(log_domain::blockchain)
+                << "Scan failed reading block " << depth;
+            state->failed = true;
+            break;
+        }
+        const data_chunk raw_object = value->data();
+        protobuf::Block proto_block;
+        proto_block.ParseFromArray(raw_object.data(), raw_object.size());
+        scan_result result =
+            scan_block(txn, common_, state->visitor, depth, proto_block);
+        if (result == scan_result::failed)
+        {
+            state->failed = true;
+            break;
+        }
+        else if (result == scan_result::stopped)
+            state->stopped = true;
+        size_t scanned = ++state->scanned;
+        if (scanned % scan_progress_interval == 0)
+        {
+            std::lock_guard<std::mutex> lock(state->progress_mutex);
+            state->handle_progress(scanned, state->total);
+        }
+        value = std::make_shared<writable_data_type>();
+        ret = cursor->get(key.get(), value->get(), DB_NEXT);
+    }
+    cursor->close();
+    txn->commit();
+}
+
+void bdb_blockchain::scan_partition(scan_state_ptr state,
+    size_t begin, size_t end)
+{
+    // Snapshot reads are never refused because a writer holds a lock,
+    // but one snapshot held for the whole scan would pin old page
+    // versions in the cache. Take a fresh one every so many blocks.
+    for (size_t depth = begin; depth < end && !state->stopped
+        && !state->failed; depth += scan_snapshot_blocks)
+        scan_range(state, depth, std::min(depth + scan_snapshot_blocks, end));
+    // Last partition out reports the result
+    if (--state->remaining_partitions != 0)
+        return;
+    if (state->failed)
+        state->handle_scan(error::not_found);
+    else if (state->stopped)
+        state->handle_scan(error::service_stopped);
+    else
+        state->handle_scan(std::error_code());
+}
+
 void bdb_blockchain::subscribe_reorganize(
     reorganize_handler handle_reorganize)
 {
@@ -12,10 +12,12 @@ namespace libbitcoin {
 
 bdb_chain_keeper::bdb_chain_keeper(bdb_common_ptr common, DbEnv* env,
     Db* db_blocks, Db* db_blocks_hash,
-    Db* db_txs, Db* db_spends, Db* db_address)
+    Db* db_txs, Db* db_spends, Db* db_address,
+    size_t prune_window)
   : common_(common), env_(env),
     db_blocks_(db_blocks), db_blocks_hash_(db_blocks_hash),
-    db_txs_(db_txs), db_spends_(db_spends), db_address_(db_address)
+    db_txs_(db_txs), db_spends_(db_spends), db_address_(db_address),
+    prune_window_(prune_window)
 {
 }
 
@@ -34,8 +36,15 @@ void bdb_chain_keeper::add(block_detail_ptr incoming_block)
 {
     uint32_t last_block_depth = common_->find_last_block_depth(txn_);
     const message::block& actual_block = incoming_block->actual();
-    if (!common_->save_block(txn_, last_block_depth + 1, actual_block))
+    uint32_t depth = last_block_depth + 1;
+    if (!common_->save_block(txn_, depth, actual_block))
         log_fatal() << "Saving block in organizer failed";
+    // Oldest block leaves the window of full blocks
+    else if (prune_window_ && depth >= prune_window_ &&
+        !prune_block(depth - prune_window_))
+        log_fatal() << "Pruning block in organizer failed";
+    else if (!common_->increment_sequence(txn_))
+        log_fatal() << "Updating chain sequence in organizer failed";
 }
 
 int bdb_chain_keeper::find_index(const hash_digest& search_block_hash)
@@ -122,13 +131,16 @@ bool bdb_chain_keeper::end_slice(size_t slice_begin_index,
         value = std::make_shared<writable_data_type>();
     }
     while (cursor->get(key.get(), value->get(), DB_NEXT) == 0);
-    return true;
+    return common_->increment_sequence(txn_);
 }
 
 bool bdb_chain_keeper::clear_transaction_data(
     const message::transaction& remove_tx)
 {
     const hash_digest& tx_hash = hash_transaction(remove_tx);
+    uint32_t tx_number;
+    if (!common_->fetch_tx_number(txn_, tx_hash, tx_number))
+        return false;
     readable_data_type del_tx_key;
     del_tx_key.set(tx_hash);
     if (db_txs_->del(txn_->get(), del_tx_key.get(), 0) != 0)
@@ -141,28 +153,40 @@ bool bdb_chain_keeper::clear_transaction_data(
         {
             const message::transaction_input& input = 
                 remove_tx.inputs[input_index];
-            const message::input_point inpoint{tx_hash, input_index};
-            if (!remove_spend(input.previous_output, inpoint))
+            if (!remove_spend(input.previous_output))
                 return false;
         }
-    // Remove addresses
+    // Remove addresses and any spends of our outputs.
+    // Spenders come later in the chain so are being removed too, but
+    // their lookups of our number will fail once it's deleted below.
     for (uint32_t output_index = 0; output_index < remove_tx.outputs.size();
         ++output_index)
     {
         const message::transaction_output& output =
             remove_tx.outputs[output_index];
-        if (!remove_address(output.output_script, {tx_hash, output_index}))
+        if (!remove_address(output.output_script, tx_number, output_index))
+            return false;
+        if (!remove_spend(tx_number, output_index))
             return false;
     }
-    return true;
+    return common_->remove_tx_number(txn_, tx_number);
 }
 
 bool bdb_chain_keeper::remove_spend(
-    const message::output_point& previous_output,
-    const message::input_point& current_input)
+    const message::output_point& previous_output)
+{
+    uint32_t previous_tx_number;
+    // Already removed along with the previous transaction
+    if (!common_->fetch_tx_number(txn_,
+            previous_output.hash, previous_tx_number))
+        return true;
+    return remove_spend(previous_tx_number, previous_output.index);
+}
+
+bool bdb_chain_keeper::remove_spend(uint32_t tx_number, uint32_t index)
 {
     readable_data_type spent_key;
-    spent_key.set(create_spent_key(previous_output));
+    spent_key.set(create_spent_key(tx_number, index));
     int ret = db_spends_->del(txn_->get(), spent_key.get(), 0);
     if (ret != 0 && ret != DB_NOTFOUND)
         return false;
@@ -170,14 +194,14 @@ bool bdb_chain_keeper::remove_spend(
 }
 
 bool bdb_chain_keeper::remove_address(const script& output_script,
-    const message::output_point& outpoint)
+    uint32_t tx_number, uint32_t output_index)
 {
     data_chunk raw_address = create_address_key(output_script);
     if (raw_address.empty())
         return true;
     readable_data_type address_key, output_value;
     address_key.set(raw_address);
-    output_value.set(create_spent_key(outpoint));
+    output_value.set(create_spent_key(tx_number, output_index));
     // Perform the actual delete
     Dbc* cursor;
     db_address_->cursor(txn_->get(), &cursor, 0);
@@ -190,10 +214,127 @@ bool bdb_chain_keeper::remove_address(const script& output_script,
     return true;
 }
 
+uint32_t max_parent_depth(const protobuf::Transaction& proto_tx)
+{
+    uint32_t depth = 0;
+    for (const auto& parent: proto_tx.parent())
+        depth = std::max(depth, parent.depth());
+    return depth;
+}
+
+bool bdb_chain_keeper::prune_block(uint32_t prune_depth)
+{
+    protobuf::Block proto_block =
+        common_->fetch_proto_block(txn_, prune_depth);
+    if (!proto_block.IsInitialized())
+        return false;
+    // Either this block's transactions or the previous transactions
+    // they spend may now have all their outputs spent below the window.
+    std::vector<hash_digest> candidates;
+    for (uint32_t tx_number: proto_block.transactions())
+    {
+        hash_digest tx_hash;
+        if (!common_->fetch_tx_hash(txn_, tx_number, tx_hash))
+            return false;
+        candidates.push_back(tx_hash);
+        protobuf::Transaction proto_tx =
+            common_->fetch_proto_transaction(txn_, tx_hash);
+        if (!proto_tx.IsInitialized() || proto_tx.is_coinbase())
+            continue;
+        for (const auto& proto_input: proto_tx.inputs())
+        {
+            const std::string& raw_previous_hash =
+                proto_input.previous_output_hash();
+            hash_digest previous_hash;
+            BITCOIN_ASSERT(raw_previous_hash.size() == previous_hash.size());
+            std::copy(raw_previous_hash.begin(), raw_previous_hash.end(),
+                previous_hash.begin());
+            candidates.push_back(previous_hash);
+        }
+    }
+    for (const hash_digest& tx_hash: candidates)
+        if (!prune_transaction(tx_hash, prune_depth))
+            return false;
+    return true;
+}
+
+bool bdb_chain_keeper::prune_transaction(
+    const hash_digest& tx_hash, uint32_t prune_depth)
+{
+    protobuf::Transaction proto_tx =
+        common_->fetch_proto_transaction(txn_, tx_hash);
+    // Already pruned
+    if (!proto_tx.IsInitialized())
+        return true;
+    if (max_parent_depth(proto_tx) > prune_depth)
+        return true;
+    uint32_t tx_number;
+    if (!common_->fetch_tx_number(txn_, tx_hash, tx_number))
+        return false;
+    const uint32_t outputs_size = proto_tx.outputs_size();
+    for (uint32_t output_index = 0; output_index < outputs_size;
+        ++output_index)
+    {
+        if (!spent_before(tx_number, output_index, prune_depth))
+            return true;
+    }
+    // Nothing can spend this transaction anymore. Its number is kept
+    // because spends of the outputs it spent still refer to it.
+    const message::transaction pruned_tx = protobuf_to_transaction(proto_tx);
+    readable_data_type del_tx_key;
+    del_tx_key.set(tx_hash);
+    if (db_txs_->del(txn_->get(), del_tx_key.get(), 0) != 0)
+        return false;
+    for (uint32_t output_index = 0; output_index < pruned_tx.outputs.size();
+        ++output_index)
+    {
+        const message::transaction_output& output =
+            pruned_tx.outputs[output_index];
+        if (!remove_address(output.output_script, tx_number, output_index))
+            return false;
+        if (!remove_spend(tx_number, output_index))
+            return false;
+    }
+    return true;
+}
+
+bool bdb_chain_keeper::spent_before(uint32_t tx_number,
+    uint32_t output_index, uint32_t prune_depth)
+{
+    readable_data_type spent_key;
+    spent_key.set(create_spent_key(tx_number, output_index));
+    writable_data_type raw_spend;
+    if (db_spends_->get(txn_->get(), spent_key.get(),
+            raw_spend.get(), 0) != 0)
+        return false;
+    const data_chunk raw_spend_data = raw_spend.data();
+    deserializer deserial(raw_spend_data);
+    uint32_t spend_tx_number = deserial.read_4_bytes();
+    hash_digest spend_tx_hash;
+    if (!common_->fetch_tx_hash(txn_, spend_tx_number, spend_tx_hash))
+        return false;
+    protobuf::Transaction spend_proto_tx =
+        common_->fetch_proto_transaction(txn_, spend_tx_hash);
+    // Spender was itself pruned so it's below the window
+    if (!spend_proto_tx.IsInitialized())
+        return true;
+    return max_parent_depth(spend_proto_tx) <= prune_depth;
+}
+
 txn_guard_ptr bdb_chain_keeper::txn()
 {
     return txn_;
 }
 
+bool bdb_chain_keeper::can_reorganize(size_t fork_index)
+{
+    if (!prune_window_)
+        return true;
+    // Blocks at depth last_block_depth - prune_window_ and below
+    // are pruned and cannot be reconstructed by end_slice()
+    uint32_t last_block_depth = common_->find_last_block_depth(txn_);
+    return fork_index + prune_window_ >= last_block_depth;
+}
+
 } // namespace libbitcoin
 
@@ -17,7 +17,8 @@ class bdb_chain_keeper
 public:
     bdb_chain_keeper(bdb_common_ptr common, DbEnv* env,
         Db* db_blocks, Db* db_blocks_hash,
-        Db* db_txs, Db* db_spends, Db* db_address);
+        Db* db_txs, Db* db_spends, Db* db_address,
+        size_t prune_window);
 
     void start();
     void stop();
@@ -30,12 +31,20 @@ public:
 
     txn_guard_ptr txn();
 
+    // False if the blocks after fork_index have been pruned
+    bool can_reorganize(size_t fork_index);
+
 private:
     bool clear_transaction_data(const message::transaction& remove_tx);
-    bool remove_spend(const message::output_point& previous_output,
-        const message::input_point& current_input);
+    bool remove_spend(const message::output_point& previous_output);
+    bool remove_spend(uint32_t tx_number, uint32_t index);
     bool remove_address(const script& output_script,
-        const message::output_point& outpoint);
+        uint32_t tx_number, uint32_t output_index);
+
+    bool prune_block(uint32_t prune_depth);
+    bool prune_transaction(const hash_digest& tx_hash, uint32_t prune_depth);
+    bool spent_before(uint32_t tx_number, uint32_t output_index,
+        uint32_t prune_depth);
 
     txn_guard_ptr txn_;
 
@@ -47,6 +56,8 @@ private:
     Db* db_txs_;
     Db* db_spends_;
     Db* db_address_;
+
+    size_t prune_window_;
 };
 
 typedef std::shared_ptr<bdb_chain_keeper> bdb_chain_keeper_ptr;
@@ -11,9 +11,13 @@
 namespace libbitcoin {
 
 bdb_common::bdb_common(DbEnv* env, Db* db_blocks, Db* db_blocks_hash,
-    Db* db_txs, Db* db_spends, Db* db_address)
+    Db* db_txs, Db* db_tx_numbers, Db* db_tx_numbers_hash,
+    Db* db_spends, Db* db_address, Db* db_sequence)
   : env_(env), db_blocks_(db_blocks), db_blocks_hash_(db_blocks_hash),
-    db_txs_(db_txs), db_spends_(db_spends), db_address_(db_address)
+    db_txs_(db_txs), db_tx_numbers_(db_tx_numbers),
+    db_tx_numbers_hash_(db_tx_numbers_hash),
+    db_spends_(db_spends), db_address_(db_address),
+    db_sequence_(db_sequence)
 {
 }
 
@@ -35,17 +39,20 @@ bool bdb_common::fetch_spend(txn_guard_ptr txn,
     const message::output_point& spent_output,
     message::input_point& input_spend)
 {
+    uint32_t spent_tx_number;
+    if (!fetch_tx_number(txn, spent_output.hash, spent_tx_number))
+        return false;
     readable_data_type search_spend;
-    search_spend.set(create_spent_key(spent_output));
+    search_spend.set(create_spent_key(spent_tx_number, spent_output.index));
     writable_data_type raw_spend;
     if (db_spends_->get(txn->get(), search_spend.get(),
             raw_spend.get(), 0) != 0)
         return false;
     const data_chunk raw_spend_data = raw_spend.data();
     deserializer deserial(raw_spend_data);
-    input_spend.hash = deserial.read_hash();
+    uint32_t spend_tx_number = deserial.read_4_bytes();
     input_spend.index = deserial.read_4_bytes();
-    return true;
+    return fetch_tx_hash(txn, spend_tx_number, input_spend.hash);
 }
 
 bool bdb_common::save_block(txn_guard_ptr txn,
@@ -59,13 +66,14 @@ bool bdb_common::save_block(txn_guard_ptr txn,
         const message::transaction& block_tx =
             serial_block.transactions[tx_index];
         const hash_digest& tx_hash = hash_transaction(block_tx);
-        if (!save_transaction(txn, depth, tx_index, tx_hash, block_tx))
+        uint32_t tx_number;
+        if (!save_transaction(txn, depth, tx_index,
+                tx_hash, block_tx, tx_number))
         {
             log_fatal() << "Could not save transaction";
             return false;
         }
-        proto_block.add_transactions(
-            std::string(tx_hash.begin(), tx_hash.end()));
+        proto_block.add_transactions(tx_number);
     }
     std::ostringstream oss;
     if (!proto_block.SerializeToOstream(&oss))
@@ -86,10 +94,10 @@ bool bdb_common::save_block(txn_guard_ptr txn,
 
 bool bdb_common::save_transaction(txn_guard_ptr txn, uint32_t block_depth,
     uint32_t tx_index, const hash_digest& tx_hash,
-    const message::transaction& block_tx)
+    const message::transaction& block_tx, uint32_t& tx_number)
 {
     if (dupli_save(txn, tx_hash, block_depth, tx_index))
-        return true;
+        return fetch_tx_number(txn, tx_hash, tx_number);
     // Actually add block
     protobuf::Transaction proto_tx = transaction_to_protobuf(block_tx);
     proto_tx.set_is_coinbase(is_coinbase(block_tx));
@@ -107,6 +115,8 @@ bool bdb_common::save_transaction(txn_guard_ptr txn, uint32_t block_depth,
     // Checks for duplicates first
     if (db_txs_->put(txn->get(), key.get(), value.get(), DB_NOOVERWRITE) != 0)
         return false;
+    if (!new_tx_number(txn, tx_hash, tx_number))
+        return false;
     // Coinbase inputs do not spend anything.
     if (!is_coinbase(block_tx))
         for (uint32_t input_index = 0; input_index < block_tx.inputs.size();
@@ -114,8 +124,8 @@ bool bdb_common::save_transaction(txn_guard_ptr txn, uint32_t block_depth,
         {
             const message::transaction_input& input = 
                 block_tx.inputs[input_index];
-            const message::input_point inpoint{tx_hash, input_index};
-            if (!mark_spent_outputs(txn, input.previous_output, inpoint))
+            if (!mark_spent_outputs(txn, input.previous_output,
+                    tx_number, input_index))
                 return false;
         }
     for (uint32_t output_index = 0; output_index < block_tx.outputs.size();
@@ -123,7 +133,7 @@ bool bdb_common::save_transaction(txn_guard_ptr txn, uint32_t block_depth,
     {
         const message::transaction_output& output =
             block_tx.outputs[output_index];
-        if (!add_address(txn, output.output_script, {tx_hash, output_index}))
+        if (!add_address(txn, output.output_script, tx_number, output_index))
             return false;
     }
     return true;
@@ -142,13 +152,114 @@ bool bdb_common::dupli_save(txn_guard_ptr txn, const hash_digest& tx_hash,
     return rewrite_transaction(txn, tx_hash, proto_tx);
 }
 
+bool bdb_common::new_tx_number(txn_guard_ptr txn,
+    const hash_digest& tx_hash, uint32_t& tx_number)
+{
+    // Allocate the number following the last one in use
+    Dbc* cursor;
+    db_tx_numbers_->cursor(txn->get(), &cursor, 0);
+    BITCOIN_ASSERT(cursor != nullptr);
+    writable_data_type last_key, last_data;
+    if (cursor->get(last_key.get(), last_data.get(), DB_LAST) == DB_NOTFOUND)
+        tx_number = 0;
+    else
+        tx_number = cast_chunk<uint32_t>(last_key.data()) + 1;
+    cursor->close();
+    readable_data_type number_key, hash_value;
+    number_key.set(tx_number);
+    hash_value.set(tx_hash);
+    if (db_tx_numbers_->put(txn->get(), number_key.get(),
+            hash_value.get(), DB_NOOVERWRITE) != 0)
+        return false;
+    return true;
+}
+
+bool bdb_common::fetch_tx_number(txn_guard_ptr txn,
+    const hash_digest& tx_hash, uint32_t& tx_number)
+{
+    readable_data_type key;
+    key.set(tx_hash);
+    writable_data_type primary_key;
+    empty_data_type ignore_data;
+    if (db_tx_numbers_hash_->pget(txn->get(), key.get(),
+            primary_key.get(), ignore_data.get(), 0) != 0)
+        return false;
+    tx_number = cast_chunk<uint32_t>(primary_key.data());
+    return true;
+}
+
+bool bdb_common::fetch_tx_hash(txn_guard_ptr txn,
+    uint32_t tx_number, hash_digest& tx_hash)
+{
+    readable_data_type key;
+    key.set(tx_number);
+    writable_data_type value;
+    if (db_tx_numbers_->get(txn->get(), key.get(), value.get(), 0) != 0)
+        return false;
+    const data_chunk raw_tx_hash = value.data();
+    BITCOIN_ASSERT(raw_tx_hash.size() == tx_hash.size());
+    std::copy(raw_tx_hash.begin(), raw_tx_hash.end(), tx_hash.begin());
+    return true;
+}
+
+bool bdb_common::remove_tx_number(txn_guard_ptr txn, uint32_t tx_number)
+{
+    // Secondary hash index is updated by BDB
+    readable_data_type key;
+    key.set(tx_number);
+    if (db_tx_numbers_->del(txn->get(), key.get(), 0) != 0)
+        return false;
+    return true;
+}
+
+bool bdb_common::transaction_pruned(txn_guard_ptr txn,
+    const hash_digest& tx_hash)
+{
+    uint32_t tx_number;
+    if (!fetch_tx_number(txn, tx_hash, tx_number))
+        return false;
+    readable_data_type key;
+    key.set(tx_hash);
+    empty_data_type ignore_data;
+    return db_txs_->get(txn->get(), key.get(), ignore_data.get(), 0) != 0;
+}
+
+const std::string sequence_key = "sequence";
+
+uint64_t bdb_common::fetch_sequence(txn_guard_ptr txn)
+{
+    readable_data_type key;
+    key.set(sequence_key);
+    writable_data_type value;
+    if (db_sequence_->get(txn->get(), key.get(), value.get(), 0) != 0)
+        return 0;
+    const data_chunk raw_sequence = value.data();
+    BITCOIN_ASSERT(raw_sequence.size() == 8);
+    deserializer deserial(raw_sequence);
+    return deserial.read_8_bytes();
+}
+
+bool bdb_common::increment_sequence(txn_guard_ptr txn)
+{
+    serializer serial;
+    serial.write_8_bytes(fetch_sequence(txn) + 1);
+    readable_data_type key, value;
+    key.set(sequence_key);
+    value.set(serial.data());
+    return db_sequence_->put(txn->get(), key.get(), value.get(), 0) == 0;
+}
+
 bool bdb_common::mark_spent_outputs(txn_guard_ptr txn,
     const message::output_point& previous_output,
-    const message::input_point& current_input)
+    uint32_t tx_number, uint32_t input_index)
 {
+    uint32_t previous_tx_number;
+    if (!fetch_tx_number(txn, previous_output.hash, previous_tx_number))
+        return false;
     readable_data_type spent_key, spend_value;
-    spent_key.set(create_spent_key(previous_output));
-    spend_value.set(create_spent_key(current_input));
+    spent_key.set(
+        create_spent_key(previous_tx_number, previous_output.index));
+    spend_value.set(create_spent_key(tx_number, input_index));
     if (db_spends_->put(txn->get(), spent_key.get(), spend_value.get(),
             DB_NOOVERWRITE) != 0)
         return false;
@@ -156,14 +267,14 @@ bool bdb_common::mark_spent_outputs(txn_guard_ptr txn,
 }
 
 bool bdb_common::add_address(txn_guard_ptr txn,
-    const script& output_script, const message::output_point& outpoint)
+    const script& output_script, uint32_t tx_number, uint32_t output_index)
 {
     data_chunk raw_address = create_address_key(output_script);
     if (raw_address.empty())
         return true;
     readable_data_type address_key, output_value;
     address_key.set(raw_address);
-    output_value.set(create_spent_key(outpoint));
+    output_value.set(create_spent_key(tx_number, output_index));
     if (db_address_->put(txn->get(), address_key.get(),
             output_value.get(), 0) != 0)
         return false;
@@ -243,16 +354,27 @@ bool bdb_common::reconstruct_block(txn_guard_ptr txn,
     message::block& result_block)
 {
     result_block = protobuf_to_block_header(proto_block_header);
-    for (const std::string& raw_tx_hash: proto_block_header.transactions())
+    for (uint32_t tx_number: proto_block_header.transactions())
     {
+        hash_digest tx_hash;
+        if (!fetch_tx_hash(txn, tx_number, tx_hash))
+            return false;
         protobuf::Transaction proto_tx;
-        if (!proto_read(db_txs_, txn, raw_tx_hash, proto_tx))
+        if (!proto_read(db_txs_, txn, tx_hash, proto_tx))
             return false;
         result_block.transactions.push_back(protobuf_to_transaction(proto_tx));
     }
     return true;
 }
 
+data_chunk create_spent_key(uint32_t tx_number, uint32_t index)
+{
+    serializer serial_spend;
+    serial_spend.write_4_bytes(tx_number);
+    serial_spend.write_4_bytes(index);
+    return serial_spend.data();
+}
+
 data_chunk create_address_key(const script& output_script)
 {
     payment_address address;
@@ -19,7 +19,8 @@ class bdb_common
 {
 public:
     bdb_common(DbEnv* env, Db* db_blocks, Db* db_blocks_hash,
-        Db* db_txs, Db* db_spends, Db* db_address);
+        Db* db_txs, Db* db_tx_numbers, Db* db_tx_numbers_hash,
+        Db* db_spends, Db* db_address, Db* db_sequence);
 
     uint32_t find_last_block_depth(txn_guard_ptr txn);
     bool fetch_spend(txn_guard_ptr txn,
@@ -39,18 +40,35 @@ public:
         const protobuf::Block& proto_block_header,
         message::block& result_block);
 
+    // Transactions are internally referred to by a short sequential number
+    // which is used in the spends, address and block transaction lists.
+    bool fetch_tx_number(txn_guard_ptr txn,
+        const hash_digest& tx_hash, uint32_t& tx_number);
+    bool fetch_tx_hash(txn_guard_ptr txn,
+        uint32_t tx_number, hash_digest& tx_hash);
+    bool remove_tx_number(txn_guard_ptr txn, uint32_t tx_number);
+    // Number is still known but the body was deleted by pruning
+    bool transaction_pruned(txn_guard_ptr txn, const hash_digest& tx_hash);
+
+    // Incremented with every change to the chain so processes reading
+    // the database can detect new blocks and reorganizations.
+    uint64_t fetch_sequence(txn_guard_ptr txn);
+    bool increment_sequence(txn_guard_ptr txn);
+
 private:
     bool save_transaction(txn_guard_ptr txn, uint32_t block_depth,
         uint32_t tx_index, const hash_digest& tx_hash,
-        const message::transaction& block_tx);
+        const message::transaction& block_tx, uint32_t& tx_number);
     bool dupli_save(txn_guard_ptr txn, const hash_digest& tx_hash,
         uint32_t block_depth, uint32_t tx_index);
+    bool new_tx_number(txn_guard_ptr txn,
+        const hash_digest& tx_hash, uint32_t& tx_number);
     bool mark_spent_outputs(txn_guard_ptr txn,
         const message::output_point& previous_output,
-        const message::input_point& current_input);
+        uint32_t tx_number, uint32_t input_index);
     // returns false only on database failure. It may or may not add an entry
     bool add_address(txn_guard_ptr txn, const script& output_script,
-        const message::output_point& outpoint);
+        uint32_t tx_number, uint32_t output_index);
     bool rewrite_transaction(txn_guard_ptr txn, const hash_digest& tx_hash,
         const protobuf::Transaction& replace_proto_tx);
 
@@ -58,21 +76,17 @@ private:
     Db* db_blocks_;
     Db* db_blocks_hash_;
     Db* db_txs_;
+    Db* db_tx_numbers_;
+    Db* db_tx_numbers_hash_;
     Db* db_spends_;
     Db* db_address_;
+    Db* db_sequence_;
 };
 
 typedef std::shared_ptr<bdb_common> bdb_common_ptr;
 
 // Used also by bdb_chain_keeper when deleting spends + addresses
-template <typename Point>
-data_chunk create_spent_key(const Point& point)
-{
-    serializer serial_spend;
-    serial_spend.write_hash(point.hash);
-    serial_spend.write_4_bytes(point.index);
-    return serial_spend.data();
-}
+data_chunk create_spent_key(uint32_t tx_number, uint32_t index);
 
 data_chunk create_address_key(const script& output_script);
 
@@ -18,6 +18,9 @@ std::error_code bdb_organizer::verify(int fork_index,
     const block_detail_list& orphan_chain, int orphan_index)
 {
     BITCOIN_ASSERT(orphan_index < orphan_chain.size());
+    // Blocks below the pruning window cannot be replaced
+    if (!chain_->can_reorganize(fork_index))
+        return error::pruned;
     const message::block& current_block = orphan_chain[orphan_index]->actual();
     size_t depth = fork_index + orphan_index + 1;
     BITCOIN_ASSERT(depth != 0);
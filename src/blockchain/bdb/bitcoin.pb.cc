@@ -1,1991 +1,2056 @@
 // Generated by the protocol buffer compiler.  DO NOT EDIT!
+// source: bitcoin.proto
 
-#define INTERNAL_SUPPRESS_PROTOBUF_FIELD_DEPRECATION
 #include "bitcoin.pb.h"
 
 #include <algorithm>
 
-#include <google/protobuf/stubs/once.h>
 #include <google/protobuf/io/coded_stream.h>
-#include <google/protobuf/wire_format_lite_inl.h>
+#include <google/protobuf/extension_set.h>
+#include <google/protobuf/wire_format_lite.h>
 #include <google/protobuf/descriptor.h>
+#include <google/protobuf/generated_message_reflection.h>
 #include <google/protobuf/reflection_ops.h>
 #include <google/protobuf/wire_format.h>
 // @@protoc_insertion_point(includes)
+#include <google/protobuf/port_def.inc>
 
-namespace protobuf {
+PROTOBUF_PRAGMA_INIT_SEG
+
+namespace _pb = ::PROTOBUF_NAMESPACE_ID;
+namespace _pbi = _pb::internal;
 
-namespace {
-
-const ::google::protobuf::Descriptor* Block_descriptor_ = NULL;
-const ::google::protobuf::internal::GeneratedMessageReflection*
-  Block_reflection_ = NULL;
-const ::google::protobuf::Descriptor* Transaction_descriptor_ = NULL;
-const ::google::protobuf::internal::GeneratedMessageReflection*
-  Transaction_reflection_ = NULL;
-const ::google::protobuf::Descriptor* Transaction_BlockPointer_descriptor_ = NULL;
-const ::google::protobuf::internal::GeneratedMessageReflection*
-  Transaction_BlockPointer_reflection_ = NULL;
-const ::google::protobuf::Descriptor* Transaction_Input_descriptor_ = NULL;
-const ::google::protobuf::internal::GeneratedMessageReflection*
-  Transaction_Input_reflection_ = NULL;
-const ::google::protobuf::Descriptor* Transaction_Output_descriptor_ = NULL;
-const ::google::protobuf::internal::GeneratedMessageReflection*
-  Transaction_Output_reflection_ = NULL;
-
-}  // namespace
-
-
-void protobuf_AssignDesc_bitcoin_2eproto() {
-  protobuf_AddDesc_bitcoin_2eproto();
-  const ::google::protobuf::FileDescriptor* file =
-    ::google::protobuf::DescriptorPool::generated_pool()->FindFileByName(
-      "bitcoin.proto");
-  GOOGLE_CHECK(file != NULL);
-  Block_descriptor_ = file->message_type(0);
-  static const int Block_offsets_[8] = {
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Block, depth_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Block, version_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Block, previous_block_hash_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Block, merkle_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Block, timestamp_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Block, bits_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Block, nonce_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Block, transactions_),
+namespace protobuf {
+PROTOBUF_CONSTEXPR Block::Block(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_._has_bits_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}
+  , /*decltype(_impl_.transactions_)*/{}
+  , /*decltype(_impl_._transactions_cached_byte_size_)*/{0}
+  , /*decltype(_impl_.previous_block_hash_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
+  , /*decltype(_impl_.merkle_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
+  , /*decltype(_impl_.depth_)*/0u
+  , /*decltype(_impl_.version_)*/0u
+  , /*decltype(_impl_.timestamp_)*/0u
+  , /*decltype(_impl_.bits_)*/0u
+  , /*decltype(_impl_.nonce_)*/0u} {}
+struct BlockDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR BlockDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~BlockDefaultTypeInternal() {}
+  union {
+    Block _instance;
   };
-  Block_reflection_ =
-    new ::google::protobuf::internal::GeneratedMessageReflection(
-      Block_descriptor_,
-      Block::default_instance_,
-      Block_offsets_,
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Block, _has_bits_[0]),
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Block, _unknown_fields_),
-      -1,
-      ::google::protobuf::DescriptorPool::generated_pool(),
-      ::google::protobuf::MessageFactory::generated_factory(),
-      sizeof(Block));
-  Transaction_descriptor_ = file->message_type(1);
-  static const int Transaction_offsets_[6] = {
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Transaction, parent_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Transaction, inputs_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Transaction, outputs_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Transaction, version_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Transaction, locktime_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Transaction, is_coinbase_),
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 BlockDefaultTypeInternal _Block_default_instance_;
+PROTOBUF_CONSTEXPR Transaction_BlockPointer::Transaction_BlockPointer(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_._has_bits_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}
+  , /*decltype(_impl_.depth_)*/0u
+  , /*decltype(_impl_.index_)*/0u} {}
+struct Transaction_BlockPointerDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR Transaction_BlockPointerDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~Transaction_BlockPointerDefaultTypeInternal() {}
+  union {
+    Transaction_BlockPointer _instance;
   };
-  Transaction_reflection_ =
-    new ::google::protobuf::internal::GeneratedMessageReflection(
-      Transaction_descriptor_,
-      Transaction::default_instance_,
-      Transaction_offsets_,
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Transaction, _has_bits_[0]),
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Transaction, _unknown_fields_),
-      -1,
-      ::google::protobuf::DescriptorPool::generated_pool(),
-      ::google::protobuf::MessageFactory::generated_factory(),
-      sizeof(Transaction));
-  Transaction_BlockPointer_descriptor_ = Transaction_descriptor_->nested_type(0);
-  static const int Transaction_BlockPointer_offsets_[2] = {
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Transaction_BlockPointer, depth_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Transaction_BlockPointer, index_),
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 Transaction_BlockPointerDefaultTypeInternal _Transaction_BlockPointer_default_instance_;
+PROTOBUF_CONSTEXPR Transaction_Input::Transaction_Input(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_._has_bits_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}
+  , /*decltype(_impl_.previous_output_hash_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
+  , /*decltype(_impl_.script_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
+  , /*decltype(_impl_.previous_output_index_)*/0u
+  , /*decltype(_impl_.sequence_)*/0u} {}
+struct Transaction_InputDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR Transaction_InputDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~Transaction_InputDefaultTypeInternal() {}
+  union {
+    Transaction_Input _instance;
   };
-  Transaction_BlockPointer_reflection_ =
-    new ::google::protobuf::internal::GeneratedMessageReflection(
-      Transaction_BlockPointer_descriptor_,
-      Transaction_BlockPointer::default_instance_,
-      Transaction_BlockPointer_offsets_,
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Transaction_BlockPointer, _has_bits_[0]),
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Transaction_BlockPointer, _unknown_fields_),
-      -1,
-      ::google::protobuf::DescriptorPool::generated_pool(),
-      ::google::protobuf::MessageFactory::generated_factory(),
-      sizeof(Transaction_BlockPointer));
-  Transaction_Input_descriptor_ = Transaction_descriptor_->nested_type(1);
-  static const int Transaction_Input_offsets_[4] = {
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Transaction_Input, previous_output_hash_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Transaction_Input, previous_output_index_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Transaction_Input, script_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Transaction_Input, sequence_),
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 Transaction_InputDefaultTypeInternal _Transaction_Input_default_instance_;
+PROTOBUF_CONSTEXPR Transaction_Output::Transaction_Output(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_._has_bits_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}
+  , /*decltype(_impl_.script_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
+  , /*decltype(_impl_.value_)*/uint64_t{0u}} {}
+struct Transaction_OutputDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR Transaction_OutputDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~Transaction_OutputDefaultTypeInternal() {}
+  union {
+    Transaction_Output _instance;
   };
-  Transaction_Input_reflection_ =
-    new ::google::protobuf::internal::GeneratedMessageReflection(
-      Transaction_Input_descriptor_,
-      Transaction_Input::default_instance_,
-      Transaction_Input_offsets_,
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Transaction_Input, _has_bits_[0]),
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Transaction_Input, _unknown_fields_),
-      -1,
-      ::google::protobuf::DescriptorPool::generated_pool(),
-      ::google::protobuf::MessageFactory::generated_factory(),
-      sizeof(Transaction_Input));
-  Transaction_Output_descriptor_ = Transaction_descriptor_->nested_type(2);
-  static const int Transaction_Output_offsets_[2] = {
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Transaction_Output, value_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Transaction_Output, script_),
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 Transaction_OutputDefaultTypeInternal _Transaction_Output_default_instance_;
+PROTOBUF_CONSTEXPR Transaction::Transaction(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_._has_bits_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}
+  , /*decltype(_impl_.parent_)*/{}
+  , /*decltype(_impl_.inputs_)*/{}
+  , /*decltype(_impl_.outputs_)*/{}
+  , /*decltype(_impl_.version_)*/0u
+  , /*decltype(_impl_.locktime_)*/0u
+  , /*decltype(_impl_.is_coinbase_)*/false} {}
+struct TransactionDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR TransactionDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~TransactionDefaultTypeInternal() {}
+  union {
+    Transaction _instance;
   };
-  Transaction_Output_reflection_ =
-    new ::google::protobuf::internal::GeneratedMessageReflection(
-      Transaction_Output_descriptor_,
-      Transaction_Output::default_instance_,
-      Transaction_Output_offsets_,
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Transaction_Output, _has_bits_[0]),
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Transaction_Output, _unknown_fields_),
-      -1,
-      ::google::protobuf::DescriptorPool::generated_pool(),
-      ::google::protobuf::MessageFactory::generated_factory(),
-      sizeof(Transaction_Output));
-}
-
-namespace {
-
-GOOGLE_PROTOBUF_DECLARE_ONCE(protobuf_AssignDescriptors_once_);
-inline void protobuf_AssignDescriptorsOnce() {
-  ::google::protobuf::GoogleOnceInit(&protobuf_AssignDescriptors_once_,
-                 &protobuf_AssignDesc_bitcoin_2eproto);
-}
-
-void protobuf_RegisterTypes(const ::std::string&) {
-  protobuf_AssignDescriptorsOnce();
-  ::google::protobuf::MessageFactory::InternalRegisterGeneratedMessage(
-    Block_descriptor_, &Block::default_instance());
-  ::google::protobuf::MessageFactory::InternalRegisterGeneratedMessage(
-    Transaction_descriptor_, &Transaction::default_instance());
-  ::google::protobuf::MessageFactory::InternalRegisterGeneratedMessage(
-    Transaction_BlockPointer_descriptor_, &Transaction_BlockPointer::default_instance());
-  ::google::protobuf::MessageFactory::InternalRegisterGeneratedMessage(
-    Transaction_Input_descriptor_, &Transaction_Input::default_instance());
-  ::google::protobuf::MessageFactory::InternalRegisterGeneratedMessage(
-    Transaction_Output_descriptor_, &Transaction_Output::default_instance());
-}
-
-}  // namespace
-
-void protobuf_ShutdownFile_bitcoin_2eproto() {
-  delete Block::default_instance_;
-  delete Block_reflection_;
-  delete Transaction::default_instance_;
-  delete Transaction_reflection_;
-  delete Transaction_BlockPointer::default_instance_;
-  delete Transaction_BlockPointer_reflection_;
-  delete Transaction_Input::default_instance_;
-  delete Transaction_Input_reflection_;
-  delete Transaction_Output::default_instance_;
-  delete Transaction_Output_reflection_;
-}
-
-void protobuf_AddDesc_bitcoin_2eproto() {
-  static bool already_here = false;
-  if (already_here) return;
-  already_here = true;
-  GOOGLE_PROTOBUF_VERIFY_VERSION;
-
-  ::google::protobuf::DescriptorPool::InternalAddGeneratedFile(
-    "\n\rbitcoin.proto\022\010protobuf\"\232\001\n\005Block\022\r\n\005d"
-    "epth\030\002 \002(\r\022\017\n\007version\030\006 \002(\r\022\033\n\023previous_"
-    "block_hash\030\007 \002(\014\022\016\n\006merkle\030\010 \002(\014\022\021\n\ttime"
-    "stamp\030\t \002(\r\022\014\n\004bits\030\n \002(\r\022\r\n\005nonce\030\013 \002(\r"
-    "\022\024\n\014transactions\030\014 \003(\014\"\224\003\n\013Transaction\0222"
-    "\n\006parent\030\001 \003(\0132\".protobuf.Transaction.Bl"
-    "ockPointer\022+\n\006inputs\030\003 \003(\0132\033.protobuf.Tr"
-    "ansaction.Input\022-\n\007outputs\030\004 \003(\0132\034.proto"
-    "buf.Transaction.Output\022\017\n\007version\030\005 \002(\r\022"
-    "\020\n\010locktime\030\006 \002(\r\022\023\n\013is_coinbase\030\007 \002(\010\032,"
-    "\n\014BlockPointer\022\r\n\005depth\030\001 \002(\r\022\r\n\005index\030\002"
-    " \002(\r\032f\n\005Input\022\034\n\024previous_output_hash\030\001 "
-    "\002(\014\022\035\n\025previous_output_index\030\002 \002(\r\022\016\n\006sc"
-    "ript\030\003 \002(\014\022\020\n\010sequence\030\004 \002(\r\032\'\n\006Output\022\r"
-    "\n\005value\030\001 \002(\004\022\016\n\006script\030\002 \002(\014", 589);
-  ::google::protobuf::MessageFactory::InternalRegisterGeneratedFile(
-    "bitcoin.proto", &protobuf_RegisterTypes);
-  Block::default_instance_ = new Block();
-  Transaction::default_instance_ = new Transaction();
-  Transaction_BlockPointer::default_instance_ = new Transaction_BlockPointer();
-  Transaction_Input::default_instance_ = new Transaction_Input();
-  Transaction_Output::default_instance_ = new Transaction_Output();
-  Block::default_instance_->InitAsDefaultInstance();
-  Transaction::default_instance_->InitAsDefaultInstance();
-  Transaction_BlockPointer::default_instance_->InitAsDefaultInstance();
-  Transaction_Input::default_instance_->InitAsDefaultInstance();
-  Transaction_Output::default_instance_->InitAsDefaultInstance();
-  ::google::protobuf::internal::OnShutdown(&protobuf_ShutdownFile_bitcoin_2eproto);
-}
-
-// Force AddDescriptors() to be called at static initialization time.
-struct StaticDescriptorInitializer_bitcoin_2eproto {
-  StaticDescriptorInitializer_bitcoin_2eproto() {
-    protobuf_AddDesc_bitcoin_2eproto();
-  }
-} static_descriptor_initializer_bitcoin_2eproto_;
-
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 TransactionDefaultTypeInternal _Transaction_default_instance_;
+}  // namespace protobuf
+static ::_pb::Metadata file_level_metadata_bitcoin_2eproto[5];
+static constexpr ::_pb::EnumDescriptor const** file_level_enum_descriptors_bitcoin_2eproto = nullptr;
+static constexpr ::_pb::ServiceDescriptor const** file_level_service_descriptors_bitcoin_2eproto = nullptr;
+
+const uint32_t TableStruct_bitcoin_2eproto::offsets[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) = {
+  PROTOBUF_FIELD_OFFSET(::protobuf::Block, _impl_._has_bits_),
+  PROTOBUF_FIELD_OFFSET(::protobuf::Block, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::protobuf::Block, _impl_.depth_),
+  PROTOBUF_FIELD_OFFSET(::protobuf::Block, _impl_.version_),
+  PROTOBUF_FIELD_OFFSET(::protobuf::Block, _impl_.previous_block_hash_),
+  PROTOBUF_FIELD_OFFSET(::protobuf::Block, _impl_.merkle_),
+  PROTOBUF_FIELD_OFFSET(::protobuf::Block, _impl_.timestamp_),
+  PROTOBUF_FIELD_OFFSET(::protobuf::Block, _impl_.bits_),
+  PROTOBUF_FIELD_OFFSET(::protobuf::Block, _impl_.nonce_),
+  PROTOBUF_FIELD_OFFSET(::protobuf::Block, _impl_.transactions_),
+  2,
+  3,
+  0,
+  1,
+  4,
+  5,
+  6,
+  ~0u,
+  PROTOBUF_FIELD_OFFSET(::protobuf::Transaction_BlockPointer, _impl_._has_bits_),
+  PROTOBUF_FIELD_OFFSET(::protobuf::Transaction_BlockPointer, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::protobuf::Transaction_BlockPointer, _impl_.depth_),
+  PROTOBUF_FIELD_OFFSET(::protobuf::Transaction_BlockPointer, _impl_.index_),
+  0,
+  1,
+  PROTOBUF_FIELD_OFFSET(::protobuf::Transaction_Input, _impl_._has_bits_),
+  PROTOBUF_FIELD_OFFSET(::protobuf::Transaction_Input, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::protobuf::Transaction_Input, _impl_.previous_output_hash_),
+  PROTOBUF_FIELD_OFFSET(::protobuf::Transaction_Input, _impl_.previous_output_index_),
+  PROTOBUF_FIELD_OFFSET(::protobuf::Transaction_Input, _impl_.script_),
+  PROTOBUF_FIELD_OFFSET(::protobuf::Transaction_Input, _impl_.sequence_),
+  0,
+  2,
+  1,
+  3,
+  PROTOBUF_FIELD_OFFSET(::protobuf::Transaction_Output, _impl_._has_bits_),
+  PROTOBUF_FIELD_OFFSET(::protobuf::Transaction_Output, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::protobuf::Transaction_Output, _impl_.value_),
+  PROTOBUF_FIELD_OFFSET(::protobuf::Transaction_Output, _impl_.script_),
+  1,
+  0,
+  PROTOBUF_FIELD_OFFSET(::protobuf::Transaction, _impl_._has_bits_),
+  PROTOBUF_FIELD_OFFSET(::protobuf::Transaction, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::protobuf::Transaction, _impl_.parent_),
+  PROTOBUF_FIELD_OFFSET(::protobuf::Transaction, _impl_.inputs_),
+  PROTOBUF_FIELD_OFFSET(::protobuf::Transaction, _impl_.outputs_),
+  PROTOBUF_FIELD_OFFSET(::protobuf::Transaction, _impl_.version_),
+  PROTOBUF_FIELD_OFFSET(::protobuf::Transaction, _impl_.locktime_),
+  PROTOBUF_FIELD_OFFSET(::protobuf::Transaction, _impl_.is_coinbase_),
+  ~0u,
+  ~0u,
+  ~0u,
+  0,
+  1,
+  2,
+};
+static const ::_pbi::MigrationSchema schemas[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) = {
+  { 0, 14, -1, sizeof(::protobuf::Block)},
+  { 22, 30, -1, sizeof(::protobuf::Transaction_BlockPointer)},
+  { 32, 42, -1, sizeof(::protobuf::Transaction_Input)},
+  { 46, 54, -1, sizeof(::protobuf::Transaction_Output)},
+  { 56, 68, -1, sizeof(::protobuf::Transaction)},
+};
+
+static const ::_pb::Message* const file_default_instances[] = {
+  &::protobuf::_Block_default_instance_._instance,
+  &::protobuf::_Transaction_BlockPointer_default_instance_._instance,
+  &::protobuf::_Transaction_Input_default_instance_._instance,
+  &::protobuf::_Transaction_Output_default_instance_._instance,
+  &::protobuf::_Transaction_default_instance_._instance,
+};
+
+const char descriptor_table_protodef_bitcoin_2eproto[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) =
+  "\n\rbitcoin.proto\022\010protobuf\"\236\001\n\005Block\022\r\n\005d"
+  "epth\030\002 \002(\r\022\017\n\007version\030\006 \002(\r\022\033\n\023previous_"
+  "block_hash\030\007 \002(\014\022\016\n\006merkle\030\010 \002(\014\022\021\n\ttime"
+  "stamp\030\t \002(\r\022\014\n\004bits\030\n \002(\r\022\r\n\005nonce\030\013 \002(\r"
+  "\022\030\n\014transactions\030\r \003(\rB\002\020\001\"\224\003\n\013Transacti"
+  "on\0222\n\006parent\030\001 \003(\0132\".protobuf.Transactio"
+  "n.BlockPointer\022+\n\006inputs\030\003 \003(\0132\033.protobu"
+  "f.Transaction.Input\022-\n\007outputs\030\004 \003(\0132\034.p"
+  "rotobuf.Transaction.Output\022\017\n\007version\030\005 "
+  "\002(\r\022\020\n\010locktime\030\006 \002(\r\022\023\n\013is_coinbase\030\007 \002"
+  "(\010\032,\n\014BlockPointer\022\r\n\005depth\030\001 \002(\r\022\r\n\005ind"
+  "ex\030\002 \002(\r\032f\n\005Input\022\034\n\024previous_output_has"
+  "h\030\001 \002(\014\022\035\n\025previous_output_index\030\002 \002(\r\022\016"
+  "\n\006script\030\003 \002(\014\022\020\n\010sequence\030\004 \002(\r\032\'\n\006Outp"
+  "ut\022\r\n\005value\030\001 \002(\004\022\016\n\006script\030\002 \002(\014"
+  ;
+static ::_pbi::once_flag descriptor_table_bitcoin_2eproto_once;
+const ::_pbi::DescriptorTable descriptor_table_bitcoin_2eproto = {
+    false, false, 593, descriptor_table_protodef_bitcoin_2eproto,
+    "bitcoin.proto",
+    &descriptor_table_bitcoin_2eproto_once, nullptr, 0, 5,
+    schemas, file_default_instances, TableStruct_bitcoin_2eproto::offsets,
+    file_level_metadata_bitcoin_2eproto, file_level_enum_descriptors_bitcoin_2eproto,
+    file_level_service_descriptors_bitcoin_2eproto,
+};
+PROTOBUF_ATTRIBUTE_WEAK const ::_pbi::DescriptorTable* descriptor_table_bitcoin_2eproto_getter() {
+  return &descriptor_table_bitcoin_2eproto;
+}
+
+// Force running AddDescriptors() at dynamic initialization time.
+PROTOBUF_ATTRIBUTE_INIT_PRIORITY2 static ::_pbi::AddDescriptorsRunner dynamic_init_dummy_bitcoin_2eproto(&descriptor_table_bitcoin_2eproto);
+namespace protobuf {
 
 // ===================================================================
 
-#ifndef _MSC_VER
-const int Block::kDepthFieldNumber;
-const int Block::kVersionFieldNumber;
-const int Block::kPreviousBlockHashFieldNumber;
-const int Block::kMerkleFieldNumber;
-const int Block::kTimestampFieldNumber;
-const int Block::kBitsFieldNumber;
-const int Block::kNonceFieldNumber;
-const int Block::kTransactionsFieldNumber;
-#endif  // !_MSC_VER
-
-Block::Block()
-  : ::google::protobuf::Message() {
-  SharedCtor();
-}
+class Block::_Internal {
+ public:
+  using HasBits = decltype(std::declval<Block>()._impl_._has_bits_);
+  static void set_has_depth(HasBits* has_bits) {
+    (*has_bits)[0] |= 4u;
+  }
+  static void set_has_version(HasBits* has_bits) {
+    (*has_bits)[0] |= 8u;
+  }
+  static void set_has_previous_block_hash(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
+  }
+  static void set_has_merkle(HasBits* has_bits) {
+    (*has_bits)[0] |= 2u;
+  }
+  static void set_has_timestamp(HasBits* has_bits) {
+    (*has_bits)[0] |= 16u;
+  }
+  static void set_has_bits(HasBits* has_bits) {
+    (*has_bits)[0] |= 32u;
+  }
+  static void set_has_nonce(HasBits* has_bits) {
+    (*has_bits)[0] |= 64u;
+  }
+  static bool MissingRequiredFields(const HasBits& has_bits) {
+    return ((has_bits[0] & 0x0000007f) ^ 0x0000007f) != 0;
+  }
+};
 
-void Block::InitAsDefaultInstance() {
+Block::Block(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:protobuf.Block)
 }
-
 Block::Block(const Block& from)
-  : ::google::protobuf::Message() {
-  SharedCtor();
-  MergeFrom(from);
-}
-
-void Block::SharedCtor() {
-  _cached_size_ = 0;
-  depth_ = 0u;
-  version_ = 0u;
-  previous_block_hash_ = const_cast< ::std::string*>(&::google::protobuf::internal::kEmptyString);
-  merkle_ = const_cast< ::std::string*>(&::google::protobuf::internal::kEmptyString);
-  timestamp_ = 0u;
-  bits_ = 0u;
-  nonce_ = 0u;
-  ::memset(_has_bits_, 0, sizeof(_has_bits_));
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  Block* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){from._impl_._has_bits_}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.transactions_){from._impl_.transactions_}
+    , /*decltype(_impl_._transactions_cached_byte_size_)*/{0}
+    , decltype(_impl_.previous_block_hash_){}
+    , decltype(_impl_.merkle_){}
+    , decltype(_impl_.depth_){}
+    , decltype(_impl_.version_){}
+    , decltype(_impl_.timestamp_){}
+    , decltype(_impl_.bits_){}
+    , decltype(_impl_.nonce_){}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  _impl_.previous_block_hash_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.previous_block_hash_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (from._internal_has_previous_block_hash()) {
+    _this->_impl_.previous_block_hash_.Set(from._internal_previous_block_hash(), 
+      _this->GetArenaForAllocation());
+  }
+  _impl_.merkle_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.merkle_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (from._internal_has_merkle()) {
+    _this->_impl_.merkle_.Set(from._internal_merkle(), 
+      _this->GetArenaForAllocation());
+  }
+  ::memcpy(&_impl_.depth_, &from._impl_.depth_,
+    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.nonce_) -
+    reinterpret_cast<char*>(&_impl_.depth_)) + sizeof(_impl_.nonce_));
+  // @@protoc_insertion_point(copy_constructor:protobuf.Block)
+}
+
+inline void Block::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.transactions_){arena}
+    , /*decltype(_impl_._transactions_cached_byte_size_)*/{0}
+    , decltype(_impl_.previous_block_hash_){}
+    , decltype(_impl_.merkle_){}
+    , decltype(_impl_.depth_){0u}
+    , decltype(_impl_.version_){0u}
+    , decltype(_impl_.timestamp_){0u}
+    , decltype(_impl_.bits_){0u}
+    , decltype(_impl_.nonce_){0u}
+  };
+  _impl_.previous_block_hash_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.previous_block_hash_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  _impl_.merkle_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.merkle_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
 }
 
 Block::~Block() {
+  // @@protoc_insertion_point(destructor:protobuf.Block)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
   SharedDtor();
 }
 
-void Block::SharedDtor() {
-  if (previous_block_hash_ != &::google::protobuf::internal::kEmptyString) {
-    delete previous_block_hash_;
-  }
-  if (merkle_ != &::google::protobuf::internal::kEmptyString) {
-    delete merkle_;
-  }
-  if (this != default_instance_) {
-  }
+inline void Block::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_.transactions_.~RepeatedField();
+  _impl_.previous_block_hash_.Destroy();
+  _impl_.merkle_.Destroy();
 }
 
 void Block::SetCachedSize(int size) const {
-  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
-  _cached_size_ = size;
-  GOOGLE_SAFE_CONCURRENT_WRITES_END();
-}
-const ::google::protobuf::Descriptor* Block::descriptor() {
-  protobuf_AssignDescriptorsOnce();
-  return Block_descriptor_;
-}
-
-const Block& Block::default_instance() {
-  if (default_instance_ == NULL) protobuf_AddDesc_bitcoin_2eproto();  return *default_instance_;
-}
-
-Block* Block::default_instance_ = NULL;
-
-Block* Block::New() const {
-  return new Block;
+  _impl_._cached_size_.Set(size);
 }
 
 void Block::Clear() {
-  if (_has_bits_[0 / 32] & (0xffu << (0 % 32))) {
-    depth_ = 0u;
-    version_ = 0u;
-    if (has_previous_block_hash()) {
-      if (previous_block_hash_ != &::google::protobuf::internal::kEmptyString) {
-        previous_block_hash_->clear();
-      }
+// @@protoc_insertion_point(message_clear_start:protobuf.Block)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_.transactions_.Clear();
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000003u) {
+    if (cached_has_bits & 0x00000001u) {
+      _impl_.previous_block_hash_.ClearNonDefaultToEmpty();
     }
-    if (has_merkle()) {
-      if (merkle_ != &::google::protobuf::internal::kEmptyString) {
-        merkle_->clear();
-      }
+    if (cached_has_bits & 0x00000002u) {
+      _impl_.merkle_.ClearNonDefaultToEmpty();
     }
-    timestamp_ = 0u;
-    bits_ = 0u;
-    nonce_ = 0u;
   }
-  transactions_.Clear();
-  ::memset(_has_bits_, 0, sizeof(_has_bits_));
-  mutable_unknown_fields()->Clear();
+  if (cached_has_bits & 0x0000007cu) {
+    ::memset(&_impl_.depth_, 0, static_cast<size_t>(
+        reinterpret_cast<char*>(&_impl_.nonce_) -
+        reinterpret_cast<char*>(&_impl_.depth_)) + sizeof(_impl_.nonce_));
+  }
+  _impl_._has_bits_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
 }
 
-bool Block::MergePartialFromCodedStream(
-    ::google::protobuf::io::CodedInputStream* input) {
-#define DO_(EXPRESSION) if (!(EXPRESSION)) return false
-  ::google::protobuf::uint32 tag;
-  while ((tag = input->ReadTag()) != 0) {
-    switch (::google::protobuf::internal::WireFormatLite::GetTagFieldNumber(tag)) {
+const char* Block::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  _Internal::HasBits has_bits{};
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
       // required uint32 depth = 2;
-      case 2: {
-        if (::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
-            ::google::protobuf::internal::WireFormatLite::WIRETYPE_VARINT) {
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   ::google::protobuf::uint32, ::google::protobuf::internal::WireFormatLite::TYPE_UINT32>(
-                 input, &depth_)));
-          set_has_depth();
-        } else {
-          goto handle_uninterpreted;
-        }
-        if (input->ExpectTag(48)) goto parse_version;
-        break;
-      }
-      
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 16)) {
+          _Internal::set_has_depth(&has_bits);
+          _impl_.depth_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       // required uint32 version = 6;
-      case 6: {
-        if (::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
-            ::google::protobuf::internal::WireFormatLite::WIRETYPE_VARINT) {
-         parse_version:
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   ::google::protobuf::uint32, ::google::protobuf::internal::WireFormatLite::TYPE_UINT32>(
-                 input, &version_)));
-          set_has_version();
-        } else {
-          goto handle_uninterpreted;
-        }
-        if (input->ExpectTag(58)) goto parse_previous_block_hash;
-        break;
-      }
-      
+      case 6:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 48)) {
+          _Internal::set_has_version(&has_bits);
+          _impl_.version_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       // required bytes previous_block_hash = 7;
-      case 7: {
-        if (::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
-            ::google::protobuf::internal::WireFormatLite::WIRETYPE_LENGTH_DELIMITED) {
-         parse_previous_block_hash:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadBytes(
-                input, this->mutable_previous_block_hash()));
-        } else {
-          goto handle_uninterpreted;
-        }
-        if (input->ExpectTag(66)) goto parse_merkle;
-        break;
-      }
-      
+      case 7:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 58)) {
+          auto str = _internal_mutable_previous_block_hash();
+          ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       // required bytes merkle = 8;
-      case 8: {
-        if (::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
-            ::google::protobuf::internal::WireFormatLite::WIRETYPE_LENGTH_DELIMITED) {
-         parse_merkle:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadBytes(
-                input, this->mutable_merkle()));
-        } else {
-          goto handle_uninterpreted;
-        }
-        if (input->ExpectTag(72)) goto parse_timestamp;
-        break;
-      }
-      
+      case 8:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 66)) {
+          auto str = _internal_mutable_merkle();
+          ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       // required uint32 timestamp = 9;
-      case 9: {
-        if (::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
-            ::google::protobuf::internal::WireFormatLite::WIRETYPE_VARINT) {
-         parse_timestamp:
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   ::google::protobuf::uint32, ::google::protobuf::internal::WireFormatLite::TYPE_UINT32>(
-                 input, &timestamp_)));
-          set_has_timestamp();
-        } else {
-          goto handle_uninterpreted;
-        }
-        if (input->ExpectTag(80)) goto parse_bits;
-        break;
-      }
-      
+      case 9:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 72)) {
+          _Internal::set_has_timestamp(&has_bits);
+          _impl_.timestamp_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       // required uint32 bits = 10;
-      case 10: {
-        if (::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
-            ::google::protobuf::internal::WireFormatLite::WIRETYPE_VARINT) {
-         parse_bits:
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   ::google::protobuf::uint32, ::google::protobuf::internal::WireFormatLite::TYPE_UINT32>(
-                 input, &bits_)));
-          set_has_bits();
-        } else {
-          goto handle_uninterpreted;
-        }
-        if (input->ExpectTag(88)) goto parse_nonce;
-        break;
-      }
-      
+      case 10:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 80)) {
+          _Internal::set_has_bits(&has_bits);
+          _impl_.bits_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       // required uint32 nonce = 11;
-      case 11: {
-        if (::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
-            ::google::protobuf::internal::WireFormatLite::WIRETYPE_VARINT) {
-         parse_nonce:
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   ::google::protobuf::uint32, ::google::protobuf::internal::WireFormatLite::TYPE_UINT32>(
-                 input, &nonce_)));
-          set_has_nonce();
-        } else {
-          goto handle_uninterpreted;
-        }
-        if (input->ExpectTag(98)) goto parse_transactions;
-        break;
-      }
-      
-      // repeated bytes transactions = 12;
-      case 12: {
-        if (::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
-            ::google::protobuf::internal::WireFormatLite::WIRETYPE_LENGTH_DELIMITED) {
-         parse_transactions:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadBytes(
-                input, this->add_transactions()));
-        } else {
-          goto handle_uninterpreted;
-        }
-        if (input->ExpectTag(98)) goto parse_transactions;
-        if (input->ExpectAtEnd()) return true;
-        break;
-      }
-      
-      default: {
-      handle_uninterpreted:
-        if (::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
-            ::google::protobuf::internal::WireFormatLite::WIRETYPE_END_GROUP) {
-          return true;
-        }
-        DO_(::google::protobuf::internal::WireFormat::SkipField(
-              input, tag, mutable_unknown_fields()));
-        break;
-      }
+      case 11:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 88)) {
+          _Internal::set_has_nonce(&has_bits);
+          _impl_.nonce_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // repeated uint32 transactions = 13 [packed = true];
+      case 13:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 106)) {
+          ptr = ::PROTOBUF_NAMESPACE_ID::internal::PackedUInt32Parser(_internal_mutable_transactions(), ptr, ctx);
+          CHK_(ptr);
+        } else if (static_cast<uint8_t>(tag) == 104) {
+          _internal_add_transactions(::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr));
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
     }
-  }
-  return true;
-#undef DO_
-}
-
-void Block::SerializeWithCachedSizes(
-    ::google::protobuf::io::CodedOutputStream* output) const {
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  _impl_._has_bits_.Or(has_bits);
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
+}
+
+uint8_t* Block::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:protobuf.Block)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
   // required uint32 depth = 2;
-  if (has_depth()) {
-    ::google::protobuf::internal::WireFormatLite::WriteUInt32(2, this->depth(), output);
+  if (cached_has_bits & 0x00000004u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt32ToArray(2, this->_internal_depth(), target);
   }
-  
+
   // required uint32 version = 6;
-  if (has_version()) {
-    ::google::protobuf::internal::WireFormatLite::WriteUInt32(6, this->version(), output);
+  if (cached_has_bits & 0x00000008u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt32ToArray(6, this->_internal_version(), target);
   }
-  
+
   // required bytes previous_block_hash = 7;
-  if (has_previous_block_hash()) {
-    ::google::protobuf::internal::WireFormatLite::WriteBytes(
-      7, this->previous_block_hash(), output);
+  if (cached_has_bits & 0x00000001u) {
+    target = stream->WriteBytesMaybeAliased(
+        7, this->_internal_previous_block_hash(), target);
   }
-  
+
   // required bytes merkle = 8;
-  if (has_merkle()) {
-    ::google::protobuf::internal::WireFormatLite::WriteBytes(
-      8, this->merkle(), output);
+  if (cached_has_bits & 0x00000002u) {
+    target = stream->WriteBytesMaybeAliased(
+        8, this->_internal_merkle(), target);
   }
-  
+
   // required uint32 timestamp = 9;
-  if (has_timestamp()) {
-    ::google::protobuf::internal::WireFormatLite::WriteUInt32(9, this->timestamp(), output);
+  if (cached_has_bits & 0x00000010u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt32ToArray(9, this->_internal_timestamp(), target);
   }
-  
+
   // required uint32 bits = 10;
-  if (has_bits()) {
-    ::google::protobuf::internal::WireFormatLite::WriteUInt32(10, this->bits(), output);
+  if (cached_has_bits & 0x00000020u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt32ToArray(10, this->_internal_bits(), target);
   }
-  
+
   // required uint32 nonce = 11;
-  if (has_nonce()) {
-    ::google::protobuf::internal::WireFormatLite::WriteUInt32(11, this->nonce(), output);
+  if (cached_has_bits & 0x00000040u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt32ToArray(11, this->_internal_nonce(), target);
   }
-  
-  // repeated bytes transactions = 12;
-  for (int i = 0; i < this->transactions_size(); i++) {
-    ::google::protobuf::internal::WireFormatLite::WriteBytes(
-      12, this->transactions(i), output);
+
+  // repeated uint32 transactions = 13 [packed = true];
+  {
+    int byte_size = _impl_._transactions_cached_byte_size_.load(std::memory_order_relaxed);
+    if (byte_size > 0) {
+      target = stream->WriteUInt32Packed(
+          13, _internal_transactions(), byte_size, target);
+    }
   }
-  
-  if (!unknown_fields().empty()) {
-    ::google::protobuf::internal::WireFormat::SerializeUnknownFields(
-        unknown_fields(), output);
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
   }
+  // @@protoc_insertion_point(serialize_to_array_end:protobuf.Block)
+  return target;
 }
 
-::google::protobuf::uint8* Block::SerializeWithCachedSizesToArray(
-    ::google::protobuf::uint8* target) const {
-  // required uint32 depth = 2;
-  if (has_depth()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteUInt32ToArray(2, this->depth(), target);
-  }
-  
-  // required uint32 version = 6;
-  if (has_version()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteUInt32ToArray(6, this->version(), target);
-  }
-  
-  // required bytes previous_block_hash = 7;
-  if (has_previous_block_hash()) {
-    target =
-      ::google::protobuf::internal::WireFormatLite::WriteBytesToArray(
-        7, this->previous_block_hash(), target);
+size_t Block::RequiredFieldsByteSizeFallback() const {
+// @@protoc_insertion_point(required_fields_byte_size_fallback_start:protobuf.Block)
+  size_t total_size = 0;
+
+  if (_internal_has_previous_block_hash()) {
+    // required bytes previous_block_hash = 7;
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::BytesSize(
+        this->_internal_previous_block_hash());
   }
-  
-  // required bytes merkle = 8;
-  if (has_merkle()) {
-    target =
-      ::google::protobuf::internal::WireFormatLite::WriteBytesToArray(
-        8, this->merkle(), target);
+
+  if (_internal_has_merkle()) {
+    // required bytes merkle = 8;
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::BytesSize(
+        this->_internal_merkle());
   }
-  
-  // required uint32 timestamp = 9;
-  if (has_timestamp()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteUInt32ToArray(9, this->timestamp(), target);
+
+  if (_internal_has_depth()) {
+    // required uint32 depth = 2;
+    total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_depth());
   }
-  
-  // required uint32 bits = 10;
-  if (has_bits()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteUInt32ToArray(10, this->bits(), target);
+
+  if (_internal_has_version()) {
+    // required uint32 version = 6;
+    total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_version());
   }
-  
-  // required uint32 nonce = 11;
-  if (has_nonce()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteUInt32ToArray(11, this->nonce(), target);
+
+  if (_internal_has_timestamp()) {
+    // required uint32 timestamp = 9;
+    total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_timestamp());
   }
-  
-  // repeated bytes transactions = 12;
-  for (int i = 0; i < this->transactions_size(); i++) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteBytesToArray(12, this->transactions(i), target);
+
+  if (_internal_has_bits()) {
+    // required uint32 bits = 10;
+    total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_bits());
   }
-  
-  if (!unknown_fields().empty()) {
-    target = ::google::protobuf::internal::WireFormat::SerializeUnknownFieldsToArray(
-        unknown_fields(), target);
+
+  if (_internal_has_nonce()) {
+    // required uint32 nonce = 11;
+    total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_nonce());
   }
-  return target;
+
+  return total_size;
 }
+size_t Block::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:protobuf.Block)
+  size_t total_size = 0;
 
-int Block::ByteSize() const {
-  int total_size = 0;
-  
-  if (_has_bits_[0 / 32] & (0xffu << (0 % 32))) {
-    // required uint32 depth = 2;
-    if (has_depth()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::UInt32Size(
-          this->depth());
-    }
-    
-    // required uint32 version = 6;
-    if (has_version()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::UInt32Size(
-          this->version());
-    }
-    
+  if (((_impl_._has_bits_[0] & 0x0000007f) ^ 0x0000007f) == 0) {  // All required fields are present.
     // required bytes previous_block_hash = 7;
-    if (has_previous_block_hash()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::BytesSize(
-          this->previous_block_hash());
-    }
-    
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::BytesSize(
+        this->_internal_previous_block_hash());
+
     // required bytes merkle = 8;
-    if (has_merkle()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::BytesSize(
-          this->merkle());
-    }
-    
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::BytesSize(
+        this->_internal_merkle());
+
+    // required uint32 depth = 2;
+    total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_depth());
+
+    // required uint32 version = 6;
+    total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_version());
+
     // required uint32 timestamp = 9;
-    if (has_timestamp()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::UInt32Size(
-          this->timestamp());
-    }
-    
+    total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_timestamp());
+
     // required uint32 bits = 10;
-    if (has_bits()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::UInt32Size(
-          this->bits());
-    }
-    
+    total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_bits());
+
     // required uint32 nonce = 11;
-    if (has_nonce()) {
+    total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_nonce());
+
+  } else {
+    total_size += RequiredFieldsByteSizeFallback();
+  }
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  // repeated uint32 transactions = 13 [packed = true];
+  {
+    size_t data_size = ::_pbi::WireFormatLite::
+      UInt32Size(this->_impl_.transactions_);
+    if (data_size > 0) {
       total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::UInt32Size(
-          this->nonce());
+        ::_pbi::WireFormatLite::Int32Size(static_cast<int32_t>(data_size));
     }
-    
-  }
-  // repeated bytes transactions = 12;
-  total_size += 1 * this->transactions_size();
-  for (int i = 0; i < this->transactions_size(); i++) {
-    total_size += ::google::protobuf::internal::WireFormatLite::BytesSize(
-      this->transactions(i));
-  }
-  
-  if (!unknown_fields().empty()) {
-    total_size +=
-      ::google::protobuf::internal::WireFormat::ComputeUnknownFieldsSize(
-        unknown_fields());
+    int cached_size = ::_pbi::ToCachedSize(data_size);
+    _impl_._transactions_cached_byte_size_.store(cached_size,
+                                    std::memory_order_relaxed);
+    total_size += data_size;
   }
-  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
-  _cached_size_ = total_size;
-  GOOGLE_SAFE_CONCURRENT_WRITES_END();
-  return total_size;
-}
 
-void Block::MergeFrom(const ::google::protobuf::Message& from) {
-  GOOGLE_CHECK_NE(&from, this);
-  const Block* source =
-    ::google::protobuf::internal::dynamic_cast_if_available<const Block*>(
-      &from);
-  if (source == NULL) {
-    ::google::protobuf::internal::ReflectionOps::Merge(from, this);
-  } else {
-    MergeFrom(*source);
-  }
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
 }
 
-void Block::MergeFrom(const Block& from) {
-  GOOGLE_CHECK_NE(&from, this);
-  transactions_.MergeFrom(from.transactions_);
-  if (from._has_bits_[0 / 32] & (0xffu << (0 % 32))) {
-    if (from.has_depth()) {
-      set_depth(from.depth());
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData Block::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    Block::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*Block::GetClassData() const { return &_class_data_; }
+
+
+void Block::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<Block*>(&to_msg);
+  auto& from = static_cast<const Block&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:protobuf.Block)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  _this->_impl_.transactions_.MergeFrom(from._impl_.transactions_);
+  cached_has_bits = from._impl_._has_bits_[0];
+  if (cached_has_bits & 0x0000007fu) {
+    if (cached_has_bits & 0x00000001u) {
+      _this->_internal_set_previous_block_hash(from._internal_previous_block_hash());
     }
-    if (from.has_version()) {
-      set_version(from.version());
+    if (cached_has_bits & 0x00000002u) {
+      _this->_internal_set_merkle(from._internal_merkle());
     }
-    if (from.has_previous_block_hash()) {
-      set_previous_block_hash(from.previous_block_hash());
+    if (cached_has_bits & 0x00000004u) {
+      _this->_impl_.depth_ = from._impl_.depth_;
     }
-    if (from.has_merkle()) {
-      set_merkle(from.merkle());
+    if (cached_has_bits & 0x00000008u) {
+      _this->_impl_.version_ = from._impl_.version_;
     }
-    if (from.has_timestamp()) {
-      set_timestamp(from.timestamp());
+    if (cached_has_bits & 0x00000010u) {
+      _this->_impl_.timestamp_ = from._impl_.timestamp_;
     }
-    if (from.has_bits()) {
-      set_bits(from.bits());
+    if (cached_has_bits & 0x00000020u) {
+      _this->_impl_.bits_ = from._impl_.bits_;
     }
-    if (from.has_nonce()) {
-      set_nonce(from.nonce());
+    if (cached_has_bits & 0x00000040u) {
+      _this->_impl_.nonce_ = from._impl_.nonce_;
     }
+    _this->_impl_._has_bits_[0] |= cached_has_bits;
   }
-  mutable_unknown_fields()->MergeFrom(from.unknown_fields());
-}
-
-void Block::CopyFrom(const ::google::protobuf::Message& from) {
-  if (&from == this) return;
-  Clear();
-  MergeFrom(from);
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
 }
 
 void Block::CopyFrom(const Block& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:protobuf.Block)
   if (&from == this) return;
   Clear();
   MergeFrom(from);
 }
 
 bool Block::IsInitialized() const {
-  if ((_has_bits_[0] & 0x0000007f) != 0x0000007f) return false;
-  
+  if (_Internal::MissingRequiredFields(_impl_._has_bits_)) return false;
   return true;
 }
 
-void Block::Swap(Block* other) {
-  if (other != this) {
-    std::swap(depth_, other->depth_);
-    std::swap(version_, other->version_);
-    std::swap(previous_block_hash_, other->previous_block_hash_);
-    std::swap(merkle_, other->merkle_);
-    std::swap(timestamp_, other->timestamp_);
-    std::swap(bits_, other->bits_);
-    std::swap(nonce_, other->nonce_);
-    transactions_.Swap(&other->transactions_);
-    std::swap(_has_bits_[0], other->_has_bits_[0]);
-    _unknown_fields_.Swap(&other->_unknown_fields_);
-    std::swap(_cached_size_, other->_cached_size_);
-  }
-}
-
-::google::protobuf::Metadata Block::GetMetadata() const {
-  protobuf_AssignDescriptorsOnce();
-  ::google::protobuf::Metadata metadata;
-  metadata.descriptor = Block_descriptor_;
-  metadata.reflection = Block_reflection_;
-  return metadata;
+void Block::InternalSwap(Block* other) {
+  using std::swap;
+  auto* lhs_arena = GetArenaForAllocation();
+  auto* rhs_arena = other->GetArenaForAllocation();
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  _impl_.transactions_.InternalSwap(&other->_impl_.transactions_);
+  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
+      &_impl_.previous_block_hash_, lhs_arena,
+      &other->_impl_.previous_block_hash_, rhs_arena
+  );
+  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
+      &_impl_.merkle_, lhs_arena,
+      &other->_impl_.merkle_, rhs_arena
+  );
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(Block, _impl_.nonce_)
+      + sizeof(Block::_impl_.nonce_)
+      - PROTOBUF_FIELD_OFFSET(Block, _impl_.depth_)>(
+          reinterpret_cast<char*>(&_impl_.depth_),
+          reinterpret_cast<char*>(&other->_impl_.depth_));
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata Block::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_bitcoin_2eproto_getter, &descriptor_table_bitcoin_2eproto_once,
+      file_level_metadata_bitcoin_2eproto[0]);
 }
 
-
 // ===================================================================
 
-#ifndef _MSC_VER
-const int Transaction_BlockPointer::kDepthFieldNumber;
-const int Transaction_BlockPointer::kIndexFieldNumber;
-#endif  // !_MSC_VER
-
-Transaction_BlockPointer::Transaction_BlockPointer()
-  : ::google::protobuf::Message() {
-  SharedCtor();
-}
+class Transaction_BlockPointer::_Internal {
+ public:
+  using HasBits = decltype(std::declval<Transaction_BlockPointer>()._impl_._has_bits_);
+  static void set_has_depth(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
+  }
+  static void set_has_index(HasBits* has_bits) {
+    (*has_bits)[0] |= 2u;
+  }
+  static bool MissingRequiredFields(const HasBits& has_bits) {
+    return ((has_bits[0] & 0x00000003) ^ 0x00000003) != 0;
+  }
+};
 
-void Transaction_BlockPointer::InitAsDefaultInstance() {
+Transaction_BlockPointer::Transaction_BlockPointer(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:protobuf.Transaction.BlockPointer)
 }
-
 Transaction_BlockPointer::Transaction_BlockPointer(const Transaction_BlockPointer& from)
-  : ::google::protobuf::Message() {
-  SharedCtor();
-  MergeFrom(from);
-}
-
-void Transaction_BlockPointer::SharedCtor() {
-  _cached_size_ = 0;
-  depth_ = 0u;
-  index_ = 0u;
-  ::memset(_has_bits_, 0, sizeof(_has_bits_));
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  Transaction_BlockPointer* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){from._impl_._has_bits_}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.depth_){}
+    , decltype(_impl_.index_){}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  ::memcpy(&_impl_.depth_, &from._impl_.depth_,
+    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.index_) -
+    reinterpret_cast<char*>(&_impl_.depth_)) + sizeof(_impl_.index_));
+  // @@protoc_insertion_point(copy_constructor:protobuf.Transaction.BlockPointer)
+}
+
+inline void Transaction_BlockPointer::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.depth_){0u}
+    , decltype(_impl_.index_){0u}
+  };
 }
 
 Transaction_BlockPointer::~Transaction_BlockPointer() {
+  // @@protoc_insertion_point(destructor:protobuf.Transaction.BlockPointer)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
   SharedDtor();
 }
 
-void Transaction_BlockPointer::SharedDtor() {
-  if (this != default_instance_) {
-  }
+inline void Transaction_BlockPointer::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
 }
 
 void Transaction_BlockPointer::SetCachedSize(int size) const {
-  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
-  _cached_size_ = size;
-  GOOGLE_SAFE_CONCURRENT_WRITES_END();
-}
-const ::google::protobuf::Descriptor* Transaction_BlockPointer::descriptor() {
-  protobuf_AssignDescriptorsOnce();
-  return Transaction_BlockPointer_descriptor_;
-}
-
-const Transaction_BlockPointer& Transaction_BlockPointer::default_instance() {
-  if (default_instance_ == NULL) protobuf_AddDesc_bitcoin_2eproto();  return *default_instance_;
-}
-
-Transaction_BlockPointer* Transaction_BlockPointer::default_instance_ = NULL;
-
-Transaction_BlockPointer* Transaction_BlockPointer::New() const {
-  return new Transaction_BlockPointer;
+  _impl_._cached_size_.Set(size);
 }
 
 void Transaction_BlockPointer::Clear() {
-  if (_has_bits_[0 / 32] & (0xffu << (0 % 32))) {
-    depth_ = 0u;
-    index_ = 0u;
-  }
-  ::memset(_has_bits_, 0, sizeof(_has_bits_));
-  mutable_unknown_fields()->Clear();
-}
-
-bool Transaction_BlockPointer::MergePartialFromCodedStream(
-    ::google::protobuf::io::CodedInputStream* input) {
-#define DO_(EXPRESSION) if (!(EXPRESSION)) return false
-  ::google::protobuf::uint32 tag;
-  while ((tag = input->ReadTag()) != 0) {
-    switch (::google::protobuf::internal::WireFormatLite::GetTagFieldNumber(tag)) {
+// @@protoc_insertion_point(message_clear_start:protobuf.Transaction.BlockPointer)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000003u) {
+    ::memset(&_impl_.depth_, 0, static_cast<size_t>(
+        reinterpret_cast<char*>(&_impl_.index_) -
+        reinterpret_cast<char*>(&_impl_.depth_)) + sizeof(_impl_.index_));
+  }
+  _impl_._has_bits_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* Transaction_BlockPointer::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  _Internal::HasBits has_bits{};
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
       // required uint32 depth = 1;
-      case 1: {
-        if (::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
-            ::google::protobuf::internal::WireFormatLite::WIRETYPE_VARINT) {
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   ::google::protobuf::uint32, ::google::protobuf::internal::WireFormatLite::TYPE_UINT32>(
-                 input, &depth_)));
-          set_has_depth();
-        } else {
-          goto handle_uninterpreted;
-        }
-        if (input->ExpectTag(16)) goto parse_index;
-        break;
-      }
-      
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 8)) {
+          _Internal::set_has_depth(&has_bits);
+          _impl_.depth_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       // required uint32 index = 2;
-      case 2: {
-        if (::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
-            ::google::protobuf::internal::WireFormatLite::WIRETYPE_VARINT) {
-         parse_index:
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   ::google::protobuf::uint32, ::google::protobuf::internal::WireFormatLite::TYPE_UINT32>(
-                 input, &index_)));
-          set_has_index();
-        } else {
-          goto handle_uninterpreted;
-        }
-        if (input->ExpectAtEnd()) return true;
-        break;
-      }
-      
-      default: {
-      handle_uninterpreted:
-        if (::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
-            ::google::protobuf::internal::WireFormatLite::WIRETYPE_END_GROUP) {
-          return true;
-        }
-        DO_(::google::protobuf::internal::WireFormat::SkipField(
-              input, tag, mutable_unknown_fields()));
-        break;
-      }
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 16)) {
+          _Internal::set_has_index(&has_bits);
+          _impl_.index_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
     }
-  }
-  return true;
-#undef DO_
-}
-
-void Transaction_BlockPointer::SerializeWithCachedSizes(
-    ::google::protobuf::io::CodedOutputStream* output) const {
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  _impl_._has_bits_.Or(has_bits);
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
+}
+
+uint8_t* Transaction_BlockPointer::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:protobuf.Transaction.BlockPointer)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
   // required uint32 depth = 1;
-  if (has_depth()) {
-    ::google::protobuf::internal::WireFormatLite::WriteUInt32(1, this->depth(), output);
-  }
-  
-  // required uint32 index = 2;
-  if (has_index()) {
-    ::google::protobuf::internal::WireFormatLite::WriteUInt32(2, this->index(), output);
+  if (cached_has_bits & 0x00000001u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt32ToArray(1, this->_internal_depth(), target);
   }
-  
-  if (!unknown_fields().empty()) {
-    ::google::protobuf::internal::WireFormat::SerializeUnknownFields(
-        unknown_fields(), output);
-  }
-}
 
-::google::protobuf::uint8* Transaction_BlockPointer::SerializeWithCachedSizesToArray(
-    ::google::protobuf::uint8* target) const {
-  // required uint32 depth = 1;
-  if (has_depth()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteUInt32ToArray(1, this->depth(), target);
-  }
-  
   // required uint32 index = 2;
-  if (has_index()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteUInt32ToArray(2, this->index(), target);
+  if (cached_has_bits & 0x00000002u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt32ToArray(2, this->_internal_index(), target);
   }
-  
-  if (!unknown_fields().empty()) {
-    target = ::google::protobuf::internal::WireFormat::SerializeUnknownFieldsToArray(
-        unknown_fields(), target);
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
   }
+  // @@protoc_insertion_point(serialize_to_array_end:protobuf.Transaction.BlockPointer)
   return target;
 }
 
-int Transaction_BlockPointer::ByteSize() const {
-  int total_size = 0;
-  
-  if (_has_bits_[0 / 32] & (0xffu << (0 % 32))) {
+size_t Transaction_BlockPointer::RequiredFieldsByteSizeFallback() const {
+// @@protoc_insertion_point(required_fields_byte_size_fallback_start:protobuf.Transaction.BlockPointer)
+  size_t total_size = 0;
+
+  if (_internal_has_depth()) {
     // required uint32 depth = 1;
-    if (has_depth()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::UInt32Size(
-          this->depth());
-    }
-    
-    // required uint32 index = 2;
-    if (has_index()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::UInt32Size(
-          this->index());
-    }
-    
+    total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_depth());
   }
-  if (!unknown_fields().empty()) {
-    total_size +=
-      ::google::protobuf::internal::WireFormat::ComputeUnknownFieldsSize(
-        unknown_fields());
+
+  if (_internal_has_index()) {
+    // required uint32 index = 2;
+    total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_index());
   }
-  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
-  _cached_size_ = total_size;
-  GOOGLE_SAFE_CONCURRENT_WRITES_END();
+
   return total_size;
 }
+size_t Transaction_BlockPointer::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:protobuf.Transaction.BlockPointer)
+  size_t total_size = 0;
+
+  if (((_impl_._has_bits_[0] & 0x00000003) ^ 0x00000003) == 0) {  // All required fields are present.
+    // required uint32 depth = 1;
+    total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_depth());
+
+    // required uint32 index = 2;
+    total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_index());
 
-void Transaction_BlockPointer::MergeFrom(const ::google::protobuf::Message& from) {
-  GOOGLE_CHECK_NE(&from, this);
-  const Transaction_BlockPointer* source =
-    ::google::protobuf::internal::dynamic_cast_if_available<const Transaction_BlockPointer*>(
-      &from);
-  if (source == NULL) {
-    ::google::protobuf::internal::ReflectionOps::Merge(from, this);
   } else {
-    MergeFrom(*source);
+    total_size += RequiredFieldsByteSizeFallback();
   }
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
 }
 
-void Transaction_BlockPointer::MergeFrom(const Transaction_BlockPointer& from) {
-  GOOGLE_CHECK_NE(&from, this);
-  if (from._has_bits_[0 / 32] & (0xffu << (0 % 32))) {
-    if (from.has_depth()) {
-      set_depth(from.depth());
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData Transaction_BlockPointer::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    Transaction_BlockPointer::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*Transaction_BlockPointer::GetClassData() const { return &_class_data_; }
+
+
+void Transaction_BlockPointer::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<Transaction_BlockPointer*>(&to_msg);
+  auto& from = static_cast<const Transaction_BlockPointer&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:protobuf.Transaction.BlockPointer)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = from._impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000003u) {
+    if (cached_has_bits & 0x00000001u) {
+      _this->_impl_.depth_ = from._impl_.depth_;
     }
-    if (from.has_index()) {
-      set_index(from.index());
+    if (cached_has_bits & 0x00000002u) {
+      _this->_impl_.index_ = from._impl_.index_;
     }
+    _this->_impl_._has_bits_[0] |= cached_has_bits;
   }
-  mutable_unknown_fields()->MergeFrom(from.unknown_fields());
-}
-
-void Transaction_BlockPointer::CopyFrom(const ::google::protobuf::Message& from) {
-  if (&from == this) return;
-  Clear();
-  MergeFrom(from);
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
 }
 
 void Transaction_BlockPointer::CopyFrom(const Transaction_BlockPointer& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:protobuf.Transaction.BlockPointer)
   if (&from == this) return;
   Clear();
   MergeFrom(from);
 }
 
 bool Transaction_BlockPointer::IsInitialized() const {
-  if ((_has_bits_[0] & 0x00000003) != 0x00000003) return false;
-  
+  if (_Internal::MissingRequiredFields(_impl_._has_bits_)) return false;
   return true;
 }
 
-void Transaction_BlockPointer::Swap(Transaction_BlockPointer* other) {
-  if (other != this) {
-    std::swap(depth_, other->depth_);
-    std::swap(index_, other->index_);
-    std::swap(_has_bits_[0], other->_has_bits_[0]);
-    _unknown_fields_.Swap(&other->_unknown_fields_);
-    std::swap(_cached_size_, other->_cached_size_);
-  }
+void Transaction_BlockPointer::InternalSwap(Transaction_BlockPointer* other) {
+  using std::swap;
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(Transaction_BlockPointer, _impl_.index_)
+      + sizeof(Transaction_BlockPointer::_impl_.index_)
+      - PROTOBUF_FIELD_OFFSET(Transaction_BlockPointer, _impl_.depth_)>(
+          reinterpret_cast<char*>(&_impl_.depth_),
+          reinterpret_cast<char*>(&other->_impl_.depth_));
 }
 
-::google::protobuf::Metadata Transaction_BlockPointer::GetMetadata() const {
-  protobuf_AssignDescriptorsOnce();
-  ::google::protobuf::Metadata metadata;
-  metadata.descriptor = Transaction_BlockPointer_descriptor_;
-  metadata.reflection = Transaction_BlockPointer_reflection_;
-  return metadata;
+::PROTOBUF_NAMESPACE_ID::Metadata Transaction_BlockPointer::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_bitcoin_2eproto_getter, &descriptor_table_bitcoin_2eproto_once,
+      file_level_metadata_bitcoin_2eproto[1]);
 }
 
+// ===================================================================
 
-// -------------------------------------------------------------------
-
-#ifndef _MSC_VER
-const int Transaction_Input::kPreviousOutputHashFieldNumber;
-const int Transaction_Input::kPreviousOutputIndexFieldNumber;
-const int Transaction_Input::kScriptFieldNumber;
-const int Transaction_Input::kSequenceFieldNumber;
-#endif  // !_MSC_VER
-
-Transaction_Input::Transaction_Input()
-  : ::google::protobuf::Message() {
-  SharedCtor();
-}
+class Transaction_Input::_Internal {
+ public:
+  using HasBits = decltype(std::declval<Transaction_Input>()._impl_._has_bits_);
+  static void set_has_previous_output_hash(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
+  }
+  static void set_has_previous_output_index(HasBits* has_bits) {
+    (*has_bits)[0] |= 4u;
+  }
+  static void set_has_script(HasBits* has_bits) {
+    (*has_bits)[0] |= 2u;
+  }
+  static void set_has_sequence(HasBits* has_bits) {
+    (*has_bits)[0] |= 8u;
+  }
+  static bool MissingRequiredFields(const HasBits& has_bits) {
+    return ((has_bits[0] & 0x0000000f) ^ 0x0000000f) != 0;
+  }
+};
 
-void Transaction_Input::InitAsDefaultInstance() {
+Transaction_Input::Transaction_Input(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:protobuf.Transaction.Input)
 }
-
 Transaction_Input::Transaction_Input(const Transaction_Input& from)
-  : ::google::protobuf::Message() {
-  SharedCtor();
-  MergeFrom(from);
-}
-
-void Transaction_Input::SharedCtor() {
-  _cached_size_ = 0;
-  previous_output_hash_ = const_cast< ::std::string*>(&::google::protobuf::internal::kEmptyString);
-  previous_output_index_ = 0u;
-  script_ = const_cast< ::std::string*>(&::google::protobuf::internal::kEmptyString);
-  sequence_ = 0u;
-  ::memset(_has_bits_, 0, sizeof(_has_bits_));
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  Transaction_Input* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){from._impl_._has_bits_}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.previous_output_hash_){}
+    , decltype(_impl_.script_){}
+    , decltype(_impl_.previous_output_index_){}
+    , decltype(_impl_.sequence_){}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  _impl_.previous_output_hash_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.previous_output_hash_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (from._internal_has_previous_output_hash()) {
+    _this->_impl_.previous_output_hash_.Set(from._internal_previous_output_hash(), 
+      _this->GetArenaForAllocation());
+  }
+  _impl_.script_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.script_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (from._internal_has_script()) {
+    _this->_impl_.script_.Set(from._internal_script(), 
+      _this->GetArenaForAllocation());
+  }
+  ::memcpy(&_impl_.previous_output_index_, &from._impl_.previous_output_index_,
+    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.sequence_) -
+    reinterpret_cast<char*>(&_impl_.previous_output_index_)) + sizeof(_impl_.sequence_));
+  // @@protoc_insertion_point(copy_constructor:protobuf.Transaction.Input)
+}
+
+inline void Transaction_Input::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.previous_output_hash_){}
+    , decltype(_impl_.script_){}
+    , decltype(_impl_.previous_output_index_){0u}
+    , decltype(_impl_.sequence_){0u}
+  };
+  _impl_.previous_output_hash_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.previous_output_hash_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  _impl_.script_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.script_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
 }
 
 Transaction_Input::~Transaction_Input() {
+  // @@protoc_insertion_point(destructor:protobuf.Transaction.Input)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
   SharedDtor();
 }
 
-void Transaction_Input::SharedDtor() {
-  if (previous_output_hash_ != &::google::protobuf::internal::kEmptyString) {
-    delete previous_output_hash_;
-  }
-  if (script_ != &::google::protobuf::internal::kEmptyString) {
-    delete script_;
-  }
-  if (this != default_instance_) {
-  }
+inline void Transaction_Input::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_.previous_output_hash_.Destroy();
+  _impl_.script_.Destroy();
 }
 
 void Transaction_Input::SetCachedSize(int size) const {
-  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
-  _cached_size_ = size;
-  GOOGLE_SAFE_CONCURRENT_WRITES_END();
-}
-const ::google::protobuf::Descriptor* Transaction_Input::descriptor() {
-  protobuf_AssignDescriptorsOnce();
-  return Transaction_Input_descriptor_;
-}
-
-const Transaction_Input& Transaction_Input::default_instance() {
-  if (default_instance_ == NULL) protobuf_AddDesc_bitcoin_2eproto();  return *default_instance_;
-}
-
-Transaction_Input* Transaction_Input::default_instance_ = NULL;
-
-Transaction_Input* Transaction_Input::New() const {
-  return new Transaction_Input;
+  _impl_._cached_size_.Set(size);
 }
 
 void Transaction_Input::Clear() {
-  if (_has_bits_[0 / 32] & (0xffu << (0 % 32))) {
-    if (has_previous_output_hash()) {
-      if (previous_output_hash_ != &::google::protobuf::internal::kEmptyString) {
-        previous_output_hash_->clear();
-      }
+// @@protoc_insertion_point(message_clear_start:protobuf.Transaction.Input)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000003u) {
+    if (cached_has_bits & 0x00000001u) {
+      _impl_.previous_output_hash_.ClearNonDefaultToEmpty();
     }
-    previous_output_index_ = 0u;
-    if (has_script()) {
-      if (script_ != &::google::protobuf::internal::kEmptyString) {
-        script_->clear();
-      }
+    if (cached_has_bits & 0x00000002u) {
+      _impl_.script_.ClearNonDefaultToEmpty();
     }
-    sequence_ = 0u;
   }
-  ::memset(_has_bits_, 0, sizeof(_has_bits_));
-  mutable_unknown_fields()->Clear();
+  if (cached_has_bits & 0x0000000cu) {
+    ::memset(&_impl_.previous_output_index_, 0, static_cast<size_t>(
+        reinterpret_cast<char*>(&_impl_.sequence_) -
+        reinterpret_cast<char*>(&_impl_.previous_output_index_)) + sizeof(_impl_.sequence_));
+  }
+  _impl_._has_bits_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
 }
 
-bool Transaction_Input::MergePartialFromCodedStream(
-    ::google::protobuf::io::CodedInputStream* input) {
-#define DO_(EXPRESSION) if (!(EXPRESSION)) return false
-  ::google::protobuf::uint32 tag;
-  while ((tag = input->ReadTag()) != 0) {
-    switch (::google::protobuf::internal::WireFormatLite::GetTagFieldNumber(tag)) {
+const char* Transaction_Input::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  _Internal::HasBits has_bits{};
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
       // required bytes previous_output_hash = 1;
-      case 1: {
-        if (::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
-            ::google::protobuf::internal::WireFormatLite::WIRETYPE_LENGTH_DELIMITED) {
-          DO_(::google::protobuf::internal::WireFormatLite::ReadBytes(
-                input, this->mutable_previous_output_hash()));
-        } else {
-          goto handle_uninterpreted;
-        }
-        if (input->ExpectTag(16)) goto parse_previous_output_index;
-        break;
-      }
-      
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 10)) {
+          auto str = _internal_mutable_previous_output_hash();
+          ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       // required uint32 previous_output_index = 2;
-      case 2: {
-        if (::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
-            ::google::protobuf::internal::WireFormatLite::WIRETYPE_VARINT) {
-         parse_previous_output_index:
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   ::google::protobuf::uint32, ::google::protobuf::internal::WireFormatLite::TYPE_UINT32>(
-                 input, &previous_output_index_)));
-          set_has_previous_output_index();
-        } else {
-          goto handle_uninterpreted;
-        }
-        if (input->ExpectTag(26)) goto parse_script;
-        break;
-      }
-      
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 16)) {
+          _Internal::set_has_previous_output_index(&has_bits);
+          _impl_.previous_output_index_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       // required bytes script = 3;
-      case 3: {
-        if (::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
-            ::google::protobuf::internal::WireFormatLite::WIRETYPE_LENGTH_DELIMITED) {
-         parse_script:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadBytes(
-                input, this->mutable_script()));
-        } else {
-          goto handle_uninterpreted;
-        }
-        if (input->ExpectTag(32)) goto parse_sequence;
-        break;
-      }
-      
+      case 3:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 26)) {
+          auto str = _internal_mutable_script();
+          ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       // required uint32 sequence = 4;
-      case 4: {
-        if (::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
-            ::google::protobuf::internal::WireFormatLite::WIRETYPE_VARINT) {
-         parse_sequence:
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   ::google::protobuf::uint32, ::google::protobuf::internal::WireFormatLite::TYPE_UINT32>(
-                 input, &sequence_)));
-          set_has_sequence();
-        } else {
-          goto handle_uninterpreted;
-        }
-        if (input->ExpectAtEnd()) return true;
-        break;
-      }
-      
-      default: {
-      handle_uninterpreted:
-        if (::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
-            ::google::protobuf::internal::WireFormatLite::WIRETYPE_END_GROUP) {
-          return true;
-        }
-        DO_(::google::protobuf::internal::WireFormat::SkipField(
-              input, tag, mutable_unknown_fields()));
-        break;
-      }
+      case 4:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 32)) {
+          _Internal::set_has_sequence(&has_bits);
+          _impl_.sequence_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
     }
-  }
-  return true;
-#undef DO_
-}
-
-void Transaction_Input::SerializeWithCachedSizes(
-    ::google::protobuf::io::CodedOutputStream* output) const {
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  _impl_._has_bits_.Or(has_bits);
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
+}
+
+uint8_t* Transaction_Input::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:protobuf.Transaction.Input)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
   // required bytes previous_output_hash = 1;
-  if (has_previous_output_hash()) {
-    ::google::protobuf::internal::WireFormatLite::WriteBytes(
-      1, this->previous_output_hash(), output);
+  if (cached_has_bits & 0x00000001u) {
+    target = stream->WriteBytesMaybeAliased(
+        1, this->_internal_previous_output_hash(), target);
   }
-  
+
   // required uint32 previous_output_index = 2;
-  if (has_previous_output_index()) {
-    ::google::protobuf::internal::WireFormatLite::WriteUInt32(2, this->previous_output_index(), output);
+  if (cached_has_bits & 0x00000004u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt32ToArray(2, this->_internal_previous_output_index(), target);
   }
-  
+
   // required bytes script = 3;
-  if (has_script()) {
-    ::google::protobuf::internal::WireFormatLite::WriteBytes(
-      3, this->script(), output);
+  if (cached_has_bits & 0x00000002u) {
+    target = stream->WriteBytesMaybeAliased(
+        3, this->_internal_script(), target);
   }
-  
+
   // required uint32 sequence = 4;
-  if (has_sequence()) {
-    ::google::protobuf::internal::WireFormatLite::WriteUInt32(4, this->sequence(), output);
+  if (cached_has_bits & 0x00000008u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt32ToArray(4, this->_internal_sequence(), target);
   }
-  
-  if (!unknown_fields().empty()) {
-    ::google::protobuf::internal::WireFormat::SerializeUnknownFields(
-        unknown_fields(), output);
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
   }
+  // @@protoc_insertion_point(serialize_to_array_end:protobuf.Transaction.Input)
+  return target;
 }
 
-::google::protobuf::uint8* Transaction_Input::SerializeWithCachedSizesToArray(
-    ::google::protobuf::uint8* target) const {
-  // required bytes previous_output_hash = 1;
-  if (has_previous_output_hash()) {
-    target =
-      ::google::protobuf::internal::WireFormatLite::WriteBytesToArray(
-        1, this->previous_output_hash(), target);
-  }
-  
-  // required uint32 previous_output_index = 2;
-  if (has_previous_output_index()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteUInt32ToArray(2, this->previous_output_index(), target);
+size_t Transaction_Input::RequiredFieldsByteSizeFallback() const {
+// @@protoc_insertion_point(required_fields_byte_size_fallback_start:protobuf.Transaction.Input)
+  size_t total_size = 0;
+
+  if (_internal_has_previous_output_hash()) {
+    // required bytes previous_output_hash = 1;
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::BytesSize(
+        this->_internal_previous_output_hash());
   }
-  
-  // required bytes script = 3;
-  if (has_script()) {
-    target =
-      ::google::protobuf::internal::WireFormatLite::WriteBytesToArray(
-        3, this->script(), target);
+
+  if (_internal_has_script()) {
+    // required bytes script = 3;
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::BytesSize(
+        this->_internal_script());
   }
-  
-  // required uint32 sequence = 4;
-  if (has_sequence()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteUInt32ToArray(4, this->sequence(), target);
+
+  if (_internal_has_previous_output_index()) {
+    // required uint32 previous_output_index = 2;
+    total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_previous_output_index());
   }
-  
-  if (!unknown_fields().empty()) {
-    target = ::google::protobuf::internal::WireFormat::SerializeUnknownFieldsToArray(
-        unknown_fields(), target);
+
+  if (_internal_has_sequence()) {
+    // required uint32 sequence = 4;
+    total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_sequence());
   }
-  return target;
+
+  return total_size;
 }
+size_t Transaction_Input::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:protobuf.Transaction.Input)
+  size_t total_size = 0;
 
-int Transaction_Input::ByteSize() const {
-  int total_size = 0;
-  
-  if (_has_bits_[0 / 32] & (0xffu << (0 % 32))) {
+  if (((_impl_._has_bits_[0] & 0x0000000f) ^ 0x0000000f) == 0) {  // All required fields are present.
     // required bytes previous_output_hash = 1;
-    if (has_previous_output_hash()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::BytesSize(
-          this->previous_output_hash());
-    }
-    
-    // required uint32 previous_output_index = 2;
-    if (has_previous_output_index()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::UInt32Size(
-          this->previous_output_index());
-    }
-    
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::BytesSize(
+        this->_internal_previous_output_hash());
+
     // required bytes script = 3;
-    if (has_script()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::BytesSize(
-          this->script());
-    }
-    
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::BytesSize(
+        this->_internal_script());
+
+    // required uint32 previous_output_index = 2;
+    total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_previous_output_index());
+
     // required uint32 sequence = 4;
-    if (has_sequence()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::UInt32Size(
-          this->sequence());
-    }
-    
-  }
-  if (!unknown_fields().empty()) {
-    total_size +=
-      ::google::protobuf::internal::WireFormat::ComputeUnknownFieldsSize(
-        unknown_fields());
-  }
-  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
-  _cached_size_ = total_size;
-  GOOGLE_SAFE_CONCURRENT_WRITES_END();
-  return total_size;
-}
+    total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_sequence());
 
-void Transaction_Input::MergeFrom(const ::google::protobuf::Message& from) {
-  GOOGLE_CHECK_NE(&from, this);
-  const Transaction_Input* source =
-    ::google::protobuf::internal::dynamic_cast_if_available<const Transaction_Input*>(
-      &from);
-  if (source == NULL) {
-    ::google::protobuf::internal::ReflectionOps::Merge(from, this);
   } else {
-    MergeFrom(*source);
+    total_size += RequiredFieldsByteSizeFallback();
   }
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
 }
 
-void Transaction_Input::MergeFrom(const Transaction_Input& from) {
-  GOOGLE_CHECK_NE(&from, this);
-  if (from._has_bits_[0 / 32] & (0xffu << (0 % 32))) {
-    if (from.has_previous_output_hash()) {
-      set_previous_output_hash(from.previous_output_hash());
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData Transaction_Input::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    Transaction_Input::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*Transaction_Input::GetClassData() const { return &_class_data_; }
+
+
+void Transaction_Input::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<Transaction_Input*>(&to_msg);
+  auto& from = static_cast<const Transaction_Input&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:protobuf.Transaction.Input)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = from._impl_._has_bits_[0];
+  if (cached_has_bits & 0x0000000fu) {
+    if (cached_has_bits & 0x00000001u) {
+      _this->_internal_set_previous_output_hash(from._internal_previous_output_hash());
     }
-    if (from.has_previous_output_index()) {
-      set_previous_output_index(from.previous_output_index());
+    if (cached_has_bits & 0x00000002u) {
+      _this->_internal_set_script(from._internal_script());
     }
-    if (from.has_script()) {
-      set_script(from.script());
+    if (cached_has_bits & 0x00000004u) {
+      _this->_impl_.previous_output_index_ = from._impl_.previous_output_index_;
     }
-    if (from.has_sequence()) {
-      set_sequence(from.sequence());
+    if (cached_has_bits & 0x00000008u) {
+      _this->_impl_.sequence_ = from._impl_.sequence_;
     }
+    _this->_impl_._has_bits_[0] |= cached_has_bits;
   }
-  mutable_unknown_fields()->MergeFrom(from.unknown_fields());
-}
-
-void Transaction_Input::CopyFrom(const ::google::protobuf::Message& from) {
-  if (&from == this) return;
-  Clear();
-  MergeFrom(from);
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
 }
 
 void Transaction_Input::CopyFrom(const Transaction_Input& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:protobuf.Transaction.Input)
   if (&from == this) return;
   Clear();
   MergeFrom(from);
 }
 
 bool Transaction_Input::IsInitialized() const {
-  if ((_has_bits_[0] & 0x0000000f) != 0x0000000f) return false;
-  
+  if (_Internal::MissingRequiredFields(_impl_._has_bits_)) return false;
   return true;
 }
 
-void Transaction_Input::Swap(Transaction_Input* other) {
-  if (other != this) {
-    std::swap(previous_output_hash_, other->previous_output_hash_);
-    std::swap(previous_output_index_, other->previous_output_index_);
-    std::swap(script_, other->script_);
-    std::swap(sequence_, other->sequence_);
-    std::swap(_has_bits_[0], other->_has_bits_[0]);
-    _unknown_fields_.Swap(&other->_unknown_fields_);
-    std::swap(_cached_size_, other->_cached_size_);
-  }
-}
-
-::google::protobuf::Metadata Transaction_Input::GetMetadata() const {
-  protobuf_AssignDescriptorsOnce();
-  ::google::protobuf::Metadata metadata;
-  metadata.descriptor = Transaction_Input_descriptor_;
-  metadata.reflection = Transaction_Input_reflection_;
-  return metadata;
+void Transaction_Input::InternalSwap(Transaction_Input* other) {
+  using std::swap;
+  auto* lhs_arena = GetArenaForAllocation();
+  auto* rhs_arena = other->GetArenaForAllocation();
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
+      &_impl_.previous_output_hash_, lhs_arena,
+      &other->_impl_.previous_output_hash_, rhs_arena
+  );
+  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
+      &_impl_.script_, lhs_arena,
+      &other->_impl_.script_, rhs_arena
+  );
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(Transaction_Input, _impl_.sequence_)
+      + sizeof(Transaction_Input::_impl_.sequence_)
+      - PROTOBUF_FIELD_OFFSET(Transaction_Input, _impl_.previous_output_index_)>(
+          reinterpret_cast<char*>(&_impl_.previous_output_index_),
+          reinterpret_cast<char*>(&other->_impl_.previous_output_index_));
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata Transaction_Input::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_bitcoin_2eproto_getter, &descriptor_table_bitcoin_2eproto_once,
+      file_level_metadata_bitcoin_2eproto[2]);
 }
 
+// ===================================================================
 
-// -------------------------------------------------------------------
-
-#ifndef _MSC_VER
-const int Transaction_Output::kValueFieldNumber;
-const int Transaction_Output::kScriptFieldNumber;
-#endif  // !_MSC_VER
-
-Transaction_Output::Transaction_Output()
-  : ::google::protobuf::Message() {
-  SharedCtor();
-}
+class Transaction_Output::_Internal {
+ public:
+  using HasBits = decltype(std::declval<Transaction_Output>()._impl_._has_bits_);
+  static void set_has_value(HasBits* has_bits) {
+    (*has_bits)[0] |= 2u;
+  }
+  static void set_has_script(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
+  }
+  static bool MissingRequiredFields(const HasBits& has_bits) {
+    return ((has_bits[0] & 0x00000003) ^ 0x00000003) != 0;
+  }
+};
 
-void Transaction_Output::InitAsDefaultInstance() {
+Transaction_Output::Transaction_Output(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:protobuf.Transaction.Output)
 }
-
 Transaction_Output::Transaction_Output(const Transaction_Output& from)
-  : ::google::protobuf::Message() {
-  SharedCtor();
-  MergeFrom(from);
-}
-
-void Transaction_Output::SharedCtor() {
-  _cached_size_ = 0;
-  value_ = GOOGLE_ULONGLONG(0);
-  script_ = const_cast< ::std::string*>(&::google::protobuf::internal::kEmptyString);
-  ::memset(_has_bits_, 0, sizeof(_has_bits_));
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  Transaction_Output* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){from._impl_._has_bits_}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.script_){}
+    , decltype(_impl_.value_){}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  _impl_.script_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.script_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (from._internal_has_script()) {
+    _this->_impl_.script_.Set(from._internal_script(), 
+      _this->GetArenaForAllocation());
+  }
+  _this->_impl_.value_ = from._impl_.value_;
+  // @@protoc_insertion_point(copy_constructor:protobuf.Transaction.Output)
+}
+
+inline void Transaction_Output::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.script_){}
+    , decltype(_impl_.value_){uint64_t{0u}}
+  };
+  _impl_.script_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.script_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
 }
 
 Transaction_Output::~Transaction_Output() {
+  // @@protoc_insertion_point(destructor:protobuf.Transaction.Output)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
   SharedDtor();
 }
 
-void Transaction_Output::SharedDtor() {
-  if (script_ != &::google::protobuf::internal::kEmptyString) {
-    delete script_;
-  }
-  if (this != default_instance_) {
-  }
+inline void Transaction_Output::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_.script_.Destroy();
 }
 
 void Transaction_Output::SetCachedSize(int size) const {
-  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
-  _cached_size_ = size;
-  GOOGLE_SAFE_CONCURRENT_WRITES_END();
-}
-const ::google::protobuf::Descriptor* Transaction_Output::descriptor() {
-  protobuf_AssignDescriptorsOnce();
-  return Transaction_Output_descriptor_;
-}
-
-const Transaction_Output& Transaction_Output::default_instance() {
-  if (default_instance_ == NULL) protobuf_AddDesc_bitcoin_2eproto();  return *default_instance_;
-}
-
-Transaction_Output* Transaction_Output::default_instance_ = NULL;
-
-Transaction_Output* Transaction_Output::New() const {
-  return new Transaction_Output;
+  _impl_._cached_size_.Set(size);
 }
 
 void Transaction_Output::Clear() {
-  if (_has_bits_[0 / 32] & (0xffu << (0 % 32))) {
-    value_ = GOOGLE_ULONGLONG(0);
-    if (has_script()) {
-      if (script_ != &::google::protobuf::internal::kEmptyString) {
-        script_->clear();
-      }
-    }
-  }
-  ::memset(_has_bits_, 0, sizeof(_has_bits_));
-  mutable_unknown_fields()->Clear();
-}
-
-bool Transaction_Output::MergePartialFromCodedStream(
-    ::google::protobuf::io::CodedInputStream* input) {
-#define DO_(EXPRESSION) if (!(EXPRESSION)) return false
-  ::google::protobuf::uint32 tag;
-  while ((tag = input->ReadTag()) != 0) {
-    switch (::google::protobuf::internal::WireFormatLite::GetTagFieldNumber(tag)) {
+// @@protoc_insertion_point(message_clear_start:protobuf.Transaction.Output)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000001u) {
+    _impl_.script_.ClearNonDefaultToEmpty();
+  }
+  _impl_.value_ = uint64_t{0u};
+  _impl_._has_bits_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* Transaction_Output::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  _Internal::HasBits has_bits{};
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
       // required uint64 value = 1;
-      case 1: {
-        if (::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
-            ::google::protobuf::internal::WireFormatLite::WIRETYPE_VARINT) {
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   ::google::protobuf::uint64, ::google::protobuf::internal::WireFormatLite::TYPE_UINT64>(
-                 input, &value_)));
-          set_has_value();
-        } else {
-          goto handle_uninterpreted;
-        }
-        if (input->ExpectTag(18)) goto parse_script;
-        break;
-      }
-      
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 8)) {
+          _Internal::set_has_value(&has_bits);
+          _impl_.value_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       // required bytes script = 2;
-      case 2: {
-        if (::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
-            ::google::protobuf::internal::WireFormatLite::WIRETYPE_LENGTH_DELIMITED) {
-         parse_script:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadBytes(
-                input, this->mutable_script()));
-        } else {
-          goto handle_uninterpreted;
-        }
-        if (input->ExpectAtEnd()) return true;
-        break;
-      }
-      
-      default: {
-      handle_uninterpreted:
-        if (::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
-            ::google::protobuf::internal::WireFormatLite::WIRETYPE_END_GROUP) {
-          return true;
-        }
-        DO_(::google::protobuf::internal::WireFormat::SkipField(
-              input, tag, mutable_unknown_fields()));
-        break;
-      }
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 18)) {
+          auto str = _internal_mutable_script();
+          ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
     }
-  }
-  return true;
-#undef DO_
-}
-
-void Transaction_Output::SerializeWithCachedSizes(
-    ::google::protobuf::io::CodedOutputStream* output) const {
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  _impl_._has_bits_.Or(has_bits);
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
+}
+
+uint8_t* Transaction_Output::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:protobuf.Transaction.Output)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
   // required uint64 value = 1;
-  if (has_value()) {
-    ::google::protobuf::internal::WireFormatLite::WriteUInt64(1, this->value(), output);
+  if (cached_has_bits & 0x00000002u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt64ToArray(1, this->_internal_value(), target);
   }
-  
-  // required bytes script = 2;
-  if (has_script()) {
-    ::google::protobuf::internal::WireFormatLite::WriteBytes(
-      2, this->script(), output);
-  }
-  
-  if (!unknown_fields().empty()) {
-    ::google::protobuf::internal::WireFormat::SerializeUnknownFields(
-        unknown_fields(), output);
-  }
-}
 
-::google::protobuf::uint8* Transaction_Output::SerializeWithCachedSizesToArray(
-    ::google::protobuf::uint8* target) const {
-  // required uint64 value = 1;
-  if (has_value()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteUInt64ToArray(1, this->value(), target);
-  }
-  
   // required bytes script = 2;
-  if (has_script()) {
-    target =
-      ::google::protobuf::internal::WireFormatLite::WriteBytesToArray(
-        2, this->script(), target);
+  if (cached_has_bits & 0x00000001u) {
+    target = stream->WriteBytesMaybeAliased(
+        2, this->_internal_script(), target);
   }
-  
-  if (!unknown_fields().empty()) {
-    target = ::google::protobuf::internal::WireFormat::SerializeUnknownFieldsToArray(
-        unknown_fields(), target);
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
   }
+  // @@protoc_insertion_point(serialize_to_array_end:protobuf.Transaction.Output)
   return target;
 }
 
-int Transaction_Output::ByteSize() const {
-  int total_size = 0;
-  
-  if (_has_bits_[0 / 32] & (0xffu << (0 % 32))) {
-    // required uint64 value = 1;
-    if (has_value()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::UInt64Size(
-          this->value());
-    }
-    
+size_t Transaction_Output::RequiredFieldsByteSizeFallback() const {
+// @@protoc_insertion_point(required_fields_byte_size_fallback_start:protobuf.Transaction.Output)
+  size_t total_size = 0;
+
+  if (_internal_has_script()) {
     // required bytes script = 2;
-    if (has_script()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::BytesSize(
-          this->script());
-    }
-    
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::BytesSize(
+        this->_internal_script());
   }
-  if (!unknown_fields().empty()) {
-    total_size +=
-      ::google::protobuf::internal::WireFormat::ComputeUnknownFieldsSize(
-        unknown_fields());
+
+  if (_internal_has_value()) {
+    // required uint64 value = 1;
+    total_size += ::_pbi::WireFormatLite::UInt64SizePlusOne(this->_internal_value());
   }
-  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
-  _cached_size_ = total_size;
-  GOOGLE_SAFE_CONCURRENT_WRITES_END();
+
   return total_size;
 }
+size_t Transaction_Output::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:protobuf.Transaction.Output)
+  size_t total_size = 0;
+
+  if (((_impl_._has_bits_[0] & 0x00000003) ^ 0x00000003) == 0) {  // All required fields are present.
+    // required bytes script = 2;
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::BytesSize(
+        this->_internal_script());
+
+    // required uint64 value = 1;
+    total_size += ::_pbi::WireFormatLite::UInt64SizePlusOne(this->_internal_value());
 
-void Transaction_Output::MergeFrom(const ::google::protobuf::Message& from) {
-  GOOGLE_CHECK_NE(&from, this);
-  const Transaction_Output* source =
-    ::google::protobuf::internal::dynamic_cast_if_available<const Transaction_Output*>(
-      &from);
-  if (source == NULL) {
-    ::google::protobuf::internal::ReflectionOps::Merge(from, this);
   } else {
-    MergeFrom(*source);
+    total_size += RequiredFieldsByteSizeFallback();
   }
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
 }
 
-void Transaction_Output::MergeFrom(const Transaction_Output& from) {
-  GOOGLE_CHECK_NE(&from, this);
-  if (from._has_bits_[0 / 32] & (0xffu << (0 % 32))) {
-    if (from.has_value()) {
-      set_value(from.value());
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData Transaction_Output::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    Transaction_Output::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*Transaction_Output::GetClassData() const { return &_class_data_; }
+
+
+void Transaction_Output::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<Transaction_Output*>(&to_msg);
+  auto& from = static_cast<const Transaction_Output&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:protobuf.Transaction.Output)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = from._impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000003u) {
+    if (cached_has_bits & 0x00000001u) {
+      _this->_internal_set_script(from._internal_script());
     }
-    if (from.has_script()) {
-      set_script(from.script());
+    if (cached_has_bits & 0x00000002u) {
+      _this->_impl_.value_ = from._impl_.value_;
     }
+    _this->_impl_._has_bits_[0] |= cached_has_bits;
   }
-  mutable_unknown_fields()->MergeFrom(from.unknown_fields());
-}
-
-void Transaction_Output::CopyFrom(const ::google::protobuf::Message& from) {
-  if (&from == this) return;
-  Clear();
-  MergeFrom(from);
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
 }
 
 void Transaction_Output::CopyFrom(const Transaction_Output& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:protobuf.Transaction.Output)
   if (&from == this) return;
   Clear();
   MergeFrom(from);
 }
 
 bool Transaction_Output::IsInitialized() const {
-  if ((_has_bits_[0] & 0x00000003) != 0x00000003) return false;
-  
+  if (_Internal::MissingRequiredFields(_impl_._has_bits_)) return false;
   return true;
 }
 
-void Transaction_Output::Swap(Transaction_Output* other) {
-  if (other != this) {
-    std::swap(value_, other->value_);
-    std::swap(script_, other->script_);
-    std::swap(_has_bits_[0], other->_has_bits_[0]);
-    _unknown_fields_.Swap(&other->_unknown_fields_);
-    std::swap(_cached_size_, other->_cached_size_);
-  }
+void Transaction_Output::InternalSwap(Transaction_Output* other) {
+  using std::swap;
+  auto* lhs_arena = GetArenaForAllocation();
+  auto* rhs_arena = other->GetArenaForAllocation();
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
+      &_impl_.script_, lhs_arena,
+      &other->_impl_.script_, rhs_arena
+  );
+  swap(_impl_.value_, other->_impl_.value_);
 }
 
-::google::protobuf::Metadata Transaction_Output::GetMetadata() const {
-  protobuf_AssignDescriptorsOnce();
-  ::google::protobuf::Metadata metadata;
-  metadata.descriptor = Transaction_Output_descriptor_;
-  metadata.reflection = Transaction_Output_reflection_;
-  return metadata;
+::PROTOBUF_NAMESPACE_ID::Metadata Transaction_Output::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_bitcoin_2eproto_getter, &descriptor_table_bitcoin_2eproto_once,
+      file_level_metadata_bitcoin_2eproto[3]);
 }
 
+// ===================================================================
 
-// -------------------------------------------------------------------
-
-#ifndef _MSC_VER
-const int Transaction::kParentFieldNumber;
-const int Transaction::kInputsFieldNumber;
-const int Transaction::kOutputsFieldNumber;
-const int Transaction::kVersionFieldNumber;
-const int Transaction::kLocktimeFieldNumber;
-const int Transaction::kIsCoinbaseFieldNumber;
-#endif  // !_MSC_VER
-
-Transaction::Transaction()
-  : ::google::protobuf::Message() {
-  SharedCtor();
-}
+class Transaction::_Internal {
+ public:
+  using HasBits = decltype(std::declval<Transaction>()._impl_._has_bits_);
+  static void set_has_version(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
+  }
+  static void set_has_locktime(HasBits* has_bits) {
+    (*has_bits)[0] |= 2u;
+  }
+  static void set_has_is_coinbase(HasBits* has_bits) {
+    (*has_bits)[0] |= 4u;
+  }
+  static bool MissingRequiredFields(const HasBits& has_bits) {
+    return ((has_bits[0] & 0x00000007) ^ 0x00000007) != 0;
+  }
+};
 
-void Transaction::InitAsDefaultInstance() {
+Transaction::Transaction(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:protobuf.Transaction)
 }
-
 Transaction::Transaction(const Transaction& from)
-  : ::google::protobuf::Message() {
-  SharedCtor();
-  MergeFrom(from);
-}
-
-void Transaction::SharedCtor() {
-  _cached_size_ = 0;
-  version_ = 0u;
-  locktime_ = 0u;
-  is_coinbase_ = false;
-  ::memset(_has_bits_, 0, sizeof(_has_bits_));
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  Transaction* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){from._impl_._has_bits_}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.parent_){from._impl_.parent_}
+    , decltype(_impl_.inputs_){from._impl_.inputs_}
+    , decltype(_impl_.outputs_){from._impl_.outputs_}
+    , decltype(_impl_.version_){}
+    , decltype(_impl_.locktime_){}
+    , decltype(_impl_.is_coinbase_){}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  ::memcpy(&_impl_.version_, &from._impl_.version_,
+    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.is_coinbase_) -
+    reinterpret_cast<char*>(&_impl_.version_)) + sizeof(_impl_.is_coinbase_));
+  // @@protoc_insertion_point(copy_constructor:protobuf.Transaction)
+}
+
+inline void Transaction::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.parent_){arena}
+    , decltype(_impl_.inputs_){arena}
+    , decltype(_impl_.outputs_){arena}
+    , decltype(_impl_.version_){0u}
+    , decltype(_impl_.locktime_){0u}
+    , decltype(_impl_.is_coinbase_){false}
+  };
 }
 
 Transaction::~Transaction() {
+  // @@protoc_insertion_point(destructor:protobuf.Transaction)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
   SharedDtor();
 }
 
-void Transaction::SharedDtor() {
-  if (this != default_instance_) {
-  }
+inline void Transaction::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_.parent_.~RepeatedPtrField();
+  _impl_.inputs_.~RepeatedPtrField();
+  _impl_.outputs_.~RepeatedPtrField();
 }
 
 void Transaction::SetCachedSize(int size) const {
-  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
-  _cached_size_ = size;
-  GOOGLE_SAFE_CONCURRENT_WRITES_END();
-}
-const ::google::protobuf::Descriptor* Transaction::descriptor() {
-  protobuf_AssignDescriptorsOnce();
-  return Transaction_descriptor_;
-}
-
-const Transaction& Transaction::default_instance() {
-  if (default_instance_ == NULL) protobuf_AddDesc_bitcoin_2eproto();  return *default_instance_;
-}
-
-Transaction* Transaction::default_instance_ = NULL;
-
-Transaction* Transaction::New() const {
-  return new Transaction;
+  _impl_._cached_size_.Set(size);
 }
 
 void Transaction::Clear() {
-  if (_has_bits_[3 / 32] & (0xffu << (3 % 32))) {
-    version_ = 0u;
-    locktime_ = 0u;
-    is_coinbase_ = false;
-  }
-  parent_.Clear();
-  inputs_.Clear();
-  outputs_.Clear();
-  ::memset(_has_bits_, 0, sizeof(_has_bits_));
-  mutable_unknown_fields()->Clear();
-}
-
-bool Transaction::MergePartialFromCodedStream(
-    ::google::protobuf::io::CodedInputStream* input) {
-#define DO_(EXPRESSION) if (!(EXPRESSION)) return false
-  ::google::protobuf::uint32 tag;
-  while ((tag = input->ReadTag()) != 0) {
-    switch (::google::protobuf::internal::WireFormatLite::GetTagFieldNumber(tag)) {
+// @@protoc_insertion_point(message_clear_start:protobuf.Transaction)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_.parent_.Clear();
+  _impl_.inputs_.Clear();
+  _impl_.outputs_.Clear();
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000007u) {
+    ::memset(&_impl_.version_, 0, static_cast<size_t>(
+        reinterpret_cast<char*>(&_impl_.is_coinbase_) -
+        reinterpret_cast<char*>(&_impl_.version_)) + sizeof(_impl_.is_coinbase_));
+  }
+  _impl_._has_bits_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* Transaction::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  _Internal::HasBits has_bits{};
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
       // repeated .protobuf.Transaction.BlockPointer parent = 1;
-      case 1: {
-        if (::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
-            ::google::protobuf::internal::WireFormatLite::WIRETYPE_LENGTH_DELIMITED) {
-         parse_parent:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-                input, add_parent()));
-        } else {
-          goto handle_uninterpreted;
-        }
-        if (input->ExpectTag(10)) goto parse_parent;
-        if (input->ExpectTag(26)) goto parse_inputs;
-        break;
-      }
-      
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 10)) {
+          ptr -= 1;
+          do {
+            ptr += 1;
+            ptr = ctx->ParseMessage(_internal_add_parent(), ptr);
+            CHK_(ptr);
+            if (!ctx->DataAvailable(ptr)) break;
+          } while (::PROTOBUF_NAMESPACE_ID::internal::ExpectTag<10>(ptr));
+        } else
+          goto handle_unusual;
+        continue;
       // repeated .protobuf.Transaction.Input inputs = 3;
-      case 3: {
-        if (::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
-            ::google::protobuf::internal::WireFormatLite::WIRETYPE_LENGTH_DELIMITED) {
-         parse_inputs:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-                input, add_inputs()));
-        } else {
-          goto handle_uninterpreted;
-        }
-        if (input->ExpectTag(26)) goto parse_inputs;
-        if (input->ExpectTag(34)) goto parse_outputs;
-        break;
-      }
-      
+      case 3:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 26)) {
+          ptr -= 1;
+          do {
+            ptr += 1;
+            ptr = ctx->ParseMessage(_internal_add_inputs(), ptr);
+            CHK_(ptr);
+            if (!ctx->DataAvailable(ptr)) break;
+          } while (::PROTOBUF_NAMESPACE_ID::internal::ExpectTag<26>(ptr));
+        } else
+          goto handle_unusual;
+        continue;
       // repeated .protobuf.Transaction.Output outputs = 4;
-      case 4: {
-        if (::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
-            ::google::protobuf::internal::WireFormatLite::WIRETYPE_LENGTH_DELIMITED) {
-         parse_outputs:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-                input, add_outputs()));
-        } else {
-          goto handle_uninterpreted;
-        }
-        if (input->ExpectTag(34)) goto parse_outputs;
-        if (input->ExpectTag(40)) goto parse_version;
-        break;
-      }
-      
+      case 4:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 34)) {
+          ptr -= 1;
+          do {
+            ptr += 1;
+            ptr = ctx->ParseMessage(_internal_add_outputs(), ptr);
+            CHK_(ptr);
+            if (!ctx->DataAvailable(ptr)) break;
+          } while (::PROTOBUF_NAMESPACE_ID::internal::ExpectTag<34>(ptr));
+        } else
+          goto handle_unusual;
+        continue;
       // required uint32 version = 5;
-      case 5: {
-        if (::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
-            ::google::protobuf::internal::WireFormatLite::WIRETYPE_VARINT) {
-         parse_version:
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   ::google::protobuf::uint32, ::google::protobuf::internal::WireFormatLite::TYPE_UINT32>(
-                 input, &version_)));
-          set_has_version();
-        } else {
-          goto handle_uninterpreted;
-        }
-        if (input->ExpectTag(48)) goto parse_locktime;
-        break;
-      }
-      
+      case 5:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 40)) {
+          _Internal::set_has_version(&has_bits);
+          _impl_.version_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       // required uint32 locktime = 6;
-      case 6: {
-        if (::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
-            ::google::protobuf::internal::WireFormatLite::WIRETYPE_VARINT) {
-         parse_locktime:
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   ::google::protobuf::uint32, ::google::protobuf::internal::WireFormatLite::TYPE_UINT32>(
-                 input, &locktime_)));
-          set_has_locktime();
-        } else {
-          goto handle_uninterpreted;
-        }
-        if (input->ExpectTag(56)) goto parse_is_coinbase;
-        break;
-      }
-      
+      case 6:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 48)) {
+          _Internal::set_has_locktime(&has_bits);
+          _impl_.locktime_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       // required bool is_coinbase = 7;
-      case 7: {
-        if (::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
-            ::google::protobuf::internal::WireFormatLite::WIRETYPE_VARINT) {
-         parse_is_coinbase:
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   bool, ::google::protobuf::internal::WireFormatLite::TYPE_BOOL>(
-                 input, &is_coinbase_)));
-          set_has_is_coinbase();
-        } else {
-          goto handle_uninterpreted;
-        }
-        if (input->ExpectAtEnd()) return true;
-        break;
-      }
-      
-      default: {
-      handle_uninterpreted:
-        if (::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
-            ::google::protobuf::internal::WireFormatLite::WIRETYPE_END_GROUP) {
-          return true;
-        }
-        DO_(::google::protobuf::internal::WireFormat::SkipField(
-              input, tag, mutable_unknown_fields()));
-        break;
-      }
+      case 7:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 56)) {
+          _Internal::set_has_is_coinbase(&has_bits);
+          _impl_.is_coinbase_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
     }
-  }
-  return true;
-#undef DO_
-}
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  _impl_._has_bits_.Or(has_bits);
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
+}
+
+uint8_t* Transaction::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:protobuf.Transaction)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
 
-void Transaction::SerializeWithCachedSizes(
-    ::google::protobuf::io::CodedOutputStream* output) const {
   // repeated .protobuf.Transaction.BlockPointer parent = 1;
-  for (int i = 0; i < this->parent_size(); i++) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      1, this->parent(i), output);
+  for (unsigned i = 0,
+      n = static_cast<unsigned>(this->_internal_parent_size()); i < n; i++) {
+    const auto& repfield = this->_internal_parent(i);
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+        InternalWriteMessage(1, repfield, repfield.GetCachedSize(), target, stream);
   }
-  
+
   // repeated .protobuf.Transaction.Input inputs = 3;
-  for (int i = 0; i < this->inputs_size(); i++) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      3, this->inputs(i), output);
+  for (unsigned i = 0,
+      n = static_cast<unsigned>(this->_internal_inputs_size()); i < n; i++) {
+    const auto& repfield = this->_internal_inputs(i);
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+        InternalWriteMessage(3, repfield, repfield.GetCachedSize(), target, stream);
   }
-  
+
   // repeated .protobuf.Transaction.Output outputs = 4;
-  for (int i = 0; i < this->outputs_size(); i++) {
-    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      4, this->outputs(i), output);
+  for (unsigned i = 0,
+      n = static_cast<unsigned>(this->_internal_outputs_size()); i < n; i++) {
+    const auto& repfield = this->_internal_outputs(i);
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+        InternalWriteMessage(4, repfield, repfield.GetCachedSize(), target, stream);
   }
-  
+
+  cached_has_bits = _impl_._has_bits_[0];
   // required uint32 version = 5;
-  if (has_version()) {
-    ::google::protobuf::internal::WireFormatLite::WriteUInt32(5, this->version(), output);
+  if (cached_has_bits & 0x00000001u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt32ToArray(5, this->_internal_version(), target);
   }
-  
+
   // required uint32 locktime = 6;
-  if (has_locktime()) {
-    ::google::protobuf::internal::WireFormatLite::WriteUInt32(6, this->locktime(), output);
+  if (cached_has_bits & 0x00000002u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt32ToArray(6, this->_internal_locktime(), target);
   }
-  
+
   // required bool is_coinbase = 7;
-  if (has_is_coinbase()) {
-    ::google::protobuf::internal::WireFormatLite::WriteBool(7, this->is_coinbase(), output);
+  if (cached_has_bits & 0x00000004u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteBoolToArray(7, this->_internal_is_coinbase(), target);
   }
-  
-  if (!unknown_fields().empty()) {
-    ::google::protobuf::internal::WireFormat::SerializeUnknownFields(
-        unknown_fields(), output);
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
   }
+  // @@protoc_insertion_point(serialize_to_array_end:protobuf.Transaction)
+  return target;
 }
 
-::google::protobuf::uint8* Transaction::SerializeWithCachedSizesToArray(
-    ::google::protobuf::uint8* target) const {
-  // repeated .protobuf.Transaction.BlockPointer parent = 1;
-  for (int i = 0; i < this->parent_size(); i++) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        1, this->parent(i), target);
-  }
-  
-  // repeated .protobuf.Transaction.Input inputs = 3;
-  for (int i = 0; i < this->inputs_size(); i++) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        3, this->inputs(i), target);
-  }
-  
-  // repeated .protobuf.Transaction.Output outputs = 4;
-  for (int i = 0; i < this->outputs_size(); i++) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteMessageNoVirtualToArray(
-        4, this->outputs(i), target);
-  }
-  
-  // required uint32 version = 5;
-  if (has_version()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteUInt32ToArray(5, this->version(), target);
-  }
-  
-  // required uint32 locktime = 6;
-  if (has_locktime()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteUInt32ToArray(6, this->locktime(), target);
+size_t Transaction::RequiredFieldsByteSizeFallback() const {
+// @@protoc_insertion_point(required_fields_byte_size_fallback_start:protobuf.Transaction)
+  size_t total_size = 0;
+
+  if (_internal_has_version()) {
+    // required uint32 version = 5;
+    total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_version());
   }
-  
-  // required bool is_coinbase = 7;
-  if (has_is_coinbase()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteBoolToArray(7, this->is_coinbase(), target);
+
+  if (_internal_has_locktime()) {
+    // required uint32 locktime = 6;
+    total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_locktime());
   }
-  
-  if (!unknown_fields().empty()) {
-    target = ::google::protobuf::internal::WireFormat::SerializeUnknownFieldsToArray(
-        unknown_fields(), target);
+
+  if (_internal_has_is_coinbase()) {
+    // required bool is_coinbase = 7;
+    total_size += 1 + 1;
   }
-  return target;
+
+  return total_size;
 }
+size_t Transaction::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:protobuf.Transaction)
+  size_t total_size = 0;
 
-int Transaction::ByteSize() const {
-  int total_size = 0;
-  
-  if (_has_bits_[3 / 32] & (0xffu << (3 % 32))) {
+  if (((_impl_._has_bits_[0] & 0x00000007) ^ 0x00000007) == 0) {  // All required fields are present.
     // required uint32 version = 5;
-    if (has_version()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::UInt32Size(
-          this->version());
-    }
-    
+    total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_version());
+
     // required uint32 locktime = 6;
-    if (has_locktime()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::UInt32Size(
-          this->locktime());
-    }
-    
+    total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_locktime());
+
     // required bool is_coinbase = 7;
-    if (has_is_coinbase()) {
-      total_size += 1 + 1;
-    }
-    
+    total_size += 1 + 1;
+
+  } else {
+    total_size += RequiredFieldsByteSizeFallback();
   }
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
   // repeated .protobuf.Transaction.BlockPointer parent = 1;
-  total_size += 1 * this->parent_size();
-  for (int i = 0; i < this->parent_size(); i++) {
+  total_size += 1UL * this->_internal_parent_size();
+  for (const auto& msg : this->_impl_.parent_) {
     total_size +=
-      ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-        this->parent(i));
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(msg);
   }
-  
+
   // repeated .protobuf.Transaction.Input inputs = 3;
-  total_size += 1 * this->inputs_size();
-  for (int i = 0; i < this->inputs_size(); i++) {
+  total_size += 1UL * this->_internal_inputs_size();
+  for (const auto& msg : this->_impl_.inputs_) {
     total_size +=
-      ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-        this->inputs(i));
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(msg);
   }
-  
+
   // repeated .protobuf.Transaction.Output outputs = 4;
-  total_size += 1 * this->outputs_size();
-  for (int i = 0; i < this->outputs_size(); i++) {
+  total_size += 1UL * this->_internal_outputs_size();
+  for (const auto& msg : this->_impl_.outputs_) {
     total_size +=
-      ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-        this->outputs(i));
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(msg);
   }
-  
-  if (!unknown_fields().empty()) {
-    total_size +=
-      ::google::protobuf::internal::WireFormat::ComputeUnknownFieldsSize(
-        unknown_fields());
-  }
-  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
-  _cached_size_ = total_size;
-  GOOGLE_SAFE_CONCURRENT_WRITES_END();
-  return total_size;
-}
 
-void Transaction::MergeFrom(const ::google::protobuf::Message& from) {
-  GOOGLE_CHECK_NE(&from, this);
-  const Transaction* source =
-    ::google::protobuf::internal::dynamic_cast_if_available<const Transaction*>(
-      &from);
-  if (source == NULL) {
-    ::google::protobuf::internal::ReflectionOps::Merge(from, this);
-  } else {
-    MergeFrom(*source);
-  }
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
 }
 
-void Transaction::MergeFrom(const Transaction& from) {
-  GOOGLE_CHECK_NE(&from, this);
-  parent_.MergeFrom(from.parent_);
-  inputs_.MergeFrom(from.inputs_);
-  outputs_.MergeFrom(from.outputs_);
-  if (from._has_bits_[3 / 32] & (0xffu << (3 % 32))) {
-    if (from.has_version()) {
-      set_version(from.version());
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData Transaction::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    Transaction::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*Transaction::GetClassData() const { return &_class_data_; }
+
+
+void Transaction::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<Transaction*>(&to_msg);
+  auto& from = static_cast<const Transaction&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:protobuf.Transaction)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  _this->_impl_.parent_.MergeFrom(from._impl_.parent_);
+  _this->_impl_.inputs_.MergeFrom(from._impl_.inputs_);
+  _this->_impl_.outputs_.MergeFrom(from._impl_.outputs_);
+  cached_has_bits = from._impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000007u) {
+    if (cached_has_bits & 0x00000001u) {
+      _this->_impl_.version_ = from._impl_.version_;
     }
-    if (from.has_locktime()) {
-      set_locktime(from.locktime());
+    if (cached_has_bits & 0x00000002u) {
+      _this->_impl_.locktime_ = from._impl_.locktime_;
     }
-    if (from.has_is_coinbase()) {
-      set_is_coinbase(from.is_coinbase());
+    if (cached_has_bits & 0x00000004u) {
+      _this->_impl_.is_coinbase_ = from._impl_.is_coinbase_;
     }
+    _this->_impl_._has_bits_[0] |= cached_has_bits;
   }
-  mutable_unknown_fields()->MergeFrom(from.unknown_fields());
-}
-
-void Transaction::CopyFrom(const ::google::protobuf::Message& from) {
-  if (&from == this) return;
-  Clear();
-  MergeFrom(from);
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
 }
 
 void Transaction::CopyFrom(const Transaction& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:protobuf.Transaction)
   if (&from == this) return;
   Clear();
   MergeFrom(from);
 }
 
 bool Transaction::IsInitialized() const {
-  if ((_has_bits_[0] & 0x00000038) != 0x00000038) return false;
-  
-  for (int i = 0; i < parent_size(); i++) {
-    if (!this->parent(i).IsInitialized()) return false;
-  }
-  for (int i = 0; i < inputs_size(); i++) {
-    if (!this->inputs(i).IsInitialized()) return false;
-  }
-  for (int i = 0; i < outputs_size(); i++) {
-    if (!this->outputs(i).IsInitialized()) return false;
-  }
+  if (_Internal::MissingRequiredFields(_impl_._has_bits_)) return false;
+  if (!::PROTOBUF_NAMESPACE_ID::internal::AllAreInitialized(_impl_.parent_))
+    return false;
+  if (!::PROTOBUF_NAMESPACE_ID::internal::AllAreInitialized(_impl_.inputs_))
+    return false;
+  if (!::PROTOBUF_NAMESPACE_ID::internal::AllAreInitialized(_impl_.outputs_))
+    return false;
   return true;
 }
 
-void Transaction::Swap(Transaction* other) {
-  if (other != this) {
-    parent_.Swap(&other->parent_);
-    inputs_.Swap(&other->inputs_);
-    outputs_.Swap(&other->outputs_);
-    std::swap(version_, other->version_);
-    std::swap(locktime_, other->locktime_);
-    std::swap(is_coinbase_, other->is_coinbase_);
-    std::swap(_has_bits_[0], other->_has_bits_[0]);
-    _unknown_fields_.Swap(&other->_unknown_fields_);
-    std::swap(_cached_size_, other->_cached_size_);
-  }
+void Transaction::InternalSwap(Transaction* other) {
+  using std::swap;
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  _impl_.parent_.InternalSwap(&other->_impl_.parent_);
+  _impl_.inputs_.InternalSwap(&other->_impl_.inputs_);
+  _impl_.outputs_.InternalSwap(&other->_impl_.outputs_);
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(Transaction, _impl_.is_coinbase_)
+      + sizeof(Transaction::_impl_.is_coinbase_)
+      - PROTOBUF_FIELD_OFFSET(Transaction, _impl_.version_)>(
+          reinterpret_cast<char*>(&_impl_.version_),
+          reinterpret_cast<char*>(&other->_impl_.version_));
 }
 
-::google::protobuf::Metadata Transaction::GetMetadata() const {
-  protobuf_AssignDescriptorsOnce();
-  ::google::protobuf::Metadata metadata;
-  metadata.descriptor = Transaction_descriptor_;
-  metadata.reflection = Transaction_reflection_;
-  return metadata;
+::PROTOBUF_NAMESPACE_ID::Metadata Transaction::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_bitcoin_2eproto_getter, &descriptor_table_bitcoin_2eproto_once,
+      file_level_metadata_bitcoin_2eproto[4]);
 }
 
-
 // @@protoc_insertion_point(namespace_scope)
-
 }  // namespace protobuf
+PROTOBUF_NAMESPACE_OPEN
+template<> PROTOBUF_NOINLINE ::protobuf::Block*
+Arena::CreateMaybeMessage< ::protobuf::Block >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::protobuf::Block >(arena);
+}
+template<> PROTOBUF_NOINLINE ::protobuf::Transaction_BlockPointer*
+Arena::CreateMaybeMessage< ::protobuf::Transaction_BlockPointer >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::protobuf::Transaction_BlockPointer >(arena);
+}
+template<> PROTOBUF_NOINLINE ::protobuf::Transaction_Input*
+Arena::CreateMaybeMessage< ::protobuf::Transaction_Input >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::protobuf::Transaction_Input >(arena);
+}
+template<> PROTOBUF_NOINLINE ::protobuf::Transaction_Output*
+Arena::CreateMaybeMessage< ::protobuf::Transaction_Output >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::protobuf::Transaction_Output >(arena);
+}
+template<> PROTOBUF_NOINLINE ::protobuf::Transaction*
+Arena::CreateMaybeMessage< ::protobuf::Transaction >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::protobuf::Transaction >(arena);
+}
+PROTOBUF_NAMESPACE_CLOSE
 
 // @@protoc_insertion_point(global_scope)
+#include <google/protobuf/port_undef.inc>
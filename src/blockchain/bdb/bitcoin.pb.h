@@ -1,938 +1,1531 @@
 // Generated by the protocol buffer compiler.  DO NOT EDIT!
 // source: bitcoin.proto
 
-#ifndef PROTOBUF_bitcoin_2eproto__INCLUDED
-#define PROTOBUF_bitcoin_2eproto__INCLUDED
+#ifndef GOOGLE_PROTOBUF_INCLUDED_bitcoin_2eproto
+#define GOOGLE_PROTOBUF_INCLUDED_bitcoin_2eproto
 
+#include <limits>
 #include <string>
 
-#include <google/protobuf/stubs/common.h>
-
-#if GOOGLE_PROTOBUF_VERSION < 2004000
+#include <google/protobuf/port_def.inc>
+#if PROTOBUF_VERSION < 3021000
 #error This file was generated by a newer version of protoc which is
-#error incompatible with your Protocol Buffer headers.  Please update
+#error incompatible with your Protocol Buffer headers. Please update
 #error your headers.
 #endif
-#if 2004000 < GOOGLE_PROTOBUF_MIN_PROTOC_VERSION
+#if 3021012 < PROTOBUF_MIN_PROTOC_VERSION
 #error This file was generated by an older version of protoc which is
-#error incompatible with your Protocol Buffer headers.  Please
+#error incompatible with your Protocol Buffer headers. Please
 #error regenerate this file with a newer version of protoc.
 #endif
 
+#include <google/protobuf/port_undef.inc>
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/arena.h>
+#include <google/protobuf/arenastring.h>
 #include <google/protobuf/generated_message_util.h>
-#include <google/protobuf/repeated_field.h>
-#include <google/protobuf/extension_set.h>
+#include <google/protobuf/metadata_lite.h>
 #include <google/protobuf/generated_message_reflection.h>
+#include <google/protobuf/message.h>
+#include <google/protobuf/repeated_field.h>  // IWYU pragma: export
+#include <google/protobuf/extension_set.h>  // IWYU pragma: export
+#include <google/protobuf/unknown_field_set.h>
 // @@protoc_insertion_point(includes)
+#include <google/protobuf/port_def.inc>
+#define PROTOBUF_INTERNAL_EXPORT_bitcoin_2eproto
+PROTOBUF_NAMESPACE_OPEN
+namespace internal {
+class AnyMetadata;
+}  // namespace internal
+PROTOBUF_NAMESPACE_CLOSE
 
+// Internal implementation detail -- do not use these members.
+struct TableStruct_bitcoin_2eproto {
+  static const uint32_t offsets[];
+};
+extern const ::PROTOBUF_NAMESPACE_ID::internal::DescriptorTable descriptor_table_bitcoin_2eproto;
 namespace protobuf {
-
-// Internal implementation detail -- do not call these.
-void  protobuf_AddDesc_bitcoin_2eproto();
-void protobuf_AssignDesc_bitcoin_2eproto();
-void protobuf_ShutdownFile_bitcoin_2eproto();
-
 class Block;
+struct BlockDefaultTypeInternal;
+extern BlockDefaultTypeInternal _Block_default_instance_;
 class Transaction;
+struct TransactionDefaultTypeInternal;
+extern TransactionDefaultTypeInternal _Transaction_default_instance_;
 class Transaction_BlockPointer;
+struct Transaction_BlockPointerDefaultTypeInternal;
+extern Transaction_BlockPointerDefaultTypeInternal _Transaction_BlockPointer_default_instance_;
 class Transaction_Input;
+struct Transaction_InputDefaultTypeInternal;
+extern Transaction_InputDefaultTypeInternal _Transaction_Input_default_instance_;
 class Transaction_Output;
+struct Transaction_OutputDefaultTypeInternal;
+extern Transaction_OutputDefaultTypeInternal _Transaction_Output_default_instance_;
+}  // namespace protobuf
+PROTOBUF_NAMESPACE_OPEN
+template<> ::protobuf::Block* Arena::CreateMaybeMessage<::protobuf::Block>(Arena*);
+template<> ::protobuf::Transaction* Arena::CreateMaybeMessage<::protobuf::Transaction>(Arena*);
+template<> ::protobuf::Transaction_BlockPointer* Arena::CreateMaybeMessage<::protobuf::Transaction_BlockPointer>(Arena*);
+template<> ::protobuf::Transaction_Input* Arena::CreateMaybeMessage<::protobuf::Transaction_Input>(Arena*);
+template<> ::protobuf::Transaction_Output* Arena::CreateMaybeMessage<::protobuf::Transaction_Output>(Arena*);
+PROTOBUF_NAMESPACE_CLOSE
+namespace protobuf {
 
 // ===================================================================
 
-class Block : public ::google::protobuf::Message {
+class Block final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:protobuf.Block) */ {
  public:
-  Block();
-  virtual ~Block();
-  
+  inline Block() : Block(nullptr) {}
+  ~Block() override;
+  explicit PROTOBUF_CONSTEXPR Block(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
   Block(const Block& from);
-  
+  Block(Block&& from) noexcept
+    : Block() {
+    *this = ::std::move(from);
+  }
+
   inline Block& operator=(const Block& from) {
     CopyFrom(from);
     return *this;
   }
-  
-  inline const ::google::protobuf::UnknownFieldSet& unknown_fields() const {
-    return _unknown_fields_;
+  inline Block& operator=(Block&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const Block& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const Block* internal_default_instance() {
+    return reinterpret_cast<const Block*>(
+               &_Block_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    0;
+
+  friend void swap(Block& a, Block& b) {
+    a.Swap(&b);
   }
-  
-  inline ::google::protobuf::UnknownFieldSet* mutable_unknown_fields() {
-    return &_unknown_fields_;
+  inline void Swap(Block* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
   }
-  
-  static const ::google::protobuf::Descriptor* descriptor();
-  static const Block& default_instance();
-  
-  void Swap(Block* other);
-  
+  void UnsafeArenaSwap(Block* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
   // implements Message ----------------------------------------------
-  
-  Block* New() const;
-  void CopyFrom(const ::google::protobuf::Message& from);
-  void MergeFrom(const ::google::protobuf::Message& from);
+
+  Block* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<Block>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
   void CopyFrom(const Block& from);
-  void MergeFrom(const Block& from);
-  void Clear();
-  bool IsInitialized() const;
-  
-  int ByteSize() const;
-  bool MergePartialFromCodedStream(
-      ::google::protobuf::io::CodedInputStream* input);
-  void SerializeWithCachedSizes(
-      ::google::protobuf::io::CodedOutputStream* output) const;
-  ::google::protobuf::uint8* SerializeWithCachedSizesToArray(::google::protobuf::uint8* output) const;
-  int GetCachedSize() const { return _cached_size_; }
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const Block& from) {
+    Block::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
   private:
-  void SharedCtor();
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
   void SharedDtor();
-  void SetCachedSize(int size) const;
+  void SetCachedSize(int size) const final;
+  void InternalSwap(Block* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "protobuf.Block";
+  }
+  protected:
+  explicit Block(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
   public:
-  
-  ::google::protobuf::Metadata GetMetadata() const;
-  
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
   // nested types ----------------------------------------------------
-  
+
   // accessors -------------------------------------------------------
-  
-  // required uint32 depth = 2;
-  inline bool has_depth() const;
-  inline void clear_depth();
-  static const int kDepthFieldNumber = 2;
-  inline ::google::protobuf::uint32 depth() const;
-  inline void set_depth(::google::protobuf::uint32 value);
-  
-  // required uint32 version = 6;
-  inline bool has_version() const;
-  inline void clear_version();
-  static const int kVersionFieldNumber = 6;
-  inline ::google::protobuf::uint32 version() const;
-  inline void set_version(::google::protobuf::uint32 value);
-  
+
+  enum : int {
+    kTransactionsFieldNumber = 13,
+    kPreviousBlockHashFieldNumber = 7,
+    kMerkleFieldNumber = 8,
+    kDepthFieldNumber = 2,
+    kVersionFieldNumber = 6,
+    kTimestampFieldNumber = 9,
+    kBitsFieldNumber = 10,
+    kNonceFieldNumber = 11,
+  };
+  // repeated uint32 transactions = 13 [packed = true];
+  int transactions_size() const;
+  private:
+  int _internal_transactions_size() const;
+  public:
+  void clear_transactions();
+  private:
+  uint32_t _internal_transactions(int index) const;
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >&
+      _internal_transactions() const;
+  void _internal_add_transactions(uint32_t value);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >*
+      _internal_mutable_transactions();
+  public:
+  uint32_t transactions(int index) const;
+  void set_transactions(int index, uint32_t value);
+  void add_transactions(uint32_t value);
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >&
+      transactions() const;
+  ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >*
+      mutable_transactions();
+
   // required bytes previous_block_hash = 7;
-  inline bool has_previous_block_hash() const;
-  inline void clear_previous_block_hash();
-  static const int kPreviousBlockHashFieldNumber = 7;
-  inline const ::std::string& previous_block_hash() const;
-  inline void set_previous_block_hash(const ::std::string& value);
-  inline void set_previous_block_hash(const char* value);
-  inline void set_previous_block_hash(const void* value, size_t size);
-  inline ::std::string* mutable_previous_block_hash();
-  inline ::std::string* release_previous_block_hash();
-  
+  bool has_previous_block_hash() const;
+  private:
+  bool _internal_has_previous_block_hash() const;
+  public:
+  void clear_previous_block_hash();
+  const std::string& previous_block_hash() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_previous_block_hash(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_previous_block_hash();
+  PROTOBUF_NODISCARD std::string* release_previous_block_hash();
+  void set_allocated_previous_block_hash(std::string* previous_block_hash);
+  private:
+  const std::string& _internal_previous_block_hash() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_previous_block_hash(const std::string& value);
+  std::string* _internal_mutable_previous_block_hash();
+  public:
+
   // required bytes merkle = 8;
-  inline bool has_merkle() const;
-  inline void clear_merkle();
-  static const int kMerkleFieldNumber = 8;
-  inline const ::std::string& merkle() const;
-  inline void set_merkle(const ::std::string& value);
-  inline void set_merkle(const char* value);
-  inline void set_merkle(const void* value, size_t size);
-  inline ::std::string* mutable_merkle();
-  inline ::std::string* release_merkle();
-  
+  bool has_merkle() const;
+  private:
+  bool _internal_has_merkle() const;
+  public:
+  void clear_merkle();
+  const std::string& merkle() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_merkle(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_merkle();
+  PROTOBUF_NODISCARD std::string* release_merkle();
+  void set_allocated_merkle(std::string* merkle);
+  private:
+  const std::string& _internal_merkle() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_merkle(const std::string& value);
+  std::string* _internal_mutable_merkle();
+  public:
+
+  // required uint32 depth = 2;
+  bool has_depth() const;
+  private:
+  bool _internal_has_depth() const;
+  public:
+  void clear_depth();
+  uint32_t depth() const;
+  void set_depth(uint32_t value);
+  private:
+  uint32_t _internal_depth() const;
+  void _internal_set_depth(uint32_t value);
+  public:
+
+  // required uint32 version = 6;
+  bool has_version() const;
+  private:
+  bool _internal_has_version() const;
+  public:
+  void clear_version();
+  uint32_t version() const;
+  void set_version(uint32_t value);
+  private:
+  uint32_t _internal_version() const;
+  void _internal_set_version(uint32_t value);
+  public:
+
   // required uint32 timestamp = 9;
-  inline bool has_timestamp() const;
-  inline void clear_timestamp();
-  static const int kTimestampFieldNumber = 9;
-  inline ::google::protobuf::uint32 timestamp() const;
-  inline void set_timestamp(::google::protobuf::uint32 value);
-  
+  bool has_timestamp() const;
+  private:
+  bool _internal_has_timestamp() const;
+  public:
+  void clear_timestamp();
+  uint32_t timestamp() const;
+  void set_timestamp(uint32_t value);
+  private:
+  uint32_t _internal_timestamp() const;
+  void _internal_set_timestamp(uint32_t value);
+  public:
+
   // required uint32 bits = 10;
-  inline bool has_bits() const;
-  inline void clear_bits();
-  static const int kBitsFieldNumber = 10;
-  inline ::google::protobuf::uint32 bits() const;
-  inline void set_bits(::google::protobuf::uint32 value);
-  
+  bool has_bits() const;
+  private:
+  bool _internal_has_bits() const;
+  public:
+  void clear_bits();
+  uint32_t bits() const;
+  void set_bits(uint32_t value);
+  private:
+  uint32_t _internal_bits() const;
+  void _internal_set_bits(uint32_t value);
+  public:
+
   // required uint32 nonce = 11;
-  inline bool has_nonce() const;
-  inline void clear_nonce();
-  static const int kNonceFieldNumber = 11;
-  inline ::google::protobuf::uint32 nonce() const;
-  inline void set_nonce(::google::protobuf::uint32 value);
-  
-  // repeated bytes transactions = 12;
-  inline int transactions_size() const;
-  inline void clear_transactions();
-  static const int kTransactionsFieldNumber = 12;
-  inline const ::std::string& transactions(int index) const;
-  inline ::std::string* mutable_transactions(int index);
-  inline void set_transactions(int index, const ::std::string& value);
-  inline void set_transactions(int index, const char* value);
-  inline void set_transactions(int index, const void* value, size_t size);
-  inline ::std::string* add_transactions();
-  inline void add_transactions(const ::std::string& value);
-  inline void add_transactions(const char* value);
-  inline void add_transactions(const void* value, size_t size);
-  inline const ::google::protobuf::RepeatedPtrField< ::std::string>& transactions() const;
-  inline ::google::protobuf::RepeatedPtrField< ::std::string>* mutable_transactions();
-  
+  bool has_nonce() const;
+  private:
+  bool _internal_has_nonce() const;
+  public:
+  void clear_nonce();
+  uint32_t nonce() const;
+  void set_nonce(uint32_t value);
+  private:
+  uint32_t _internal_nonce() const;
+  void _internal_set_nonce(uint32_t value);
+  public:
+
   // @@protoc_insertion_point(class_scope:protobuf.Block)
  private:
-  inline void set_has_depth();
-  inline void clear_has_depth();
-  inline void set_has_version();
-  inline void clear_has_version();
-  inline void set_has_previous_block_hash();
-  inline void clear_has_previous_block_hash();
-  inline void set_has_merkle();
-  inline void clear_has_merkle();
-  inline void set_has_timestamp();
-  inline void clear_has_timestamp();
-  inline void set_has_bits();
-  inline void clear_has_bits();
-  inline void set_has_nonce();
-  inline void clear_has_nonce();
-  
-  ::google::protobuf::UnknownFieldSet _unknown_fields_;
-  
-  ::google::protobuf::uint32 depth_;
-  ::google::protobuf::uint32 version_;
-  ::std::string* previous_block_hash_;
-  ::std::string* merkle_;
-  ::google::protobuf::uint32 timestamp_;
-  ::google::protobuf::uint32 bits_;
-  ::google::protobuf::RepeatedPtrField< ::std::string> transactions_;
-  ::google::protobuf::uint32 nonce_;
-  
-  mutable int _cached_size_;
-  ::google::protobuf::uint32 _has_bits_[(8 + 31) / 32];
-  
-  friend void  protobuf_AddDesc_bitcoin_2eproto();
-  friend void protobuf_AssignDesc_bitcoin_2eproto();
-  friend void protobuf_ShutdownFile_bitcoin_2eproto();
-  
-  void InitAsDefaultInstance();
-  static Block* default_instance_;
+  class _Internal;
+
+  // helper for ByteSizeLong()
+  size_t RequiredFieldsByteSizeFallback() const;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t > transactions_;
+    mutable std::atomic<int> _transactions_cached_byte_size_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr previous_block_hash_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr merkle_;
+    uint32_t depth_;
+    uint32_t version_;
+    uint32_t timestamp_;
+    uint32_t bits_;
+    uint32_t nonce_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_bitcoin_2eproto;
 };
 // -------------------------------------------------------------------
 
-class Transaction_BlockPointer : public ::google::protobuf::Message {
+class Transaction_BlockPointer final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:protobuf.Transaction.BlockPointer) */ {
  public:
-  Transaction_BlockPointer();
-  virtual ~Transaction_BlockPointer();
-  
+  inline Transaction_BlockPointer() : Transaction_BlockPointer(nullptr) {}
+  ~Transaction_BlockPointer() override;
+  explicit PROTOBUF_CONSTEXPR Transaction_BlockPointer(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
   Transaction_BlockPointer(const Transaction_BlockPointer& from);
-  
+  Transaction_BlockPointer(Transaction_BlockPointer&& from) noexcept
+    : Transaction_BlockPointer() {
+    *this = ::std::move(from);
+  }
+
   inline Transaction_BlockPointer& operator=(const Transaction_BlockPointer& from) {
     CopyFrom(from);
     return *this;
   }
-  
-  inline const ::google::protobuf::UnknownFieldSet& unknown_fields() const {
-    return _unknown_fields_;
+  inline Transaction_BlockPointer& operator=(Transaction_BlockPointer&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
   }
-  
-  inline ::google::protobuf::UnknownFieldSet* mutable_unknown_fields() {
-    return &_unknown_fields_;
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const Transaction_BlockPointer& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const Transaction_BlockPointer* internal_default_instance() {
+    return reinterpret_cast<const Transaction_BlockPointer*>(
+               &_Transaction_BlockPointer_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    1;
+
+  friend void swap(Transaction_BlockPointer& a, Transaction_BlockPointer& b) {
+    a.Swap(&b);
   }
-  
-  static const ::google::protobuf::Descriptor* descriptor();
-  static const Transaction_BlockPointer& default_instance();
-  
-  void Swap(Transaction_BlockPointer* other);
-  
+  inline void Swap(Transaction_BlockPointer* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(Transaction_BlockPointer* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
   // implements Message ----------------------------------------------
-  
-  Transaction_BlockPointer* New() const;
-  void CopyFrom(const ::google::protobuf::Message& from);
-  void MergeFrom(const ::google::protobuf::Message& from);
+
+  Transaction_BlockPointer* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<Transaction_BlockPointer>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
   void CopyFrom(const Transaction_BlockPointer& from);
-  void MergeFrom(const Transaction_BlockPointer& from);
-  void Clear();
-  bool IsInitialized() const;
-  
-  int ByteSize() const;
-  bool MergePartialFromCodedStream(
-      ::google::protobuf::io::CodedInputStream* input);
-  void SerializeWithCachedSizes(
-      ::google::protobuf::io::CodedOutputStream* output) const;
-  ::google::protobuf::uint8* SerializeWithCachedSizesToArray(::google::protobuf::uint8* output) const;
-  int GetCachedSize() const { return _cached_size_; }
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const Transaction_BlockPointer& from) {
+    Transaction_BlockPointer::MergeImpl(*this, from);
+  }
   private:
-  void SharedCtor();
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
   void SharedDtor();
-  void SetCachedSize(int size) const;
+  void SetCachedSize(int size) const final;
+  void InternalSwap(Transaction_BlockPointer* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "protobuf.Transaction.BlockPointer";
+  }
+  protected:
+  explicit Transaction_BlockPointer(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
   public:
-  
-  ::google::protobuf::Metadata GetMetadata() const;
-  
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
   // nested types ----------------------------------------------------
-  
+
   // accessors -------------------------------------------------------
-  
+
+  enum : int {
+    kDepthFieldNumber = 1,
+    kIndexFieldNumber = 2,
+  };
   // required uint32 depth = 1;
-  inline bool has_depth() const;
-  inline void clear_depth();
-  static const int kDepthFieldNumber = 1;
-  inline ::google::protobuf::uint32 depth() const;
-  inline void set_depth(::google::protobuf::uint32 value);
-  
+  bool has_depth() const;
+  private:
+  bool _internal_has_depth() const;
+  public:
+  void clear_depth();
+  uint32_t depth() const;
+  void set_depth(uint32_t value);
+  private:
+  uint32_t _internal_depth() const;
+  void _internal_set_depth(uint32_t value);
+  public:
+
   // required uint32 index = 2;
-  inline bool has_index() const;
-  inline void clear_index();
-  static const int kIndexFieldNumber = 2;
-  inline ::google::protobuf::uint32 index() const;
-  inline void set_index(::google::protobuf::uint32 value);
-  
+  bool has_index() const;
+  private:
+  bool _internal_has_index() const;
+  public:
+  void clear_index();
+  uint32_t index() const;
+  void set_index(uint32_t value);
+  private:
+  uint32_t _internal_index() const;
+  void _internal_set_index(uint32_t value);
+  public:
+
   // @@protoc_insertion_point(class_scope:protobuf.Transaction.BlockPointer)
  private:
-  inline void set_has_depth();
-  inline void clear_has_depth();
-  inline void set_has_index();
-  inline void clear_has_index();
-  
-  ::google::protobuf::UnknownFieldSet _unknown_fields_;
-  
-  ::google::protobuf::uint32 depth_;
-  ::google::protobuf::uint32 index_;
-  
-  mutable int _cached_size_;
-  ::google::protobuf::uint32 _has_bits_[(2 + 31) / 32];
-  
-  friend void  protobuf_AddDesc_bitcoin_2eproto();
-  friend void protobuf_AssignDesc_bitcoin_2eproto();
-  friend void protobuf_ShutdownFile_bitcoin_2eproto();
-  
-  void InitAsDefaultInstance();
-  static Transaction_BlockPointer* default_instance_;
+  class _Internal;
+
+  // helper for ByteSizeLong()
+  size_t RequiredFieldsByteSizeFallback() const;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    uint32_t depth_;
+    uint32_t index_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_bitcoin_2eproto;
 };
 // -------------------------------------------------------------------
 
-class Transaction_Input : public ::google::protobuf::Message {
+class Transaction_Input final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:protobuf.Transaction.Input) */ {
  public:
-  Transaction_Input();
-  virtual ~Transaction_Input();
-  
+  inline Transaction_Input() : Transaction_Input(nullptr) {}
+  ~Transaction_Input() override;
+  explicit PROTOBUF_CONSTEXPR Transaction_Input(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
   Transaction_Input(const Transaction_Input& from);
-  
+  Transaction_Input(Transaction_Input&& from) noexcept
+    : Transaction_Input() {
+    *this = ::std::move(from);
+  }
+
   inline Transaction_Input& operator=(const Transaction_Input& from) {
     CopyFrom(from);
     return *this;
   }
-  
-  inline const ::google::protobuf::UnknownFieldSet& unknown_fields() const {
-    return _unknown_fields_;
+  inline Transaction_Input& operator=(Transaction_Input&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
   }
-  
-  inline ::google::protobuf::UnknownFieldSet* mutable_unknown_fields() {
-    return &_unknown_fields_;
+  static const Transaction_Input& default_instance() {
+    return *internal_default_instance();
   }
-  
-  static const ::google::protobuf::Descriptor* descriptor();
-  static const Transaction_Input& default_instance();
-  
-  void Swap(Transaction_Input* other);
-  
+  static inline const Transaction_Input* internal_default_instance() {
+    return reinterpret_cast<const Transaction_Input*>(
+               &_Transaction_Input_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    2;
+
+  friend void swap(Transaction_Input& a, Transaction_Input& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(Transaction_Input* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(Transaction_Input* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
   // implements Message ----------------------------------------------
-  
-  Transaction_Input* New() const;
-  void CopyFrom(const ::google::protobuf::Message& from);
-  void MergeFrom(const ::google::protobuf::Message& from);
+
+  Transaction_Input* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<Transaction_Input>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
   void CopyFrom(const Transaction_Input& from);
-  void MergeFrom(const Transaction_Input& from);
-  void Clear();
-  bool IsInitialized() const;
-  
-  int ByteSize() const;
-  bool MergePartialFromCodedStream(
-      ::google::protobuf::io::CodedInputStream* input);
-  void SerializeWithCachedSizes(
-      ::google::protobuf::io::CodedOutputStream* output) const;
-  ::google::protobuf::uint8* SerializeWithCachedSizesToArray(::google::protobuf::uint8* output) const;
-  int GetCachedSize() const { return _cached_size_; }
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const Transaction_Input& from) {
+    Transaction_Input::MergeImpl(*this, from);
+  }
   private:
-  void SharedCtor();
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
   void SharedDtor();
-  void SetCachedSize(int size) const;
+  void SetCachedSize(int size) const final;
+  void InternalSwap(Transaction_Input* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "protobuf.Transaction.Input";
+  }
+  protected:
+  explicit Transaction_Input(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
   public:
-  
-  ::google::protobuf::Metadata GetMetadata() const;
-  
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
   // nested types ----------------------------------------------------
-  
+
   // accessors -------------------------------------------------------
-  
+
+  enum : int {
+    kPreviousOutputHashFieldNumber = 1,
+    kScriptFieldNumber = 3,
+    kPreviousOutputIndexFieldNumber = 2,
+    kSequenceFieldNumber = 4,
+  };
   // required bytes previous_output_hash = 1;
-  inline bool has_previous_output_hash() const;
-  inline void clear_previous_output_hash();
-  static const int kPreviousOutputHashFieldNumber = 1;
-  inline const ::std::string& previous_output_hash() const;
-  inline void set_previous_output_hash(const ::std::string& value);
-  inline void set_previous_output_hash(const char* value);
-  inline void set_previous_output_hash(const void* value, size_t size);
-  inline ::std::string* mutable_previous_output_hash();
-  inline ::std::string* release_previous_output_hash();
-  
-  // required uint32 previous_output_index = 2;
-  inline bool has_previous_output_index() const;
-  inline void clear_previous_output_index();
-  static const int kPreviousOutputIndexFieldNumber = 2;
-  inline ::google::protobuf::uint32 previous_output_index() const;
-  inline void set_previous_output_index(::google::protobuf::uint32 value);
-  
+  bool has_previous_output_hash() const;
+  private:
+  bool _internal_has_previous_output_hash() const;
+  public:
+  void clear_previous_output_hash();
+  const std::string& previous_output_hash() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_previous_output_hash(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_previous_output_hash();
+  PROTOBUF_NODISCARD std::string* release_previous_output_hash();
+  void set_allocated_previous_output_hash(std::string* previous_output_hash);
+  private:
+  const std::string& _internal_previous_output_hash() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_previous_output_hash(const std::string& value);
+  std::string* _internal_mutable_previous_output_hash();
+  public:
+
   // required bytes script = 3;
-  inline bool has_script() const;
-  inline void clear_script();
-  static const int kScriptFieldNumber = 3;
-  inline const ::std::string& script() const;
-  inline void set_script(const ::std::string& value);
-  inline void set_script(const char* value);
-  inline void set_script(const void* value, size_t size);
-  inline ::std::string* mutable_script();
-  inline ::std::string* release_script();
-  
+  bool has_script() const;
+  private:
+  bool _internal_has_script() const;
+  public:
+  void clear_script();
+  const std::string& script() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_script(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_script();
+  PROTOBUF_NODISCARD std::string* release_script();
+  void set_allocated_script(std::string* script);
+  private:
+  const std::string& _internal_script() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_script(const std::string& value);
+  std::string* _internal_mutable_script();
+  public:
+
+  // required uint32 previous_output_index = 2;
+  bool has_previous_output_index() const;
+  private:
+  bool _internal_has_previous_output_index() const;
+  public:
+  void clear_previous_output_index();
+  uint32_t previous_output_index() const;
+  void set_previous_output_index(uint32_t value);
+  private:
+  uint32_t _internal_previous_output_index() const;
+  void _internal_set_previous_output_index(uint32_t value);
+  public:
+
   // required uint32 sequence = 4;
-  inline bool has_sequence() const;
-  inline void clear_sequence();
-  static const int kSequenceFieldNumber = 4;
-  inline ::google::protobuf::uint32 sequence() const;
-  inline void set_sequence(::google::protobuf::uint32 value);
-  
+  bool has_sequence() const;
+  private:
+  bool _internal_has_sequence() const;
+  public:
+  void clear_sequence();
+  uint32_t sequence() const;
+  void set_sequence(uint32_t value);
+  private:
+  uint32_t _internal_sequence() const;
+  void _internal_set_sequence(uint32_t value);
+  public:
+
   // @@protoc_insertion_point(class_scope:protobuf.Transaction.Input)
  private:
-  inline void set_has_previous_output_hash();
-  inline void clear_has_previous_output_hash();
-  inline void set_has_previous_output_index();
-  inline void clear_has_previous_output_index();
-  inline void set_has_script();
-  inline void clear_has_script();
-  inline void set_has_sequence();
-  inline void clear_has_sequence();
-  
-  ::google::protobuf::UnknownFieldSet _unknown_fields_;
-  
-  ::std::string* previous_output_hash_;
-  ::std::string* script_;
-  ::google::protobuf::uint32 previous_output_index_;
-  ::google::protobuf::uint32 sequence_;
-  
-  mutable int _cached_size_;
-  ::google::protobuf::uint32 _has_bits_[(4 + 31) / 32];
-  
-  friend void  protobuf_AddDesc_bitcoin_2eproto();
-  friend void protobuf_AssignDesc_bitcoin_2eproto();
-  friend void protobuf_ShutdownFile_bitcoin_2eproto();
-  
-  void InitAsDefaultInstance();
-  static Transaction_Input* default_instance_;
+  class _Internal;
+
+  // helper for ByteSizeLong()
+  size_t RequiredFieldsByteSizeFallback() const;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr previous_output_hash_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr script_;
+    uint32_t previous_output_index_;
+    uint32_t sequence_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_bitcoin_2eproto;
 };
 // -------------------------------------------------------------------
 
-class Transaction_Output : public ::google::protobuf::Message {
+class Transaction_Output final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:protobuf.Transaction.Output) */ {
  public:
-  Transaction_Output();
-  virtual ~Transaction_Output();
-  
+  inline Transaction_Output() : Transaction_Output(nullptr) {}
+  ~Transaction_Output() override;
+  explicit PROTOBUF_CONSTEXPR Transaction_Output(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
   Transaction_Output(const Transaction_Output& from);
-  
+  Transaction_Output(Transaction_Output&& from) noexcept
+    : Transaction_Output() {
+    *this = ::std::move(from);
+  }
+
   inline Transaction_Output& operator=(const Transaction_Output& from) {
     CopyFrom(from);
     return *this;
   }
-  
-  inline const ::google::protobuf::UnknownFieldSet& unknown_fields() const {
-    return _unknown_fields_;
+  inline Transaction_Output& operator=(Transaction_Output&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
   }
-  
-  inline ::google::protobuf::UnknownFieldSet* mutable_unknown_fields() {
-    return &_unknown_fields_;
+  static const Transaction_Output& default_instance() {
+    return *internal_default_instance();
   }
-  
-  static const ::google::protobuf::Descriptor* descriptor();
-  static const Transaction_Output& default_instance();
-  
-  void Swap(Transaction_Output* other);
-  
+  static inline const Transaction_Output* internal_default_instance() {
+    return reinterpret_cast<const Transaction_Output*>(
+               &_Transaction_Output_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    3;
+
+  friend void swap(Transaction_Output& a, Transaction_Output& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(Transaction_Output* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(Transaction_Output* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
   // implements Message ----------------------------------------------
-  
-  Transaction_Output* New() const;
-  void CopyFrom(const ::google::protobuf::Message& from);
-  void MergeFrom(const ::google::protobuf::Message& from);
+
+  Transaction_Output* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<Transaction_Output>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
   void CopyFrom(const Transaction_Output& from);
-  void MergeFrom(const Transaction_Output& from);
-  void Clear();
-  bool IsInitialized() const;
-  
-  int ByteSize() const;
-  bool MergePartialFromCodedStream(
-      ::google::protobuf::io::CodedInputStream* input);
-  void SerializeWithCachedSizes(
-      ::google::protobuf::io::CodedOutputStream* output) const;
-  ::google::protobuf::uint8* SerializeWithCachedSizesToArray(::google::protobuf::uint8* output) const;
-  int GetCachedSize() const { return _cached_size_; }
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const Transaction_Output& from) {
+    Transaction_Output::MergeImpl(*this, from);
+  }
   private:
-  void SharedCtor();
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
   void SharedDtor();
-  void SetCachedSize(int size) const;
+  void SetCachedSize(int size) const final;
+  void InternalSwap(Transaction_Output* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "protobuf.Transaction.Output";
+  }
+  protected:
+  explicit Transaction_Output(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
   public:
-  
-  ::google::protobuf::Metadata GetMetadata() const;
-  
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
   // nested types ----------------------------------------------------
-  
+
   // accessors -------------------------------------------------------
-  
-  // required uint64 value = 1;
-  inline bool has_value() const;
-  inline void clear_value();
-  static const int kValueFieldNumber = 1;
-  inline ::google::protobuf::uint64 value() const;
-  inline void set_value(::google::protobuf::uint64 value);
-  
+
+  enum : int {
+    kScriptFieldNumber = 2,
+    kValueFieldNumber = 1,
+  };
   // required bytes script = 2;
-  inline bool has_script() const;
-  inline void clear_script();
-  static const int kScriptFieldNumber = 2;
-  inline const ::std::string& script() const;
-  inline void set_script(const ::std::string& value);
-  inline void set_script(const char* value);
-  inline void set_script(const void* value, size_t size);
-  inline ::std::string* mutable_script();
-  inline ::std::string* release_script();
-  
+  bool has_script() const;
+  private:
+  bool _internal_has_script() const;
+  public:
+  void clear_script();
+  const std::string& script() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_script(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_script();
+  PROTOBUF_NODISCARD std::string* release_script();
+  void set_allocated_script(std::string* script);
+  private:
+  const std::string& _internal_script() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_script(const std::string& value);
+  std::string* _internal_mutable_script();
+  public:
+
+  // required uint64 value = 1;
+  bool has_value() const;
+  private:
+  bool _internal_has_value() const;
+  public:
+  void clear_value();
+  uint64_t value() const;
+  void set_value(uint64_t value);
+  private:
+  uint64_t _internal_value() const;
+  void _internal_set_value(uint64_t value);
+  public:
+
   // @@protoc_insertion_point(class_scope:protobuf.Transaction.Output)
  private:
-  inline void set_has_value();
-  inline void clear_has_value();
-  inline void set_has_script();
-  inline void clear_has_script();
-  
-  ::google::protobuf::UnknownFieldSet _unknown_fields_;
-  
-  ::google::protobuf::uint64 value_;
-  ::std::string* script_;
-  
-  mutable int _cached_size_;
-  ::google::protobuf::uint32 _has_bits_[(2 + 31) / 32];
-  
-  friend void  protobuf_AddDesc_bitcoin_2eproto();
-  friend void protobuf_AssignDesc_bitcoin_2eproto();
-  friend void protobuf_ShutdownFile_bitcoin_2eproto();
-  
-  void InitAsDefaultInstance();
-  static Transaction_Output* default_instance_;
+  class _Internal;
+
+  // helper for ByteSizeLong()
+  size_t RequiredFieldsByteSizeFallback() const;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr script_;
+    uint64_t value_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_bitcoin_2eproto;
 };
 // -------------------------------------------------------------------
 
-class Transaction : public ::google::protobuf::Message {
+class Transaction final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:protobuf.Transaction) */ {
  public:
-  Transaction();
-  virtual ~Transaction();
-  
+  inline Transaction() : Transaction(nullptr) {}
+  ~Transaction() override;
+  explicit PROTOBUF_CONSTEXPR Transaction(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
   Transaction(const Transaction& from);
-  
+  Transaction(Transaction&& from) noexcept
+    : Transaction() {
+    *this = ::std::move(from);
+  }
+
   inline Transaction& operator=(const Transaction& from) {
     CopyFrom(from);
     return *this;
   }
-  
-  inline const ::google::protobuf::UnknownFieldSet& unknown_fields() const {
-    return _unknown_fields_;
+  inline Transaction& operator=(Transaction&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const Transaction& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const Transaction* internal_default_instance() {
+    return reinterpret_cast<const Transaction*>(
+               &_Transaction_default_instance_);
   }
-  
-  inline ::google::protobuf::UnknownFieldSet* mutable_unknown_fields() {
-    return &_unknown_fields_;
+  static constexpr int kIndexInFileMessages =
+    4;
+
+  friend void swap(Transaction& a, Transaction& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(Transaction* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
   }
-  
-  static const ::google::protobuf::Descriptor* descriptor();
-  static const Transaction& default_instance();
-  
-  void Swap(Transaction* other);
-  
+  void UnsafeArenaSwap(Transaction* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
   // implements Message ----------------------------------------------
-  
-  Transaction* New() const;
-  void CopyFrom(const ::google::protobuf::Message& from);
-  void MergeFrom(const ::google::protobuf::Message& from);
+
+  Transaction* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<Transaction>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
   void CopyFrom(const Transaction& from);
-  void MergeFrom(const Transaction& from);
-  void Clear();
-  bool IsInitialized() const;
-  
-  int ByteSize() const;
-  bool MergePartialFromCodedStream(
-      ::google::protobuf::io::CodedInputStream* input);
-  void SerializeWithCachedSizes(
-      ::google::protobuf::io::CodedOutputStream* output) const;
-  ::google::protobuf::uint8* SerializeWithCachedSizesToArray(::google::protobuf::uint8* output) const;
-  int GetCachedSize() const { return _cached_size_; }
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const Transaction& from) {
+    Transaction::MergeImpl(*this, from);
+  }
   private:
-  void SharedCtor();
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
   void SharedDtor();
-  void SetCachedSize(int size) const;
+  void SetCachedSize(int size) const final;
+  void InternalSwap(Transaction* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "protobuf.Transaction";
+  }
+  protected:
+  explicit Transaction(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
   public:
-  
-  ::google::protobuf::Metadata GetMetadata() const;
-  
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
   // nested types ----------------------------------------------------
-  
+
   typedef Transaction_BlockPointer BlockPointer;
   typedef Transaction_Input Input;
   typedef Transaction_Output Output;
-  
+
   // accessors -------------------------------------------------------
-  
+
+  enum : int {
+    kParentFieldNumber = 1,
+    kInputsFieldNumber = 3,
+    kOutputsFieldNumber = 4,
+    kVersionFieldNumber = 5,
+    kLocktimeFieldNumber = 6,
+    kIsCoinbaseFieldNumber = 7,
+  };
   // repeated .protobuf.Transaction.BlockPointer parent = 1;
-  inline int parent_size() const;
-  inline void clear_parent();
-  static const int kParentFieldNumber = 1;
-  inline const ::protobuf::Transaction_BlockPointer& parent(int index) const;
-  inline ::protobuf::Transaction_BlockPointer* mutable_parent(int index);
-  inline ::protobuf::Transaction_BlockPointer* add_parent();
-  inline const ::google::protobuf::RepeatedPtrField< ::protobuf::Transaction_BlockPointer >&
-      parent() const;
-  inline ::google::protobuf::RepeatedPtrField< ::protobuf::Transaction_BlockPointer >*
+  int parent_size() const;
+  private:
+  int _internal_parent_size() const;
+  public:
+  void clear_parent();
+  ::protobuf::Transaction_BlockPointer* mutable_parent(int index);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::protobuf::Transaction_BlockPointer >*
       mutable_parent();
-  
+  private:
+  const ::protobuf::Transaction_BlockPointer& _internal_parent(int index) const;
+  ::protobuf::Transaction_BlockPointer* _internal_add_parent();
+  public:
+  const ::protobuf::Transaction_BlockPointer& parent(int index) const;
+  ::protobuf::Transaction_BlockPointer* add_parent();
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::protobuf::Transaction_BlockPointer >&
+      parent() const;
+
   // repeated .protobuf.Transaction.Input inputs = 3;
-  inline int inputs_size() const;
-  inline void clear_inputs();
-  static const int kInputsFieldNumber = 3;
-  inline const ::protobuf::Transaction_Input& inputs(int index) const;
-  inline ::protobuf::Transaction_Input* mutable_inputs(int index);
-  inline ::protobuf::Transaction_Input* add_inputs();
-  inline const ::google::protobuf::RepeatedPtrField< ::protobuf::Transaction_Input >&
-      inputs() const;
-  inline ::google::protobuf::RepeatedPtrField< ::protobuf::Transaction_Input >*
+  int inputs_size() const;
+  private:
+  int _internal_inputs_size() const;
+  public:
+  void clear_inputs();
+  ::protobuf::Transaction_Input* mutable_inputs(int index);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::protobuf::Transaction_Input >*
       mutable_inputs();
-  
+  private:
+  const ::protobuf::Transaction_Input& _internal_inputs(int index) const;
+  ::protobuf::Transaction_Input* _internal_add_inputs();
+  public:
+  const ::protobuf::Transaction_Input& inputs(int index) const;
+  ::protobuf::Transaction_Input* add_inputs();
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::protobuf::Transaction_Input >&
+      inputs() const;
+
   // repeated .protobuf.Transaction.Output outputs = 4;
-  inline int outputs_size() const;
-  inline void clear_outputs();
-  static const int kOutputsFieldNumber = 4;
-  inline const ::protobuf::Transaction_Output& outputs(int index) const;
-  inline ::protobuf::Transaction_Output* mutable_outputs(int index);
-  inline ::protobuf::Transaction_Output* add_outputs();
-  inline const ::google::protobuf::RepeatedPtrField< ::protobuf::Transaction_Output >&
-      outputs() const;
-  inline ::google::protobuf::RepeatedPtrField< ::protobuf::Transaction_Output >*
+  int outputs_size() const;
+  private:
+  int _internal_outputs_size() const;
+  public:
+  void clear_outputs();
+  ::protobuf::Transaction_Output* mutable_outputs(int index);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::protobuf::Transaction_Output >*
       mutable_outputs();
-  
+  private:
+  const ::protobuf::Transaction_Output& _internal_outputs(int index) const;
+  ::protobuf::Transaction_Output* _internal_add_outputs();
+  public:
+  const ::protobuf::Transaction_Output& outputs(int index) const;
+  ::protobuf::Transaction_Output* add_outputs();
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::protobuf::Transaction_Output >&
+      outputs() const;
+
   // required uint32 version = 5;
-  inline bool has_version() const;
-  inline void clear_version();
-  static const int kVersionFieldNumber = 5;
-  inline ::google::protobuf::uint32 version() const;
-  inline void set_version(::google::protobuf::uint32 value);
-  
+  bool has_version() const;
+  private:
+  bool _internal_has_version() const;
+  public:
+  void clear_version();
+  uint32_t version() const;
+  void set_version(uint32_t value);
+  private:
+  uint32_t _internal_version() const;
+  void _internal_set_version(uint32_t value);
+  public:
+
   // required uint32 locktime = 6;
-  inline bool has_locktime() const;
-  inline void clear_locktime();
-  static const int kLocktimeFieldNumber = 6;
-  inline ::google::protobuf::uint32 locktime() const;
-  inline void set_locktime(::google::protobuf::uint32 value);
-  
+  bool has_locktime() const;
+  private:
+  bool _internal_has_locktime() const;
+  public:
+  void clear_locktime();
+  uint32_t locktime() const;
+  void set_locktime(uint32_t value);
+  private:
+  uint32_t _internal_locktime() const;
+  void _internal_set_locktime(uint32_t value);
+  public:
+
   // required bool is_coinbase = 7;
-  inline bool has_is_coinbase() const;
-  inline void clear_is_coinbase();
-  static const int kIsCoinbaseFieldNumber = 7;
-  inline bool is_coinbase() const;
-  inline void set_is_coinbase(bool value);
-  
+  bool has_is_coinbase() const;
+  private:
+  bool _internal_has_is_coinbase() const;
+  public:
+  void clear_is_coinbase();
+  bool is_coinbase() const;
+  void set_is_coinbase(bool value);
+  private:
+  bool _internal_is_coinbase() const;
+  void _internal_set_is_coinbase(bool value);
+  public:
+
   // @@protoc_insertion_point(class_scope:protobuf.Transaction)
  private:
-  inline void set_has_version();
-  inline void clear_has_version();
-  inline void set_has_locktime();
-  inline void clear_has_locktime();
-  inline void set_has_is_coinbase();
-  inline void clear_has_is_coinbase();
-  
-  ::google::protobuf::UnknownFieldSet _unknown_fields_;
-  
-  ::google::protobuf::RepeatedPtrField< ::protobuf::Transaction_BlockPointer > parent_;
-  ::google::protobuf::RepeatedPtrField< ::protobuf::Transaction_Input > inputs_;
-  ::google::protobuf::RepeatedPtrField< ::protobuf::Transaction_Output > outputs_;
-  ::google::protobuf::uint32 version_;
-  ::google::protobuf::uint32 locktime_;
-  bool is_coinbase_;
-  
-  mutable int _cached_size_;
-  ::google::protobuf::uint32 _has_bits_[(6 + 31) / 32];
-  
-  friend void  protobuf_AddDesc_bitcoin_2eproto();
-  friend void protobuf_AssignDesc_bitcoin_2eproto();
-  friend void protobuf_ShutdownFile_bitcoin_2eproto();
-  
-  void InitAsDefaultInstance();
-  static Transaction* default_instance_;
+  class _Internal;
+
+  // helper for ByteSizeLong()
+  size_t RequiredFieldsByteSizeFallback() const;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::protobuf::Transaction_BlockPointer > parent_;
+    ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::protobuf::Transaction_Input > inputs_;
+    ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::protobuf::Transaction_Output > outputs_;
+    uint32_t version_;
+    uint32_t locktime_;
+    bool is_coinbase_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_bitcoin_2eproto;
 };
 // ===================================================================
 
 
 // ===================================================================
 
+#ifdef __GNUC__
+  #pragma GCC diagnostic push
+  #pragma GCC diagnostic ignored "-Wstrict-aliasing"
+#endif  // __GNUC__
 // Block
 
 // required uint32 depth = 2;
+inline bool Block::_internal_has_depth() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000004u) != 0;
+  return value;
+}
 inline bool Block::has_depth() const {
-  return (_has_bits_[0] & 0x00000001u) != 0;
+  return _internal_has_depth();
 }
-inline void Block::set_has_depth() {
-  _has_bits_[0] |= 0x00000001u;
+inline void Block::clear_depth() {
+  _impl_.depth_ = 0u;
+  _impl_._has_bits_[0] &= ~0x00000004u;
 }
-inline void Block::clear_has_depth() {
-  _has_bits_[0] &= ~0x00000001u;
+inline uint32_t Block::_internal_depth() const {
+  return _impl_.depth_;
 }
-inline void Block::clear_depth() {
-  depth_ = 0u;
-  clear_has_depth();
+inline uint32_t Block::depth() const {
+  // @@protoc_insertion_point(field_get:protobuf.Block.depth)
+  return _internal_depth();
 }
-inline ::google::protobuf::uint32 Block::depth() const {
-  return depth_;
+inline void Block::_internal_set_depth(uint32_t value) {
+  _impl_._has_bits_[0] |= 0x00000004u;
+  _impl_.depth_ = value;
 }
-inline void Block::set_depth(::google::protobuf::uint32 value) {
-  set_has_depth();
-  depth_ = value;
+inline void Block::set_depth(uint32_t value) {
+  _internal_set_depth(value);
+  // @@protoc_insertion_point(field_set:protobuf.Block.depth)
 }
 
 // required uint32 version = 6;
+inline bool Block::_internal_has_version() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000008u) != 0;
+  return value;
+}
 inline bool Block::has_version() const {
-  return (_has_bits_[0] & 0x00000002u) != 0;
+  return _internal_has_version();
 }
-inline void Block::set_has_version() {
-  _has_bits_[0] |= 0x00000002u;
+inline void Block::clear_version() {
+  _impl_.version_ = 0u;
+  _impl_._has_bits_[0] &= ~0x00000008u;
 }
-inline void Block::clear_has_version() {
-  _has_bits_[0] &= ~0x00000002u;
+inline uint32_t Block::_internal_version() const {
+  return _impl_.version_;
 }
-inline void Block::clear_version() {
-  version_ = 0u;
-  clear_has_version();
+inline uint32_t Block::version() const {
+  // @@protoc_insertion_point(field_get:protobuf.Block.version)
+  return _internal_version();
 }
-inline ::google::protobuf::uint32 Block::version() const {
-  return version_;
+inline void Block::_internal_set_version(uint32_t value) {
+  _impl_._has_bits_[0] |= 0x00000008u;
+  _impl_.version_ = value;
 }
-inline void Block::set_version(::google::protobuf::uint32 value) {
-  set_has_version();
-  version_ = value;
+inline void Block::set_version(uint32_t value) {
+  _internal_set_version(value);
+  // @@protoc_insertion_point(field_set:protobuf.Block.version)
 }
 
 // required bytes previous_block_hash = 7;
-inline bool Block::has_previous_block_hash() const {
-  return (_has_bits_[0] & 0x00000004u) != 0;
+inline bool Block::_internal_has_previous_block_hash() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  return value;
 }
-inline void Block::set_has_previous_block_hash() {
-  _has_bits_[0] |= 0x00000004u;
-}
-inline void Block::clear_has_previous_block_hash() {
-  _has_bits_[0] &= ~0x00000004u;
+inline bool Block::has_previous_block_hash() const {
+  return _internal_has_previous_block_hash();
 }
 inline void Block::clear_previous_block_hash() {
-  if (previous_block_hash_ != &::google::protobuf::internal::kEmptyString) {
-    previous_block_hash_->clear();
-  }
-  clear_has_previous_block_hash();
-}
-inline const ::std::string& Block::previous_block_hash() const {
-  return *previous_block_hash_;
-}
-inline void Block::set_previous_block_hash(const ::std::string& value) {
-  set_has_previous_block_hash();
-  if (previous_block_hash_ == &::google::protobuf::internal::kEmptyString) {
-    previous_block_hash_ = new ::std::string;
+  _impl_.previous_block_hash_.ClearToEmpty();
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline const std::string& Block::previous_block_hash() const {
+  // @@protoc_insertion_point(field_get:protobuf.Block.previous_block_hash)
+  return _internal_previous_block_hash();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void Block::set_previous_block_hash(ArgT0&& arg0, ArgT... args) {
+ _impl_._has_bits_[0] |= 0x00000001u;
+ _impl_.previous_block_hash_.SetBytes(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:protobuf.Block.previous_block_hash)
+}
+inline std::string* Block::mutable_previous_block_hash() {
+  std::string* _s = _internal_mutable_previous_block_hash();
+  // @@protoc_insertion_point(field_mutable:protobuf.Block.previous_block_hash)
+  return _s;
+}
+inline const std::string& Block::_internal_previous_block_hash() const {
+  return _impl_.previous_block_hash_.Get();
+}
+inline void Block::_internal_set_previous_block_hash(const std::string& value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.previous_block_hash_.Set(value, GetArenaForAllocation());
+}
+inline std::string* Block::_internal_mutable_previous_block_hash() {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  return _impl_.previous_block_hash_.Mutable(GetArenaForAllocation());
+}
+inline std::string* Block::release_previous_block_hash() {
+  // @@protoc_insertion_point(field_release:protobuf.Block.previous_block_hash)
+  if (!_internal_has_previous_block_hash()) {
+    return nullptr;
   }
-  previous_block_hash_->assign(value);
-}
-inline void Block::set_previous_block_hash(const char* value) {
-  set_has_previous_block_hash();
-  if (previous_block_hash_ == &::google::protobuf::internal::kEmptyString) {
-    previous_block_hash_ = new ::std::string;
-  }
-  previous_block_hash_->assign(value);
-}
-inline void Block::set_previous_block_hash(const void* value, size_t size) {
-  set_has_previous_block_hash();
-  if (previous_block_hash_ == &::google::protobuf::internal::kEmptyString) {
-    previous_block_hash_ = new ::std::string;
+  _impl_._has_bits_[0] &= ~0x00000001u;
+  auto* p = _impl_.previous_block_hash_.Release();
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.previous_block_hash_.IsDefault()) {
+    _impl_.previous_block_hash_.Set("", GetArenaForAllocation());
   }
-  previous_block_hash_->assign(reinterpret_cast<const char*>(value), size);
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  return p;
 }
-inline ::std::string* Block::mutable_previous_block_hash() {
-  set_has_previous_block_hash();
-  if (previous_block_hash_ == &::google::protobuf::internal::kEmptyString) {
-    previous_block_hash_ = new ::std::string;
-  }
-  return previous_block_hash_;
-}
-inline ::std::string* Block::release_previous_block_hash() {
-  clear_has_previous_block_hash();
-  if (previous_block_hash_ == &::google::protobuf::internal::kEmptyString) {
-    return NULL;
+inline void Block::set_allocated_previous_block_hash(std::string* previous_block_hash) {
+  if (previous_block_hash != nullptr) {
+    _impl_._has_bits_[0] |= 0x00000001u;
   } else {
-    ::std::string* temp = previous_block_hash_;
-    previous_block_hash_ = const_cast< ::std::string*>(&::google::protobuf::internal::kEmptyString);
-    return temp;
+    _impl_._has_bits_[0] &= ~0x00000001u;
+  }
+  _impl_.previous_block_hash_.SetAllocated(previous_block_hash, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.previous_block_hash_.IsDefault()) {
+    _impl_.previous_block_hash_.Set("", GetArenaForAllocation());
   }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:protobuf.Block.previous_block_hash)
 }
 
 // required bytes merkle = 8;
-inline bool Block::has_merkle() const {
-  return (_has_bits_[0] & 0x00000008u) != 0;
+inline bool Block::_internal_has_merkle() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
+  return value;
 }
-inline void Block::set_has_merkle() {
-  _has_bits_[0] |= 0x00000008u;
-}
-inline void Block::clear_has_merkle() {
-  _has_bits_[0] &= ~0x00000008u;
+inline bool Block::has_merkle() const {
+  return _internal_has_merkle();
 }
 inline void Block::clear_merkle() {
-  if (merkle_ != &::google::protobuf::internal::kEmptyString) {
-    merkle_->clear();
+  _impl_.merkle_.ClearToEmpty();
+  _impl_._has_bits_[0] &= ~0x00000002u;
+}
+inline const std::string& Block::merkle() const {
+  // @@protoc_insertion_point(field_get:protobuf.Block.merkle)
+  return _internal_merkle();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void Block::set_merkle(ArgT0&& arg0, ArgT... args) {
+ _impl_._has_bits_[0] |= 0x00000002u;
+ _impl_.merkle_.SetBytes(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:protobuf.Block.merkle)
+}
+inline std::string* Block::mutable_merkle() {
+  std::string* _s = _internal_mutable_merkle();
+  // @@protoc_insertion_point(field_mutable:protobuf.Block.merkle)
+  return _s;
+}
+inline const std::string& Block::_internal_merkle() const {
+  return _impl_.merkle_.Get();
+}
+inline void Block::_internal_set_merkle(const std::string& value) {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  _impl_.merkle_.Set(value, GetArenaForAllocation());
+}
+inline std::string* Block::_internal_mutable_merkle() {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  return _impl_.merkle_.Mutable(GetArenaForAllocation());
+}
+inline std::string* Block::release_merkle() {
+  // @@protoc_insertion_point(field_release:protobuf.Block.merkle)
+  if (!_internal_has_merkle()) {
+    return nullptr;
   }
-  clear_has_merkle();
-}
-inline const ::std::string& Block::merkle() const {
-  return *merkle_;
-}
-inline void Block::set_merkle(const ::std::string& value) {
-  set_has_merkle();
-  if (merkle_ == &::google::protobuf::internal::kEmptyString) {
-    merkle_ = new ::std::string;
+  _impl_._has_bits_[0] &= ~0x00000002u;
+  auto* p = _impl_.merkle_.Release();
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.merkle_.IsDefault()) {
+    _impl_.merkle_.Set("", GetArenaForAllocation());
   }
-  merkle_->assign(value);
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  return p;
 }
-inline void Block::set_merkle(const char* value) {
-  set_has_merkle();
-  if (merkle_ == &::google::protobuf::internal::kEmptyString) {
-    merkle_ = new ::std::string;
-  }
-  merkle_->assign(value);
-}
-inline void Block::set_merkle(const void* value, size_t size) {
-  set_has_merkle();
-  if (merkle_ == &::google::protobuf::internal::kEmptyString) {
-    merkle_ = new ::std::string;
-  }
-  merkle_->assign(reinterpret_cast<const char*>(value), size);
-}
-inline ::std::string* Block::mutable_merkle() {
-  set_has_merkle();
-  if (merkle_ == &::google::protobuf::internal::kEmptyString) {
-    merkle_ = new ::std::string;
-  }
-  return merkle_;
-}
-inline ::std::string* Block::release_merkle() {
-  clear_has_merkle();
-  if (merkle_ == &::google::protobuf::internal::kEmptyString) {
-    return NULL;
+inline void Block::set_allocated_merkle(std::string* merkle) {
+  if (merkle != nullptr) {
+    _impl_._has_bits_[0] |= 0x00000002u;
   } else {
-    ::std::string* temp = merkle_;
-    merkle_ = const_cast< ::std::string*>(&::google::protobuf::internal::kEmptyString);
-    return temp;
+    _impl_._has_bits_[0] &= ~0x00000002u;
   }
+  _impl_.merkle_.SetAllocated(merkle, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.merkle_.IsDefault()) {
+    _impl_.merkle_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:protobuf.Block.merkle)
 }
 
 // required uint32 timestamp = 9;
+inline bool Block::_internal_has_timestamp() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000010u) != 0;
+  return value;
+}
 inline bool Block::has_timestamp() const {
-  return (_has_bits_[0] & 0x00000010u) != 0;
+  return _internal_has_timestamp();
 }
-inline void Block::set_has_timestamp() {
-  _has_bits_[0] |= 0x00000010u;
+inline void Block::clear_timestamp() {
+  _impl_.timestamp_ = 0u;
+  _impl_._has_bits_[0] &= ~0x00000010u;
 }
-inline void Block::clear_has_timestamp() {
-  _has_bits_[0] &= ~0x00000010u;
+inline uint32_t Block::_internal_timestamp() const {
+  return _impl_.timestamp_;
 }
-inline void Block::clear_timestamp() {
-  timestamp_ = 0u;
-  clear_has_timestamp();
+inline uint32_t Block::timestamp() const {
+  // @@protoc_insertion_point(field_get:protobuf.Block.timestamp)
+  return _internal_timestamp();
 }
-inline ::google::protobuf::uint32 Block::timestamp() const {
-  return timestamp_;
+inline void Block::_internal_set_timestamp(uint32_t value) {
+  _impl_._has_bits_[0] |= 0x00000010u;
+  _impl_.timestamp_ = value;
 }
-inline void Block::set_timestamp(::google::protobuf::uint32 value) {
-  set_has_timestamp();
-  timestamp_ = value;
+inline void Block::set_timestamp(uint32_t value) {
+  _internal_set_timestamp(value);
+  // @@protoc_insertion_point(field_set:protobuf.Block.timestamp)
 }
 
 // required uint32 bits = 10;
+inline bool Block::_internal_has_bits() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000020u) != 0;
+  return value;
+}
 inline bool Block::has_bits() const {
-  return (_has_bits_[0] & 0x00000020u) != 0;
+  return _internal_has_bits();
 }
-inline void Block::set_has_bits() {
-  _has_bits_[0] |= 0x00000020u;
+inline void Block::clear_bits() {
+  _impl_.bits_ = 0u;
+  _impl_._has_bits_[0] &= ~0x00000020u;
 }
-inline void Block::clear_has_bits() {
-  _has_bits_[0] &= ~0x00000020u;
+inline uint32_t Block::_internal_bits() const {
+  return _impl_.bits_;
 }
-inline void Block::clear_bits() {
-  bits_ = 0u;
-  clear_has_bits();
+inline uint32_t Block::bits() const {
+  // @@protoc_insertion_point(field_get:protobuf.Block.bits)
+  return _internal_bits();
 }
-inline ::google::protobuf::uint32 Block::bits() const {
-  return bits_;
+inline void Block::_internal_set_bits(uint32_t value) {
+  _impl_._has_bits_[0] |= 0x00000020u;
+  _impl_.bits_ = value;
 }
-inline void Block::set_bits(::google::protobuf::uint32 value) {
-  set_has_bits();
-  bits_ = value;
+inline void Block::set_bits(uint32_t value) {
+  _internal_set_bits(value);
+  // @@protoc_insertion_point(field_set:protobuf.Block.bits)
 }
 
 // required uint32 nonce = 11;
+inline bool Block::_internal_has_nonce() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000040u) != 0;
+  return value;
+}
 inline bool Block::has_nonce() const {
-  return (_has_bits_[0] & 0x00000040u) != 0;
+  return _internal_has_nonce();
 }
-inline void Block::set_has_nonce() {
-  _has_bits_[0] |= 0x00000040u;
+inline void Block::clear_nonce() {
+  _impl_.nonce_ = 0u;
+  _impl_._has_bits_[0] &= ~0x00000040u;
 }
-inline void Block::clear_has_nonce() {
-  _has_bits_[0] &= ~0x00000040u;
+inline uint32_t Block::_internal_nonce() const {
+  return _impl_.nonce_;
 }
-inline void Block::clear_nonce() {
-  nonce_ = 0u;
-  clear_has_nonce();
+inline uint32_t Block::nonce() const {
+  // @@protoc_insertion_point(field_get:protobuf.Block.nonce)
+  return _internal_nonce();
 }
-inline ::google::protobuf::uint32 Block::nonce() const {
-  return nonce_;
+inline void Block::_internal_set_nonce(uint32_t value) {
+  _impl_._has_bits_[0] |= 0x00000040u;
+  _impl_.nonce_ = value;
 }
-inline void Block::set_nonce(::google::protobuf::uint32 value) {
-  set_has_nonce();
-  nonce_ = value;
+inline void Block::set_nonce(uint32_t value) {
+  _internal_set_nonce(value);
+  // @@protoc_insertion_point(field_set:protobuf.Block.nonce)
 }
 
-// repeated bytes transactions = 12;
+// repeated uint32 transactions = 13 [packed = true];
+inline int Block::_internal_transactions_size() const {
+  return _impl_.transactions_.size();
+}
 inline int Block::transactions_size() const {
-  return transactions_.size();
+  return _internal_transactions_size();
 }
 inline void Block::clear_transactions() {
-  transactions_.Clear();
-}
-inline const ::std::string& Block::transactions(int index) const {
-  return transactions_.Get(index);
-}
-inline ::std::string* Block::mutable_transactions(int index) {
-  return transactions_.Mutable(index);
-}
-inline void Block::set_transactions(int index, const ::std::string& value) {
-  transactions_.Mutable(index)->assign(value);
+  _impl_.transactions_.Clear();
 }
-inline void Block::set_transactions(int index, const char* value) {
-  transactions_.Mutable(index)->assign(value);
+inline uint32_t Block::_internal_transactions(int index) const {
+  return _impl_.transactions_.Get(index);
 }
-inline void Block::set_transactions(int index, const void* value, size_t size) {
-  transactions_.Mutable(index)->assign(
-    reinterpret_cast<const char*>(value), size);
+inline uint32_t Block::transactions(int index) const {
+  // @@protoc_insertion_point(field_get:protobuf.Block.transactions)
+  return _internal_transactions(index);
 }
-inline ::std::string* Block::add_transactions() {
-  return transactions_.Add();
+inline void Block::set_transactions(int index, uint32_t value) {
+  _impl_.transactions_.Set(index, value);
+  // @@protoc_insertion_point(field_set:protobuf.Block.transactions)
 }
-inline void Block::add_transactions(const ::std::string& value) {
-  transactions_.Add()->assign(value);
+inline void Block::_internal_add_transactions(uint32_t value) {
+  _impl_.transactions_.Add(value);
 }
-inline void Block::add_transactions(const char* value) {
-  transactions_.Add()->assign(value);
+inline void Block::add_transactions(uint32_t value) {
+  _internal_add_transactions(value);
+  // @@protoc_insertion_point(field_add:protobuf.Block.transactions)
 }
-inline void Block::add_transactions(const void* value, size_t size) {
-  transactions_.Add()->assign(reinterpret_cast<const char*>(value), size);
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >&
+Block::_internal_transactions() const {
+  return _impl_.transactions_;
 }
-inline const ::google::protobuf::RepeatedPtrField< ::std::string>&
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >&
 Block::transactions() const {
-  return transactions_;
+  // @@protoc_insertion_point(field_list:protobuf.Block.transactions)
+  return _internal_transactions();
 }
-inline ::google::protobuf::RepeatedPtrField< ::std::string>*
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >*
+Block::_internal_mutable_transactions() {
+  return &_impl_.transactions_;
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >*
 Block::mutable_transactions() {
-  return &transactions_;
+  // @@protoc_insertion_point(field_mutable_list:protobuf.Block.transactions)
+  return _internal_mutable_transactions();
 }
 
 // -------------------------------------------------------------------
@@ -940,47 +1533,59 @@ Block::mutable_transactions() {
 // Transaction_BlockPointer
 
 // required uint32 depth = 1;
+inline bool Transaction_BlockPointer::_internal_has_depth() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  return value;
+}
 inline bool Transaction_BlockPointer::has_depth() const {
-  return (_has_bits_[0] & 0x00000001u) != 0;
+  return _internal_has_depth();
 }
-inline void Transaction_BlockPointer::set_has_depth() {
-  _has_bits_[0] |= 0x00000001u;
+inline void Transaction_BlockPointer::clear_depth() {
+  _impl_.depth_ = 0u;
+  _impl_._has_bits_[0] &= ~0x00000001u;
 }
-inline void Transaction_BlockPointer::clear_has_depth() {
-  _has_bits_[0] &= ~0x00000001u;
+inline uint32_t Transaction_BlockPointer::_internal_depth() const {
+  return _impl_.depth_;
 }
-inline void Transaction_BlockPointer::clear_depth() {
-  depth_ = 0u;
-  clear_has_depth();
+inline uint32_t Transaction_BlockPointer::depth() const {
+  // @@protoc_insertion_point(field_get:protobuf.Transaction.BlockPointer.depth)
+  return _internal_depth();
 }
-inline ::google::protobuf::uint32 Transaction_BlockPointer::depth() const {
-  return depth_;
+inline void Transaction_BlockPointer::_internal_set_depth(uint32_t value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.depth_ = value;
 }
-inline void Transaction_BlockPointer::set_depth(::google::protobuf::uint32 value) {
-  set_has_depth();
-  depth_ = value;
+inline void Transaction_BlockPointer::set_depth(uint32_t value) {
+  _internal_set_depth(value);
+  // @@protoc_insertion_point(field_set:protobuf.Transaction.BlockPointer.depth)
 }
 
 // required uint32 index = 2;
+inline bool Transaction_BlockPointer::_internal_has_index() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
+  return value;
+}
 inline bool Transaction_BlockPointer::has_index() const {
-  return (_has_bits_[0] & 0x00000002u) != 0;
+  return _internal_has_index();
 }
-inline void Transaction_BlockPointer::set_has_index() {
-  _has_bits_[0] |= 0x00000002u;
+inline void Transaction_BlockPointer::clear_index() {
+  _impl_.index_ = 0u;
+  _impl_._has_bits_[0] &= ~0x00000002u;
 }
-inline void Transaction_BlockPointer::clear_has_index() {
-  _has_bits_[0] &= ~0x00000002u;
+inline uint32_t Transaction_BlockPointer::_internal_index() const {
+  return _impl_.index_;
 }
-inline void Transaction_BlockPointer::clear_index() {
-  index_ = 0u;
-  clear_has_index();
+inline uint32_t Transaction_BlockPointer::index() const {
+  // @@protoc_insertion_point(field_get:protobuf.Transaction.BlockPointer.index)
+  return _internal_index();
 }
-inline ::google::protobuf::uint32 Transaction_BlockPointer::index() const {
-  return index_;
+inline void Transaction_BlockPointer::_internal_set_index(uint32_t value) {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  _impl_.index_ = value;
 }
-inline void Transaction_BlockPointer::set_index(::google::protobuf::uint32 value) {
-  set_has_index();
-  index_ = value;
+inline void Transaction_BlockPointer::set_index(uint32_t value) {
+  _internal_set_index(value);
+  // @@protoc_insertion_point(field_set:protobuf.Transaction.BlockPointer.index)
 }
 
 // -------------------------------------------------------------------
@@ -988,163 +1593,195 @@ inline void Transaction_BlockPointer::set_index(::google::protobuf::uint32 value
 // Transaction_Input
 
 // required bytes previous_output_hash = 1;
-inline bool Transaction_Input::has_previous_output_hash() const {
-  return (_has_bits_[0] & 0x00000001u) != 0;
-}
-inline void Transaction_Input::set_has_previous_output_hash() {
-  _has_bits_[0] |= 0x00000001u;
+inline bool Transaction_Input::_internal_has_previous_output_hash() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  return value;
 }
-inline void Transaction_Input::clear_has_previous_output_hash() {
-  _has_bits_[0] &= ~0x00000001u;
+inline bool Transaction_Input::has_previous_output_hash() const {
+  return _internal_has_previous_output_hash();
 }
 inline void Transaction_Input::clear_previous_output_hash() {
-  if (previous_output_hash_ != &::google::protobuf::internal::kEmptyString) {
-    previous_output_hash_->clear();
+  _impl_.previous_output_hash_.ClearToEmpty();
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline const std::string& Transaction_Input::previous_output_hash() const {
+  // @@protoc_insertion_point(field_get:protobuf.Transaction.Input.previous_output_hash)
+  return _internal_previous_output_hash();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void Transaction_Input::set_previous_output_hash(ArgT0&& arg0, ArgT... args) {
+ _impl_._has_bits_[0] |= 0x00000001u;
+ _impl_.previous_output_hash_.SetBytes(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:protobuf.Transaction.Input.previous_output_hash)
+}
+inline std::string* Transaction_Input::mutable_previous_output_hash() {
+  std::string* _s = _internal_mutable_previous_output_hash();
+  // @@protoc_insertion_point(field_mutable:protobuf.Transaction.Input.previous_output_hash)
+  return _s;
+}
+inline const std::string& Transaction_Input::_internal_previous_output_hash() const {
+  return _impl_.previous_output_hash_.Get();
+}
+inline void Transaction_Input::_internal_set_previous_output_hash(const std::string& value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.previous_output_hash_.Set(value, GetArenaForAllocation());
+}
+inline std::string* Transaction_Input::_internal_mutable_previous_output_hash() {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  return _impl_.previous_output_hash_.Mutable(GetArenaForAllocation());
+}
+inline std::string* Transaction_Input::release_previous_output_hash() {
+  // @@protoc_insertion_point(field_release:protobuf.Transaction.Input.previous_output_hash)
+  if (!_internal_has_previous_output_hash()) {
+    return nullptr;
   }
-  clear_has_previous_output_hash();
-}
-inline const ::std::string& Transaction_Input::previous_output_hash() const {
-  return *previous_output_hash_;
-}
-inline void Transaction_Input::set_previous_output_hash(const ::std::string& value) {
-  set_has_previous_output_hash();
-  if (previous_output_hash_ == &::google::protobuf::internal::kEmptyString) {
-    previous_output_hash_ = new ::std::string;
-  }
-  previous_output_hash_->assign(value);
-}
-inline void Transaction_Input::set_previous_output_hash(const char* value) {
-  set_has_previous_output_hash();
-  if (previous_output_hash_ == &::google::protobuf::internal::kEmptyString) {
-    previous_output_hash_ = new ::std::string;
+  _impl_._has_bits_[0] &= ~0x00000001u;
+  auto* p = _impl_.previous_output_hash_.Release();
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.previous_output_hash_.IsDefault()) {
+    _impl_.previous_output_hash_.Set("", GetArenaForAllocation());
   }
-  previous_output_hash_->assign(value);
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  return p;
 }
-inline void Transaction_Input::set_previous_output_hash(const void* value, size_t size) {
-  set_has_previous_output_hash();
-  if (previous_output_hash_ == &::google::protobuf::internal::kEmptyString) {
-    previous_output_hash_ = new ::std::string;
-  }
-  previous_output_hash_->assign(reinterpret_cast<const char*>(value), size);
-}
-inline ::std::string* Transaction_Input::mutable_previous_output_hash() {
-  set_has_previous_output_hash();
-  if (previous_output_hash_ == &::google::protobuf::internal::kEmptyString) {
-    previous_output_hash_ = new ::std::string;
-  }
-  return previous_output_hash_;
-}
-inline ::std::string* Transaction_Input::release_previous_output_hash() {
-  clear_has_previous_output_hash();
-  if (previous_output_hash_ == &::google::protobuf::internal::kEmptyString) {
-    return NULL;
+inline void Transaction_Input::set_allocated_previous_output_hash(std::string* previous_output_hash) {
+  if (previous_output_hash != nullptr) {
+    _impl_._has_bits_[0] |= 0x00000001u;
   } else {
-    ::std::string* temp = previous_output_hash_;
-    previous_output_hash_ = const_cast< ::std::string*>(&::google::protobuf::internal::kEmptyString);
-    return temp;
+    _impl_._has_bits_[0] &= ~0x00000001u;
+  }
+  _impl_.previous_output_hash_.SetAllocated(previous_output_hash, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.previous_output_hash_.IsDefault()) {
+    _impl_.previous_output_hash_.Set("", GetArenaForAllocation());
   }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:protobuf.Transaction.Input.previous_output_hash)
 }
 
 // required uint32 previous_output_index = 2;
+inline bool Transaction_Input::_internal_has_previous_output_index() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000004u) != 0;
+  return value;
+}
 inline bool Transaction_Input::has_previous_output_index() const {
-  return (_has_bits_[0] & 0x00000002u) != 0;
+  return _internal_has_previous_output_index();
 }
-inline void Transaction_Input::set_has_previous_output_index() {
-  _has_bits_[0] |= 0x00000002u;
+inline void Transaction_Input::clear_previous_output_index() {
+  _impl_.previous_output_index_ = 0u;
+  _impl_._has_bits_[0] &= ~0x00000004u;
 }
-inline void Transaction_Input::clear_has_previous_output_index() {
-  _has_bits_[0] &= ~0x00000002u;
+inline uint32_t Transaction_Input::_internal_previous_output_index() const {
+  return _impl_.previous_output_index_;
 }
-inline void Transaction_Input::clear_previous_output_index() {
-  previous_output_index_ = 0u;
-  clear_has_previous_output_index();
+inline uint32_t Transaction_Input::previous_output_index() const {
+  // @@protoc_insertion_point(field_get:protobuf.Transaction.Input.previous_output_index)
+  return _internal_previous_output_index();
 }
-inline ::google::protobuf::uint32 Transaction_Input::previous_output_index() const {
-  return previous_output_index_;
+inline void Transaction_Input::_internal_set_previous_output_index(uint32_t value) {
+  _impl_._has_bits_[0] |= 0x00000004u;
+  _impl_.previous_output_index_ = value;
 }
-inline void Transaction_Input::set_previous_output_index(::google::protobuf::uint32 value) {
-  set_has_previous_output_index();
-  previous_output_index_ = value;
+inline void Transaction_Input::set_previous_output_index(uint32_t value) {
+  _internal_set_previous_output_index(value);
+  // @@protoc_insertion_point(field_set:protobuf.Transaction.Input.previous_output_index)
 }
 
 // required bytes script = 3;
-inline bool Transaction_Input::has_script() const {
-  return (_has_bits_[0] & 0x00000004u) != 0;
-}
-inline void Transaction_Input::set_has_script() {
-  _has_bits_[0] |= 0x00000004u;
+inline bool Transaction_Input::_internal_has_script() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
+  return value;
 }
-inline void Transaction_Input::clear_has_script() {
-  _has_bits_[0] &= ~0x00000004u;
+inline bool Transaction_Input::has_script() const {
+  return _internal_has_script();
 }
 inline void Transaction_Input::clear_script() {
-  if (script_ != &::google::protobuf::internal::kEmptyString) {
-    script_->clear();
-  }
-  clear_has_script();
-}
-inline const ::std::string& Transaction_Input::script() const {
-  return *script_;
-}
-inline void Transaction_Input::set_script(const ::std::string& value) {
-  set_has_script();
-  if (script_ == &::google::protobuf::internal::kEmptyString) {
-    script_ = new ::std::string;
+  _impl_.script_.ClearToEmpty();
+  _impl_._has_bits_[0] &= ~0x00000002u;
+}
+inline const std::string& Transaction_Input::script() const {
+  // @@protoc_insertion_point(field_get:protobuf.Transaction.Input.script)
+  return _internal_script();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void Transaction_Input::set_script(ArgT0&& arg0, ArgT... args) {
+ _impl_._has_bits_[0] |= 0x00000002u;
+ _impl_.script_.SetBytes(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:protobuf.Transaction.Input.script)
+}
+inline std::string* Transaction_Input::mutable_script() {
+  std::string* _s = _internal_mutable_script();
+  // @@protoc_insertion_point(field_mutable:protobuf.Transaction.Input.script)
+  return _s;
+}
+inline const std::string& Transaction_Input::_internal_script() const {
+  return _impl_.script_.Get();
+}
+inline void Transaction_Input::_internal_set_script(const std::string& value) {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  _impl_.script_.Set(value, GetArenaForAllocation());
+}
+inline std::string* Transaction_Input::_internal_mutable_script() {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  return _impl_.script_.Mutable(GetArenaForAllocation());
+}
+inline std::string* Transaction_Input::release_script() {
+  // @@protoc_insertion_point(field_release:protobuf.Transaction.Input.script)
+  if (!_internal_has_script()) {
+    return nullptr;
   }
-  script_->assign(value);
-}
-inline void Transaction_Input::set_script(const char* value) {
-  set_has_script();
-  if (script_ == &::google::protobuf::internal::kEmptyString) {
-    script_ = new ::std::string;
-  }
-  script_->assign(value);
-}
-inline void Transaction_Input::set_script(const void* value, size_t size) {
-  set_has_script();
-  if (script_ == &::google::protobuf::internal::kEmptyString) {
-    script_ = new ::std::string;
+  _impl_._has_bits_[0] &= ~0x00000002u;
+  auto* p = _impl_.script_.Release();
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.script_.IsDefault()) {
+    _impl_.script_.Set("", GetArenaForAllocation());
   }
-  script_->assign(reinterpret_cast<const char*>(value), size);
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  return p;
 }
-inline ::std::string* Transaction_Input::mutable_script() {
-  set_has_script();
-  if (script_ == &::google::protobuf::internal::kEmptyString) {
-    script_ = new ::std::string;
-  }
-  return script_;
-}
-inline ::std::string* Transaction_Input::release_script() {
-  clear_has_script();
-  if (script_ == &::google::protobuf::internal::kEmptyString) {
-    return NULL;
+inline void Transaction_Input::set_allocated_script(std::string* script) {
+  if (script != nullptr) {
+    _impl_._has_bits_[0] |= 0x00000002u;
   } else {
-    ::std::string* temp = script_;
-    script_ = const_cast< ::std::string*>(&::google::protobuf::internal::kEmptyString);
-    return temp;
+    _impl_._has_bits_[0] &= ~0x00000002u;
   }
+  _impl_.script_.SetAllocated(script, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.script_.IsDefault()) {
+    _impl_.script_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:protobuf.Transaction.Input.script)
 }
 
 // required uint32 sequence = 4;
+inline bool Transaction_Input::_internal_has_sequence() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000008u) != 0;
+  return value;
+}
 inline bool Transaction_Input::has_sequence() const {
-  return (_has_bits_[0] & 0x00000008u) != 0;
+  return _internal_has_sequence();
 }
-inline void Transaction_Input::set_has_sequence() {
-  _has_bits_[0] |= 0x00000008u;
+inline void Transaction_Input::clear_sequence() {
+  _impl_.sequence_ = 0u;
+  _impl_._has_bits_[0] &= ~0x00000008u;
 }
-inline void Transaction_Input::clear_has_sequence() {
-  _has_bits_[0] &= ~0x00000008u;
+inline uint32_t Transaction_Input::_internal_sequence() const {
+  return _impl_.sequence_;
 }
-inline void Transaction_Input::clear_sequence() {
-  sequence_ = 0u;
-  clear_has_sequence();
+inline uint32_t Transaction_Input::sequence() const {
+  // @@protoc_insertion_point(field_get:protobuf.Transaction.Input.sequence)
+  return _internal_sequence();
 }
-inline ::google::protobuf::uint32 Transaction_Input::sequence() const {
-  return sequence_;
+inline void Transaction_Input::_internal_set_sequence(uint32_t value) {
+  _impl_._has_bits_[0] |= 0x00000008u;
+  _impl_.sequence_ = value;
 }
-inline void Transaction_Input::set_sequence(::google::protobuf::uint32 value) {
-  set_has_sequence();
-  sequence_ = value;
+inline void Transaction_Input::set_sequence(uint32_t value) {
+  _internal_set_sequence(value);
+  // @@protoc_insertion_point(field_set:protobuf.Transaction.Input.sequence)
 }
 
 // -------------------------------------------------------------------
@@ -1152,83 +1789,99 @@ inline void Transaction_Input::set_sequence(::google::protobuf::uint32 value) {
 // Transaction_Output
 
 // required uint64 value = 1;
+inline bool Transaction_Output::_internal_has_value() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
+  return value;
+}
 inline bool Transaction_Output::has_value() const {
-  return (_has_bits_[0] & 0x00000001u) != 0;
+  return _internal_has_value();
 }
-inline void Transaction_Output::set_has_value() {
-  _has_bits_[0] |= 0x00000001u;
+inline void Transaction_Output::clear_value() {
+  _impl_.value_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000002u;
 }
-inline void Transaction_Output::clear_has_value() {
-  _has_bits_[0] &= ~0x00000001u;
+inline uint64_t Transaction_Output::_internal_value() const {
+  return _impl_.value_;
 }
-inline void Transaction_Output::clear_value() {
-  value_ = GOOGLE_ULONGLONG(0);
-  clear_has_value();
+inline uint64_t Transaction_Output::value() const {
+  // @@protoc_insertion_point(field_get:protobuf.Transaction.Output.value)
+  return _internal_value();
 }
-inline ::google::protobuf::uint64 Transaction_Output::value() const {
-  return value_;
+inline void Transaction_Output::_internal_set_value(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  _impl_.value_ = value;
 }
-inline void Transaction_Output::set_value(::google::protobuf::uint64 value) {
-  set_has_value();
-  value_ = value;
+inline void Transaction_Output::set_value(uint64_t value) {
+  _internal_set_value(value);
+  // @@protoc_insertion_point(field_set:protobuf.Transaction.Output.value)
 }
 
 // required bytes script = 2;
-inline bool Transaction_Output::has_script() const {
-  return (_has_bits_[0] & 0x00000002u) != 0;
+inline bool Transaction_Output::_internal_has_script() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  return value;
 }
-inline void Transaction_Output::set_has_script() {
-  _has_bits_[0] |= 0x00000002u;
-}
-inline void Transaction_Output::clear_has_script() {
-  _has_bits_[0] &= ~0x00000002u;
+inline bool Transaction_Output::has_script() const {
+  return _internal_has_script();
 }
 inline void Transaction_Output::clear_script() {
-  if (script_ != &::google::protobuf::internal::kEmptyString) {
-    script_->clear();
-  }
-  clear_has_script();
-}
-inline const ::std::string& Transaction_Output::script() const {
-  return *script_;
-}
-inline void Transaction_Output::set_script(const ::std::string& value) {
-  set_has_script();
-  if (script_ == &::google::protobuf::internal::kEmptyString) {
-    script_ = new ::std::string;
-  }
-  script_->assign(value);
-}
-inline void Transaction_Output::set_script(const char* value) {
-  set_has_script();
-  if (script_ == &::google::protobuf::internal::kEmptyString) {
-    script_ = new ::std::string;
+  _impl_.script_.ClearToEmpty();
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline const std::string& Transaction_Output::script() const {
+  // @@protoc_insertion_point(field_get:protobuf.Transaction.Output.script)
+  return _internal_script();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void Transaction_Output::set_script(ArgT0&& arg0, ArgT... args) {
+ _impl_._has_bits_[0] |= 0x00000001u;
+ _impl_.script_.SetBytes(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:protobuf.Transaction.Output.script)
+}
+inline std::string* Transaction_Output::mutable_script() {
+  std::string* _s = _internal_mutable_script();
+  // @@protoc_insertion_point(field_mutable:protobuf.Transaction.Output.script)
+  return _s;
+}
+inline const std::string& Transaction_Output::_internal_script() const {
+  return _impl_.script_.Get();
+}
+inline void Transaction_Output::_internal_set_script(const std::string& value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.script_.Set(value, GetArenaForAllocation());
+}
+inline std::string* Transaction_Output::_internal_mutable_script() {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  return _impl_.script_.Mutable(GetArenaForAllocation());
+}
+inline std::string* Transaction_Output::release_script() {
+  // @@protoc_insertion_point(field_release:protobuf.Transaction.Output.script)
+  if (!_internal_has_script()) {
+    return nullptr;
   }
-  script_->assign(value);
-}
-inline void Transaction_Output::set_script(const void* value, size_t size) {
-  set_has_script();
-  if (script_ == &::google::protobuf::internal::kEmptyString) {
-    script_ = new ::std::string;
-  }
-  script_->assign(reinterpret_cast<const char*>(value), size);
-}
-inline ::std::string* Transaction_Output::mutable_script() {
-  set_has_script();
-  if (script_ == &::google::protobuf::internal::kEmptyString) {
-    script_ = new ::std::string;
+  _impl_._has_bits_[0] &= ~0x00000001u;
+  auto* p = _impl_.script_.Release();
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.script_.IsDefault()) {
+    _impl_.script_.Set("", GetArenaForAllocation());
   }
-  return script_;
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  return p;
 }
-inline ::std::string* Transaction_Output::release_script() {
-  clear_has_script();
-  if (script_ == &::google::protobuf::internal::kEmptyString) {
-    return NULL;
+inline void Transaction_Output::set_allocated_script(std::string* script) {
+  if (script != nullptr) {
+    _impl_._has_bits_[0] |= 0x00000001u;
   } else {
-    ::std::string* temp = script_;
-    script_ = const_cast< ::std::string*>(&::google::protobuf::internal::kEmptyString);
-    return temp;
+    _impl_._has_bits_[0] &= ~0x00000001u;
   }
+  _impl_.script_.SetAllocated(script, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.script_.IsDefault()) {
+    _impl_.script_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:protobuf.Transaction.Output.script)
 }
 
 // -------------------------------------------------------------------
@@ -1236,160 +1889,226 @@ inline ::std::string* Transaction_Output::release_script() {
 // Transaction
 
 // repeated .protobuf.Transaction.BlockPointer parent = 1;
+inline int Transaction::_internal_parent_size() const {
+  return _impl_.parent_.size();
+}
 inline int Transaction::parent_size() const {
-  return parent_.size();
+  return _internal_parent_size();
 }
 inline void Transaction::clear_parent() {
-  parent_.Clear();
+  _impl_.parent_.Clear();
+}
+inline ::protobuf::Transaction_BlockPointer* Transaction::mutable_parent(int index) {
+  // @@protoc_insertion_point(field_mutable:protobuf.Transaction.parent)
+  return _impl_.parent_.Mutable(index);
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::protobuf::Transaction_BlockPointer >*
+Transaction::mutable_parent() {
+  // @@protoc_insertion_point(field_mutable_list:protobuf.Transaction.parent)
+  return &_impl_.parent_;
+}
+inline const ::protobuf::Transaction_BlockPointer& Transaction::_internal_parent(int index) const {
+  return _impl_.parent_.Get(index);
 }
 inline const ::protobuf::Transaction_BlockPointer& Transaction::parent(int index) const {
-  return parent_.Get(index);
+  // @@protoc_insertion_point(field_get:protobuf.Transaction.parent)
+  return _internal_parent(index);
 }
-inline ::protobuf::Transaction_BlockPointer* Transaction::mutable_parent(int index) {
-  return parent_.Mutable(index);
+inline ::protobuf::Transaction_BlockPointer* Transaction::_internal_add_parent() {
+  return _impl_.parent_.Add();
 }
 inline ::protobuf::Transaction_BlockPointer* Transaction::add_parent() {
-  return parent_.Add();
+  ::protobuf::Transaction_BlockPointer* _add = _internal_add_parent();
+  // @@protoc_insertion_point(field_add:protobuf.Transaction.parent)
+  return _add;
 }
-inline const ::google::protobuf::RepeatedPtrField< ::protobuf::Transaction_BlockPointer >&
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::protobuf::Transaction_BlockPointer >&
 Transaction::parent() const {
-  return parent_;
-}
-inline ::google::protobuf::RepeatedPtrField< ::protobuf::Transaction_BlockPointer >*
-Transaction::mutable_parent() {
-  return &parent_;
+  // @@protoc_insertion_point(field_list:protobuf.Transaction.parent)
+  return _impl_.parent_;
 }
 
 // repeated .protobuf.Transaction.Input inputs = 3;
+inline int Transaction::_internal_inputs_size() const {
+  return _impl_.inputs_.size();
+}
 inline int Transaction::inputs_size() const {
-  return inputs_.size();
+  return _internal_inputs_size();
 }
 inline void Transaction::clear_inputs() {
-  inputs_.Clear();
+  _impl_.inputs_.Clear();
+}
+inline ::protobuf::Transaction_Input* Transaction::mutable_inputs(int index) {
+  // @@protoc_insertion_point(field_mutable:protobuf.Transaction.inputs)
+  return _impl_.inputs_.Mutable(index);
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::protobuf::Transaction_Input >*
+Transaction::mutable_inputs() {
+  // @@protoc_insertion_point(field_mutable_list:protobuf.Transaction.inputs)
+  return &_impl_.inputs_;
+}
+inline const ::protobuf::Transaction_Input& Transaction::_internal_inputs(int index) const {
+  return _impl_.inputs_.Get(index);
 }
 inline const ::protobuf::Transaction_Input& Transaction::inputs(int index) const {
-  return inputs_.Get(index);
+  // @@protoc_insertion_point(field_get:protobuf.Transaction.inputs)
+  return _internal_inputs(index);
 }
-inline ::protobuf::Transaction_Input* Transaction::mutable_inputs(int index) {
-  return inputs_.Mutable(index);
+inline ::protobuf::Transaction_Input* Transaction::_internal_add_inputs() {
+  return _impl_.inputs_.Add();
 }
 inline ::protobuf::Transaction_Input* Transaction::add_inputs() {
-  return inputs_.Add();
+  ::protobuf::Transaction_Input* _add = _internal_add_inputs();
+  // @@protoc_insertion_point(field_add:protobuf.Transaction.inputs)
+  return _add;
 }
-inline const ::google::protobuf::RepeatedPtrField< ::protobuf::Transaction_Input >&
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::protobuf::Transaction_Input >&
 Transaction::inputs() const {
-  return inputs_;
-}
-inline ::google::protobuf::RepeatedPtrField< ::protobuf::Transaction_Input >*
-Transaction::mutable_inputs() {
-  return &inputs_;
+  // @@protoc_insertion_point(field_list:protobuf.Transaction.inputs)
+  return _impl_.inputs_;
 }
 
 // repeated .protobuf.Transaction.Output outputs = 4;
+inline int Transaction::_internal_outputs_size() const {
+  return _impl_.outputs_.size();
+}
 inline int Transaction::outputs_size() const {
-  return outputs_.size();
+  return _internal_outputs_size();
 }
 inline void Transaction::clear_outputs() {
-  outputs_.Clear();
+  _impl_.outputs_.Clear();
+}
+inline ::protobuf::Transaction_Output* Transaction::mutable_outputs(int index) {
+  // @@protoc_insertion_point(field_mutable:protobuf.Transaction.outputs)
+  return _impl_.outputs_.Mutable(index);
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::protobuf::Transaction_Output >*
+Transaction::mutable_outputs() {
+  // @@protoc_insertion_point(field_mutable_list:protobuf.Transaction.outputs)
+  return &_impl_.outputs_;
+}
+inline const ::protobuf::Transaction_Output& Transaction::_internal_outputs(int index) const {
+  return _impl_.outputs_.Get(index);
 }
 inline const ::protobuf::Transaction_Output& Transaction::outputs(int index) const {
-  return outputs_.Get(index);
+  // @@protoc_insertion_point(field_get:protobuf.Transaction.outputs)
+  return _internal_outputs(index);
 }
-inline ::protobuf::Transaction_Output* Transaction::mutable_outputs(int index) {
-  return outputs_.Mutable(index);
+inline ::protobuf::Transaction_Output* Transaction::_internal_add_outputs() {
+  return _impl_.outputs_.Add();
 }
 inline ::protobuf::Transaction_Output* Transaction::add_outputs() {
-  return outputs_.Add();
+  ::protobuf::Transaction_Output* _add = _internal_add_outputs();
+  // @@protoc_insertion_point(field_add:protobuf.Transaction.outputs)
+  return _add;
 }
-inline const ::google::protobuf::RepeatedPtrField< ::protobuf::Transaction_Output >&
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::protobuf::Transaction_Output >&
 Transaction::outputs() const {
-  return outputs_;
-}
-inline ::google::protobuf::RepeatedPtrField< ::protobuf::Transaction_Output >*
-Transaction::mutable_outputs() {
-  return &outputs_;
+  // @@protoc_insertion_point(field_list:protobuf.Transaction.outputs)
+  return _impl_.outputs_;
 }
 
 // required uint32 version = 5;
+inline bool Transaction::_internal_has_version() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  return value;
+}
 inline bool Transaction::has_version() const {
-  return (_has_bits_[0] & 0x00000008u) != 0;
+  return _internal_has_version();
 }
-inline void Transaction::set_has_version() {
-  _has_bits_[0] |= 0x00000008u;
+inline void Transaction::clear_version() {
+  _impl_.version_ = 0u;
+  _impl_._has_bits_[0] &= ~0x00000001u;
 }
-inline void Transaction::clear_has_version() {
-  _has_bits_[0] &= ~0x00000008u;
+inline uint32_t Transaction::_internal_version() const {
+  return _impl_.version_;
 }
-inline void Transaction::clear_version() {
-  version_ = 0u;
-  clear_has_version();
+inline uint32_t Transaction::version() const {
+  // @@protoc_insertion_point(field_get:protobuf.Transaction.version)
+  return _internal_version();
 }
-inline ::google::protobuf::uint32 Transaction::version() const {
-  return version_;
+inline void Transaction::_internal_set_version(uint32_t value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.version_ = value;
 }
-inline void Transaction::set_version(::google::protobuf::uint32 value) {
-  set_has_version();
-  version_ = value;
+inline void Transaction::set_version(uint32_t value) {
+  _internal_set_version(value);
+  // @@protoc_insertion_point(field_set:protobuf.Transaction.version)
 }
 
 // required uint32 locktime = 6;
+inline bool Transaction::_internal_has_locktime() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
+  return value;
+}
 inline bool Transaction::has_locktime() const {
-  return (_has_bits_[0] & 0x00000010u) != 0;
+  return _internal_has_locktime();
 }
-inline void Transaction::set_has_locktime() {
-  _has_bits_[0] |= 0x00000010u;
+inline void Transaction::clear_locktime() {
+  _impl_.locktime_ = 0u;
+  _impl_._has_bits_[0] &= ~0x00000002u;
 }
-inline void Transaction::clear_has_locktime() {
-  _has_bits_[0] &= ~0x00000010u;
+inline uint32_t Transaction::_internal_locktime() const {
+  return _impl_.locktime_;
 }
-inline void Transaction::clear_locktime() {
-  locktime_ = 0u;
-  clear_has_locktime();
+inline uint32_t Transaction::locktime() const {
+  // @@protoc_insertion_point(field_get:protobuf.Transaction.locktime)
+  return _internal_locktime();
 }
-inline ::google::protobuf::uint32 Transaction::locktime() const {
-  return locktime_;
+inline void Transaction::_internal_set_locktime(uint32_t value) {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  _impl_.locktime_ = value;
 }
-inline void Transaction::set_locktime(::google::protobuf::uint32 value) {
-  set_has_locktime();
-  locktime_ = value;
+inline void Transaction::set_locktime(uint32_t value) {
+  _internal_set_locktime(value);
+  // @@protoc_insertion_point(field_set:protobuf.Transaction.locktime)
 }
 
 // required bool is_coinbase = 7;
-inline bool Transaction::has_is_coinbase() const {
-  return (_has_bits_[0] & 0x00000020u) != 0;
+inline bool Transaction::_internal_has_is_coinbase() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000004u) != 0;
+  return value;
 }
-inline void Transaction::set_has_is_coinbase() {
-  _has_bits_[0] |= 0x00000020u;
-}
-inline void Transaction::clear_has_is_coinbase() {
-  _has_bits_[0] &= ~0x00000020u;
+inline bool Transaction::has_is_coinbase() const {
+  return _internal_has_is_coinbase();
 }
 inline void Transaction::clear_is_coinbase() {
-  is_coinbase_ = false;
-  clear_has_is_coinbase();
+  _impl_.is_coinbase_ = false;
+  _impl_._has_bits_[0] &= ~0x00000004u;
+}
+inline bool Transaction::_internal_is_coinbase() const {
+  return _impl_.is_coinbase_;
 }
 inline bool Transaction::is_coinbase() const {
-  return is_coinbase_;
+  // @@protoc_insertion_point(field_get:protobuf.Transaction.is_coinbase)
+  return _internal_is_coinbase();
+}
+inline void Transaction::_internal_set_is_coinbase(bool value) {
+  _impl_._has_bits_[0] |= 0x00000004u;
+  _impl_.is_coinbase_ = value;
 }
 inline void Transaction::set_is_coinbase(bool value) {
-  set_has_is_coinbase();
-  is_coinbase_ = value;
+  _internal_set_is_coinbase(value);
+  // @@protoc_insertion_point(field_set:protobuf.Transaction.is_coinbase)
 }
 
+#ifdef __GNUC__
+  #pragma GCC diagnostic pop
+#endif  // __GNUC__
+// -------------------------------------------------------------------
 
-// @@protoc_insertion_point(namespace_scope)
+// -------------------------------------------------------------------
 
-}  // namespace protobuf
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
 
-#ifndef SWIG
-namespace google {
-namespace protobuf {
 
+// @@protoc_insertion_point(namespace_scope)
 
-}  // namespace google
 }  // namespace protobuf
-#endif  // SWIG
 
 // @@protoc_insertion_point(global_scope)
 
-#endif  // PROTOBUF_bitcoin_2eproto__INCLUDED
+#include <google/protobuf/port_undef.inc>
+#endif  // GOOGLE_PROTOBUF_INCLUDED_GOOGLE_PROTOBUF_INCLUDED_bitcoin_2eproto
@@ -2,6 +2,8 @@
 
 #include <bitcoin/transaction.hpp>
 
+#include "script_compression.hpp"
+
 namespace libbitcoin {
 
 struct protobuf_shutdown
@@ -51,7 +53,7 @@ protobuf::Transaction transaction_to_protobuf(
     {
         protobuf::Transaction::Output& proto_output = *proto_tx.add_outputs();
         proto_output.set_value(block_output.value);
-        data_chunk raw_script = save_script(block_output.output_script);
+        data_chunk raw_script = compress_script(block_output.output_script);
         proto_output.set_script(&raw_script[0], raw_script.size());
     }
     return proto_tx;
@@ -107,7 +109,8 @@ message::transaction protobuf_to_transaction(
         const protobuf::Transaction::Output& proto_output = proto_tx.outputs(i);
         message::transaction_output tx_output;
         tx_output.value = proto_output.value();
-        tx_output.output_script = parse_script(read_raw_script(proto_output));
+        tx_output.output_script =
+            decompress_script(read_raw_script(proto_output));
         result_tx.outputs.push_back(tx_output);
     }
     return result_tx;
@@ -0,0 +1,168 @@
+#include "script_compression.hpp"
+
+#include <bitcoin/utility/assert.hpp>
+#include <bitcoin/utility/elliptic_curve_key.hpp>
+#include <bitcoin/utility/logger.hpp>
+#include <bitcoin/format.hpp>
+
+namespace libbitcoin {
+
+namespace compressed_type
+{
+    enum : byte
+    {
+        pubkey_hash = 0x00,
+        script_hash = 0x01,
+        pubkey_even = 0x02,
+        pubkey_odd = 0x03,
+        uncompressed_even = 0x04,
+        uncompressed_odd = 0x05,
+        raw = 0x06
+    };
+}
+
+constexpr size_t compressed_pubkey_size = 33;
+constexpr size_t uncompressed_pubkey_size = 65;
+
+data_chunk compress_raw(const script& output_script)
+{
+    data_chunk result{compressed_type::raw};
+    extend_data(result, save_script(output_script));
+    return result;
+}
+
+data_chunk compress_pubkey(const script& output_script)
+{
+    const data_chunk& pubkey = output_script.operations()[0].data;
+    if (pubkey.size() == compressed_pubkey_size &&
+        (pubkey[0] == 0x02 || pubkey[0] == 0x03))
+    {
+        // Prefix byte doubles as the type tag
+        return pubkey;
+    }
+    if (pubkey.size() != uncompressed_pubkey_size || pubkey[0] != 0x04)
+        return compress_raw(output_script);
+    // Only points on the curve can be recovered from their x coordinate
+    elliptic_curve_key key;
+    if (!key.set_public_key(pubkey))
+        return compress_raw(output_script);
+    key.set_compressed(true);
+    data_chunk result = key.public_key();
+    BITCOIN_ASSERT(result.size() == compressed_pubkey_size);
+    result[0] += 2;
+    return result;
+}
+
+data_chunk compress_script(const script& output_script)
+{
+    const operation_stack& ops = output_script.operations();
+    data_chunk result;
+    switch (output_script.type())
+    {
+        case payment_type::pubkey_hash:
+            result.push_back(compressed_type::pubkey_hash);
+            extend_data(result, ops[2].data);
+            return result;
+
+        case payment_type::script_hash:
+            result.push_back(compressed_type::script_hash);
+            extend_data(result, ops[1].data);
+            return result;
+
+        case payment_type::pubkey:
+            return compress_pubkey(output_script);
+
+        default:
+            return compress_raw(output_script);
+    }
+}
+
+script pubkey_hash_script(const data_chunk& hash)
+{
+    script result;
+    result.push_operation({opcode::dup, data_chunk()});
+    result.push_operation({opcode::hash160, data_chunk()});
+    result.push_operation({opcode::special, hash});
+    result.push_operation({opcode::equalverify, data_chunk()});
+    result.push_operation({opcode::checksig, data_chunk()});
+    return result;
+}
+
+script script_hash_script(const data_chunk& hash)
+{
+    script result;
+    result.push_operation({opcode::hash160, data_chunk()});
+    result.push_operation({opcode::special, hash});
+    result.push_operation({opcode::equal, data_chunk()});
+    return result;
+}
+
+script pubkey_script(const data_chunk& pubkey)
+{
+    script result;
+    result.push_operation({opcode::special, pubkey});
+    result.push_operation({opcode::checksig, data_chunk()});
+    return result;
+}
+
+bool decompress_pubkey(data_chunk& pubkey)
+{
+    // Restore the original compressed prefix
+    pubkey[0] -= 2;
+    elliptic_curve_key key;
+    if (!key.set_public_key(pubkey))
+        return false;
+    key.set_compressed(false);
+    pubkey = key.public_key();
+    return pubkey.size() == uncompressed_pubkey_size;
+}
+
+script decompress_script(const data_chunk& compressed_script)
+{
+    if (compressed_script.empty())
+    {
+        log_error() << "Empty compressed script";
+        return script();
+    }
+    const byte type = compressed_script[0];
+    const data_chunk payload(
+        compressed_script.begin() + 1, compressed_script.end());
+    data_chunk pubkey;
+    switch (type)
+    {
+        case compressed_type::pubkey_hash:
+            if (payload.size() != short_hash().size())
+                break;
+            return pubkey_hash_script(payload);
+
+        case compressed_type::script_hash:
+            if (payload.size() != short_hash().size())
+                break;
+            return script_hash_script(payload);
+
+        case compressed_type::pubkey_even:
+        case compressed_type::pubkey_odd:
+            if (compressed_script.size() != compressed_pubkey_size)
+                break;
+            return pubkey_script(compressed_script);
+
+        case compressed_type::uncompressed_even:
+        case compressed_type::uncompressed_odd:
+            pubkey = compressed_script;
+            if (pubkey.size() != compressed_pubkey_size ||
+                    !decompress_pubkey(pubkey))
+                break;
+            return pubkey_script(pubkey);
+
+        case compressed_type::raw:
+            return parse_script(payload);
+
+        default:
+            break;
+    }
+    log_error() << "Malformed compressed script";
+    return script();
+}
+
+} // namespace libbitcoin
+
@@ -0,0 +1,24 @@
+#ifndef LIBBITCOIN_BLOCKCHAIN_BERKELEYDB_SCRIPT_COMPRESSION_H
+#define LIBBITCOIN_BLOCKCHAIN_BERKELEYDB_SCRIPT_COMPRESSION_H
+
+#include <bitcoin/script.hpp>
+
+namespace libbitcoin {
+
+// Storage format for output scripts. The first byte is a type tag:
+//
+//   0x00 + 20 bytes        pay to pubkey hash
+//   0x01 + 20 bytes        pay to script hash
+//   0x02/0x03 + 32 bytes   pay to compressed pubkey (tag is the prefix)
+//   0x04/0x05 + 32 bytes   pay to uncompressed pubkey, stored compressed
+//                          with the prefix being tag - 2
+//   0x06 + raw script      anything else
+data_chunk compress_script(const script& output_script);
+
+// Returns an empty script if the data is malformed.
+script decompress_script(const data_chunk& compressed_script);
+
+} // namespace libbitcoin
+
+#endif
+
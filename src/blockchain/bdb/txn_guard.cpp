@@ -4,10 +4,10 @@
 
 namespace libbitcoin {
 
-txn_guard::txn_guard(DbEnv* env)
+txn_guard::txn_guard(DbEnv* env, uint32_t flags)
   : used_(false)
 {
-    env->txn_begin(nullptr, &txn_, DB_READ_COMMITTED|DB_TXN_NOWAIT);
+    env->txn_begin(nullptr, &txn_, flags);
 }
 txn_guard::~txn_guard()
 {
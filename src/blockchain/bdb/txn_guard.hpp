@@ -6,10 +6,15 @@
 
 namespace libbitcoin {
 
+constexpr uint32_t txn_read_committed = DB_READ_COMMITTED|DB_TXN_NOWAIT;
+// Reads see the state committed when the transaction began and are never
+// blocked by writers. Needs the databases opened with DB_MULTIVERSION.
+constexpr uint32_t txn_snapshot = DB_TXN_SNAPSHOT|DB_TXN_NOWAIT;
+
 class txn_guard
 {
 public:
-    txn_guard(DbEnv* env);
+    txn_guard(DbEnv* env, uint32_t flags=txn_read_committed);
     ~txn_guard();
 
     txn_guard(const txn_guard&) = delete;
@@ -0,0 +1,634 @@
+#include <bitcoin/blockchain/postgresql_exporter.hpp>
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <thread>
+
+#include <libpq-fe.h>
+
+#include <bitcoin/script.hpp>
+#include <bitcoin/transaction.hpp>
+#include <bitcoin/block.hpp>
+#include <bitcoin/error.hpp>
+#include <bitcoin/utility/assert.hpp>
+#include <bitcoin/utility/logger.hpp>
+
+namespace libbitcoin {
+
+using std::placeholders::_1;
+using std::placeholders::_2;
+using std::placeholders::_3;
+using std::placeholders::_4;
+
+// Partial batches are written once the chain goes quiet for this long
+const boost::posix_time::seconds flush_timeout(2);
+
+// Staging tables hold rows in exactly the layout they are copied in.
+// Being temporary they are private to each connection, so parallel
+// writers never see each other's rows.
+const char* create_staging_sql =
+    "CREATE TEMP TABLE IF NOT EXISTS stage_blocks ( "
+    "    block_hash BYTEA NOT NULL, "
+    "    depth INT NOT NULL, "
+    "    version BIGINT NOT NULL, "
+    "    prev_block_hash BYTEA NOT NULL, "
+    "    merkle BYTEA NOT NULL, "
+    "    timestamp BIGINT NOT NULL, "
+    "    bits_head INT NOT NULL, "
+    "    bits_body INT NOT NULL, "
+    "    nonce BIGINT NOT NULL "
+    "); "
+    "CREATE TEMP TABLE IF NOT EXISTS stage_transactions ( "
+    "    transaction_hash BYTEA NOT NULL, "
+    "    block_hash BYTEA NOT NULL, "
+    "    index_in_block INT NOT NULL, "
+    "    version BIGINT NOT NULL, "
+    "    locktime BIGINT NOT NULL, "
+    "    coinbase BOOL NOT NULL "
+    "); "
+    "CREATE TEMP TABLE IF NOT EXISTS stage_outputs ( "
+    "    transaction_hash BYTEA NOT NULL, "
+    "    index_in_parent BIGINT NOT NULL, "
+    "    script BYTEA NOT NULL, "
+    "    value BIGINT NOT NULL "
+    "); "
+    "CREATE TEMP TABLE IF NOT EXISTS stage_inputs ( "
+    "    transaction_hash BYTEA NOT NULL, "
+    "    index_in_parent INT NOT NULL, "
+    "    script BYTEA NOT NULL, "
+    "    previous_output_hash BYTEA NOT NULL, "
+    "    previous_output_index BIGINT NOT NULL, "
+    "    sequence BIGINT NOT NULL "
+    "); "
+    "CREATE TEMP TABLE IF NOT EXISTS stage_new_transactions ( "
+    "    transaction_id INT NOT NULL, "
+    "    transaction_hash BYTEA NOT NULL "
+    "); "
+    "CREATE TEMP TABLE IF NOT EXISTS stage_replaced ( "
+    "    block_hash BYTEA NOT NULL "
+    "); ";
+
+// Anything already exported is skipped. Inputs and outputs are only
+// written for transactions inserted by this batch, which also covers
+// the duplicate coinbases of blocks 91842 and 91880.
+const char* merge_sql =
+    "WITH new_blocks AS ( "
+    "    INSERT INTO blocks (block_hash, space, depth, span_left, "
+    "        span_right, version, prev_block_hash, merkle, when_created, "
+    "        bits_head, bits_body, nonce) "
+    "    SELECT block_hash, 0, depth, 0, 0, version, prev_block_hash, "
+    "        merkle, TO_TIMESTAMP(timestamp), bits_head, bits_body, nonce "
+    "    FROM stage_blocks "
+    "    ON CONFLICT (block_hash) DO NOTHING "
+    "    RETURNING depth, bits_head, bits_body "
+    ") "
+    "UPDATE chains SET "
+    "    work = work + COALESCE((SELECT SUM(difficulty(bits_head, bits_body)) "
+    "        FROM new_blocks), 0), "
+    "    depth = GREATEST(depth, "
+    "        COALESCE((SELECT MAX(depth) FROM new_blocks), 0)) "
+    "WHERE chain_id = 0; "
+    "WITH inserted AS ( "
+    "    INSERT INTO transactions (transaction_hash, version, locktime, "
+    "        coinbase) "
+    "    SELECT DISTINCT ON (transaction_hash) "
+    "        transaction_hash, version, locktime, coinbase "
+    "    FROM stage_transactions "
+    "    ON CONFLICT (transaction_hash) DO NOTHING "
+    "    RETURNING transaction_id, transaction_hash "
+    ") "
+    "INSERT INTO stage_new_transactions SELECT * FROM inserted; "
+    "INSERT INTO outputs (transaction_id, index_in_parent, script, value) "
+    "SELECT DISTINCT ON (t.transaction_id, s.index_in_parent) "
+    "    t.transaction_id, s.index_in_parent, s.script, "
+    "    s.value / CAST(100000000 AS NUMERIC(17, 8)) "
+    "FROM stage_outputs s "
+    "JOIN stage_new_transactions t USING (transaction_hash); "
+    "INSERT INTO inputs (transaction_id, index_in_parent, script, "
+    "    previous_output_hash, previous_output_index, sequence) "
+    "SELECT DISTINCT ON (t.transaction_id, s.index_in_parent) "
+    "    t.transaction_id, s.index_in_parent, s.script, "
+    "    s.previous_output_hash, s.previous_output_index, s.sequence "
+    "FROM stage_inputs s "
+    "JOIN stage_new_transactions t USING (transaction_hash); "
+    "INSERT INTO transactions_parents (transaction_id, block_id, "
+    "    index_in_block) "
+    "SELECT t.transaction_id, b.block_id, s.index_in_block "
+    "FROM stage_transactions s "
+    "JOIN transactions t USING (transaction_hash) "
+    "JOIN blocks b ON b.block_hash = s.block_hash "
+    "WHERE NOT EXISTS ( "
+    "    SELECT 1 FROM transactions_parents p "
+    "    WHERE p.transaction_id = t.transaction_id "
+    "        AND p.block_id = b.block_id "
+    "); "
+    "TRUNCATE stage_blocks, stage_transactions, stage_outputs, "
+    "    stage_inputs, stage_new_transactions; ";
+
+const char* delete_replaced_sql =
+    "DELETE FROM transactions_parents WHERE block_id IN ( "
+    "    SELECT block_id FROM blocks "
+    "    JOIN stage_replaced USING (block_hash) "
+    "); "
+    "WITH removed AS ( "
+    "    DELETE FROM blocks "
+    "    WHERE block_hash IN (SELECT block_hash FROM stage_replaced) "
+    "    RETURNING bits_head, bits_body "
+    ") "
+    "UPDATE chains SET "
+    "    work = work - COALESCE((SELECT SUM(difficulty(bits_head, bits_body)) "
+    "        FROM removed), 0) "
+    "WHERE chain_id = 0; "
+    "UPDATE chains SET depth = ( "
+    "    SELECT COALESCE(MAX(depth), 0) FROM blocks WHERE space = 0 "
+    ") WHERE chain_id = 0; "
+    "TRUNCATE stage_replaced; ";
+
+// Builds the body of a COPY ... (FORMAT binary) which is
+// big endian throughout.
+class copy_buffer
+{
+public:
+    copy_buffer()
+    {
+        reset();
+    }
+
+    void reset()
+    {
+        const uint8_t signature[] =
+            {'P', 'G', 'C', 'O', 'P', 'Y', '\n', 0xff, '\r', '\n', 0};
+        data_.assign(signature, signature + sizeof(signature));
+        // Flags then length of the header extension area
+        write_big_endian<uint32_t>(0);
+        write_big_endian<uint32_t>(0);
+        rows_ = 0;
+    }
+
+    void begin_row(uint16_t number_fields)
+    {
+        write_big_endian(number_fields);
+        ++rows_;
+    }
+
+    void write_int32(uint32_t value)
+    {
+        write_big_endian<uint32_t>(4);
+        write_big_endian(value);
+    }
+    void write_int64(uint64_t value)
+    {
+        write_big_endian<uint32_t>(8);
+        write_big_endian(value);
+    }
+    void write_bool(bool value)
+    {
+        write_big_endian<uint32_t>(1);
+        data_.push_back(value ? 1 : 0);
+    }
+    template <typename Iterator>
+    void write_bytes(Iterator begin, Iterator end)
+    {
+        write_big_endian<uint32_t>(std::distance(begin, end));
+        data_.insert(data_.end(), begin, end);
+    }
+    void write_bytes(const data_chunk& data)
+    {
+        write_bytes(data.begin(), data.end());
+    }
+    void write_bytes(const hash_digest& hash)
+    {
+        write_bytes(hash.begin(), hash.end());
+    }
+
+    size_t rows() const
+    {
+        return rows_;
+    }
+
+    // Leaves the buffer untouched so a failed batch can be retried
+    data_chunk finished() const
+    {
+        data_chunk result = data_;
+        // File trailer
+        result.push_back(0xff);
+        result.push_back(0xff);
+        return result;
+    }
+
+private:
+    template <typename T>
+    void write_big_endian(T value)
+    {
+        for (int shift = (sizeof(T) - 1) * 8; shift >= 0; shift -= 8)
+            data_.push_back(static_cast<uint8_t>(value >> shift));
+    }
+
+    data_chunk data_;
+    size_t rows_;
+};
+
+bool execute(PGconn* connection, const char* sql)
+{
+    PGresult* result = PQexec(connection, sql);
+    ExecStatusType status = PQresultStatus(result);
+    PQclear(result);
+    if (status != PGRES_COMMAND_OK && status != PGRES_TUPLES_OK)
+    {
+        log_error(log_domain::blockchain)
+            << "PostgreSQL: " << PQerrorMessage(connection);
+        return false;
+    }
+    return true;
+}
+
+bool copy_in(PGconn* connection, const char* sql, const data_chunk& data)
+{
+    PGresult* result = PQexec(connection, sql);
+    ExecStatusType status = PQresultStatus(result);
+    PQclear(result);
+    if (status != PGRES_COPY_IN)
+    {
+        log_error(log_domain::blockchain)
+            << "PostgreSQL: " << PQerrorMessage(connection);
+        return false;
+    }
+    bool success =
+        PQputCopyData(connection,
+            reinterpret_cast<const char*>(data.data()), data.size()) == 1;
+    success = PQputCopyEnd(connection, success ? nullptr : "aborted") == 1
+        && success;
+    // Drain results until the COPY has completed
+    while ((result = PQgetResult(connection)) != nullptr)
+    {
+        if (PQresultStatus(result) != PGRES_COMMAND_OK)
+            success = false;
+        PQclear(result);
+    }
+    if (!success)
+        log_error(log_domain::blockchain)
+            << "PostgreSQL: " << PQerrorMessage(connection);
+    return success;
+}
+
+PGconn* connect_postgresql(const std::string& connection_info)
+{
+    PGconn* connection = PQconnectdb(connection_info.c_str());
+    if (PQstatus(connection) != CONNECTION_OK)
+    {
+        log_error(log_domain::blockchain)
+            << "PostgreSQL connect failed: " << PQerrorMessage(connection);
+        PQfinish(connection);
+        return nullptr;
+    }
+    if (!execute(connection, create_staging_sql))
+    {
+        PQfinish(connection);
+        return nullptr;
+    }
+    return connection;
+}
+
+class postgresql_copy_batch
+{
+public:
+    void add_block(size_t depth, const message::block& header)
+    {
+        block_hash_ = hash_block_header(header);
+        blocks_.begin_row(9);
+        blocks_.write_bytes(block_hash_);
+        blocks_.write_int32(depth);
+        blocks_.write_int64(header.version);
+        blocks_.write_bytes(header.previous_block_hash);
+        blocks_.write_bytes(header.merkle);
+        blocks_.write_int64(header.timestamp);
+        blocks_.write_int32(header.bits >> 24);
+        blocks_.write_int32(header.bits & 0x00ffffff);
+        blocks_.write_int64(header.nonce);
+    }
+
+    // Belongs to the block last passed to add_block()
+    void add_transaction(size_t index_in_block, const hash_digest& tx_hash,
+        const message::transaction& tx)
+    {
+        transactions_.begin_row(6);
+        transactions_.write_bytes(tx_hash);
+        transactions_.write_bytes(block_hash_);
+        transactions_.write_int32(index_in_block);
+        transactions_.write_int64(tx.version);
+        transactions_.write_int64(tx.locktime);
+        transactions_.write_bool(is_coinbase(tx));
+        for (size_t i = 0; i < tx.inputs.size(); ++i)
+        {
+            const message::transaction_input& input = tx.inputs[i];
+            inputs_.begin_row(6);
+            inputs_.write_bytes(tx_hash);
+            inputs_.write_int32(i);
+            inputs_.write_bytes(save_script(input.input_script));
+            inputs_.write_bytes(input.previous_output.hash);
+            inputs_.write_int64(input.previous_output.index);
+            inputs_.write_int64(input.sequence);
+        }
+        for (size_t i = 0; i < tx.outputs.size(); ++i)
+        {
+            const message::transaction_output& output = tx.outputs[i];
+            outputs_.begin_row(4);
+            outputs_.write_bytes(tx_hash);
+            outputs_.write_int64(i);
+            outputs_.write_bytes(save_script(output.output_script));
+            outputs_.write_int64(output.value);
+        }
+    }
+
+    void add_full_block(size_t depth, const message::block& blk)
+    {
+        add_block(depth, blk);
+        for (size_t i = 0; i < blk.transactions.size(); ++i)
+        {
+            const message::transaction& tx = blk.transactions[i];
+            add_transaction(i, hash_transaction(tx), tx);
+        }
+    }
+
+    // Measured in transactions since they dominate the batch
+    size_t size() const
+    {
+        return transactions_.rows();
+    }
+    bool empty() const
+    {
+        return blocks_.rows() == 0;
+    }
+
+    bool flush(PGconn* connection)
+    {
+        if (empty())
+            return true;
+        if (!execute(connection, "BEGIN"))
+            return false;
+        bool success =
+            copy_in(connection, "COPY stage_blocks FROM STDIN "
+                "(FORMAT binary)", blocks_.finished()) &&
+            copy_in(connection, "COPY stage_transactions FROM STDIN "
+                "(FORMAT binary)", transactions_.finished()) &&
+            copy_in(connection, "COPY stage_outputs FROM STDIN "
+                "(FORMAT binary)", outputs_.finished()) &&
+            copy_in(connection, "COPY stage_inputs FROM STDIN "
+                "(FORMAT binary)", inputs_.finished()) &&
+            execute(connection, merge_sql) &&
+            execute(connection, "COMMIT");
+        if (!success)
+        {
+            // Rows stay buffered for the next attempt
+            execute(connection, "ROLLBACK");
+            return false;
+        }
+        blocks_.reset();
+        transactions_.reset();
+        outputs_.reset();
+        inputs_.reset();
+        return true;
+    }
+
+private:
+    hash_digest block_hash_;
+    copy_buffer blocks_, transactions_, outputs_, inputs_;
+};
+
+// The scan calls the visitor from several threads at once. Each thread
+// writes through its own connection and batch. A thread always sees a
+// whole block at a time so batches only ever hold complete blocks.
+class postgresql_exporter::backfill_visitor
+  : public scan_visitor
+{
+public:
+    backfill_visitor(const std::string& connection_info, size_t flush_size)
+      : connection_info_(connection_info), flush_size_(flush_size),
+        failed_(false)
+    {
+    }
+    ~backfill_visitor()
+    {
+        for (auto& value: writers_)
+            if (value.second.connection)
+                PQfinish(value.second.connection);
+    }
+
+    bool visit_block(size_t depth, const message::block& header)
+    {
+        writer* current = thread_writer();
+        if (!current)
+            return false;
+        if (current->batch.size() >= flush_size_ &&
+            !current->batch.flush(current->connection))
+        {
+            failed_ = true;
+            return false;
+        }
+        current->batch.add_block(depth, header);
+        return true;
+    }
+    bool visit_transaction(size_t depth, size_t index_in_block,
+        const hash_digest& tx_hash, const message::transaction& tx)
+    {
+        writer* current = thread_writer();
+        BITCOIN_ASSERT(current);
+        current->batch.add_transaction(index_in_block, tx_hash, tx);
+        return true;
+    }
+
+    // Called once the scan has finished so no other thread is running
+    bool finish()
+    {
+        for (auto& value: writers_)
+            if (!value.second.batch.flush(value.second.connection))
+                failed_ = true;
+        return !failed_;
+    }
+
+private:
+    struct writer
+    {
+        PGconn* connection;
+        postgresql_copy_batch batch;
+    };
+    typedef std::map<std::thread::id, writer> writer_map;
+
+    writer* thread_writer()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = writers_.find(std::this_thread::get_id());
+        if (it != writers_.end())
+            return &it->second;
+        PGconn* connection = connect_postgresql(connection_info_);
+        if (!connection)
+        {
+            failed_ = true;
+            return nullptr;
+        }
+        writer& current = writers_[std::this_thread::get_id()];
+        current.connection = connection;
+        return &current;
+    }
+
+    const std::string connection_info_;
+    const size_t flush_size_;
+    std::atomic<bool> failed_;
+    // std::map never moves its values so pointers stay valid
+    std::mutex mutex_;
+    writer_map writers_;
+};
+
+postgresql_exporter::postgresql_exporter(async_service& service,
+    bdb_blockchain& chain, const std::string& connection_info,
+    size_t flush_size)
+  : strand_(service.get_service()), timer_(service.get_service()),
+    chain_(chain), connection_info_(connection_info),
+    flush_size_(flush_size), stopped_(false), connection_(nullptr),
+    batch_(std::make_shared<postgresql_copy_batch>())
+{
+}
+
+postgresql_exporter::~postgresql_exporter()
+{
+    if (connection_)
+        PQfinish(connection_);
+}
+
+void postgresql_exporter::start(completion_handler handle_start)
+{
+    strand_.post(
+        [this, handle_start]
+        {
+            connection_ = connect_postgresql(connection_info_);
+            if (!connection_)
+            {
+                handle_start(error::export_failed);
+                return;
+            }
+            chain_.subscribe_reorganize(
+                strand_.wrap(std::bind(&postgresql_exporter::reorganize,
+                    this, _1, _2, _3, _4)));
+            handle_start(std::error_code());
+        });
+}
+
+void postgresql_exporter::backfill(async_service& scan_service,
+    size_t number_partitions, completion_handler handle_backfill)
+{
+    auto visitor = std::make_shared<backfill_visitor>(
+        connection_info_, flush_size_);
+    chain_.scan(scan_service, number_partitions, *visitor,
+        [](size_t scanned, size_t total)
+        {
+            log_info(log_domain::blockchain)
+                << "Exported " << scanned << " of " << total << " blocks";
+        },
+        [visitor, handle_backfill](const std::error_code& ec)
+        {
+            // A failed writer stops the scan early
+            if (!visitor->finish())
+                handle_backfill(error::export_failed);
+            else if (ec)
+                handle_backfill(ec);
+            else
+                handle_backfill(std::error_code());
+        });
+}
+
+void postgresql_exporter::stop(completion_handler handle_stop)
+{
+    strand_.post(
+        [this, handle_stop]
+        {
+            stopped_ = true;
+            boost::system::error_code ret_ec;
+            timer_.cancel(ret_ec);
+            if (!connection_)
+            {
+                handle_stop(std::error_code());
+                return;
+            }
+            bool success = batch_->flush(connection_);
+            PQfinish(connection_);
+            connection_ = nullptr;
+            if (success)
+                handle_stop(std::error_code());
+            else
+                handle_stop(error::export_failed);
+        });
+}
+
+void postgresql_exporter::reorganize(const std::error_code& ec,
+    size_t fork_point, const blockchain::block_list& arrivals,
+    const blockchain::block_list& replaced)
+{
+    if (ec || stopped_)
+        return;
+    if (!replaced.empty())
+    {
+        // Buffered blocks may be among those being replaced
+        if (!batch_->flush(connection_) || !delete_blocks(replaced))
+            log_error(log_domain::blockchain)
+                << "Unable to remove replaced blocks from PostgreSQL";
+    }
+    for (size_t i = 0; i < arrivals.size(); ++i)
+        batch_->add_full_block(fork_point + 1 + i, *arrivals[i]);
+    if (batch_->size() >= flush_size_)
+    {
+        if (!batch_->flush(connection_))
+            log_error(log_domain::blockchain)
+                << "Unable to write blocks to PostgreSQL";
+    }
+    reset_timer();
+    chain_.subscribe_reorganize(
+        strand_.wrap(std::bind(&postgresql_exporter::reorganize,
+            this, _1, _2, _3, _4)));
+}
+
+bool postgresql_exporter::delete_blocks(
+    const blockchain::block_list& replaced)
+{
+    copy_buffer hashes;
+    for (auto blk: replaced)
+    {
+        hashes.begin_row(1);
+        hashes.write_bytes(hash_block_header(*blk));
+    }
+    if (!execute(connection_, "BEGIN"))
+        return false;
+    bool success =
+        copy_in(connection_, "COPY stage_replaced FROM STDIN "
+            "(FORMAT binary)", hashes.finished()) &&
+        execute(connection_, delete_replaced_sql) &&
+        execute(connection_, "COMMIT");
+    if (!success)
+        execute(connection_, "ROLLBACK");
+    return success;
+}
+
+void postgresql_exporter::reset_timer()
+{
+    timer_.expires_from_now(flush_timeout);
+    timer_.async_wait(
+        strand_.wrap(std::bind(&postgresql_exporter::handle_timer,
+            this, _1)));
+}
+
+void postgresql_exporter::handle_timer(const boost::system::error_code& ec)
+{
+    // Cancelled by a newer arrival or by stop()
+    if (ec == boost::asio::error::operation_aborted || stopped_)
+        return;
+    if (!batch_->flush(connection_))
+    {
+        log_error(log_domain::blockchain)
+            << "Unable to write blocks to PostgreSQL";
+        // Try again later
+        reset_timer();
+    }
+}
+
+} // namespace libbitcoin
+
@@ -0,0 +1,352 @@
+#include <bitcoin/compact_block_relay.hpp>
+
+#include <algorithm>
+#include <unordered_map>
+
+#include <bitcoin/block.hpp>
+#include <bitcoin/constants.hpp>
+#include <bitcoin/format.hpp>
+#include <bitcoin/transaction.hpp>
+#include <bitcoin/utility/logger.hpp>
+#include <bitcoin/utility/sha256.hpp>
+
+namespace libbitcoin {
+
+using std::placeholders::_1;
+using std::placeholders::_2;
+
+// Blocks can wait this many at once for missing transactions
+constexpr size_t max_pending_blocks = 16;
+
+uint64_t compact_short_id(const hash_digest& block_hash,
+    uint64_t nonce, const hash_digest& tx_hash)
+{
+    data_chunk preimage(block_hash.begin(), block_hash.end());
+    extend_data(preimage, uncast_type(nonce));
+    extend_data(preimage, tx_hash);
+    hash_digest digest = generate_sha256_hash(preimage);
+    uint64_t short_id = 0;
+    for (size_t i = 0; i < message::short_id_size; ++i)
+        short_id |= static_cast<uint64_t>(digest[i]) << (8 * i);
+    return short_id;
+}
+
+void handle_compact_send(const std::error_code& ec)
+{
+    if (ec)
+        log_warning(log_domain::session)
+            << "Compact block relay: " << ec.message();
+}
+
+void request_full_block(const hash_digest& block_hash, channel_ptr node)
+{
+    message::get_data request_block;
+    request_block.inventories.push_back(
+        {message::inventory_type::block, block_hash});
+    node->send(request_block, handle_compact_send);
+}
+
+compact_block_relay::compact_block_relay(async_service& service,
+    blockchain& chain, transaction_pool& txpool)
+  : strand_(service.get_service()), chain_(chain), tx_pool_(txpool)
+{
+}
+
+bool compact_block_relay::is_compact_peer(channel_ptr node)
+{
+    return (node->peer_services() & node_compact_blocks) != 0;
+}
+
+void compact_block_relay::monitor(channel_ptr node)
+{
+    if (!is_compact_peer(node))
+        return;
+    strand_.post(
+        std::bind(&compact_block_relay::do_monitor, this, node));
+}
+void compact_block_relay::do_monitor(channel_ptr node)
+{
+    peers_.push_back(node);
+    node->subscribe_stop(
+        strand_.wrap(std::bind(&compact_block_relay::remove_peer,
+            this, _1, node)));
+    node->subscribe_compact_block(
+        strand_.wrap(std::bind(&compact_block_relay::receive_compact_block,
+            this, _1, _2, node)));
+    node->subscribe_get_block_transactions(
+        strand_.wrap(std::bind(
+            &compact_block_relay::receive_get_block_transactions,
+                this, _1, _2, node)));
+    node->subscribe_block_transactions(
+        strand_.wrap(std::bind(
+            &compact_block_relay::receive_block_transactions,
+                this, _1, _2, node)));
+}
+
+void compact_block_relay::remove_peer(
+    const std::error_code& ec, channel_ptr node)
+{
+    auto it = std::find(peers_.begin(), peers_.end(), node);
+    if (it != peers_.end())
+        peers_.erase(it);
+    // Forget blocks we were completing from this node
+    for (auto pending = pending_.begin(); pending != pending_.end(); )
+    {
+        if (pending->second.node == node)
+            pending = pending_.erase(pending);
+        else
+            ++pending;
+    }
+}
+
+void compact_block_relay::announce(const message::block& blk)
+{
+    strand_.post(
+        std::bind(&compact_block_relay::do_announce, this, blk));
+}
+void compact_block_relay::do_announce(const message::block& blk)
+{
+    if (peers_.empty() || blk.transactions.empty())
+        return;
+    message::compact_block packet;
+    packet.header = blk;
+    packet.header.transactions.clear();
+    packet.nonce = (static_cast<uint64_t>(rand()) << 32) ^ rand();
+    // The coinbase is never in anyone's pool
+    packet.prefilled.push_back({0, blk.transactions[0]});
+    const hash_digest block_hash = hash_block_header(blk);
+    for (size_t i = 1; i < blk.transactions.size(); ++i)
+        packet.short_ids.push_back(compact_short_id(block_hash,
+            packet.nonce, hash_transaction(blk.transactions[i])));
+    for (channel_ptr node: peers_)
+        node->send(packet, handle_compact_send);
+}
+
+void compact_block_relay::receive_compact_block(const std::error_code& ec,
+    const message::compact_block& packet, channel_ptr node)
+{
+    if (ec)
+    {
+        if (ec != error::service_stopped)
+            log_warning(log_domain::session)
+                << "Received bad compact block: " << ec.message();
+        return;
+    }
+    node->subscribe_compact_block(
+        strand_.wrap(std::bind(&compact_block_relay::receive_compact_block,
+            this, _1, _2, node)));
+    // Match the short ids against the pool in one pass. The pool is
+    // only borrowed for the duration of the call.
+    tx_pool_.visit(
+        std::bind(&compact_block_relay::reconstruct,
+            this, _1, packet, node));
+}
+
+void compact_block_relay::reconstruct(const pool_buffer& pool,
+    const message::compact_block& packet, channel_ptr node)
+{
+    message::block blk = packet.header;
+    const size_t tx_count = packet.short_ids.size() + packet.prefilled.size();
+    blk.transactions.resize(tx_count);
+    std::vector<bool> filled(tx_count, false);
+    for (const message::prefilled_transaction& prefilled: packet.prefilled)
+    {
+        // Straight off the wire, so anything goes
+        if (prefilled.index >= tx_count || filled[prefilled.index])
+        {
+            log_warning(log_domain::session)
+                << "Compact block has a bad prefilled index";
+            node->stop();
+            return;
+        }
+        blk.transactions[prefilled.index] = prefilled.tx;
+        filled[prefilled.index] = true;
+    }
+    // Positions left over after the prefilled ones take the short ids
+    std::unordered_map<uint64_t, size_t> positions;
+    auto short_id = packet.short_ids.begin();
+    for (size_t i = 0; i < tx_count; ++i)
+        if (!filled[i])
+            positions.emplace(*short_id++, i);
+    const hash_digest block_hash = hash_block_header(blk);
+    for (const transaction_entry_info& entry: pool)
+    {
+        auto it = positions.find(
+            compact_short_id(block_hash, packet.nonce, entry.hash));
+        if (it == positions.end())
+            continue;
+        blk.transactions[it->second] = entry.tx();
+        filled[it->second] = true;
+    }
+    index_list missing;
+    for (size_t i = 0; i < tx_count; ++i)
+        if (!filled[i])
+            missing.push_back(i);
+    strand_.post(
+        std::bind(&compact_block_relay::handle_reconstruct,
+            this, blk, missing, node));
+}
+
+void compact_block_relay::handle_reconstruct(const message::block& blk,
+    const index_list& missing, channel_ptr node)
+{
+    if (missing.empty())
+    {
+        verify_and_store(blk, node);
+        return;
+    }
+    const hash_digest block_hash = hash_block_header(blk);
+    if (pending_.size() >= max_pending_blocks &&
+        pending_.find(block_hash) == pending_.end())
+    {
+        // Drop whichever block has been waiting longest
+        auto oldest = std::min_element(pending_.begin(), pending_.end(),
+            [](const pending_block_map::value_type& a,
+                const pending_block_map::value_type& b)
+            {
+                return a.second.sequence < b.second.sequence;
+            });
+        pending_.erase(oldest);
+    }
+    pending_[block_hash] =
+        pending_block{blk, missing, node, next_pending_sequence_++};
+    message::get_block_transactions request;
+    request.block_hash = block_hash;
+    request.indexes = missing;
+    node->send(request, handle_compact_send);
+}
+
+void compact_block_relay::receive_get_block_transactions(
+    const std::error_code& ec,
+    const message::get_block_transactions& packet, channel_ptr node)
+{
+    if (ec)
+    {
+        if (ec != error::service_stopped)
+            log_warning(log_domain::session)
+                << "Received bad getblocktxn: " << ec.message();
+        return;
+    }
+    node->subscribe_get_block_transactions(
+        strand_.wrap(std::bind(
+            &compact_block_relay::receive_get_block_transactions,
+                this, _1, _2, node)));
+    fetch_block(chain_, packet.block_hash,
+        std::bind(&compact_block_relay::send_block_transactions,
+            this, _1, _2, packet.indexes, node));
+}
+
+void compact_block_relay::send_block_transactions(const std::error_code& ec,
+    const message::block& blk, const index_list& indexes, channel_ptr node)
+{
+    if (ec)
+    {
+        log_warning(log_domain::session)
+            << "Fetching block for getblocktxn: " << ec.message();
+        return;
+    }
+    message::block_transactions reply;
+    reply.block_hash = hash_block_header(blk);
+    for (size_t index: indexes)
+    {
+        if (index >= blk.transactions.size())
+        {
+            log_warning(log_domain::session)
+                << "getblocktxn index out of range";
+            node->stop();
+            return;
+        }
+        reply.transactions.push_back(blk.transactions[index]);
+    }
+    node->send(reply, handle_compact_send);
+}
+
+void compact_block_relay::receive_block_transactions(
+    const std::error_code& ec,
+    const message::block_transactions& packet, channel_ptr node)
+{
+    if (ec)
+    {
+        if (ec != error::service_stopped)
+            log_warning(log_domain::session)
+                << "Received bad blocktxn: " << ec.message();
+        return;
+    }
+    node->subscribe_block_transactions(
+        strand_.wrap(std::bind(
+            &compact_block_relay::receive_block_transactions,
+                this, _1, _2, node)));
+    auto it = pending_.find(packet.block_hash);
+    if (it == pending_.end())
+        return;
+    pending_block pending = std::move(it->second);
+    pending_.erase(it);
+    if (packet.transactions.size() != pending.missing.size())
+    {
+        request_full_block(packet.block_hash, node);
+        return;
+    }
+    for (size_t i = 0; i < pending.missing.size(); ++i)
+        pending.blk.transactions[pending.missing[i]] = packet.transactions[i];
+    verify_and_store(pending.blk, node);
+}
+
+void compact_block_relay::verify_and_store(
+    const message::block& blk, channel_ptr node)
+{
+    const hash_digest block_hash = hash_block_header(blk);
+    // A short id collision or a bad peer gave us the wrong transactions
+    if (generate_merkle_root(blk.transactions) != blk.merkle)
+    {
+        log_debug(log_domain::session) << "Compact block "
+            << pretty_hex(block_hash) << " didn't rebuild, fetching it";
+        request_full_block(block_hash, node);
+        return;
+    }
+    chain_.store(blk,
+        std::bind(&compact_block_relay::handle_store,
+            this, _1, _2, block_hash, node));
+}
+
+void compact_block_relay::handle_store(const std::error_code& ec,
+    block_info info, const hash_digest& block_hash, channel_ptr node)
+{
+    if (ec && info.status != block_status::orphan)
+    {
+        if (ec != error::duplicate)
+            log_error(log_domain::session)
+                << "Storing compact block " << pretty_hex(block_hash)
+                << ": " << ec.message();
+        return;
+    }
+    switch (info.status)
+    {
+        case block_status::orphan:
+            // Ask the sender for the blocks leading up to it
+            fetch_block_locator(chain_,
+                [block_hash, node](const std::error_code& ec,
+                    const message::block_locator& locator)
+                {
+                    if (ec)
+                        return;
+                    message::get_blocks packet;
+                    packet.start_hashes = locator;
+                    packet.hash_stop = block_hash;
+                    node->send(packet, handle_compact_send);
+                });
+            break;
+
+        case block_status::rejected:
+            log_error(log_domain::session)
+                << "Rejected compact block " << pretty_hex(block_hash);
+            break;
+
+        case block_status::confirmed:
+            log_info(log_domain::session) << "Compact block #"
+                << info.depth << " " << pretty_hex(block_hash);
+            break;
+    }
+}
+
+} // namespace libbitcoin
+
@@ -34,6 +34,10 @@ std::string error_category_impl::message(int ev) const noexcept
             return "Unsupport payment type";
         case error::start_failed:
             return "Failed to initialize";
+        case error::pruned:
+            return "Object has been pruned";
+        case error::read_only:
+            return "Database opened read-only";
         case error::resolve_failed:
             return "Resolving hostname failed";
         case error::network_unreachable:
@@ -104,6 +108,15 @@ std::string error_category_impl::message(int ev) const noexcept
             return "Fees are out of range";
         case error::coinbase_too_large:
             return "Reported coinbase value is too large";
+        // query
+        case error::server_busy:
+            return "Too many requests waiting";
+        // exporter
+        case error::export_failed:
+            return "Writing to the export database failed";
+        // transaction pool
+        case error::pool_save_failed:
+            return "Writing the transaction pool file failed";
         default:
             return "Unknown error";
     }
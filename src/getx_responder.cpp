@@ -1,5 +1,7 @@
 #include <bitcoin/getx_responder.hpp>
 
+#include <bitcoin/constants.hpp>
+#include <bitcoin/format.hpp>
 #include <bitcoin/network/channel.hpp>
 #include <bitcoin/transaction_pool.hpp>
 #include <bitcoin/blockchain/blockchain.hpp>
@@ -9,6 +11,10 @@ namespace libbitcoin {
 using std::placeholders::_1;
 using std::placeholders::_2;
 
+// Blocks older than this are for peers catching up, not new block
+// relay, and are the first to be held back by upload limits.
+constexpr uint32_t historical_block_age = 60 * 60;
+
 getx_responder::getx_responder(async_service& service,
     blockchain& chain, transaction_pool& txpool)
   : service_(service.get_service()), chain_(chain), txpool_(txpool)
@@ -35,7 +41,7 @@ void getx_responder::receive_get_data(const std::error_code& ec,
             case message::inventory_type::transaction:
                 // First attempt lookup in faster pool, then do slow
                 // lookup in blockchain after.
-                txpool_.fetch(inv.hash,
+                txpool_.fetch_raw(inv.hash,
                     service_.wrap(std::bind(
                         &getx_responder::pool_tx,
                             this, _1, _2, inv.hash, node)));
@@ -62,7 +68,7 @@ void getx_responder::receive_get_data(const std::error_code& ec,
 }
 
 void getx_responder::pool_tx(const std::error_code& ec,
-    const message::transaction& tx, const hash_digest& tx_hash,
+    const data_chunk& raw_tx, const hash_digest& tx_hash,
     channel_ptr node)
 {
     if (ec)
@@ -71,9 +77,18 @@ void getx_responder::pool_tx(const std::error_code& ec,
             service_.wrap(std::bind(
                 &getx_responder::chain_tx,
                     this, _1, _2, node)));
+        return;
     }
-    else
-        node->send(tx, [](const std::error_code&) {});
+    // Pool transactions are already serialized. Send them as they are.
+    message::header head;
+    head.magic = magic_value;
+    head.command = "tx";
+    head.payload_length = raw_tx.size();
+    // The checksum is the first 4 bytes of the same double sha256 that
+    // gives the transaction hash, so there's no need to hash it again.
+    head.checksum = cast_chunk<uint32_t>(
+        data_chunk(tx_hash.rbegin(), tx_hash.rbegin() + 4));
+    node->send_raw(head, raw_tx, [](const std::error_code&) {});
 }
 
 void getx_responder::chain_tx(const std::error_code& ec,
@@ -89,7 +104,9 @@ void getx_responder::send_block(const std::error_code& ec,
 {
     if (ec)
         return;
-    node->send(blk, [](const std::error_code&) {});
+    const bool historical = blk.timestamp + historical_block_age < time(0);
+    node->send(blk, [](const std::error_code&) {},
+        historical ? send_priority::historical : send_priority::block);
 }
 
 } // libbitcoin
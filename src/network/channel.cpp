@@ -1,5 +1,8 @@
 #include <bitcoin/network/channel.hpp>
 
+#include <bitcoin/utility/token_bucket.hpp>
+#include <bitcoin/utility/weak_bind.hpp>
+
 namespace libbitcoin {
 
 using std::placeholders::_1;
@@ -16,35 +19,170 @@ const time_duration disconnect_timeout = seconds(0) + minutes(90);
 
 const time_duration heartbeat_time = seconds(0) + minutes(30);
 
-channel_stream_loader::~channel_stream_loader()
+// A non-empty send queue skipped this many times in a row for higher
+// classes goes next, so a busy channel still relays txs and addresses.
+constexpr size_t max_passed_over = 8;
+
+// Set by set_upload_limits(). The version tells channels to pick up
+// new per peer and per class limits.
+static std::mutex limits_mutex;
+static upload_limits current_limits;
+static std::atomic<bool> upload_limited(false);
+static std::atomic<size_t> limits_version(0);
+
+static token_bucket& global_upload()
+{
+    static token_bucket bucket;
+    return bucket;
+}
+
+void set_upload_limits(const upload_limits& limits)
 {
-    for (channel_loader_module_base* module: modules_)
-        delete module;
+    std::lock_guard<std::mutex> lock(limits_mutex);
+    current_limits = limits;
+    global_upload().set_rate(limits.global);
+    bool limited = limits.global || limits.peer;
+    for (uint64_t rate: limits.priority)
+        limited = limited || rate;
+    upload_limited = limited;
+    ++limits_version;
 }
 
-void channel_stream_loader::add(channel_loader_module_base* module)
+struct channel_proxy::upload_throttle
+{
+    upload_throttle(io_service& service)
+      : timer(service) {}
+
+    void set_limits()
+    {
+        std::lock_guard<std::mutex> lock(limits_mutex);
+        peer.set_rate(current_limits.peer);
+        for (size_t i = 0; i < send_priority_count; ++i)
+            priority[i].set_rate(current_limits.priority[i]);
+        version = limits_version;
+    }
+
+    token_bucket peer;
+    std::array<token_bucket, send_priority_count> priority;
+    size_t version = 0;
+    boost::asio::deadline_timer timer;
+};
+
+// Keeps the memory of stopped proxies for new connections, so peers
+// coming and going don't keep going back to the heap.
+constexpr size_t max_pooled_proxies = 1024;
+
+template <typename Type>
+class pooled_allocator
+{
+public:
+    typedef Type value_type;
+
+    pooled_allocator() {}
+    template <typename Other>
+    pooled_allocator(const pooled_allocator<Other>&) {}
+
+    Type* allocate(size_t count)
+    {
+        if (count == 1)
+        {
+            free_list& pool = blocks();
+            std::lock_guard<std::mutex> lock(pool.mutex);
+            if (!pool.free.empty())
+            {
+                void* block = pool.free.back();
+                pool.free.pop_back();
+                return static_cast<Type*>(block);
+            }
+        }
+        return static_cast<Type*>(::operator new(count * sizeof(Type)));
+    }
+    void deallocate(Type* ptr, size_t count)
+    {
+        if (count == 1)
+        {
+            free_list& pool = blocks();
+            std::lock_guard<std::mutex> lock(pool.mutex);
+            if (pool.free.size() < max_pooled_proxies)
+            {
+                pool.free.push_back(ptr);
+                return;
+            }
+        }
+        ::operator delete(ptr);
+    }
+
+private:
+    struct free_list
+    {
+        ~free_list()
+        {
+            for (void* block: free)
+                ::operator delete(block);
+        }
+        std::mutex mutex;
+        std::vector<void*> free;
+    };
+
+    // One pool for each type the allocator is rebound to
+    static free_list& blocks()
+    {
+        static free_list pool;
+        return pool;
+    }
+};
+template <typename TypeA, typename TypeB>
+bool operator==(const pooled_allocator<TypeA>&,
+    const pooled_allocator<TypeB>&)
 {
-    modules_.push_back(module);
+    return true;
+}
+template <typename TypeA, typename TypeB>
+bool operator!=(const pooled_allocator<TypeA>&,
+    const pooled_allocator<TypeB>&)
+{
+    return false;
 }
 
-void channel_stream_loader::load_lookup(const std::string& symbol,
-    const data_chunk& stream) const
+static message::ip_address endpoint_ip(socket_ptr socket)
 {
-    for (channel_loader_module_base* module: modules_)
-        if (module->lookup_symbol() == symbol)
-            module->attempt_load(stream);
+    boost::system::error_code ec;
+    const tcp::endpoint endpoint = socket->remote_endpoint(ec);
+    if (ec)
+        return message::ip_address();
+    boost::asio::ip::address ip = endpoint.address();
+    const boost::asio::ip::address_v6 ipv6 = ip.is_v4() ?
+        boost::asio::ip::address_v6::v4_mapped(ip.to_v4()) : ip.to_v6();
+    const boost::asio::ip::address_v6::bytes_type bytes = ipv6.to_bytes();
+    message::ip_address result;
+    std::copy(bytes.begin(), bytes.end(), result.begin());
+    return result;
 }
 
 channel_proxy::channel_proxy(async_service& service, socket_ptr socket)
-  : strand_(service.get_service()), stopped_(false), socket_(socket), 
-    timeout_(service.get_service()), heartbeat_(service.get_service())
+  : service_(service), strand_(service.get_service()),
+    timeout_(service.get_service()), heartbeat_(service.get_service()),
+    stopped_(false), peer_services_(0), socket_(socket),
+    remote_ip_(endpoint_ip(socket)), writing_(false)
 {
+    passed_over_.fill(0);
+}
+
+const channel_proxy::loader_map& channel_proxy::loaders()
+{
+    static const loader_map table = make_loaders();
+    return table;
+}
+channel_proxy::loader_map channel_proxy::make_loaders()
+{
+    loader_map table;
 #define CHANNEL_TRANSPORT_MECHANISM(MESSAGE_TYPE) \
-    MESSAGE_TYPE##_subscriber_ = \
-        std::make_shared<MESSAGE_TYPE##_subscriber_type>(service); \
-    loader_.add(new channel_loader_module<message::MESSAGE_TYPE>( \
-        std::bind(&MESSAGE_TYPE##_subscriber_type::relay, \
-            MESSAGE_TYPE##_subscriber_, _1, _2)));
+    table[satoshi_command(message::MESSAGE_TYPE())] = \
+        [](channel_proxy& proxy, const data_chunk& payload) \
+        { \
+            proxy.load_message<message::MESSAGE_TYPE>( \
+                payload, proxy.MESSAGE_TYPE##_subscriber_); \
+        };
 
     CHANNEL_TRANSPORT_MECHANISM(version);
     CHANNEL_TRANSPORT_MECHANISM(verack);
@@ -55,18 +193,19 @@ channel_proxy::channel_proxy(async_service& service, socket_ptr socket)
     CHANNEL_TRANSPORT_MECHANISM(get_blocks);
     CHANNEL_TRANSPORT_MECHANISM(transaction);
     CHANNEL_TRANSPORT_MECHANISM(block);
+    CHANNEL_TRANSPORT_MECHANISM(compact_block);
+    CHANNEL_TRANSPORT_MECHANISM(get_block_transactions);
+    CHANNEL_TRANSPORT_MECHANISM(block_transactions);
 
 #undef CHANNEL_TRANSPORT_MECHANISM
-
-    raw_subscriber_ = 
-        std::make_shared<raw_subscriber_type>(service);
-    stop_subscriber_ =
-        std::make_shared<stop_subscriber_type>(service);
+    return table;
 }
 
 channel_proxy::~channel_proxy()
 {
     stop();
+    // Messages left waiting on upload limits
+    flush_send_queues();
 }
 
 void channel_proxy::start()
@@ -81,7 +220,10 @@ void channel_proxy::stop()
     if (stopped_)
         return;
     stop_impl();
-    stop_subscriber_->relay(error::service_stopped);
+    stop_subscriber_type::ptr stop_subscribe =
+        existing_subscriber(stop_subscriber_);
+    if (stop_subscribe)
+        stop_subscribe->relay(error::service_stopped);
 }
 void channel_proxy::stop_impl()
 {
@@ -99,26 +241,25 @@ void channel_proxy::stop_impl()
 
 void channel_proxy::clear_subscriptions()
 {
-    version_subscriber_->relay(error::service_stopped, 
-        message::version());
-    verack_subscriber_->relay(error::service_stopped, 
-        message::verack());
-    address_subscriber_->relay(error::service_stopped, 
-        message::address());
-    get_address_subscriber_->relay(error::service_stopped,
-        message::get_address());
-    inventory_subscriber_->relay(error::service_stopped, 
-        message::inventory());
-    get_data_subscriber_->relay(error::service_stopped, 
-        message::get_data());
-    get_blocks_subscriber_->relay(error::service_stopped, 
-        message::get_blocks());
-    transaction_subscriber_->relay(error::service_stopped, 
-        message::transaction());
-    block_subscriber_->relay(error::service_stopped, 
-        message::block());
-    raw_subscriber_->relay(error::service_stopped,
-        message::header(), data_chunk());
+    relay_stopped<message::version>(version_subscriber_);
+    relay_stopped<message::verack>(verack_subscriber_);
+    relay_stopped<message::address>(address_subscriber_);
+    relay_stopped<message::get_address>(get_address_subscriber_);
+    relay_stopped<message::inventory>(inventory_subscriber_);
+    relay_stopped<message::get_data>(get_data_subscriber_);
+    relay_stopped<message::get_blocks>(get_blocks_subscriber_);
+    relay_stopped<message::transaction>(transaction_subscriber_);
+    relay_stopped<message::block>(block_subscriber_);
+    relay_stopped<message::compact_block>(compact_block_subscriber_);
+    relay_stopped<message::get_block_transactions>(
+        get_block_transactions_subscriber_);
+    relay_stopped<message::block_transactions>(
+        block_transactions_subscriber_);
+    raw_subscriber_type::ptr raw_subscribe =
+        existing_subscriber(raw_subscriber_);
+    if (raw_subscribe)
+        raw_subscribe->relay(error::service_stopped,
+            message::header(), data_chunk());
 }
 
 bool channel_proxy::stopped() const
@@ -126,6 +267,19 @@ bool channel_proxy::stopped() const
     return stopped_;
 }
 
+void channel_proxy::set_peer_services(uint64_t services)
+{
+    peer_services_ = services;
+}
+uint64_t channel_proxy::peer_services() const
+{
+    return peer_services_;
+}
+const message::ip_address& channel_proxy::remote_ip() const
+{
+    return remote_ip_;
+}
+
 bool timer_errors(const boost::system::error_code& ec, bool stopped)
 {
     if (ec == boost::asio::error::operation_aborted)
@@ -157,7 +311,10 @@ void channel_proxy::handle_timeout(const boost::system::error_code& ec)
     socket_->shutdown(tcp::socket::shutdown_both, ret_ec);
     socket_->close(ret_ec);
     stop_impl();
-    stop_subscriber_->relay(error::channel_timeout);
+    stop_subscriber_type::ptr stop_subscribe =
+        existing_subscriber(stop_subscriber_);
+    if (stop_subscribe)
+        stop_subscribe->relay(error::channel_timeout);
 }
 
 void handle_ping(const std::error_code&)
@@ -254,7 +411,10 @@ bool verify_header(const message::header& header_msg)
         || header_msg.command == "tx"
         || header_msg.command == "block"
         || header_msg.command == "headers"
-        || header_msg.command == "alert")
+        || header_msg.command == "alert"
+        || header_msg.command == "cmpctblock"
+        || header_msg.command == "getblocktxn"
+        || header_msg.command == "blocktxn")
     {
         // Should check if sizes make sense
         // i.e for addr should be multiple of 30x + 1 byte
@@ -309,35 +469,30 @@ void channel_proxy::handle_read_payload(const boost::system::error_code& ec,
     if (problems_check(ec))
         return;
     BITCOIN_ASSERT(bytes_transferred == header_msg.payload_length);
-    data_chunk payload_stream = data_chunk(
-        inbound_payload_.begin(), inbound_payload_.end());
-    BITCOIN_ASSERT(payload_stream.size() == header_msg.payload_length);
-    if (header_msg.checksum != generate_sha256_checksum(payload_stream))
+    raw_subscriber_type::ptr raw_subscribe =
+        existing_subscriber(raw_subscriber_);
+    if (header_msg.checksum != generate_sha256_checksum(inbound_payload_))
     {
         log_warning(log_domain::network) << "Bad checksum!";
-        raw_subscriber_->relay(error::bad_stream,
-            message::header(), data_chunk());
+        if (raw_subscribe)
+            raw_subscribe->relay(error::bad_stream,
+                message::header(), data_chunk());
         stop();
         return;
     }
-    raw_subscriber_->relay(std::error_code(),
-        header_msg, inbound_payload_);
+    if (raw_subscribe)
+        raw_subscribe->relay(std::error_code(),
+            header_msg, inbound_payload_);
 
     // This must happen before calling subscribe notification handlers
     // In case user tries to stop() this channel.
+    // The payload buffer is only reused after this handler returns.
     read_header();
     reset_timers();
 
-    loader_.load_lookup(header_msg.command, payload_stream);
-}
-
-void channel_proxy::call_handle_send(const boost::system::error_code& ec,
-    send_handler handle_send)
-{
-    if (problems_check(ec))
-        handle_send(error::service_stopped);
-    else
-        handle_send(std::error_code());
+    auto it = loaders().find(header_msg.command);
+    if (it != loaders().end())
+        it->second(*this, inbound_payload_);
 }
 
 void channel_proxy::subscribe_version(receive_version_handler handle_receive)
@@ -384,6 +539,24 @@ void channel_proxy::subscribe_block(receive_block_handler handle_receive)
     generic_subscribe<message::block>(
         handle_receive, block_subscriber_);
 }
+void channel_proxy::subscribe_compact_block(
+    receive_compact_block_handler handle_receive)
+{
+    generic_subscribe<message::compact_block>(
+        handle_receive, compact_block_subscriber_);
+}
+void channel_proxy::subscribe_get_block_transactions(
+    receive_get_block_transactions_handler handle_receive)
+{
+    generic_subscribe<message::get_block_transactions>(
+        handle_receive, get_block_transactions_subscriber_);
+}
+void channel_proxy::subscribe_block_transactions(
+    receive_block_transactions_handler handle_receive)
+{
+    generic_subscribe<message::block_transactions>(
+        handle_receive, block_transactions_subscriber_);
+}
 void channel_proxy::subscribe_get_address(
     receive_get_address_handler handle_receive)
 {
@@ -396,7 +569,7 @@ void channel_proxy::subscribe_raw(receive_raw_handler handle_receive)
         handle_receive(error::service_stopped,
             message::header(), data_chunk());
     else
-        raw_subscriber_->subscribe(handle_receive);
+        create_subscriber(raw_subscriber_)->subscribe(handle_receive);
 }
 
 void channel_proxy::subscribe_stop(stop_handler handle_stop)
@@ -404,7 +577,7 @@ void channel_proxy::subscribe_stop(stop_handler handle_stop)
     if (stopped_)
         handle_stop(error::service_stopped);
     else
-        stop_subscriber_->subscribe(handle_stop);
+        create_subscriber(stop_subscriber_)->subscribe(handle_stop);
 }
 
 void channel_proxy::send_raw(const message::header& packet_header,
@@ -414,33 +587,208 @@ void channel_proxy::send_raw(const message::header& packet_header,
         handle_send(error::service_stopped);
     else
         strand_.post(std::bind(&channel_proxy::do_send_raw,
-            shared_from_this(), packet_header, payload, handle_send));
+            shared_from_this(), packet_header, payload, handle_send,
+            now()));
 }
 void channel_proxy::do_send_raw(const message::header& packet_header,
-    const data_chunk& payload, send_handler handle_send)
+    const data_chunk& payload, send_handler handle_send,
+    boost::posix_time::ptime queued)
 {
     data_chunk raw_header(satoshi_raw_size(packet_header));
     satoshi_save(packet_header, raw_header.begin());
     // Construct completed packet with header + payload
     data_chunk whole_message = raw_header;
     extend_data(whole_message, payload);
-    do_send_common(whole_message, handle_send);
+    queue_send(std::move(whole_message), handle_send,
+        message_priority(packet_header.command), queued);
+}
+
+boost::posix_time::ptime channel_proxy::now()
+{
+    return boost::posix_time::microsec_clock::universal_time();
+}
+
+void channel_proxy::queue_send(data_chunk&& whole_message,
+    send_handler handle_send, send_priority priority,
+    boost::posix_time::ptime queued)
+{
+    if (stopped_)
+    {
+        handle_send(error::service_stopped);
+        return;
+    }
+    send_queues_[static_cast<size_t>(priority)].push_back(
+        {std::move(whole_message), handle_send, queued});
+    if (!writing_)
+        write_next();
+}
+
+size_t channel_proxy::next_send_queue() const
+{
+    // Highest non-empty class, unless a lower one has waited too long
+    size_t next = send_priority_count;
+    for (size_t i = 0; i < send_priority_count; ++i)
+    {
+        if (send_queues_[i].empty())
+            continue;
+        if (next == send_priority_count)
+            next = i;
+        else if (passed_over_[i] >= max_passed_over)
+        {
+            next = i;
+            break;
+        }
+    }
+    return next;
+}
+void channel_proxy::count_passed_over(size_t sent)
+{
+    for (size_t i = 0; i < send_priority_count; ++i)
+        if (i != sent && !send_queues_[i].empty())
+            ++passed_over_[i];
+    passed_over_[sent] = 0;
 }
-void channel_proxy::do_send_common(const data_chunk& whole_message,
+
+size_t channel_proxy::unthrottled_send_queue(size_t preferred)
+{
+    if (!throttle_)
+        throttle_.reset(new upload_throttle(service_.get_service()));
+    if (throttle_->version != limits_version)
+        throttle_->set_limits();
+    // Lower classes can go while the preferred one is over its limit
+    time_duration shortest_wait = boost::posix_time::pos_infin;
+    for (size_t i = 0; i <= send_priority_count; ++i)
+    {
+        const size_t index = i == 0 ? preferred : i - 1;
+        if ((i > 0 && index == preferred) || send_queues_[index].empty())
+            continue;
+        const time_duration wait = upload_wait(index);
+        if (wait.is_zero())
+        {
+            const size_t size =
+                send_queues_[index].front().whole_message.size();
+            global_upload().consume(size);
+            throttle_->peer.consume(size);
+            throttle_->priority[index].consume(size);
+            return index;
+        }
+        shortest_wait = std::min(shortest_wait, wait);
+    }
+    throttle_->timer.expires_from_now(shortest_wait);
+    throttle_->timer.async_wait(strand_.wrap(weak_bind(
+        &channel_proxy::handle_throttle, shared_from_this(), _1)));
+    return send_priority_count;
+}
+
+time_duration channel_proxy::upload_wait(size_t index)
+{
+    // Historical blocks keep half of each shared bucket for everyone else
+    const bool historical =
+        index == static_cast<size_t>(send_priority::historical);
+    const uint64_t global_reserve =
+        historical ? global_upload().burst() / 2 : 0;
+    const uint64_t peer_reserve =
+        historical ? throttle_->peer.burst() / 2 : 0;
+    return std::max({global_upload().wait_time(global_reserve),
+        throttle_->peer.wait_time(peer_reserve),
+        throttle_->priority[index].wait_time()});
+}
+
+void channel_proxy::handle_throttle(const boost::system::error_code& ec)
+{
+    // A new message may have started a write while we waited
+    if (ec == boost::asio::error::operation_aborted || writing_)
+        return;
+    if (stopped_)
+        flush_send_queues();
+    else
+        write_next();
+}
+
+void channel_proxy::write_next()
+{
+    size_t index = next_send_queue();
+    if (index != send_priority_count && upload_limited)
+        index = unthrottled_send_queue(index);
+    writing_ = index != send_priority_count;
+    if (!writing_)
+        return;
+    // Only now, as the upload limits may have picked another queue
+    count_passed_over(index);
+    send_queue& queue = send_queues_[index];
+    queued_message message = std::move(queue.front());
+    queue.pop_front();
+    const time_duration wait = now() - message.queued;
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        send_queue_stats& stats = queue_stats_[index];
+        ++stats.messages;
+        stats.total_wait += wait;
+        if (wait > stats.max_wait)
+            stats.max_wait = wait;
+    }
+    // Lives in the proxy until the write completes
+    outbound_message_ = std::move(message.whole_message);
+    async_write(*socket_, buffer(outbound_message_),
+        strand_.wrap(std::bind(&channel_proxy::handle_write,
+            shared_from_this(), _1, message.handle_send)));
+}
+
+void channel_proxy::handle_write(const boost::system::error_code& ec,
     send_handler handle_send)
 {
-    shared_const_buffer buffer(whole_message);
-    async_write(*socket_, buffer,
-        std::bind(&channel_proxy::call_handle_send, shared_from_this(),
-            std::placeholders::_1, handle_send));
+    if (problems_check(ec))
+    {
+        handle_send(error::service_stopped);
+        flush_send_queues();
+        writing_ = false;
+        return;
+    }
+    handle_send(std::error_code());
+    write_next();
+}
+
+void channel_proxy::flush_send_queues()
+{
+    for (send_queue& queue: send_queues_)
+    {
+        for (queued_message& message: queue)
+            message.handle_send(error::service_stopped);
+        queue.clear();
+    }
+}
+
+send_queue_stats channel_proxy::queue_stats(send_priority priority) const
+{
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    return queue_stats_[static_cast<size_t>(priority)];
+}
+
+send_priority message_priority(const std::string& command)
+{
+    if (command == "block" || command == "cmpctblock" ||
+        command == "getblocktxn" || command == "blocktxn")
+        return send_priority::block;
+    if (command == "tx")
+        return send_priority::transaction;
+    if (command == "addr" || command == "getaddr")
+        return send_priority::address;
+    return send_priority::control;
+}
+send_priority message_priority(const message::inventory& packet)
+{
+    for (const message::inventory_vector& inv: packet.inventories)
+        if (inv.type == message::inventory_type::block)
+            return send_priority::block;
+    return send_priority::transaction;
 }
 
 // channel
 
 channel::channel(async_service& service, socket_ptr socket)
 {
-    channel_proxy_ptr proxy =
-        std::make_shared<channel_proxy>(service, socket);
+    channel_proxy_ptr proxy = std::allocate_shared<channel_proxy>(
+        pooled_allocator<channel_proxy>(), service, socket);
     proxy->start();
     weak_proxy_ = proxy;
 }
@@ -466,6 +814,27 @@ bool channel::stopped() const
         return proxy->stopped();
 }
 
+void channel::set_peer_services(uint64_t services)
+{
+    channel_proxy_ptr proxy = weak_proxy_.lock();
+    if (proxy)
+        proxy->set_peer_services(services);
+}
+uint64_t channel::peer_services() const
+{
+    channel_proxy_ptr proxy = weak_proxy_.lock();
+    if (!proxy)
+        return 0;
+    return proxy->peer_services();
+}
+message::ip_address channel::remote_ip() const
+{
+    channel_proxy_ptr proxy = weak_proxy_.lock();
+    if (!proxy)
+        return message::ip_address();
+    return proxy->remote_ip();
+}
+
 void channel::send_raw(const message::header& packet_header,
     const data_chunk& payload, channel_proxy::send_handler handle_send)
 {
@@ -476,6 +845,14 @@ void channel::send_raw(const message::header& packet_header,
         proxy->send_raw(packet_header, payload, handle_send);
 }
 
+send_queue_stats channel::queue_stats(send_priority priority) const
+{
+    channel_proxy_ptr proxy = weak_proxy_.lock();
+    if (!proxy)
+        return send_queue_stats();
+    return proxy->queue_stats(priority);
+}
+
 void channel::subscribe_version(
     channel_proxy::receive_version_handler handle_receive)
 {
@@ -557,6 +934,35 @@ void channel::subscribe_block(
     else
         proxy->subscribe_block(handle_receive);
 }
+void channel::subscribe_compact_block(
+    channel_proxy::receive_compact_block_handler handle_receive)
+{
+    channel_proxy_ptr proxy = weak_proxy_.lock();
+    if (!proxy)
+        handle_receive(error::service_stopped, message::compact_block());
+    else
+        proxy->subscribe_compact_block(handle_receive);
+}
+void channel::subscribe_get_block_transactions(
+    channel_proxy::receive_get_block_transactions_handler handle_receive)
+{
+    channel_proxy_ptr proxy = weak_proxy_.lock();
+    if (!proxy)
+        handle_receive(error::service_stopped,
+            message::get_block_transactions());
+    else
+        proxy->subscribe_get_block_transactions(handle_receive);
+}
+void channel::subscribe_block_transactions(
+    channel_proxy::receive_block_transactions_handler handle_receive)
+{
+    channel_proxy_ptr proxy = weak_proxy_.lock();
+    if (!proxy)
+        handle_receive(error::service_stopped,
+            message::block_transactions());
+    else
+        proxy->subscribe_block_transactions(handle_receive);
+}
 void channel::subscribe_raw(
     channel_proxy::receive_raw_handler handle_receive)
 {
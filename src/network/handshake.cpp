@@ -1,11 +1,11 @@
 #include <bitcoin/network/handshake.hpp>
 
+#include <algorithm>
 #include <functional>
-#include <boost/regex.hpp>
-#include <boost/lexical_cast.hpp>
-#include <curl/curl.h>
 
+#include <bitcoin/network/channel.hpp>
 #include <bitcoin/network/network.hpp>
+#include <bitcoin/constants.hpp>
 #include <bitcoin/version.hpp>
 
 namespace libbitcoin {
@@ -15,12 +15,23 @@ using std::placeholders::_2;
 
 const size_t clearance_count = 3;
 
+// Each new vote scales the existing scores by this
+constexpr double ip_vote_decay = 0.95;
+// Votes needed before we trust any address
+constexpr size_t ip_vote_quorum = 3;
+// Scores below this are forgotten
+constexpr double ip_vote_min_score = 0.05;
+// Voters remembered. By the time one is forgotten its old vote has
+// decayed below ip_vote_min_score, so voting again is harmless.
+constexpr size_t max_ip_voters = 100;
+
 handshake::handshake(async_service& service)
-  : strand_(service.get_service())
+  : strand_(service.get_service()), total_votes_(0),
+    external_ip_known_(false), external_ip_fixed_(false)
 {
     // Setup template version packet with defaults
     template_version_.version = protocol_version;
-    template_version_.services = 1;
+    template_version_.services = node_network;
     // non-constant field
     //template_version_.timestamp = time(NULL);
     template_version_.address_me.services = template_version_.services;
@@ -38,11 +49,12 @@ handshake::handshake(async_service& service)
 
 void handshake::start(start_handler handle_start)
 {
-    discover_external_ip(std::bind(handle_start, _1));
+    // Our external address is learnt from peers as they connect
+    handle_start(std::error_code());
 }
 
 void handshake::ready(channel_ptr node,
-    handshake::handshake_handler handle_handshake)
+    handshake::handshake_handler handle_handshake, bool outbound)
 {
     atomic_counter_ptr counter = std::make_shared<atomic_counter>(0);
 
@@ -54,7 +66,7 @@ void handshake::ready(channel_ptr node,
 
     node->subscribe_version(
         strand_.wrap(std::bind(&handshake::receive_version,
-            this, _1, _2, node, counter, handle_handshake)));
+            this, _1, _2, node, outbound, counter, handle_handshake)));
     node->subscribe_verack(
         strand_.wrap(std::bind(&handshake::receive_verack,
             this, _1, _2, counter, handle_handshake)));
@@ -71,15 +83,21 @@ void handshake::handle_message_sent(const std::error_code& ec,
 }
 
 void handshake::receive_version(const std::error_code& ec,
-    const message::version&, channel_ptr node, atomic_counter_ptr counter,
+    const message::version& version, channel_ptr node,
+    bool outbound, atomic_counter_ptr counter,
     handshake::handshake_handler completion_callback)
 {
     if (ec)
         completion_callback(ec);
     else
+    {
+        node->set_peer_services(version.services);
+        if (outbound)
+            vote_external_ip(version.address_you.ip, node->remote_ip());
         node->send(message::verack(),
             strand_.wrap(std::bind(&handshake::handle_message_sent,
                 this, _1, counter, completion_callback)));
+    }
 }
 
 void handshake::receive_verack(const std::error_code& ec,
@@ -92,96 +110,111 @@ void handshake::receive_verack(const std::error_code& ec,
         completion_callback(std::error_code());
 }
 
-int writer(char* data, size_t size, size_t count, std::string* buffer)
+void handshake::discover_external_ip(discover_ip_handler handle_discover)
+{
+    strand_.post(
+        std::bind(&handshake::do_discover_external_ip,
+            this, handle_discover));
+}
+
+message::ip_address handshake::localhost_ip()
+{
+    return message::ip_address{0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+                               0x00, 0x00, 0xff, 0xff, 0x0a, 0x00, 0x00, 0x01};
+}
+
+void handshake::do_discover_external_ip(discover_ip_handler handle_discover)
 {
-    int result = 0;
-    if (buffer != NULL)
+    if (!external_ip_known_)
     {
-        result = count * size;
-        *buffer = std::string(data, result);
+        handle_discover(error::not_found, message::ip_address());
+        return;
     }
-    return result;
+    handle_discover(std::error_code(), template_version_.address_me.ip);
 }
 
-void handshake::discover_external_ip(discover_ip_handler handle_discover)
+static bool is_ipv4(const message::ip_address& ip)
 {
-    strand_.post(
-        std::bind(&handshake::do_discover_external_ip,
-            this, handle_discover));
+    return std::all_of(ip.begin(), ip.begin() + 10,
+        [](uint8_t byte) { return byte == 0; })
+        && ip[10] == 0xff && ip[11] == 0xff;
 }
 
-bool handshake::lookup_external(const std::string& website,
-    message::ip_address& ip)
+static bool is_public_ip(const message::ip_address& ip)
 {
-    // Initialise CURL with our various options.
-    CURL* curl = curl_easy_init();
-    // This goes first in case of any problems below. We get an error message.
-    char error_buffer[CURL_ERROR_SIZE];
-    error_buffer[0] = '\0';
-    curl_easy_setopt(curl, CURLOPT_ERRORBUFFER, error_buffer);
-    // fail when server sends >= 404
-    curl_easy_setopt(curl, CURLOPT_FAILONERROR, 1);
-    curl_easy_setopt(curl, CURLOPT_HEADER, 0);
-    curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 0);
-    curl_easy_setopt(curl, CURLOPT_POSTREDIR, CURL_REDIR_POST_302);
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, writer);
-    curl_easy_setopt(curl, CURLOPT_USE_SSL, CURLUSESSL_TRY);
-    curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 1);
-    // server response goes in response_buffer
-    std::string response_buffer;
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response_buffer);
-    curl_easy_setopt(curl, CURLOPT_URL, website.c_str());
-    // Everything fine. Do fetch
-    CURLcode result = curl_easy_perform(curl);
-    curl_easy_cleanup(curl);
-    if (result != CURLE_OK)
+    static const message::ip_address unspecified{};
+    static const message::ip_address loopback{
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01};
+    if (ip == unspecified || ip == loopback)
         return false;
-    // TODO use std::regex instead ... when it work >_>
-    boost::cmatch results;
-    boost::regex rx("(\\d+)[.](\\d+)[.](\\d+)[.](\\d+)");
-    if (!boost::regex_search(response_buffer.c_str(), results, rx))
+    if (!is_ipv4(ip))
     {
-        return false;
+        // Link local fe80::/10 and unique local fc00::/7
+        return !(ip[0] == 0xfe && (ip[1] & 0xc0) == 0x80)
+            && (ip[0] & 0xfe) != 0xfc;
     }
-    ip = localhost_ip();
-    for (size_t i = 0; i < 4; ++i)
-        ip[i + 12] = boost::lexical_cast<unsigned>(results[i + 1]);
-    return true;
+    // 0/8, 10/8, 127/8, 169.254/16, 172.16/12, 192.168/16
+    // and carrier grade NAT 100.64/10
+    return ip[12] != 0 && ip[12] != 10 && ip[12] != 127
+        && !(ip[12] == 169 && ip[13] == 254)
+        && !(ip[12] == 172 && (ip[13] & 0xf0) == 16)
+        && !(ip[12] == 192 && ip[13] == 168)
+        && !(ip[12] == 100 && (ip[13] & 0xc0) == 64);
 }
 
-message::ip_address handshake::localhost_ip()
+// Hosts in one netgroup are likely run by the same people
+static message::ip_address netgroup(const message::ip_address& ip)
 {
-    return message::ip_address{0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-                               0x00, 0x00, 0xff, 0xff, 0x0a, 0x00, 0x00, 0x01};
+    message::ip_address group{};
+    const size_t prefix = is_ipv4(ip) ? 14 : 4;
+    std::copy(ip.begin(), ip.begin() + prefix, group.begin());
+    return group;
 }
 
-void handshake::do_discover_external_ip(discover_ip_handler handle_discover)
+void handshake::vote_external_ip(const message::ip_address& ip,
+    const message::ip_address& voter)
 {
-    template_version_.address_me.ip = localhost_ip();
-    std::vector<message::ip_address> corroborate_ips;
-    // Lookup our IP address from a bunch of hosts
-    message::ip_address lookup_ip;
-    if (lookup_external("checkip.dyndns.org", lookup_ip))
-        corroborate_ips.push_back(lookup_ip);
-    if (lookup_external("whatismyip.org", lookup_ip))
-        corroborate_ips.push_back(lookup_ip);
-    if (corroborate_ips.empty())
-    {
-        handle_discover(error::bad_stream, message::ip_address());
+    if (external_ip_fixed_ || !is_public_ip(ip))
         return;
+    const message::ip_address voter_group = netgroup(voter);
+    if (!voters_.insert(voter_group).second)
+        return;
+    voter_order_.push_back(voter_group);
+    if (voter_order_.size() > max_ip_voters)
+    {
+        voters_.erase(voter_order_.front());
+        voter_order_.pop_front();
     }
-    // Make sure that the IPs are the same
-    template_version_.address_me.ip = corroborate_ips[0];
-    for (const message::ip_address& match_ip: corroborate_ips)
+    for (auto it = ip_votes_.begin(); it != ip_votes_.end(); )
     {
-        if (match_ip != template_version_.address_me.ip)
-        {
-            template_version_.address_me.ip = localhost_ip();
-            handle_discover(error::bad_stream, message::ip_address());
-            return;
-        }
+        it->second *= ip_vote_decay;
+        if (it->second < ip_vote_min_score)
+            it = ip_votes_.erase(it);
+        else
+            ++it;
     }
-    handle_discover(std::error_code(), template_version_.address_me.ip);
+    ip_votes_[ip] += 1.0;
+    ++total_votes_;
+    if (total_votes_ < ip_vote_quorum)
+        return;
+    // Adopt the leader only once it holds a majority of the score
+    double total_score = 0;
+    auto leader = ip_votes_.begin();
+    for (auto it = ip_votes_.begin(); it != ip_votes_.end(); ++it)
+    {
+        total_score += it->second;
+        if (it->second > leader->second)
+            leader = it;
+    }
+    if (leader->second * 2 <= total_score)
+        return;
+    if (external_ip_known_ && template_version_.address_me.ip == leader->first)
+        return;
+    template_version_.address_me.ip = leader->first;
+    external_ip_known_ = true;
+    log_info(log_domain::network) << "External address: "
+        << pretty_hex(leader->first);
 }
 
 void handshake::fetch_network_address(
@@ -197,6 +230,23 @@ void handshake::do_fetch_network_address(
     handle_fetch(std::error_code(), template_version_.address_me);
 }
 
+void handshake::set_external_ip(const message::ip_address& ip,
+    setter_handler handle_set)
+{
+    strand_.post(
+        std::bind(&handshake::do_set_external_ip,
+            this, ip, handle_set));
+}
+void handshake::do_set_external_ip(const message::ip_address& ip,
+    setter_handler handle_set)
+{
+    template_version_.address_me.ip = ip;
+    external_ip_known_ = true;
+    external_ip_fixed_ = true;
+    ip_votes_.clear();
+    handle_set(std::error_code());
+}
+
 void handshake::set_port(uint16_t port, setter_handler handle_set)
 {
     strand_.post(
@@ -235,6 +285,19 @@ void handshake::do_set_start_depth(uint32_t depth, setter_handler handle_set)
     handle_set(std::error_code());
 }
 
+void handshake::set_services(uint64_t services, setter_handler handle_set)
+{
+    strand_.post(
+        std::bind(&handshake::do_set_services,
+            this, services, handle_set));
+}
+void handshake::do_set_services(uint64_t services, setter_handler handle_set)
+{
+    template_version_.services = services;
+    template_version_.address_me.services = services;
+    handle_set(std::error_code());
+}
+
 void finish_connect(const std::error_code& ec,
     channel_ptr node, handshake& shake,
     network::connect_handler handle_connect)
@@ -242,7 +305,7 @@ void finish_connect(const std::error_code& ec,
     if (ec)
         handle_connect(ec, node);
     else
-        shake.ready(node, std::bind(handle_connect, _1, node));
+        shake.ready(node, std::bind(handle_connect, _1, node), true);
 }
 
 void connect(handshake& shake, network& net,
@@ -252,6 +315,13 @@ void connect(handshake& shake, network& net,
     net.connect(hostname, port, 
         std::bind(finish_connect, _1, _2, std::ref(shake), handle_connect));
 }
+void connect(handshake& shake, network& net,
+    const message::network_address& address,
+    network::connect_handler handle_connect)
+{
+    net.connect(address,
+        std::bind(finish_connect, _1, _2, std::ref(shake), handle_connect));
+}
 
 } // namespace libbitcoin
 
@@ -28,14 +28,24 @@ void hosts::do_load(const std::string& filename, load_handler handle_load)
     {
         std::vector<std::string> parts;
         boost::split(parts, line, boost::is_any_of(" "));
-        if (parts.size() != 2)
+        // Older files have no timestamp
+        if (parts.size() != 2 && parts.size() != 3)
             continue;
         data_chunk raw_ip = bytes_from_pretty(parts[0]);
         hosts_field field;
         if (raw_ip.size() != field.ip.size())
             continue;
         std::copy(raw_ip.begin(), raw_ip.end(), field.ip.begin());
-        field.port = boost::lexical_cast<uint16_t>(parts[1]);
+        try
+        {
+            field.port = boost::lexical_cast<uint16_t>(parts[1]);
+            field.timestamp = parts.size() == 3 ?
+                boost::lexical_cast<uint32_t>(parts[2]) : 0;
+        }
+        catch (const boost::bad_lexical_cast&)
+        {
+            continue;
+        }
         queue(
             [this, field]()
             {
@@ -56,7 +66,7 @@ void hosts::do_save(const std::string& filename, save_handler handle_save)
     std::ofstream file_handle(filename);
     for (const hosts_field& field: buffer_)
         file_handle << pretty_hex(field.ip) << ' '
-            << field.port << std::endl;
+            << field.port << ' ' << field.timestamp << std::endl;
     handle_save(std::error_code());
 }
 
@@ -66,7 +76,13 @@ void hosts::store(const message::network_address& address,
     queue(
         [this, address, handle_store]()
         {
-            buffer_.push_back(hosts_field{address.ip, address.port});
+            // Peers can claim any time, so never take one from the future
+            const uint32_t now = time(nullptr);
+            uint32_t timestamp = address.timestamp;
+            if (timestamp == 0 || timestamp > now)
+                timestamp = now;
+            buffer_.push_back(
+                hosts_field{address.ip, address.port, timestamp});
             handle_store(std::error_code());
         });
 }
@@ -86,7 +102,7 @@ void hosts::do_remove(const message::network_address& address,
     remove_handler handle_remove)
 {
     auto it = std::find(buffer_.begin(), buffer_.end(),
-        hosts_field{address.ip, address.port});
+        hosts_field{address.ip, address.port, 0});
     if (it == buffer_.end())
     {
         handle_remove(error::not_found);
@@ -111,7 +127,7 @@ void hosts::do_fetch_address(fetch_address_handler handle_fetch)
     }
     size_t index = rand() % buffer_.size();
     message::network_address address;
-    address.timestamp = 0;
+    address.timestamp = buffer_[index].timestamp;
     address.services = 0;
     address.ip = buffer_[index].ip;
     address.port = buffer_[index].port;
@@ -129,5 +145,23 @@ void hosts::do_fetch_count(fetch_count_handler handle_fetch)
     handle_fetch(std::error_code(), buffer_.size());
 }
 
+void hosts::fetch_count_since(uint32_t timestamp,
+    fetch_count_handler handle_fetch)
+{
+    queue(
+        std::bind(&hosts::do_fetch_count_since,
+            this, timestamp, handle_fetch));
+}
+void hosts::do_fetch_count_since(uint32_t timestamp,
+    fetch_count_handler handle_fetch)
+{
+    size_t count = std::count_if(buffer_.begin(), buffer_.end(),
+        [timestamp](const hosts_field& field)
+        {
+            return field.timestamp >= timestamp;
+        });
+    handle_fetch(std::error_code(), count);
+}
+
 } // namespace libbitcoin
 
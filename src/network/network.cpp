@@ -11,6 +11,11 @@ namespace libbitcoin {
 using std::placeholders::_1;
 using std::placeholders::_2;
 
+// Seconds to reuse the endpoints a hostname resolved to
+constexpr time_t resolve_cache_lifetime = 10 * 60;
+// Expired entries are dropped once the cache grows past this
+constexpr size_t resolve_cache_size = 256;
+
 acceptor::acceptor(async_service& service, tcp_acceptor_ptr tcp_accept)
   : service_(service), tcp_accept_(tcp_accept)
 {
@@ -41,8 +46,41 @@ network::network(async_service& service)
 {
 }
 
+network::endpoint_list_ptr network::cached_endpoints(
+    const std::string& key)
+{
+    std::lock_guard<std::mutex> lock(resolve_cache_mutex_);
+    auto it = resolve_cache_.find(key);
+    if (it == resolve_cache_.end())
+        return nullptr;
+    if (it->second.expires <= time(nullptr))
+    {
+        resolve_cache_.erase(it);
+        return nullptr;
+    }
+    return it->second.endpoints;
+}
+
+void network::cache_endpoints(const std::string& key,
+    endpoint_list_ptr endpoints)
+{
+    const time_t now = time(nullptr);
+    std::lock_guard<std::mutex> lock(resolve_cache_mutex_);
+    if (resolve_cache_.size() >= resolve_cache_size)
+    {
+        for (auto it = resolve_cache_.begin(); it != resolve_cache_.end(); )
+        {
+            if (it->second.expires <= now)
+                it = resolve_cache_.erase(it);
+            else
+                ++it;
+        }
+    }
+    resolve_cache_[key] = {endpoints, now + resolve_cache_lifetime};
+}
+
 void network::resolve_handler(const boost::system::error_code& ec,
-    tcp::resolver::iterator endpoint_iterator,
+    tcp::resolver::iterator endpoint_iterator, const std::string& key,
     connect_handler handle_connect, resolver_ptr, query_ptr)
 {
     if (ec)
@@ -50,16 +88,34 @@ void network::resolve_handler(const boost::system::error_code& ec,
         handle_connect(error::resolve_failed, nullptr);
         return;
     }
+    endpoint_list_ptr endpoints = std::make_shared<endpoint_list>();
+    for (; endpoint_iterator != tcp::resolver::iterator();
+        ++endpoint_iterator)
+    {
+        endpoints->push_back(endpoint_iterator->endpoint());
+    }
+    cache_endpoints(key, endpoints);
+    connect_endpoints(endpoints, handle_connect);
+}
+
+void network::connect_endpoints(endpoint_list_ptr endpoints,
+    connect_handler handle_connect)
+{
     socket_ptr socket =
         std::make_shared<tcp::socket>(service_.get_service());
-    boost::asio::async_connect(*socket, endpoint_iterator,
+    // Tries each endpoint in turn. The list lives as long as the handler.
+    boost::asio::async_connect(*socket, endpoints->begin(), endpoints->end(),
         std::bind(&network::call_connect_handler,
-            this, _1, _2, socket, handle_connect));
+            this, _1, socket,
+            [endpoints, handle_connect](
+                const std::error_code& ec, channel_ptr node)
+            {
+                handle_connect(ec, node);
+            }));
 }
 
 void network::call_connect_handler(const boost::system::error_code& ec, 
-    tcp::resolver::iterator, socket_ptr socket,
-    connect_handler handle_connect)
+    socket_ptr socket, connect_handler handle_connect)
 {
     if (ec)
     {
@@ -74,13 +130,58 @@ void network::call_connect_handler(const boost::system::error_code& ec,
 void network::connect(const std::string& hostname, uint16_t port,
     connect_handler handle_connect)
 {
+    boost::system::error_code ec;
+    boost::asio::ip::address ip =
+        boost::asio::ip::address::from_string(hostname, ec);
+    if (!ec)
+    {
+        connect(tcp::endpoint(ip, port), handle_connect);
+        return;
+    }
+    const std::string key = hostname + ":" + std::to_string(port);
+    endpoint_list_ptr endpoints = cached_endpoints(key);
+    if (endpoints)
+    {
+        connect_endpoints(endpoints, handle_connect);
+        return;
+    }
     resolver_ptr resolver =
         std::make_shared<tcp::resolver>(service_.get_service());
     query_ptr query =
         std::make_shared<tcp::resolver::query>(hostname, std::to_string(port));
     resolver->async_resolve(*query,
         std::bind(&network::resolve_handler,
-            this, _1, _2, handle_connect, resolver, query));
+            this, _1, _2, key, handle_connect, resolver, query));
+}
+
+void network::connect(const message::network_address& address,
+    connect_handler handle_connect)
+{
+    // Addresses on the wire are IPv6, with IPv4 mapped into the last
+    // four bytes.
+    boost::asio::ip::address_v6::bytes_type bytes;
+    std::copy(address.ip.begin(), address.ip.end(), bytes.begin());
+    const boost::asio::ip::address_v6 ip(bytes);
+    if (ip.is_v4_mapped())
+    {
+        const boost::asio::ip::address_v4::bytes_type v4_bytes{
+            {bytes[12], bytes[13], bytes[14], bytes[15]}};
+        connect(tcp::endpoint(
+            boost::asio::ip::address_v4(v4_bytes), address.port),
+            handle_connect);
+    }
+    else
+        connect(tcp::endpoint(ip, address.port), handle_connect);
+}
+
+void network::connect(const tcp::endpoint& endpoint,
+    connect_handler handle_connect)
+{
+    socket_ptr socket =
+        std::make_shared<tcp::socket>(service_.get_service());
+    socket->async_connect(endpoint,
+        std::bind(&network::call_connect_handler,
+            this, _1, socket, handle_connect));
 }
 
 // I personally don't like how exceptions mess with the program flow
@@ -1,5 +1,9 @@
 #include <bitcoin/network/protocol.hpp>
 
+#include <ctime>
+
+#include <bitcoin/constants.hpp>
+#include <bitcoin/error.hpp>
 #include <bitcoin/network/hosts.hpp>
 #include <bitcoin/network/handshake.hpp>
 #include <bitcoin/utility/logger.hpp>
@@ -9,6 +13,14 @@ namespace libbitcoin {
 using std::placeholders::_1;
 using std::placeholders::_2;
 
+// Skip seeding if we saw enough hosts within this many seconds
+constexpr uint32_t seed_cache_lifetime = 24 * 60 * 60;
+// Give up waiting on slow seeds after this long
+const boost::posix_time::time_duration seeding_timeout =
+    boost::posix_time::seconds(10);
+// Stop seeding once this many addresses came back
+constexpr size_t seeding_target = 32;
+
 static std::string pretty(const message::ip_address& ip)
 {
     std::ostringstream oss;
@@ -19,7 +31,8 @@ static std::string pretty(const message::ip_address& ip)
 
 protocol::protocol(async_service& service, hosts& hsts,
     handshake& shake, network& net)
-  : strand_(service.get_service()), hosts_filename_("hosts"),
+  : service_(service), strand_(service.get_service()),
+    hosts_filename_("hosts"),
     hosts_(hsts), handshake_(shake), network_(net), max_outbound_(8)
 {
     channel_subscribe_ = std::make_shared<channel_subscriber_type>(service);
@@ -105,28 +118,31 @@ void protocol::load_hosts(const std::error_code& ec,
         handle_complete(ec);
         return;
     }
-    hosts_.fetch_count(
-        strand_.wrap(std::bind(&protocol::if_0_seed,
+    // Hosts seen within this time are likely to still be up
+    uint32_t fresh_since = time(nullptr) - seed_cache_lifetime;
+    hosts_.fetch_count_since(fresh_since,
+        strand_.wrap(std::bind(&protocol::if_stale_seed,
             this, _1, _2, handle_complete)));
 }
 
-void protocol::if_0_seed(const std::error_code& ec, size_t hosts_count,
+void protocol::if_stale_seed(const std::error_code& ec, size_t fresh_count,
     completion_handler handle_complete)
 {
     if (ec)
     {
         log_error(log_domain::protocol) 
-            << "Unable to check hosts empty: " << ec.message();
+            << "Unable to check for fresh hosts: " << ec.message();
         handle_complete(ec);
         return;
     }
-    if (hosts_count == 0)
+    // Enough cached addresses to fill our outbound slots
+    if (fresh_count >= max_outbound_)
     {
-        load_seeds_ = std::make_shared<seeds>(this);
-        load_seeds_->start(handle_complete);
-    }
-    else
         handle_complete(std::error_code());
+        return;
+    }
+    load_seeds_ = std::make_shared<seeds>(this);
+    load_seeds_->start(handle_complete);
 }
 
 const std::vector<std::string> dns_seeds
@@ -138,92 +154,79 @@ const std::vector<std::string> dns_seeds
 };
 
 protocol::seeds::seeds(protocol* parent)
-  : strand_(parent->strand_), hosts_(parent->hosts_),
-    handshake_(parent->handshake_), network_(parent->network_)
+  : deadline_(parent->service_.get_service()),
+    service_(parent->service_), strand_(parent->strand_),
+    hosts_(parent->hosts_)
 {
 }
 void protocol::seeds::start(completion_handler handle_complete)
 {
     handle_complete_ = handle_complete;
     ended_paths_ = 0;
+    stored_count_ = 0;
     finished_ = false;
+    deadline_.expires_from_now(seeding_timeout);
+    deadline_.async_wait(
+        strand_.wrap(std::bind(&protocol::seeds::handle_deadline,
+            shared_from_this(), _1)));
     for (const std::string& hostname: dns_seeds)
-        connect_dns_seed(hostname);
+        resolve_dns_seed(hostname);
 }
 
-void protocol::seeds::error_case(const std::error_code& ec)
+void protocol::seeds::resolve_dns_seed(const std::string& hostname)
 {
-    if (finished_)
-        return;
-    ++ended_paths_;
-    if (ended_paths_ == dns_seeds.size())
-    {
-        finished_ = true;
-        handle_complete_(ec);
-    }
+    resolver_ptr resolver =
+        std::make_shared<tcp::resolver>(service_.get_service());
+    resolvers_.push_back(resolver);
+    tcp::resolver::query query(hostname, "8333");
+    resolver->async_resolve(query,
+        strand_.wrap(std::bind(&protocol::seeds::save_addresses,
+            shared_from_this(), _1, _2, hostname, resolver)));
 }
 
-void protocol::seeds::connect_dns_seed(const std::string& hostname)
-{
-    connect(handshake_, network_, hostname, 8333,
-        strand_.wrap(std::bind(&protocol::seeds::request_addresses,
-            shared_from_this(), _1, _2)));
-}
-void protocol::seeds::request_addresses(
-    const std::error_code& ec, channel_ptr dns_seed_node)
-{
-    if (ec)
-    {
-        log_error(log_domain::protocol) 
-            << "Failed to connect to seed node: " << ec.message();
-        error_case(ec);
-    }
+static message::network_address seeded_address(const tcp::endpoint& endpoint)
+{
+    message::network_address address;
+    address.timestamp = time(nullptr);
+    address.services = node_network;
+    address.port = endpoint.port();
+    boost::asio::ip::address_v6 ip;
+    if (endpoint.address().is_v4())
+        ip = boost::asio::ip::address_v6::v4_mapped(
+            endpoint.address().to_v4());
     else
-    {
-        dns_seed_node->send(message::get_address(),
-            strand_.wrap(std::bind(&protocol::seeds::handle_send_get_address,
-                shared_from_this(), _1)));
-        dns_seed_node->subscribe_address(
-            strand_.wrap(std::bind(&protocol::seeds::save_addresses,
-                shared_from_this(), _1, _2, dns_seed_node)));
-    }
-
-}
-void protocol::seeds::handle_send_get_address(const std::error_code& ec)
-{
-    if (ec)
-    {
-        log_error(log_domain::protocol)
-            << "Sending get_address message failed: " << ec.message();
-        error_case(ec);
-    }
+        ip = endpoint.address().to_v6();
+    boost::asio::ip::address_v6::bytes_type bytes = ip.to_bytes();
+    std::copy(bytes.begin(), bytes.end(), address.ip.begin());
+    return address;
 }
 
-void protocol::seeds::save_addresses(const std::error_code& ec,
-    const message::address& packet, channel_ptr)
+void protocol::seeds::save_addresses(const boost::system::error_code& ec,
+    tcp::resolver::iterator endpoint_iterator,
+    const std::string& hostname, resolver_ptr)
 {
+    if (finished_)
+        return;
+    ++ended_paths_;
     if (ec)
-    {
-        log_error(log_domain::protocol)
-            << "Problem receiving addresses from seed nodes: "
-            << ec.message();
-        error_case(ec);
-    }
+        log_warning(log_domain::protocol) << "Failed to resolve seed "
+            << hostname << ": " << ec.message();
     else
     {
-        log_info() << "Storing seeded addresses.";
-        for (const message::network_address& net_address: packet.addresses)
-            hosts_.store(net_address,
+        size_t count = 0;
+        for (; endpoint_iterator != tcp::resolver::iterator();
+            ++endpoint_iterator, ++count)
+        {
+            hosts_.store(seeded_address(endpoint_iterator->endpoint()),
                 strand_.wrap(std::bind(&protocol::seeds::handle_store,
                     shared_from_this(), _1)));
-
-        if (!finished_)
-        {
-            ++ended_paths_;
-            finished_ = true;
-            handle_complete_(std::error_code());
         }
+        log_info(log_domain::protocol) << "Seeded " << count
+            << " addresses from " << hostname;
+        stored_count_ += count;
     }
+    if (stored_count_ >= seeding_target || ended_paths_ == dns_seeds.size())
+        finish();
 }
 void protocol::seeds::handle_store(const std::error_code& ec)
 {
@@ -233,6 +236,29 @@ void protocol::seeds::handle_store(const std::error_code& ec)
             << ec.message();
 }
 
+void protocol::seeds::handle_deadline(const boost::system::error_code& ec)
+{
+    if (ec == boost::asio::error::operation_aborted || finished_)
+        return;
+    log_warning(log_domain::protocol) << "Seeding timed out with "
+        << stored_count_ << " addresses";
+    finish();
+}
+
+void protocol::seeds::finish()
+{
+    finished_ = true;
+    boost::system::error_code ignore_ec;
+    deadline_.cancel(ignore_ec);
+    for (resolver_ptr resolver: resolvers_)
+        resolver->cancel();
+    resolvers_.clear();
+    if (stored_count_ == 0)
+        handle_complete_(error::resolve_failed);
+    else
+        handle_complete_(std::error_code());
+}
+
 void protocol::run()
 {
     strand_.dispatch(std::bind(&protocol::try_connect, this));
@@ -274,7 +300,7 @@ void protocol::attempt_connect(const std::error_code& ec,
     }
     log_info(log_domain::protocol) << "Trying "
         << pretty(address.ip) << ":" << address.port;
-    connect(handshake_, network_, pretty(address.ip), address.port,
+    connect(handshake_, network_, address,
         strand_.wrap(std::bind(&protocol::handle_connect,
             this, _1, _2, address)));
 }
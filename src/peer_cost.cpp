@@ -0,0 +1,84 @@
+#include <bitcoin/peer_cost.hpp>
+
+#include <cmath>
+
+namespace libbitcoin {
+
+using boost::posix_time::microsec_clock;
+
+peer_cost::peer_cost(const peer_cost_policy& policy)
+  : policy_(policy), last_decay_(microsec_clock::universal_time())
+{
+}
+
+void peer_cost::decay(ptime now)
+{
+    const double elapsed = (now - last_decay_).total_microseconds();
+    const double half_life = policy_.half_life.total_microseconds();
+    if (elapsed <= 0 || half_life <= 0)
+        return;
+    const double factor = std::exp2(-elapsed / half_life);
+    cost_ *= factor;
+    value_ *= factor;
+    last_decay_ = now;
+}
+
+void peer_cost::add(const validation_cost& cost, bool accepted)
+{
+    double charge = cost.cpu_time.total_microseconds() +
+        cost.storage_lookups * policy_.lookup_cost.total_microseconds();
+    if (policy_.bytes_per_millisecond)
+        charge += 1000.0 * cost.bytes / policy_.bytes_per_millisecond;
+    std::lock_guard<std::mutex> lock(mutex_);
+    decay(microsec_clock::universal_time());
+    totals_.cpu_time += cost.cpu_time;
+    totals_.storage_lookups += cost.storage_lookups;
+    totals_.bytes += cost.bytes;
+    cost_ += charge;
+    if (accepted)
+    {
+        value_ += charge;
+        ++accepted_;
+    }
+    else
+        ++rejected_;
+}
+
+validation_cost peer_cost::totals() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return totals_;
+}
+size_t peer_cost::accepted() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return accepted_;
+}
+size_t peer_cost::rejected() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return rejected_;
+}
+
+double peer_cost::ratio()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Throttled peers are never charged so this is how they recover
+    decay(microsec_clock::universal_time());
+    return cost_ / (value_ + policy_.allowance.total_microseconds());
+}
+
+peer_standing peer_cost::standing()
+{
+    const double current = ratio();
+    if (current >= policy_.disconnect_ratio)
+        return peer_standing::disconnect;
+    if (current >= policy_.throttle_ratio)
+        return peer_standing::throttled;
+    if (current >= policy_.deprioritize_ratio)
+        return peer_standing::deprioritized;
+    return peer_standing::normal;
+}
+
+} // namespace libbitcoin
+
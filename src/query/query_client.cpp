@@ -0,0 +1,452 @@
+#include <bitcoin/query/query_client.hpp>
+
+#include <bitcoin/error.hpp>
+#include <bitcoin/satoshi_serialize.hpp>
+#include <bitcoin/utility/assert.hpp>
+#include <bitcoin/utility/logger.hpp>
+
+namespace libbitcoin {
+
+using std::placeholders::_1;
+using std::placeholders::_2;
+using boost::asio::buffer;
+
+typedef boost::asio::local::stream_protocol::endpoint local_endpoint;
+
+typedef std::function<void (const std::error_code&, const data_chunk&, bool)>
+    reply_frame_handler;
+
+// Parse a single frame reply with read_result and pass it on
+template <typename Result, typename Reader, typename Handler>
+reply_frame_handler decode_reply(Reader read_result, Handler handle_fetch)
+{
+    return [read_result, handle_fetch](const std::error_code& ec,
+        const data_chunk& payload, bool)
+        {
+            if (ec)
+            {
+                handle_fetch(ec, Result());
+                return;
+            }
+            Result result = Result();
+            std::error_code reply_ec;
+            try
+            {
+                deserializer deserial(payload);
+                reply_ec = read_error_code(deserial);
+                if (!reply_ec)
+                    result = read_result(deserial);
+            }
+            catch (const end_of_stream&)
+            {
+                reply_ec = error::bad_stream;
+            }
+            handle_fetch(reply_ec, result);
+        };
+}
+
+message::block read_header_reply(deserializer& deserial)
+{
+    return read_block_header(deserial);
+}
+
+message::inventory_list read_tx_hashes_reply(deserializer& deserial)
+{
+    message::inventory_list tx_hashes;
+    uint32_t count = deserial.read_4_bytes();
+    for (size_t i = 0; i < count; ++i)
+    {
+        message::inventory_vector tx_inv;
+        tx_inv.type = message::inventory_type::transaction;
+        tx_inv.hash = deserial.read_hash();
+        tx_hashes.push_back(tx_inv);
+    }
+    return tx_hashes;
+}
+
+size_t read_depth_reply(deserializer& deserial)
+{
+    return deserial.read_4_bytes();
+}
+
+message::transaction read_transaction_reply(deserializer& deserial)
+{
+    message::transaction tx;
+    read_transaction(deserial, tx);
+    return tx;
+}
+
+message::input_point read_spend_reply(deserializer& deserial)
+{
+    message::input_point inpoint;
+    inpoint.hash = deserial.read_hash();
+    inpoint.index = deserial.read_4_bytes();
+    return inpoint;
+}
+
+query_client::query_client(async_service& service)
+  : strand_(service.get_service()), socket_(service.get_service()),
+    stopped_(true), last_id_(0)
+{
+}
+query_client::~query_client()
+{
+    BITCOIN_ASSERT(stopped_);
+}
+
+void query_client::connect(const std::string& socket_path,
+    connect_handler handle_connect)
+{
+    socket_.async_connect(local_endpoint(socket_path),
+        strand_.wrap(
+            [this, handle_connect](const boost::system::error_code& ec)
+            {
+                if (ec)
+                {
+                    handle_connect(error::network_unreachable);
+                    return;
+                }
+                stopped_ = false;
+                read_header();
+                handle_connect(std::error_code());
+            }));
+}
+
+void query_client::stop()
+{
+    strand_.dispatch(std::bind(&query_client::do_stop, this));
+}
+void query_client::do_stop()
+{
+    if (stopped_)
+        return;
+    stopped_ = true;
+    boost::system::error_code ret_ec;
+    socket_.close(ret_ec);
+    outbound_.clear();
+    // Fail everything still outstanding
+    frame_handler_map pending;
+    pending.swap(pending_);
+    for (const auto& pending_request: pending)
+        pending_request.second(error::service_stopped, data_chunk(), false);
+}
+
+void query_client::send_request(query_command command,
+    const data_chunk& payload, frame_handler handle_frame)
+{
+    strand_.post(std::bind(&query_client::do_send_request,
+        this, command, payload, handle_frame));
+}
+void query_client::do_send_request(query_command command,
+    const data_chunk& payload, frame_handler handle_frame)
+{
+    if (stopped_)
+    {
+        handle_frame(error::service_stopped, data_chunk(), false);
+        return;
+    }
+    uint32_t id = ++last_id_;
+    pending_[id] = handle_frame;
+    outbound_.push_back(create_query_frame(id, command, 0, payload));
+    // Otherwise handle_write() picks it up. Requests keep being written
+    // without waiting for replies.
+    if (outbound_.size() == 1)
+        write_next();
+}
+void query_client::write_next()
+{
+    BITCOIN_ASSERT(!outbound_.empty());
+    async_write(socket_, buffer(outbound_.front()),
+        strand_.wrap(std::bind(&query_client::handle_write, this, _1)));
+}
+void query_client::handle_write(const boost::system::error_code& ec)
+{
+    if (ec)
+    {
+        do_stop();
+        return;
+    }
+    if (stopped_)
+        return;
+    outbound_.pop_front();
+    if (!outbound_.empty())
+        write_next();
+}
+
+void query_client::read_header()
+{
+    async_read(socket_, buffer(inbound_header_),
+        strand_.wrap(std::bind(&query_client::handle_read_header,
+            this, _1, _2)));
+}
+
+void query_client::handle_read_header(const boost::system::error_code& ec,
+    size_t bytes_transferred)
+{
+    if (ec)
+    {
+        do_stop();
+        return;
+    }
+    BITCOIN_ASSERT(bytes_transferred == query_frame_header_size);
+    const data_chunk raw_header(inbound_header_.begin(), inbound_header_.end());
+    const query_frame_header head = read_query_frame_header(raw_header);
+    if (head.payload_length > query_max_payload_length)
+    {
+        log_debug(log_domain::query) << "Bad query frame received.";
+        do_stop();
+        return;
+    }
+    inbound_payload_.resize(head.payload_length);
+    async_read(socket_, buffer(inbound_payload_),
+        strand_.wrap(std::bind(&query_client::handle_read_payload,
+            this, _1, _2, head)));
+}
+
+void query_client::handle_read_payload(const boost::system::error_code& ec,
+    size_t bytes_transferred, const query_frame_header& head)
+{
+    if (ec)
+    {
+        do_stop();
+        return;
+    }
+    BITCOIN_ASSERT(bytes_transferred == head.payload_length);
+    auto it = pending_.find(head.id);
+    if (it == pending_.end())
+        log_debug(log_domain::query)
+            << "Query reply for unknown request " << head.id;
+    else
+    {
+        bool more = head.flags & query_flags::more;
+        frame_handler handle_frame = it->second;
+        if (!more)
+            pending_.erase(it);
+        handle_frame(std::error_code(), inbound_payload_, more);
+    }
+    read_header();
+}
+
+void query_client::fetch_block_header(size_t depth,
+    blockchain::fetch_handler_block_header handle_fetch)
+{
+    serializer serial;
+    serial.write_4_bytes(depth);
+    send_request(query_command::block_header_by_depth, serial.data(),
+        decode_reply<message::block>(read_header_reply, handle_fetch));
+}
+void query_client::fetch_block_header(const hash_digest& block_hash,
+    blockchain::fetch_handler_block_header handle_fetch)
+{
+    serializer serial;
+    serial.write_hash(block_hash);
+    send_request(query_command::block_header_by_hash, serial.data(),
+        decode_reply<message::block>(read_header_reply, handle_fetch));
+}
+
+void query_client::fetch_block_transaction_hashes(size_t depth,
+    blockchain::fetch_handler_block_transaction_hashes handle_fetch)
+{
+    serializer serial;
+    serial.write_4_bytes(depth);
+    send_request(query_command::block_transaction_hashes_by_depth,
+        serial.data(), decode_reply<message::inventory_list>(
+            read_tx_hashes_reply, handle_fetch));
+}
+void query_client::fetch_block_transaction_hashes(
+    const hash_digest& block_hash,
+    blockchain::fetch_handler_block_transaction_hashes handle_fetch)
+{
+    serializer serial;
+    serial.write_hash(block_hash);
+    send_request(query_command::block_transaction_hashes_by_hash,
+        serial.data(), decode_reply<message::inventory_list>(
+            read_tx_hashes_reply, handle_fetch));
+}
+
+void query_client::fetch_block_depth(const hash_digest& block_hash,
+    blockchain::fetch_handler_block_depth handle_fetch)
+{
+    serializer serial;
+    serial.write_hash(block_hash);
+    send_request(query_command::block_depth, serial.data(),
+        decode_reply<size_t>(read_depth_reply, handle_fetch));
+}
+
+void query_client::fetch_last_depth(
+    blockchain::fetch_handler_last_depth handle_fetch)
+{
+    send_request(query_command::last_depth, data_chunk(),
+        decode_reply<size_t>(read_depth_reply, handle_fetch));
+}
+
+void query_client::fetch_transaction(const hash_digest& transaction_hash,
+    blockchain::fetch_handler_transaction handle_fetch)
+{
+    serializer serial;
+    serial.write_hash(transaction_hash);
+    send_request(query_command::transaction, serial.data(),
+        decode_reply<message::transaction>(
+            read_transaction_reply, handle_fetch));
+}
+
+void query_client::fetch_transaction_index(
+    const hash_digest& transaction_hash,
+    blockchain::fetch_handler_transaction_index handle_fetch)
+{
+    serializer serial;
+    serial.write_hash(transaction_hash);
+    // Two values so decode_reply() doesn't fit
+    auto handle_frame =
+        [handle_fetch](const std::error_code& ec,
+            const data_chunk& payload, bool)
+        {
+            if (ec)
+            {
+                handle_fetch(ec, 0, 0);
+                return;
+            }
+            try
+            {
+                deserializer deserial(payload);
+                std::error_code reply_ec = read_error_code(deserial);
+                if (reply_ec)
+                {
+                    handle_fetch(reply_ec, 0, 0);
+                    return;
+                }
+                size_t depth = deserial.read_4_bytes();
+                size_t offset = deserial.read_4_bytes();
+                handle_fetch(std::error_code(), depth, offset);
+            }
+            catch (const end_of_stream&)
+            {
+                handle_fetch(error::bad_stream, 0, 0);
+            }
+        };
+    send_request(query_command::transaction_index, serial.data(),
+        handle_frame);
+}
+
+void query_client::fetch_spend(const message::output_point& outpoint,
+    blockchain::fetch_handler_spend handle_fetch)
+{
+    serializer serial;
+    serial.write_hash(outpoint.hash);
+    serial.write_4_bytes(outpoint.index);
+    send_request(query_command::spend, serial.data(),
+        decode_reply<message::input_point>(read_spend_reply, handle_fetch));
+}
+
+void query_client::fetch_outputs(const payment_address& address,
+    blockchain::fetch_handler_outputs handle_fetch)
+{
+    serializer serial;
+    serial.write_byte(address.version());
+    serial.write_short_hash(address.hash());
+    // Frames are accumulated here until the last one arrives
+    auto outpoints = std::make_shared<message::output_point_list>();
+    // Frames after an error are ignored. handle_fetch is called once.
+    auto done = std::make_shared<bool>(false);
+    auto handle_frame =
+        [handle_fetch, outpoints, done](const std::error_code& ec,
+            const data_chunk& payload, bool more)
+        {
+            if (*done)
+                return;
+            if (ec)
+            {
+                *done = true;
+                handle_fetch(ec, message::output_point_list());
+                return;
+            }
+            std::error_code reply_ec;
+            try
+            {
+                deserializer deserial(payload);
+                reply_ec = read_error_code(deserial);
+                uint32_t count = deserial.read_4_bytes();
+                for (size_t i = 0; i < count; ++i)
+                {
+                    message::output_point outpoint;
+                    outpoint.hash = deserial.read_hash();
+                    outpoint.index = deserial.read_4_bytes();
+                    outpoints->push_back(outpoint);
+                }
+            }
+            catch (const end_of_stream&)
+            {
+                reply_ec = error::bad_stream;
+            }
+            if (reply_ec)
+            {
+                *done = true;
+                handle_fetch(reply_ec, message::output_point_list());
+            }
+            else if (!more)
+            {
+                *done = true;
+                handle_fetch(std::error_code(), *outpoints);
+            }
+        };
+    send_request(query_command::outputs, serial.data(), handle_frame);
+}
+
+void query_client::fetch_pool_transaction(
+    const hash_digest& transaction_hash,
+    blockchain::fetch_handler_transaction handle_fetch)
+{
+    serializer serial;
+    serial.write_hash(transaction_hash);
+    send_request(query_command::pool_transaction, serial.data(),
+        decode_reply<message::transaction>(
+            read_transaction_reply, handle_fetch));
+}
+
+void query_client::fetch_block_headers(size_t depth, size_t count,
+    fetch_handler_block_headers handle_fetch)
+{
+    serializer serial;
+    serial.write_4_bytes(depth);
+    serial.write_4_bytes(count);
+    // Nothing more is passed on after an error
+    auto failed = std::make_shared<bool>(false);
+    auto handle_frame =
+        [handle_fetch, failed](const std::error_code& ec,
+            const data_chunk& payload, bool more)
+        {
+            if (*failed)
+                return;
+            if (ec)
+            {
+                *failed = true;
+                handle_fetch(ec, block_header_list(), false);
+                return;
+            }
+            block_header_list headers;
+            std::error_code reply_ec;
+            try
+            {
+                deserializer deserial(payload);
+                reply_ec = read_error_code(deserial);
+                uint32_t headers_count = deserial.read_4_bytes();
+                for (size_t i = 0; i < headers_count; ++i)
+                    headers.push_back(read_block_header(deserial));
+            }
+            catch (const end_of_stream&)
+            {
+                reply_ec = error::bad_stream;
+            }
+            if (reply_ec)
+            {
+                *failed = true;
+                handle_fetch(reply_ec, headers, false);
+                return;
+            }
+            handle_fetch(reply_ec, headers, more);
+        };
+    send_request(query_command::block_headers, serial.data(), handle_frame);
+}
+
+} // namespace libbitcoin
+
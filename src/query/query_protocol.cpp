@@ -0,0 +1,76 @@
+#include <bitcoin/query/query_protocol.hpp>
+
+#include <bitcoin/error.hpp>
+#include <bitcoin/utility/assert.hpp>
+
+namespace libbitcoin {
+
+bool is_query_command(uint8_t raw_command)
+{
+    return raw_command >=
+            static_cast<uint8_t>(query_command::block_header_by_depth) &&
+        raw_command <= static_cast<uint8_t>(query_command::block_headers);
+}
+
+data_chunk create_query_frame(uint32_t id, query_command command,
+    uint8_t flags, const data_chunk& payload)
+{
+    BITCOIN_ASSERT(payload.size() <= query_max_payload_length);
+    serializer serial;
+    serial.write_4_bytes(payload.size());
+    serial.write_4_bytes(id);
+    serial.write_byte(static_cast<uint8_t>(command));
+    serial.write_byte(flags);
+    serial.write_data(payload);
+    return serial.data();
+}
+
+query_frame_header read_query_frame_header(const data_chunk& raw_header)
+{
+    BITCOIN_ASSERT(raw_header.size() == query_frame_header_size);
+    deserializer deserial(raw_header);
+    query_frame_header head;
+    head.payload_length = deserial.read_4_bytes();
+    head.id = deserial.read_4_bytes();
+    head.command = static_cast<query_command>(deserial.read_byte());
+    head.flags = deserial.read_byte();
+    return head;
+}
+
+void write_error_code(serializer& serial, const std::error_code& ec)
+{
+    serial.write_4_bytes(ec.value());
+}
+
+std::error_code read_error_code(deserializer& deserial)
+{
+    uint32_t value = deserial.read_4_bytes();
+    if (value == 0)
+        return std::error_code();
+    return error::make_error_code(static_cast<error::error_code_t>(value));
+}
+
+void write_block_header(serializer& serial, const message::block& blk)
+{
+    serial.write_4_bytes(blk.version);
+    serial.write_hash(blk.previous_block_hash);
+    serial.write_hash(blk.merkle);
+    serial.write_4_bytes(blk.timestamp);
+    serial.write_4_bytes(blk.bits);
+    serial.write_4_bytes(blk.nonce);
+}
+
+message::block read_block_header(deserializer& deserial)
+{
+    message::block blk;
+    blk.version = deserial.read_4_bytes();
+    blk.previous_block_hash = deserial.read_hash();
+    blk.merkle = deserial.read_hash();
+    blk.timestamp = deserial.read_4_bytes();
+    blk.bits = deserial.read_4_bytes();
+    blk.nonce = deserial.read_4_bytes();
+    return blk;
+}
+
+} // namespace libbitcoin
+
@@ -0,0 +1,688 @@
+#include <bitcoin/query/query_server.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <deque>
+
+#include <sys/stat.h>
+#include <boost/array.hpp>
+
+#include <bitcoin/address.hpp>
+#include <bitcoin/error.hpp>
+#include <bitcoin/satoshi_serialize.hpp>
+#include <bitcoin/transaction_pool.hpp>
+#include <bitcoin/blockchain/blockchain.hpp>
+#include <bitcoin/utility/assert.hpp>
+#include <bitcoin/utility/logger.hpp>
+
+namespace libbitcoin {
+
+using std::placeholders::_1;
+using std::placeholders::_2;
+using boost::asio::buffer;
+
+typedef boost::asio::local::stream_protocol::endpoint local_endpoint;
+
+// Streamed results are split into frames of this many items
+constexpr size_t outputs_per_frame = 1000;
+constexpr size_t headers_per_frame = 500;
+// Requesters waiting on one lookup. More are turned away.
+constexpr size_t max_waiters = 1000;
+// Requests from one client still waiting on their reply. More are
+// turned away.
+constexpr size_t max_requests_per_connection = 100;
+// Replies queued up for a client that isn't reading them. Past this
+// the client is dropped.
+constexpr size_t max_outbound_bytes = 64 * 1024 * 1024;
+
+data_chunk error_reply(const std::error_code& ec)
+{
+    serializer serial;
+    write_error_code(serial, ec);
+    return serial.data();
+}
+
+class query_connection
+  : public std::enable_shared_from_this<query_connection>
+{
+public:
+    typedef boost::asio::local::stream_protocol::socket local_socket;
+
+    query_connection(async_service& service, query_server& server);
+
+    query_connection(const query_connection&) = delete;
+    void operator=(const query_connection&) = delete;
+
+    local_socket& socket();
+
+    void start();
+    void stop();
+    bool stopped() const;
+
+    void send(const data_chunk& frame);
+
+private:
+    void read_header();
+    void handle_read_header(const boost::system::error_code& ec,
+        size_t bytes_transferred);
+    void handle_read_payload(const boost::system::error_code& ec,
+        size_t bytes_transferred, const query_frame_header& head);
+
+    void do_send(const data_chunk& frame);
+    // Doesn't count towards the requests in flight
+    void queue_frame(const data_chunk& frame);
+    void write_next();
+    void handle_write(const boost::system::error_code& ec);
+
+    void do_stop();
+
+    io_service::strand strand_;
+    local_socket socket_;
+    query_server& server_;
+    std::atomic<bool> stopped_;
+
+    boost::array<uint8_t, query_frame_header_size> inbound_header_;
+    data_chunk inbound_payload_;
+    // Requests passed to the server which haven't had their last frame
+    size_t in_flight_;
+    // Frames are written one at a time in order
+    std::deque<data_chunk> outbound_;
+    size_t outbound_bytes_;
+};
+
+query_connection::query_connection(
+    async_service& service, query_server& server)
+  : strand_(service.get_service()), socket_(service.get_service()),
+    server_(server), stopped_(false), in_flight_(0), outbound_bytes_(0)
+{
+}
+
+query_connection::local_socket& query_connection::socket()
+{
+    return socket_;
+}
+
+void query_connection::start()
+{
+    strand_.post(std::bind(&query_connection::read_header,
+        shared_from_this()));
+}
+
+void query_connection::stop()
+{
+    strand_.post(std::bind(&query_connection::do_stop,
+        shared_from_this()));
+}
+void query_connection::do_stop()
+{
+    if (stopped_)
+        return;
+    stopped_ = true;
+    boost::system::error_code ret_ec;
+    socket_.close(ret_ec);
+    outbound_.clear();
+    outbound_bytes_ = 0;
+}
+
+bool query_connection::stopped() const
+{
+    return stopped_;
+}
+
+void query_connection::read_header()
+{
+    async_read(socket_, buffer(inbound_header_),
+        strand_.wrap(std::bind(&query_connection::handle_read_header,
+            shared_from_this(), _1, _2)));
+}
+
+void query_connection::handle_read_header(
+    const boost::system::error_code& ec, size_t bytes_transferred)
+{
+    if (ec)
+    {
+        do_stop();
+        return;
+    }
+    BITCOIN_ASSERT(bytes_transferred == query_frame_header_size);
+    const data_chunk raw_header(inbound_header_.begin(), inbound_header_.end());
+    const query_frame_header head = read_query_frame_header(raw_header);
+    if (head.payload_length > query_max_payload_length ||
+        !is_query_command(static_cast<uint8_t>(head.command)))
+    {
+        log_debug(log_domain::query) << "Bad query frame received.";
+        do_stop();
+        return;
+    }
+    inbound_payload_.resize(head.payload_length);
+    async_read(socket_, buffer(inbound_payload_),
+        strand_.wrap(std::bind(&query_connection::handle_read_payload,
+            shared_from_this(), _1, _2, head)));
+}
+
+void query_connection::handle_read_payload(
+    const boost::system::error_code& ec, size_t bytes_transferred,
+    const query_frame_header& head)
+{
+    if (ec)
+    {
+        do_stop();
+        return;
+    }
+    BITCOIN_ASSERT(bytes_transferred == head.payload_length);
+    if (in_flight_ >= max_requests_per_connection)
+        queue_frame(create_query_frame(head.id, head.command,
+            0, error_reply(error::server_busy)));
+    else
+    {
+        ++in_flight_;
+        server_.request(shared_from_this(), head, inbound_payload_);
+    }
+    // Requests are pipelined so carry on reading straight away
+    read_header();
+}
+
+void query_connection::send(const data_chunk& frame)
+{
+    strand_.post(std::bind(&query_connection::do_send,
+        shared_from_this(), frame));
+}
+void query_connection::do_send(const data_chunk& frame)
+{
+    if (stopped_)
+        return;
+    // The last frame of a reply frees up its request's slot
+    const query_frame_header head = read_query_frame_header(data_chunk(
+        frame.begin(), frame.begin() + query_frame_header_size));
+    if ((head.flags & query_flags::more) == 0)
+    {
+        BITCOIN_ASSERT(in_flight_ > 0);
+        --in_flight_;
+    }
+    queue_frame(frame);
+}
+void query_connection::queue_frame(const data_chunk& frame)
+{
+    if (stopped_)
+        return;
+    outbound_bytes_ += frame.size();
+    if (outbound_bytes_ > max_outbound_bytes)
+    {
+        log_debug(log_domain::query)
+            << "Query client isn't reading its replies.";
+        do_stop();
+        return;
+    }
+    outbound_.push_back(frame);
+    // Otherwise handle_write() will pick it up
+    if (outbound_.size() == 1)
+        write_next();
+}
+void query_connection::write_next()
+{
+    BITCOIN_ASSERT(!outbound_.empty());
+    async_write(socket_, buffer(outbound_.front()),
+        strand_.wrap(std::bind(&query_connection::handle_write,
+            shared_from_this(), _1)));
+}
+void query_connection::handle_write(const boost::system::error_code& ec)
+{
+    if (ec)
+    {
+        do_stop();
+        return;
+    }
+    if (stopped_)
+        return;
+    outbound_bytes_ -= outbound_.front().size();
+    outbound_.pop_front();
+    if (!outbound_.empty())
+        write_next();
+}
+
+// Results are encoded once so batched requesters share the same payload.
+
+template <typename Handler>
+blockchain::fetch_handler_block_header reply_block_header(
+    Handler handle_reply)
+{
+    return [handle_reply](const std::error_code& ec,
+        const message::block& blk)
+        {
+            serializer serial;
+            write_error_code(serial, ec);
+            if (!ec)
+                write_block_header(serial, blk);
+            handle_reply(serial.data());
+        };
+}
+
+template <typename Handler>
+blockchain::fetch_handler_block_transaction_hashes reply_tx_hashes(
+    Handler handle_reply)
+{
+    return [handle_reply](const std::error_code& ec,
+        const message::inventory_list& tx_hashes)
+        {
+            serializer serial;
+            write_error_code(serial, ec);
+            if (!ec)
+            {
+                serial.write_4_bytes(tx_hashes.size());
+                for (const message::inventory_vector& tx_inv: tx_hashes)
+                    serial.write_hash(tx_inv.hash);
+            }
+            handle_reply(serial.data());
+        };
+}
+
+template <typename Handler>
+blockchain::fetch_handler_block_depth reply_depth(Handler handle_reply)
+{
+    return [handle_reply](const std::error_code& ec, size_t depth)
+        {
+            serializer serial;
+            write_error_code(serial, ec);
+            if (!ec)
+                serial.write_4_bytes(depth);
+            handle_reply(serial.data());
+        };
+}
+
+template <typename Handler>
+blockchain::fetch_handler_transaction reply_transaction(Handler handle_reply)
+{
+    return [handle_reply](const std::error_code& ec,
+        const message::transaction& tx)
+        {
+            serializer serial;
+            write_error_code(serial, ec);
+            if (!ec)
+                save_transaction(serial, tx);
+            handle_reply(serial.data());
+        };
+}
+
+template <typename Handler>
+blockchain::fetch_handler_transaction_index reply_transaction_index(
+    Handler handle_reply)
+{
+    return [handle_reply](const std::error_code& ec,
+        size_t depth, size_t offset)
+        {
+            serializer serial;
+            write_error_code(serial, ec);
+            if (!ec)
+            {
+                serial.write_4_bytes(depth);
+                serial.write_4_bytes(offset);
+            }
+            handle_reply(serial.data());
+        };
+}
+
+template <typename Handler>
+blockchain::fetch_handler_spend reply_spend(Handler handle_reply)
+{
+    return [handle_reply](const std::error_code& ec,
+        const message::input_point& inpoint)
+        {
+            serializer serial;
+            write_error_code(serial, ec);
+            if (!ec)
+            {
+                serial.write_hash(inpoint.hash);
+                serial.write_4_bytes(inpoint.index);
+            }
+            handle_reply(serial.data());
+        };
+}
+
+query_server::query_server(async_service& service,
+    blockchain& chain, transaction_pool& txpool)
+  : service_(service), strand_(service.get_service()),
+    chain_(chain), txpool_(txpool), acceptor_(service.get_service())
+{
+}
+query_server::~query_server()
+{
+    stop();
+}
+
+void query_server::start(const std::string& socket_path,
+    start_handler handle_start)
+{
+    // Socket file from a previous run. Anything else at that path is
+    // a configuration mistake and isn't ours to delete.
+    struct stat existing;
+    if (stat(socket_path.c_str(), &existing) == 0)
+    {
+        if (!S_ISSOCK(existing.st_mode))
+        {
+            log_error(log_domain::query) << "Not listening on "
+                << socket_path << ": a file which isn't a socket is there";
+            handle_start(error::listen_failed);
+            return;
+        }
+        std::remove(socket_path.c_str());
+    }
+    local_endpoint endpoint(socket_path);
+    boost::system::error_code ec;
+    acceptor_.open(endpoint.protocol(), ec);
+    if (!ec)
+        acceptor_.bind(endpoint, ec);
+    if (!ec)
+        acceptor_.listen(boost::asio::socket_base::max_connections, ec);
+    if (ec)
+    {
+        log_error(log_domain::query) << "Listening on " << socket_path
+            << " failed: " << ec.message();
+        handle_start(error::listen_failed);
+        return;
+    }
+    socket_path_ = socket_path;
+    accept_next();
+    handle_start(std::error_code());
+}
+
+void query_server::stop()
+{
+    if (!acceptor_.is_open())
+        return;
+    boost::system::error_code ret_ec;
+    acceptor_.close(ret_ec);
+    std::remove(socket_path_.c_str());
+    std::lock_guard<std::mutex> lock(connections_mutex_);
+    for (std::weak_ptr<query_connection> weak_connection: connections_)
+    {
+        query_connection_ptr connection = weak_connection.lock();
+        if (connection)
+            connection->stop();
+    }
+    connections_.clear();
+}
+
+void query_server::accept_next()
+{
+    query_connection_ptr connection =
+        std::make_shared<query_connection>(service_, *this);
+    acceptor_.async_accept(connection->socket(),
+        strand_.wrap(std::bind(&query_server::handle_accept,
+            this, _1, connection)));
+}
+
+void query_server::handle_accept(const boost::system::error_code& ec,
+    query_connection_ptr connection)
+{
+    if (ec == boost::asio::error::operation_aborted)
+        return;
+    if (ec)
+        log_warning(log_domain::query) << "Accepting query client failed: "
+            << ec.message();
+    else
+    {
+        std::lock_guard<std::mutex> lock(connections_mutex_);
+        // Forget clients which have gone away
+        auto is_expired =
+            [](const std::weak_ptr<query_connection>& weak_connection)
+            {
+                return weak_connection.expired();
+            };
+        connections_.erase(std::remove_if(connections_.begin(),
+            connections_.end(), is_expired), connections_.end());
+        connections_.push_back(connection);
+        connection->start();
+    }
+    accept_next();
+}
+
+void query_server::request(query_connection_ptr connection,
+    const query_frame_header& head, const data_chunk& payload)
+{
+    strand_.post(std::bind(&query_server::do_request,
+        this, connection, head, payload));
+}
+void query_server::do_request(query_connection_ptr connection,
+    const query_frame_header& head, const data_chunk& payload)
+{
+    // Streams are sent separately to each requester
+    if (head.command == query_command::outputs)
+    {
+        stream_outputs(connection, head.id, payload);
+        return;
+    }
+    else if (head.command == query_command::block_headers)
+    {
+        stream_block_headers(connection, head.id, payload);
+        return;
+    }
+    data_chunk key = payload;
+    key.insert(key.begin(), static_cast<uint8_t>(head.command));
+    auto it = pending_.find(key);
+    if (it != pending_.end())
+    {
+        if (it->second.size() >= max_waiters)
+        {
+            connection->send(create_query_frame(head.id, head.command,
+                0, error_reply(error::server_busy)));
+            return;
+        }
+        // Same lookup is already in flight. Wait for its result.
+        it->second.push_back(waiter{connection, head.id});
+        return;
+    }
+    pending_[key].push_back(waiter{connection, head.id});
+    fetch(head.command, payload,
+        strand_.wrap(std::bind(&query_server::complete,
+            this, key, head.command, _1)));
+}
+
+void query_server::fetch(query_command command, const data_chunk& payload,
+    reply_handler handle_reply)
+{
+    deserializer deserial(payload);
+    try
+    {
+        switch (command)
+        {
+            case query_command::block_header_by_depth:
+                chain_.fetch_block_header(deserial.read_4_bytes(),
+                    reply_block_header(handle_reply));
+                break;
+
+            case query_command::block_header_by_hash:
+                chain_.fetch_block_header(deserial.read_hash(),
+                    reply_block_header(handle_reply));
+                break;
+
+            case query_command::block_transaction_hashes_by_depth:
+                chain_.fetch_block_transaction_hashes(
+                    deserial.read_4_bytes(), reply_tx_hashes(handle_reply));
+                break;
+
+            case query_command::block_transaction_hashes_by_hash:
+                chain_.fetch_block_transaction_hashes(
+                    deserial.read_hash(), reply_tx_hashes(handle_reply));
+                break;
+
+            case query_command::block_depth:
+                chain_.fetch_block_depth(deserial.read_hash(),
+                    reply_depth(handle_reply));
+                break;
+
+            case query_command::last_depth:
+                chain_.fetch_last_depth(reply_depth(handle_reply));
+                break;
+
+            case query_command::transaction:
+                chain_.fetch_transaction(deserial.read_hash(),
+                    reply_transaction(handle_reply));
+                break;
+
+            case query_command::transaction_index:
+                chain_.fetch_transaction_index(deserial.read_hash(),
+                    reply_transaction_index(handle_reply));
+                break;
+
+            case query_command::spend:
+            {
+                message::output_point outpoint;
+                outpoint.hash = deserial.read_hash();
+                outpoint.index = deserial.read_4_bytes();
+                chain_.fetch_spend(outpoint, reply_spend(handle_reply));
+                break;
+            }
+
+            case query_command::pool_transaction:
+                txpool_.fetch(deserial.read_hash(),
+                    reply_transaction(handle_reply));
+                break;
+
+            // Streamed commands are handled by do_request()
+            case query_command::outputs:
+            case query_command::block_headers:
+            default:
+                BITCOIN_ASSERT(false);
+                handle_reply(error_reply(error::bad_stream));
+                break;
+        }
+    }
+    catch (const end_of_stream&)
+    {
+        handle_reply(error_reply(error::bad_stream));
+    }
+}
+
+void query_server::complete(const data_chunk& key,
+    query_command command, const data_chunk& reply)
+{
+    auto it = pending_.find(key);
+    BITCOIN_ASSERT(it != pending_.end());
+    for (const waiter& wait: it->second)
+        wait.connection->send(create_query_frame(wait.id, command, 0, reply));
+    pending_.erase(it);
+}
+
+void query_server::stream_outputs(query_connection_ptr connection,
+    uint32_t id, const data_chunk& payload)
+{
+    payment_address address;
+    try
+    {
+        deserializer deserial(payload);
+        byte version_byte = deserial.read_byte();
+        if (!address.set_raw(version_byte, deserial.read_short_hash()))
+        {
+            connection->send(create_query_frame(id, query_command::outputs,
+                0, error_reply(error::unsupported_payment_type)));
+            return;
+        }
+    }
+    catch (const end_of_stream&)
+    {
+        connection->send(create_query_frame(id, query_command::outputs,
+            0, error_reply(error::bad_stream)));
+        return;
+    }
+    auto send_outputs =
+        [connection, id](const std::error_code& ec,
+            const message::output_point_list& outpoints)
+        {
+            // Always at least one frame, even when there's nothing
+            size_t position = 0;
+            do
+            {
+                size_t count = std::min(outputs_per_frame,
+                    outpoints.size() - position);
+                serializer serial;
+                write_error_code(serial, ec);
+                serial.write_4_bytes(count);
+                for (size_t i = position; i < position + count; ++i)
+                {
+                    serial.write_hash(outpoints[i].hash);
+                    serial.write_4_bytes(outpoints[i].index);
+                }
+                position += count;
+                uint8_t flags = position < outpoints.size() ?
+                    query_flags::more : 0;
+                connection->send(create_query_frame(id,
+                    query_command::outputs, flags, serial.data()));
+            }
+            while (position < outpoints.size());
+        };
+    chain_.fetch_outputs(address, send_outputs);
+}
+
+struct query_server::header_stream
+{
+    query_connection_ptr connection;
+    uint32_t id;
+    size_t depth, end_depth;
+    std::vector<message::block> headers;
+};
+
+void query_server::stream_block_headers(query_connection_ptr connection,
+    uint32_t id, const data_chunk& payload)
+{
+    header_stream_ptr stream = std::make_shared<header_stream>();
+    stream->connection = connection;
+    stream->id = id;
+    try
+    {
+        deserializer deserial(payload);
+        stream->depth = deserial.read_4_bytes();
+        stream->end_depth = stream->depth + deserial.read_4_bytes();
+    }
+    catch (const end_of_stream&)
+    {
+        connection->send(create_query_frame(id, query_command::block_headers,
+            0, error_reply(error::bad_stream)));
+        return;
+    }
+    if (stream->depth == stream->end_depth)
+        handle_block_header(std::error_code(), message::block(), stream);
+    else
+        next_block_header(stream);
+}
+
+void query_server::next_block_header(header_stream_ptr stream)
+{
+    // Headers are read one by one so only a frame's worth is held in memory
+    chain_.fetch_block_header(stream->depth,
+        strand_.wrap(std::bind(&query_server::handle_block_header,
+            this, _1, _2, stream)));
+}
+
+void query_server::handle_block_header(const std::error_code& ec,
+    const message::block& blk, header_stream_ptr stream)
+{
+    // Client went away
+    if (stream->connection->stopped())
+        return;
+    bool finished = ec || stream->depth == stream->end_depth;
+    if (!finished)
+    {
+        stream->headers.push_back(blk);
+        ++stream->depth;
+        finished = stream->depth == stream->end_depth;
+    }
+    if (finished || stream->headers.size() == headers_per_frame)
+    {
+        // Reaching the end of the chain ends the stream with not_found
+        serializer serial;
+        write_error_code(serial, ec);
+        serial.write_4_bytes(stream->headers.size());
+        for (const message::block& header: stream->headers)
+            write_block_header(serial, header);
+        stream->connection->send(create_query_frame(stream->id,
+            query_command::block_headers,
+            finished ? 0 : query_flags::more, serial.data()));
+        stream->headers.clear();
+    }
+    if (!finished)
+        next_block_header(stream);
+}
+
+} // namespace libbitcoin
+
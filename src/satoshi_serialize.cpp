@@ -181,7 +181,7 @@ message::transaction read_transaction(
         else
             input.input_script = read_script(deserial);
         input.sequence = deserial.read_4_bytes();
-        packet.inputs.push_back(input);
+        packet.inputs.push_back(std::move(input));
     }
     uint64_t tx_out_count = deserial.read_variable_uint();
     for (size_t tx_out_i = 0; tx_out_i < tx_out_count; ++tx_out_i)
@@ -189,7 +189,7 @@ message::transaction read_transaction(
         message::transaction_output output;
         output.value = deserial.read_8_bytes();
         output.output_script = read_script(deserial);
-        packet.outputs.push_back(output);
+        packet.outputs.push_back(std::move(output));
     }
     packet.locktime = deserial.read_4_bytes();
     return packet;
@@ -205,18 +205,14 @@ size_t satoshi_raw_size(const transaction& packet)
     tx_size += variable_uint_size(packet.inputs.size());
     for (const message::transaction_input& input: packet.inputs)
     {
-        data_chunk raw_script = save_script(input.input_script);
-        tx_size += 40 +
-            variable_uint_size(raw_script.size()) +
-            raw_script.size();
+        const size_t script_length = script_size(input.input_script);
+        tx_size += 40 + variable_uint_size(script_length) + script_length;
     }
     tx_size += variable_uint_size(packet.outputs.size());
     for (const message::transaction_output& output: packet.outputs)
     {
-        data_chunk raw_script = save_script(output.output_script);
-        tx_size += 8 +
-            variable_uint_size(raw_script.size()) +
-            raw_script.size();
+        const size_t script_length = script_size(output.output_script);
+        tx_size += 8 + variable_uint_size(script_length) + script_length;
     }
     return tx_size;
 }
@@ -233,6 +229,65 @@ size_t satoshi_raw_size(const block& packet)
     return block_size;
 }
 
+void save_block_header(serializer& serial, const message::block& packet)
+{
+    serial.write_4_bytes(packet.version);
+    serial.write_hash(packet.previous_block_hash);
+    serial.write_hash(packet.merkle);
+    serial.write_4_bytes(packet.timestamp);
+    serial.write_4_bytes(packet.bits);
+    serial.write_4_bytes(packet.nonce);
+}
+void read_block_header(deserializer& deserial, message::block& packet)
+{
+    packet.version = deserial.read_4_bytes();
+    packet.previous_block_hash = deserial.read_hash();
+    packet.merkle = deserial.read_hash();
+    packet.timestamp = deserial.read_4_bytes();
+    packet.bits = deserial.read_4_bytes();
+    packet.nonce = deserial.read_4_bytes();
+}
+
+const std::string satoshi_command(const compact_block&)
+{
+    return "cmpctblock";
+}
+size_t satoshi_raw_size(const compact_block& packet)
+{
+    size_t block_size = 80 + 8 +
+        variable_uint_size(packet.short_ids.size()) +
+        short_id_size * packet.short_ids.size() +
+        variable_uint_size(packet.prefilled.size());
+    for (const prefilled_transaction& prefilled: packet.prefilled)
+        block_size += variable_uint_size(prefilled.index) +
+            satoshi_raw_size(prefilled.tx);
+    return block_size;
+}
+
+const std::string satoshi_command(const get_block_transactions&)
+{
+    return "getblocktxn";
+}
+size_t satoshi_raw_size(const get_block_transactions& packet)
+{
+    size_t request_size = 32 + variable_uint_size(packet.indexes.size());
+    for (size_t index: packet.indexes)
+        request_size += variable_uint_size(index);
+    return request_size;
+}
+
+const std::string satoshi_command(const block_transactions&)
+{
+    return "blocktxn";
+}
+size_t satoshi_raw_size(const block_transactions& packet)
+{
+    size_t reply_size = 32 + variable_uint_size(packet.transactions.size());
+    for (const message::transaction& tx: packet.transactions)
+        reply_size += satoshi_raw_size(tx);
+    return reply_size;
+}
+
 const std::string satoshi_command(const ping&)
 {
     return "ping";
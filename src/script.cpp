@@ -1,6 +1,7 @@
 #include <bitcoin/script.hpp>
 
 #include <stack>
+#include <unordered_map>
 
 #include <boost/optional.hpp>
 
@@ -18,8 +19,43 @@ namespace libbitcoin {
 
 typedef boost::optional<size_t> optional_number;
 
-static const data_chunk stack_true_value{1};
-static const data_chunk stack_false_value;  // False is an empty
+static const small_chunk stack_true_value(data_chunk{1});
+static const small_chunk stack_false_value;  // False is an empty
+
+// Stacks hand their storage back here once script::run() finishes so
+// the next run on this thread pushes into memory it already has.
+class script::stack_lease
+{
+public:
+    stack_lease(data_stack& stack)
+      : stack_(stack)
+    {
+        std::vector<data_stack>& spares = spare_stacks();
+        if (!spares.empty())
+        {
+            stack_.swap(spares.back());
+            spares.pop_back();
+        }
+        stack_.clear();
+    }
+    ~stack_lease()
+    {
+        stack_.clear();
+        spare_stacks().push_back(std::move(stack_));
+    }
+
+    stack_lease(const stack_lease&) = delete;
+    void operator=(const stack_lease&) = delete;
+
+private:
+    static std::vector<data_stack>& spare_stacks()
+    {
+        static thread_local std::vector<data_stack> spares;
+        return spares;
+    }
+
+    data_stack& stack_;
+};
 
 bool script::conditional_stack::closed() const
 {
@@ -27,23 +63,32 @@ bool script::conditional_stack::closed() const
 }
 bool script::conditional_stack::has_failed_branches() const
 {
-    return std::count(stack_.begin(), stack_.end(), false) > 0;
+    return failed_ > 0;
 }
 
 void script::conditional_stack::clear()
 {
     stack_.clear();
+    failed_ = 0;
 }
 void script::conditional_stack::open(bool value)
 {
     stack_.push_back(value);
+    if (!value)
+        ++failed_;
 }
 void script::conditional_stack::else_()
 {
     stack_.back() = !stack_.back();
+    if (stack_.back())
+        --failed_;
+    else
+        ++failed_;
 }
 void script::conditional_stack::close()
 {
+    if (!stack_.back())
+        --failed_;
     stack_.pop_back();
 }
 
@@ -51,11 +96,13 @@ void script::join(const script& other)
 {
     operations_.insert(operations_.end(),
         other.operations_.begin(), other.operations_.end());
+    compile_state_ = compile_state::none;
 }
 
 void script::push_operation(operation oper)
 {
-    operations_.push_back(oper);
+    operations_.push_back(std::move(oper));
+    compile_state_ = compile_state::none;
 }
 
 const operation_stack& script::operations() const
@@ -63,7 +110,7 @@ const operation_stack& script::operations() const
     return operations_;
 }
 
-inline bool cast_to_big_number(const data_chunk& raw_number,
+inline bool cast_to_big_number(const small_chunk& raw_number,
     big_number& result)
 {
     // Satoshi bitcoin does it this way.
@@ -71,12 +118,12 @@ inline bool cast_to_big_number(const data_chunk& raw_number,
     if (raw_number.size() > 4)
         return false;
     big_number mid;
-    mid.set_data(raw_number);
+    mid.set_data(raw_number.chunk());
     result.set_data(mid.data());
     return true;
 }
 
-inline bool cast_to_bool(const data_chunk& values)
+inline bool cast_to_bool(const small_chunk& values)
 {
     for (auto it = values.begin(); it != values.end(); ++it)
     {
@@ -128,11 +175,27 @@ bool is_push_only(const operation_stack& operations)
     return count_non_push(operations) == 0;
 }
 
+// The same redeem scripts get spent over and over, so keep them parsed
+// and compiled. Keyed by the hash of the serialized script.
+script& redeem_script(const small_chunk& raw_item)
+{
+    constexpr size_t max_cached_scripts = 1024;
+    typedef std::unordered_map<hash_digest, script> script_cache;
+    static thread_local script_cache cache;
+    const data_chunk raw_script = raw_item.chunk();
+    const hash_digest key = generate_sha256_hash(raw_script);
+    auto it = cache.find(key);
+    if (it != cache.end())
+        return it->second;
+    if (cache.size() >= max_cached_scripts)
+        cache.clear();
+    return cache.emplace(key, parse_script(raw_script)).first->second;
+}
+
 bool script::run(script input_script, const message::transaction& parent_tx,
     uint32_t input_index, bool bip16_enabled)
 {
-    stack_.clear();
-    input_script.stack_.clear();
+    stack_lease lease(stack_), input_lease(input_script.stack_);
     if (!input_script.run(parent_tx, input_index))
         return false;
     stack_ = input_script.stack_;
@@ -148,11 +211,11 @@ bool script::run(script input_script, const message::transaction& parent_tx,
         if (!is_push_only(input_script.operations()))
             return false;
         // Load last input_script stack item as a script
-        data_stack eval_stack = input_script.stack_;
-        script eval_script = parse_script(input_script.stack_.back());
+        script& eval_script = redeem_script(input_script.stack_.back());
+        stack_lease eval_lease(eval_script.stack_);
         // Pop last item and copy as starting stack to eval script
-        eval_stack.pop_back();
-        eval_script.stack_ = eval_stack;
+        eval_script.stack_.assign(
+            input_script.stack_.begin(), input_script.stack_.end() - 1);
         // Run script
         if (!eval_script.run(parent_tx, input_index))
             return false;
@@ -197,62 +260,75 @@ bool opcode_is_disabled(opcode code)
     return true;
 }
 
-bool script::run(const message::transaction& parent_tx, uint32_t input_index)
+constexpr size_t max_operation_count = 201;
+constexpr size_t max_multisig_keys = 20;
+
+bool script::compile()
 {
+    if (compile_state_ != compile_state::none)
+        return compile_state_ == compile_state::valid;
+    compile_state_ = compile_state::invalid;
     if (script_size(*this) > 10000)
         return false;
-    if (count_non_push(operations_) > 201)
+    compiled_operation_count_ = count_non_push(operations_);
+    if (compiled_operation_count_ > max_operation_count)
+        return false;
+    const operation_handler* table = dispatch_table();
+    program_.clear();
+    program_.reserve(operations_.size());
+    for (const operation& op: operations_)
+    {
+        if (op.data.size() > 520)
+            return false;
+        if (opcode_is_disabled(op.code))
+            return false;
+        program_.push_back(table[static_cast<uint8_t>(op.code)]);
+    }
+    compile_state_ = compile_state::valid;
+    return true;
+}
+
+bool script::run(const message::transaction& parent_tx, uint32_t input_index)
+{
+    if (!compile())
         return false;
     alternate_stack_.clear();
+    operation_count_ = compiled_operation_count_;
     codehash_begin_ = operations_.begin();
     conditional_stack_.clear();
-    for (auto it = operations_.begin(); it != operations_.end(); ++it)
-        if (!next_step(it, parent_tx, input_index))
+    auto handler = program_.begin();
+    for (auto it = operations_.begin(); it != operations_.end();
+        ++it, ++handler)
+    {
+        if (!next_step(it, *handler, parent_tx, input_index))
             return false;
+    }
     if (!conditional_stack_.closed())
         return false;
     return true;
 }
 
+inline bool is_condition_opcode(opcode code)
+{
+    return code == opcode::if_
+        || code == opcode::notif
+        || code == opcode::else_
+        || code == opcode::endif;
+}
+
 bool script::next_step(operation_stack::iterator it,
+    operation_handler handler,
     const message::transaction& parent_tx, uint32_t input_index)
 {
-    const operation& op = *it;
-    if (op.data.size() > 520)
-        return false;
-    if (opcode_is_disabled(op.code))
-        return false;
-    auto is_condition_opcode =
-        [](opcode code)
-        {
-            return code == opcode::if_
-                || code == opcode::notif
-                || code == opcode::else_
-                || code == opcode::endif;
-        };
+    // Limits and disabled opcodes were checked by compile()
     bool allow_execution = !conditional_stack_.has_failed_branches();
     // continue onwards to next command.
-    if (!allow_execution && !is_condition_opcode(op.code))
+    if (!allow_execution && !is_condition_opcode(it->code))
         return true;
-    // push data to the stack
-    if (op.code == opcode::zero)
-        stack_.push_back(data_chunk());
-    // These operations may also push empty data (opcode zero)
-    // Hence we check the opcode over the shorter !op.data.empty()
-    else if (op.code == opcode::special
-        || op.code == opcode::pushdata1
-        || op.code == opcode::pushdata2
-        || op.code == opcode::pushdata4)
-    {
-        stack_.push_back(op.data);
-    }
-    else if (op.code == opcode::codeseparator)
-        codehash_begin_ = it;
-    // opcodes above should assert inside run_operation
-    else if (!run_operation(op, parent_tx, input_index))
+    if (!handler(*this, it, parent_tx, input_index))
         return false;
     //log_debug() << "--------------------";
-    //log_debug() << "Run: " << opcode_to_string(op.code);
+    //log_debug() << "Run: " << opcode_to_string(it->code);
     //log_debug() << "Stack:";
     //for (auto s: stack_)
     //    log_debug() << "[" << pretty_hex(s) << "]";
@@ -261,9 +337,9 @@ bool script::next_step(operation_stack::iterator it,
     return true;
 }
 
-data_chunk script::pop_stack()
+small_chunk script::pop_stack()
 {
-    data_chunk value = stack_.back();
+    small_chunk value = stack_.back();
     stack_.pop_back();
     return value;
 }
@@ -347,8 +423,7 @@ bool script::op_toaltstack()
 {
     if (stack_.size() < 1)
         return false;
-    data_chunk move_data = pop_stack();
-    alternate_stack_.push_back(move_data);
+    alternate_stack_.push_back(pop_stack());
     return true;
 }
 
@@ -414,7 +489,7 @@ bool script::op_2rot()
 {
     if (stack_.size() < 6)
         return false;
-    data_chunk first = *(stack_.end() - 6), second = *(stack_.end() - 5);
+    small_chunk first = *(stack_.end() - 6), second = *(stack_.end() - 5);
     stack_.erase(stack_.end() - 6, stack_.end() - 4);
     stack_.push_back(first);
     stack_.push_back(second);
@@ -499,7 +574,7 @@ bool pick_roll_impl(DataStack& stack, bool is_roll)
     if (n >= stack.size())
         return false;
     auto slice_iter = stack.end() - n - 1;
-    data_chunk item = *slice_iter;
+    small_chunk item = *slice_iter;
     if (is_roll)
         stack.erase(slice_iter);
     stack.push_back(item);
@@ -540,7 +615,7 @@ bool script::op_tuck()
 {
     if (stack_.size() < 2)
         return false;
-    data_chunk data = stack_.back();
+    small_chunk data = stack_.back();
     stack_.insert(stack_.end() - 2, data);
     return true;
 }
@@ -799,10 +874,10 @@ bool script::op_ripemd160()
 {
     if (stack_.size() < 1)
         return false;
-    data_chunk data = pop_stack();
-    data_chunk hash(ripemd_length);
+    small_chunk data = pop_stack();
+    std::array<uint8_t, ripemd_length> hash;
     RIPEMD160(data.data(), data.size(), hash.data());
-    stack_.push_back(hash);
+    stack_.push_back(small_chunk(hash.begin(), hash.end()));
     return true;
 }
 
@@ -810,10 +885,10 @@ bool script::op_sha1()
 {
     if (stack_.size() < 1)
         return false;
-    data_chunk data = pop_stack();
-    data_chunk hash(SHA_DIGEST_LENGTH);
+    small_chunk data = pop_stack();
+    std::array<uint8_t, SHA_DIGEST_LENGTH> hash;
     SHA1(data.data(), data.size(), hash.data());
-    stack_.push_back(hash);
+    stack_.push_back(small_chunk(hash.begin(), hash.end()));
     return true;
 }
 
@@ -821,10 +896,10 @@ bool script::op_sha256()
 {
     if (stack_.size() < 1)
         return false;
-    data_chunk data = pop_stack();
-    data_chunk hash(sha256_length);
+    small_chunk data = pop_stack();
+    hash_digest hash;
     SHA256(data.data(), data.size(), hash.data());
-    stack_.push_back(hash);
+    stack_.push_back(small_chunk(hash.begin(), hash.end()));
     return true;
 }
 
@@ -832,11 +907,13 @@ bool script::op_hash160()
 {
     if (stack_.size() < 1)
         return false;
-    data_chunk data = pop_stack();
-    short_hash hash = generate_ripemd_hash(data);
-    // hash must be reversed
-    data_chunk raw_hash(hash.begin(), hash.end());
-    stack_.push_back(raw_hash);
+    small_chunk data = pop_stack();
+    // Same as generate_ripemd_hash() without copying data out
+    hash_digest sha_hash;
+    SHA256(data.data(), data.size(), sha_hash.data());
+    short_hash hash;
+    RIPEMD160(sha_hash.data(), sha_hash.size(), hash.data());
+    stack_.push_back(small_chunk(hash.begin(), hash.end()));
     return true;
 }
 
@@ -844,11 +921,12 @@ bool script::op_hash256()
 {
     if (stack_.size() < 1)
         return false;
-    data_chunk data = pop_stack();
-    hash_digest hash = generate_sha256_hash(data);
-    // hash must be reversed
-    data_chunk raw_hash(hash.rbegin(), hash.rend());
-    stack_.push_back(raw_hash);
+    small_chunk data = pop_stack();
+    // generate_sha256_hash() without its final reversal
+    hash_digest hash;
+    SHA256(data.data(), data.size(), hash.data());
+    SHA256(hash.data(), hash.size(), hash.data());
+    stack_.push_back(small_chunk(hash.begin(), hash.end()));
     return true;
 }
 
@@ -913,17 +991,20 @@ hash_digest script::generate_signature_hash(
     return hash_transaction(parent_tx, hash_type);
 }
 
-bool check_signature(data_chunk signature,
-    const data_chunk& pubkey, const script& script_code,
+bool check_signature(const small_chunk& signature_and_type,
+    const small_chunk& pubkey, const script& script_code,
     const message::transaction& parent_tx, uint32_t input_index)
 {
+    if (signature_and_type.empty())
+        return false;
     elliptic_curve_key key;
-    if (!key.set_public_key(pubkey))
+    if (!key.set_public_key(pubkey.chunk()))
         return false;
 
     uint32_t hash_type = 0;
-    hash_type = signature.back();
-    signature.pop_back();
+    hash_type = signature_and_type.back();
+    data_chunk signature(signature_and_type.begin(),
+        signature_and_type.end() - 1);
 
     hash_digest tx_hash =
         script::generate_signature_hash(
@@ -948,7 +1029,7 @@ bool script::op_checksigverify(
 {
     if (stack_.size() < 2)
         return false;
-    data_chunk pubkey = pop_stack(), signature = pop_stack();
+    small_chunk pubkey = pop_stack(), signature = pop_stack();
 
     script script_code;
     for (auto it = codehash_begin_; it != operations_.end(); ++it)
@@ -994,6 +1075,12 @@ bool script::op_checkmultisigverify(
     data_stack pubkeys;
     if (!read_section(pubkeys))
         return false;
+    if (pubkeys.size() > max_multisig_keys)
+        return false;
+    // Every public key counts towards the operation limit
+    operation_count_ += pubkeys.size();
+    if (operation_count_ > max_operation_count)
+        return false;
 
     data_stack signatures;
     if (!read_section(signatures))
@@ -1020,7 +1107,7 @@ bool script::op_checkmultisigverify(
     // we always advance forwards until we either run out of pubkeys (fail)
     // or finish with our signatures (pass)
     auto pubkey_current = pubkeys.begin();
-    for (const data_chunk& signature: signatures)
+    for (const small_chunk& signature: signatures)
     {
         for (auto pubkey_iter = pubkey_current; ;)
         {
@@ -1040,291 +1127,152 @@ bool script::op_checkmultisigverify(
     return true;
 }
 
-bool script::run_operation(const operation& op, 
-        const message::transaction& parent_tx, uint32_t input_index)
+const script::operation_handler* script::dispatch_table()
 {
-    switch (op.code)
-    {
-        case opcode::zero:
-        case opcode::special:
-        case opcode::pushdata1:
-        case opcode::pushdata2:
-        case opcode::pushdata4:
-            BITCOIN_ASSERT_MSG(op.code == opcode::bad_operation,
-                "Invalid push operation in run_operation");
-            return true;
-
-        case opcode::negative_1:
-            return op_negative_1();
-
-        case opcode::reserved:
-            return false;
-
-        case opcode::op_1:
-        case opcode::op_2:
-        case opcode::op_3:
-        case opcode::op_4:
-        case opcode::op_5:
-        case opcode::op_6:
-        case opcode::op_7:
-        case opcode::op_8:
-        case opcode::op_9:
-        case opcode::op_10:
-        case opcode::op_11:
-        case opcode::op_12:
-        case opcode::op_13:
-        case opcode::op_14:
-        case opcode::op_15:
-        case opcode::op_16:
-            return op_x(op.code);
-
-        case opcode::nop:
-            return true;
-
-        case opcode::ver:
-            return false;
-
-        case opcode::if_:
-            return op_if();
-
-        case opcode::notif:
-            return op_notif();
-
-        case opcode::verif:
-        case opcode::vernotif:
-            BITCOIN_ASSERT_MSG(op.code == opcode::bad_operation,
-                "Disabled opcodes (verif/vernotif) in run_operation");
-            return false;
-
-        case opcode::else_:
-            return op_else();
-
-        case opcode::endif:
-            return op_endif();
-
-        case opcode::verify:
-            return op_verify();
-
-        case opcode::return_:
-            return false;
-
-        case opcode::toaltstack:
-            return op_toaltstack();
-
-        case opcode::fromaltstack:
-            return op_fromaltstack();
-
-        case opcode::op_2drop:
-            return op_2drop();
-
-        case opcode::op_2dup:
-            return op_2dup();
-
-        case opcode::op_3dup:
-            return op_3dup();
-
-        case opcode::op_2over:
-            return op_2over();
-
-        case opcode::op_2rot:
-            return op_2rot();
-
-        case opcode::op_2swap:
-            return op_2swap();
-
-        case opcode::ifdup:
-            return op_ifdup();
-
-        case opcode::depth:
-            return op_depth();
-
-        case opcode::drop:
-            return op_drop();
-
-        case opcode::dup:
-            return op_dup();
-
-        case opcode::nip:
-            return op_nip();
-
-        case opcode::over:
-            return op_over();
-
-        case opcode::pick:
-            return op_pick();
-
-        case opcode::roll:
-            return op_roll();
-
-        case opcode::rot:
-            return op_rot();
-
-        case opcode::swap:
-            return op_swap();
-
-        case opcode::cat:
-        case opcode::substr:
-        case opcode::left:
-        case opcode::right:
-            BITCOIN_ASSERT_MSG(op.code == opcode::bad_operation,
-                "Disabled splice operations in run_operation");
-            return false;
-
-        case opcode::tuck:
-            return op_tuck();
-
-        case opcode::size:
-            return op_size();
-
-        case opcode::invert:
-        case opcode::and_:
-        case opcode::or_:
-        case opcode::xor_:
-            BITCOIN_ASSERT_MSG(op.code == opcode::bad_operation,
-                "Disabled bit logic operations in run_operation");
-            return false;
-
-        case opcode::equal:
-            return op_equal();
-
-        case opcode::equalverify:
-            return op_equalverify();
-
-        case opcode::reserved1:
-        case opcode::reserved2:
-            return false;
-
-        case opcode::op_1add:
-            return op_1add();
-
-        case opcode::op_1sub:
-            return op_1sub();
-
-        case opcode::op_2mul:
-        case opcode::op_2div:
-            BITCOIN_ASSERT_MSG(op.code == opcode::bad_operation,
-                "Disabled opcodes (2mul/2div) in run_operation");
-            return false;
-
-        case opcode::negate:
-            return op_negate();
-
-        case opcode::abs:
-            return op_abs();
-
-        case opcode::not_:
-            return op_not();
-
-        case opcode::op_0notequal:
-            return op_0notequal();
-
-        case opcode::add:
-            return op_add();
-
-        case opcode::sub:
-            return op_sub();
-
-        case opcode::mul:
-        case opcode::div:
-        case opcode::mod:
-        case opcode::lshift:
-        case opcode::rshift:
-            BITCOIN_ASSERT_MSG(op.code == opcode::bad_operation,
-                "Disabled numeric operations in run_operation");
-            return false;
-
-        case opcode::booland:
-            return op_booland();
-
-        case opcode::boolor:
-            return op_boolor();
-
-        case opcode::numequal:
-            return op_numequal();
-
-        case opcode::numequalverify:
-            return op_numequalverify();
-
-        case opcode::numnotequal:
-            return op_numnotequal();
-
-        case opcode::lessthan:
-            return op_lessthan();
-
-        case opcode::greaterthan:
-            return op_greaterthan();
-
-        case opcode::lessthanorequal:
-            return op_lessthanorequal();
-
-        case opcode::greaterthanorequal:
-            return op_greaterthanorequal();
-
-        case opcode::min:
-            return op_min();
-
-        case opcode::max:
-            return op_max();
-
-        case opcode::within:
-            return op_within();
-
-        case opcode::ripemd160:
-            return op_ripemd160();
-
-        case opcode::sha1:
-            return op_sha1();
-
-        case opcode::sha256:
-            return op_sha256();
-
-        case opcode::hash160:
-            return op_hash160();
-
-        case opcode::hash256:
-            return op_hash256();
-
-        case opcode::codeseparator:
-            // This is set in the main run(...) loop
-            // codehash_begin_ is updated to the current
-            // operations_ iterator
-            BITCOIN_ASSERT_MSG(op.code == opcode::bad_operation,
-                "Invalid operation (codeseparator) in run_operation");
-            return true;
-
-        case opcode::checksig:
-            return op_checksig(parent_tx, input_index);
-
-        case opcode::checksigverify:
-            return op_checksigverify(parent_tx, input_index);
-
-        case opcode::checkmultisig:
-            return op_checkmultisig(parent_tx, input_index);
+    static const std::array<operation_handler, 256> table =
+        make_dispatch_table();
+    return table.data();
+}
 
-        case opcode::checkmultisigverify:
-            return op_checkmultisigverify(parent_tx, input_index);
+bool fail_operation(script&, operation_stack::iterator it,
+    const message::transaction&, uint32_t)
+{
+    log_fatal() << "Unimplemented operation <none "
+        << static_cast<int>(it->code) << ">";
+    return false;
+}
 
-        case opcode::op_nop1:
-        case opcode::op_nop2:
-        case opcode::op_nop3:
-        case opcode::op_nop4:
-        case opcode::op_nop5:
-        case opcode::op_nop6:
-        case opcode::op_nop7:
-        case opcode::op_nop8:
-        case opcode::op_nop9:
-        case opcode::op_nop10:
-            return true;
+std::array<script::operation_handler, 256> script::make_dispatch_table()
+{
+    std::array<operation_handler, 256> table;
+    table.fill(fail_operation);
 
-        case opcode::raw_data:
-            return false;
+#define SCRIPT_OPERATION(CODE, ...) \
+    table[static_cast<uint8_t>(opcode::CODE)] = \
+        [](script& self, operation_stack::iterator it, \
+            const message::transaction& parent_tx, uint32_t input_index) \
+        { \
+            return __VA_ARGS__; \
+        };
 
-        default:
-            log_fatal() << "Unimplemented operation <none " 
-                << static_cast<int>(op.code) << ">";
-            return false;
-    }
-    return false;
+    // Pushes
+    SCRIPT_OPERATION(zero,
+        (self.stack_.push_back(small_chunk()), true));
+    SCRIPT_OPERATION(special, (self.stack_.push_back(it->data), true));
+    SCRIPT_OPERATION(pushdata1, (self.stack_.push_back(it->data), true));
+    SCRIPT_OPERATION(pushdata2, (self.stack_.push_back(it->data), true));
+    SCRIPT_OPERATION(pushdata4, (self.stack_.push_back(it->data), true));
+    SCRIPT_OPERATION(negative_1, self.op_negative_1());
+    SCRIPT_OPERATION(op_1, self.op_x(it->code));
+    SCRIPT_OPERATION(op_2, self.op_x(it->code));
+    SCRIPT_OPERATION(op_3, self.op_x(it->code));
+    SCRIPT_OPERATION(op_4, self.op_x(it->code));
+    SCRIPT_OPERATION(op_5, self.op_x(it->code));
+    SCRIPT_OPERATION(op_6, self.op_x(it->code));
+    SCRIPT_OPERATION(op_7, self.op_x(it->code));
+    SCRIPT_OPERATION(op_8, self.op_x(it->code));
+    SCRIPT_OPERATION(op_9, self.op_x(it->code));
+    SCRIPT_OPERATION(op_10, self.op_x(it->code));
+    SCRIPT_OPERATION(op_11, self.op_x(it->code));
+    SCRIPT_OPERATION(op_12, self.op_x(it->code));
+    SCRIPT_OPERATION(op_13, self.op_x(it->code));
+    SCRIPT_OPERATION(op_14, self.op_x(it->code));
+    SCRIPT_OPERATION(op_15, self.op_x(it->code));
+    SCRIPT_OPERATION(op_16, self.op_x(it->code));
+
+    // Flow control
+    SCRIPT_OPERATION(reserved, false);
+    SCRIPT_OPERATION(nop, true);
+    SCRIPT_OPERATION(ver, false);
+    SCRIPT_OPERATION(if_, self.op_if());
+    SCRIPT_OPERATION(notif, self.op_notif());
+    SCRIPT_OPERATION(else_, self.op_else());
+    SCRIPT_OPERATION(endif, self.op_endif());
+    SCRIPT_OPERATION(verify, self.op_verify());
+    SCRIPT_OPERATION(return_, false);
+
+    // Stack
+    SCRIPT_OPERATION(toaltstack, self.op_toaltstack());
+    SCRIPT_OPERATION(fromaltstack, self.op_fromaltstack());
+    SCRIPT_OPERATION(op_2drop, self.op_2drop());
+    SCRIPT_OPERATION(op_2dup, self.op_2dup());
+    SCRIPT_OPERATION(op_3dup, self.op_3dup());
+    SCRIPT_OPERATION(op_2over, self.op_2over());
+    SCRIPT_OPERATION(op_2rot, self.op_2rot());
+    SCRIPT_OPERATION(op_2swap, self.op_2swap());
+    SCRIPT_OPERATION(ifdup, self.op_ifdup());
+    SCRIPT_OPERATION(depth, self.op_depth());
+    SCRIPT_OPERATION(drop, self.op_drop());
+    SCRIPT_OPERATION(dup, self.op_dup());
+    SCRIPT_OPERATION(nip, self.op_nip());
+    SCRIPT_OPERATION(over, self.op_over());
+    SCRIPT_OPERATION(pick, self.op_pick());
+    SCRIPT_OPERATION(roll, self.op_roll());
+    SCRIPT_OPERATION(rot, self.op_rot());
+    SCRIPT_OPERATION(swap, self.op_swap());
+    SCRIPT_OPERATION(tuck, self.op_tuck());
+    SCRIPT_OPERATION(size, self.op_size());
+
+    // Bitwise logic
+    SCRIPT_OPERATION(equal, self.op_equal());
+    SCRIPT_OPERATION(equalverify, self.op_equalverify());
+    SCRIPT_OPERATION(reserved1, false);
+    SCRIPT_OPERATION(reserved2, false);
+
+    // Arithmetic
+    SCRIPT_OPERATION(op_1add, self.op_1add());
+    SCRIPT_OPERATION(op_1sub, self.op_1sub());
+    SCRIPT_OPERATION(negate, self.op_negate());
+    SCRIPT_OPERATION(abs, self.op_abs());
+    SCRIPT_OPERATION(not_, self.op_not());
+    SCRIPT_OPERATION(op_0notequal, self.op_0notequal());
+    SCRIPT_OPERATION(add, self.op_add());
+    SCRIPT_OPERATION(sub, self.op_sub());
+    SCRIPT_OPERATION(booland, self.op_booland());
+    SCRIPT_OPERATION(boolor, self.op_boolor());
+    SCRIPT_OPERATION(numequal, self.op_numequal());
+    SCRIPT_OPERATION(numequalverify, self.op_numequalverify());
+    SCRIPT_OPERATION(numnotequal, self.op_numnotequal());
+    SCRIPT_OPERATION(lessthan, self.op_lessthan());
+    SCRIPT_OPERATION(greaterthan, self.op_greaterthan());
+    SCRIPT_OPERATION(lessthanorequal, self.op_lessthanorequal());
+    SCRIPT_OPERATION(greaterthanorequal, self.op_greaterthanorequal());
+    SCRIPT_OPERATION(min, self.op_min());
+    SCRIPT_OPERATION(max, self.op_max());
+    SCRIPT_OPERATION(within, self.op_within());
+
+    // Crypto
+    SCRIPT_OPERATION(ripemd160, self.op_ripemd160());
+    SCRIPT_OPERATION(sha1, self.op_sha1());
+    SCRIPT_OPERATION(sha256, self.op_sha256());
+    SCRIPT_OPERATION(hash160, self.op_hash160());
+    SCRIPT_OPERATION(hash256, self.op_hash256());
+    SCRIPT_OPERATION(codeseparator, (self.codehash_begin_ = it, true));
+    SCRIPT_OPERATION(checksig, self.op_checksig(parent_tx, input_index));
+    SCRIPT_OPERATION(checksigverify,
+        self.op_checksigverify(parent_tx, input_index));
+    SCRIPT_OPERATION(checkmultisig,
+        self.op_checkmultisig(parent_tx, input_index));
+    SCRIPT_OPERATION(checkmultisigverify,
+        self.op_checkmultisigverify(parent_tx, input_index));
+
+    // Expansion
+    SCRIPT_OPERATION(op_nop1, true);
+    SCRIPT_OPERATION(op_nop2, true);
+    SCRIPT_OPERATION(op_nop3, true);
+    SCRIPT_OPERATION(op_nop4, true);
+    SCRIPT_OPERATION(op_nop5, true);
+    SCRIPT_OPERATION(op_nop6, true);
+    SCRIPT_OPERATION(op_nop7, true);
+    SCRIPT_OPERATION(op_nop8, true);
+    SCRIPT_OPERATION(op_nop9, true);
+    SCRIPT_OPERATION(op_nop10, true);
+    SCRIPT_OPERATION(raw_data, false);
+
+#undef SCRIPT_OPERATION
+
+    // Disabled opcodes never reach the table. compile() rejects them.
+    return table;
 }
 
 bool is_pubkey_type(const operation_stack& ops)
@@ -1949,7 +1897,7 @@ script parse_script(const data_chunk& raw_script)
                     *read_n_bytes, op.data))
                 return script();
         }
-        script_object.push_operation(op);
+        script_object.push_operation(std::move(op));
     }
     return script_object;
 }
@@ -1976,6 +1924,7 @@ data_chunk save_script(const script& scr)
     else if (operations[0].code == opcode::raw_data)
         return operations[0].data;
     data_chunk raw_script;
+    raw_script.reserve(script_size(scr));
     for (const operation& op: scr.operations())
     {
         byte raw_byte = static_cast<byte>(op.code);
@@ -10,12 +10,18 @@ using std::placeholders::_2;
 using std::placeholders::_3;
 using std::placeholders::_4;
 
+// Transactions held back for one deprioritized peer. More are dropped.
+constexpr size_t max_waiting_transactions = 100;
+
 session::session(async_service& service, const session_params& params)
   : strand_(service.get_service()),
     handshake_(params.handshake_), protocol_(params.protocol_),
     chain_(params.blockchain_), poll_(params.poller_),
     tx_pool_(params.transaction_pool_),
-    grabbed_invs_(20)
+    compact_relay_(params.compact_block_relay_),
+    tx_pool_filename_("mempool"),
+    grabbed_invs_(1000), tx_requests_(service, strand_),
+    store_transactions_(false)
 {
 }
 
@@ -24,9 +30,21 @@ void handle_set_start_depth(const std::error_code&)
     // Set start depth in handshake
     // Do nothing
 }
+void handle_set_services(const std::error_code&)
+{
+    // Do nothing
+}
 void session::start(completion_handler handle_complete)
 {
+    // Must come before any channel is handshaked
+    if (compact_relay_)
+        handshake_.set_services(node_network | node_compact_blocks,
+            handle_set_services);
     protocol_.start(handle_complete);
+    tx_pool_.load(tx_pool_filename_,
+        strand_.wrap(std::bind(&session::handle_load_pool,
+            this, _1, _2)));
+    tx_requests_.start();
     protocol_.subscribe_channel(
         [this](channel_ptr node)
         {
@@ -42,11 +60,44 @@ void session::start(completion_handler handle_complete)
             this, _1, _2, _3, _4));
 }
 
+void session::handle_load_pool(const std::error_code& ec, size_t accepted)
+{
+    // Nothing saved yet on the first run
+    if (ec == error::not_found)
+        return;
+    if (ec)
+    {
+        log_error(log_domain::session) << "Failed to load transaction pool '"
+            << tx_pool_filename_ << "': " << ec.message();
+        return;
+    }
+    log_info(log_domain::session)
+        << "Loaded " << accepted << " transactions into the pool";
+}
+
 void session::stop(completion_handler handle_complete)
 {
+    tx_requests_.stop();
+    tx_pool_.save(tx_pool_filename_,
+        strand_.wrap(std::bind(&session::handle_save_pool,
+            this, _1, handle_complete)));
+}
+void session::handle_save_pool(const std::error_code& ec,
+    completion_handler handle_complete)
+{
+    // Losing the pool isn't worth failing the shutdown over
+    if (ec)
+        log_error(log_domain::session) << "Failed to save transaction pool '"
+            << tx_pool_filename_ << "': " << ec.message();
     protocol_.stop(handle_complete);
 }
 
+void session::set_cost_policy(const peer_cost_policy& policy)
+{
+    store_transactions_ = true;
+    cost_policy_ = policy;
+}
+
 void session::new_channel(channel_ptr node)
 {
     BITCOIN_ASSERT(node);
@@ -56,7 +107,23 @@ void session::new_channel(channel_ptr node)
         std::bind(&session::get_data, this, _1, _2, node));
     node->subscribe_get_blocks(
         std::bind(&session::get_blocks, this, _1, _2, node));
-    // tx
+    if (compact_relay_)
+        compact_relay_->monitor(node);
+    if (store_transactions_)
+        strand_.post(
+            [this, node]()
+            {
+                accounts_[node].cost =
+                    std::make_shared<peer_cost>(cost_policy_);
+            });
+    node->subscribe_transaction(
+        std::bind(&session::transaction, this, _1, _2, node));
+    node->subscribe_stop(
+        [this, node](const std::error_code&)
+        {
+            strand_.post(
+                std::bind(&session::channel_stopped, this, node));
+        });
     // block
     protocol_.subscribe_channel(
         std::bind(&session::new_channel, this, _1));
@@ -80,7 +147,19 @@ void session::set_start_depth(const std::error_code& ec, size_t fork_point,
             message::inventory_type::block,
             hash_block_header(*block)});
     }
-    protocol_.broadcast(blocks_inv);
+    if (!compact_relay_)
+    {
+        protocol_.broadcast(blocks_inv);
+        return;
+    }
+    // Compact peers get the blocks themselves instead
+    for (auto block: new_blocks)
+        compact_relay_->announce(*block);
+    protocol_.broadcast(blocks_inv,
+        [](channel_ptr node)
+        {
+            return !compact_block_relay::is_compact_peer(node);
+        });
 }
 
 void session::inventory(const std::error_code& ec,
@@ -107,6 +186,121 @@ void session::inventory(const std::error_code& ec,
         std::bind(&session::inventory, this, _1, _2, node));
 }
 
+void session::transaction(const std::error_code& ec,
+    const message::transaction& tx, channel_ptr node)
+{
+    if (ec)
+    {
+        if (ec != error::service_stopped)
+            log_error(log_domain::session) << "transaction: " << ec.message();
+        return;
+    }
+    strand_.post(
+        std::bind(&session::handle_transaction, this, tx, node));
+    node->subscribe_transaction(
+        std::bind(&session::transaction, this, _1, _2, node));
+}
+
+void session::channel_stopped(channel_ptr node)
+{
+    accounts_.erase(node);
+    tx_requests_.remove_peer(node);
+}
+
+void session::handle_transaction(
+    const message::transaction& tx, channel_ptr node)
+{
+    const hash_digest tx_hash = hash_transaction(tx);
+    tx_requests_.received(tx_hash, node);
+    grabbed_invs_.store(tx_hash);
+    if (!store_transactions_)
+        return;
+    auto it = accounts_.find(node);
+    if (it == accounts_.end())
+        return;
+    peer_account& account = it->second;
+    const peer_standing standing = account.cost->standing();
+    switch (standing)
+    {
+        case peer_standing::normal:
+            store_transaction(tx, tx_hash, node, account);
+            break;
+
+        case peer_standing::deprioritized:
+            if (account.validating == 0)
+                store_transaction(tx, tx_hash, node, account);
+            else if (account.waiting.size() < max_waiting_transactions)
+                account.waiting.push_back(tx);
+            break;
+
+        case peer_standing::throttled:
+        case peer_standing::disconnect:
+            apply_policy(node, standing);
+            break;
+    }
+}
+
+static void handle_pool_confirm(const std::error_code&)
+{
+    // Nothing tracks confirmations of relayed transactions yet
+}
+void session::store_transaction(const message::transaction& tx,
+    const hash_digest& tx_hash, channel_ptr node, peer_account& account)
+{
+    ++account.validating;
+    tx_pool_.store(tx, handle_pool_confirm,
+        strand_.wrap(std::bind(&session::handle_store,
+            this, _1, tx_hash, node)),
+        account.cost);
+}
+
+void session::handle_store(const std::error_code& ec,
+    const hash_digest& tx_hash, channel_ptr node)
+{
+    if (ec)
+        log_debug(log_domain::session) << "Rejected transaction "
+            << pretty_hex(tx_hash) << ": " << ec.message();
+    auto it = accounts_.find(node);
+    if (it == accounts_.end())
+        return;
+    peer_account& account = it->second;
+    BITCOIN_ASSERT(account.validating > 0);
+    --account.validating;
+    const peer_standing standing = account.cost->standing();
+    if (standing == peer_standing::disconnect)
+    {
+        apply_policy(node, standing);
+        return;
+    }
+    if (account.waiting.empty() || account.validating > 0)
+        return;
+    if (standing == peer_standing::throttled)
+    {
+        account.waiting.clear();
+        return;
+    }
+    const message::transaction tx = account.waiting.front();
+    account.waiting.pop_front();
+    store_transaction(tx, hash_transaction(tx), node, account);
+}
+
+void session::apply_policy(channel_ptr node, peer_standing standing)
+{
+    if (standing == peer_standing::disconnect)
+    {
+        peer_cost_ptr cost = accounts_[node].cost;
+        log_info(log_domain::session) << "Disconnecting peer costing "
+            << cost->ratio() << " times what its transactions are worth ("
+            << cost->rejected() << " rejected, "
+            << cost->accepted() << " accepted)";
+        accounts_.erase(node);
+        node->stop();
+    }
+    else if (standing == peer_standing::throttled)
+        log_debug(log_domain::session)
+            << "Dropping transaction from throttled peer";
+}
+
 void session::new_tx_inventory(const hash_digest& tx_hash, channel_ptr node)
 {
     if (grabbed_invs_.exists(tx_hash))
@@ -116,9 +310,8 @@ void session::new_tx_inventory(const hash_digest& tx_hash, channel_ptr node)
     // does it exist already
     // if not then issue getdata
     tx_pool_.exists(tx_hash,
-        std::bind(&session::request_tx_data,
-            this, _1, tx_hash, node));
-    grabbed_invs_.store(tx_hash);
+        strand_.wrap(std::bind(&session::request_tx_data,
+            this, _1, tx_hash, node)));
 }
 
 void session::get_data(const std::error_code& ec,
@@ -149,20 +342,13 @@ void session::get_blocks(const std::error_code& ec,
         std::bind(&session::get_blocks, this, _1, _2, node));
 }
 
-void handle_send_get_data(const std::error_code& ec)
-{
-    if (ec)
-        log_error(log_domain::session) << "Requesting data: " << ec.message();
-}
 void session::request_tx_data(bool tx_exists,
     const hash_digest& tx_hash, channel_ptr node)
 {
     if (tx_exists)
-        return;
-    message::get_data request_tx;
-    request_tx.inventories.push_back(
-        {message::inventory_type::transaction, tx_hash});
-    node->send(request_tx, handle_send_get_data);
+        grabbed_invs_.store(tx_hash);
+    else
+        tx_requests_.announced(tx_hash, node);
 }
 
 } // namespace libbitcoin
@@ -61,7 +61,7 @@ hash_digest build_merkle_tree(hash_list& merkle)
 hash_digest generate_merkle_root(const message::transaction_list& transactions)
 {
     hash_list tx_hashes;
-    for (message::transaction tx: transactions)
+    for (const message::transaction& tx: transactions)
         tx_hashes.push_back(hash_transaction(tx));
     return build_merkle_tree(tx_hashes);
 }
@@ -91,10 +91,10 @@ std::string pretty(const message::transaction& tx)
         << "\tversion = " << tx.version << "\n"
         << "\tlocktime = " << tx.locktime << "\n"
         << "Inputs:\n";
-    for (message::transaction_input input: tx.inputs)
+    for (const message::transaction_input& input: tx.inputs)
         ss << pretty(input);
     ss << "Outputs:\n";
-    for (message::transaction_output output: tx.outputs)
+    for (const message::transaction_output& output: tx.outputs)
         ss << pretty(output);
     ss << "\n";
     return ss.str();
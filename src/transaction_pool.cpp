@@ -1,9 +1,19 @@
 #include <bitcoin/transaction_pool.hpp>
 
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
 #include <bitcoin/error.hpp>
+#include <bitcoin/format.hpp>
+#include <bitcoin/satoshi_serialize.hpp>
 #include <bitcoin/transaction.hpp>
 #include <bitcoin/validate.hpp>
 #include <bitcoin/utility/assert.hpp>
+#include <bitcoin/utility/async_frame.hpp>
+#include <bitcoin/utility/logger.hpp>
+#include <bitcoin/utility/sha256.hpp>
 
 namespace libbitcoin {
 
@@ -12,9 +22,51 @@ using std::placeholders::_2;
 using std::placeholders::_3;
 using std::placeholders::_4;
 
+using boost::posix_time::microsec_clock;
+
+// Start of every file written by save()
+constexpr uint32_t pool_file_magic = 0x4c4f4f50;
+constexpr uint32_t pool_file_version = 1;
+
+constexpr size_t max_orphans = 100;
+// Bigger orphans are dropped. Too easy to fill the pool with otherwise.
+constexpr size_t max_orphan_size = 100000;
+const boost::posix_time::time_duration max_orphan_age =
+    boost::posix_time::minutes(20);
+
+message::transaction transaction_entry_info::tx() const
+{
+    message::transaction result;
+    satoshi_load(raw_tx.begin(), raw_tx.end(), result);
+    return result;
+}
+
+void pool_index::add(const transaction_entry_info& entry)
+{
+    hashes.insert(entry.hash);
+    spent.insert(entry.spent.begin(), entry.spent.end());
+}
+void pool_index::remove(const transaction_entry_info& entry)
+{
+    hashes.erase(entry.hash);
+    for (const message::output_point& outpoint: entry.spent)
+        spent.erase(outpoint);
+}
+
+std::error_code pool_conflict(const pool_index& index,
+    const hash_digest& tx_hash, const message::output_point_list& spent)
+{
+    if (index.hashes.count(tx_hash))
+        return error::duplicate;
+    for (const message::output_point& outpoint: spent)
+        if (index.spent.count(outpoint))
+            return error::double_spend;
+    return std::error_code();
+}
+
 transaction_pool::transaction_pool(
     async_service& service, blockchain& chain)
-  : strand_(service.get_service()), chain_(chain), pool_(2000)
+  : strand_(service.get_service()), chain_(chain), pool_(2000), counts_()
 {
 }
 void transaction_pool::start()
@@ -25,37 +77,79 @@ void transaction_pool::start()
 }
 
 void transaction_pool::store(const message::transaction& stored_transaction,
-    confirm_handler handle_confirm, store_handler handle_store)
+    confirm_handler handle_confirm, store_handler handle_store,
+    peer_cost_ptr cost)
 {
     strand_.post(
         std::bind(&transaction_pool::do_store,
-            this, stored_transaction, handle_confirm, handle_store));
+            this, stored_transaction, handle_confirm, handle_store, cost,
+            time(nullptr)));
 }
 void transaction_pool::do_store(
     const message::transaction& stored_transaction,
-    confirm_handler handle_confirm, store_handler handle_store)
+    confirm_handler handle_confirm, store_handler handle_store,
+    peer_cost_ptr cost, time_t arrival_time)
 {
+    data_chunk raw_tx(satoshi_raw_size(stored_transaction));
+    satoshi_save(stored_transaction, raw_tx.begin());
+    const hash_digest tx_hash = generate_sha256_hash(raw_tx);
+    message::output_point_list spent;
+    spent.reserve(stored_transaction.inputs.size());
+    for (const message::transaction_input& input:
+        stored_transaction.inputs)
+    {
+        spent.push_back(input.previous_output);
+    }
     transaction_entry_info new_tx_entry{
-        hash_transaction(stored_transaction),
-        stored_transaction,
-        handle_confirm};
+        tx_hash,
+        std::move(raw_tx),
+        std::move(spent),
+        handle_confirm,
+        arrival_time,
+        0};
 
     validate_transaction_ptr validate =
         std::make_shared<validate_transaction>(
-            chain_, stored_transaction, pool_, strand_);
+            chain_, stored_transaction, pool_, index_, strand_);
     validate->start(strand_.wrap(std::bind(
         &transaction_pool::handle_delegate,
-            this, _1, _2, new_tx_entry, handle_store)));
+            this, _1, _2, new_tx_entry, handle_store,
+            std::weak_ptr<validate_transaction>(validate),
+            validate->cost(), cost)));
 }
 
 void transaction_pool::handle_delegate(
     const std::error_code& ec, const index_list& unconfirmed,
-    const transaction_entry_info& tx_entry, store_handler handle_store)
+    transaction_entry_info& tx_entry, store_handler handle_store,
+    std::weak_ptr<validate_transaction> validate,
+    validation_cost_ptr validate_cost, peer_cost_ptr cost)
 {
+    // Re-check as another transaction might've been added in the interim
+    std::error_code conflict;
+    if (!ec)
+        conflict = pool_conflict(index_, tx_entry.hash, tx_entry.spent);
+    // Validation calls us, so it's always still around
+    validate_transaction_ptr finished = validate.lock();
+    if (conflict)
+        count_stage(validation_stage::pool_conflict);
+    else if (finished)
+        count_stage(finished->stage());
+    // We're called from inside validation, which is still timing the
+    // step that finished it. Charge once that's done.
+    if (cost)
+    {
+        const bool accepted = !ec && !conflict;
+        strand_.post(
+            [cost, validate_cost, accepted]()
+            {
+                cost->add(*validate_cost, accepted);
+            });
+    }
     if (ec == error::input_not_found)
     {
         BITCOIN_ASSERT(unconfirmed.size() == 1);
-        BITCOIN_ASSERT(unconfirmed[0] < tx_entry.tx.inputs.size());
+        BITCOIN_ASSERT(unconfirmed[0] < tx_entry.spent.size());
+        add_orphan(tx_entry, unconfirmed[0], cost);
         handle_store(ec, unconfirmed);
     }
     else if (ec)
@@ -63,24 +157,126 @@ void transaction_pool::handle_delegate(
         BITCOIN_ASSERT(unconfirmed.empty());
         handle_store(ec, index_list());
     }
-    // Re-check as another transaction might've been added in the interim
-    else if (tx_exists(tx_entry.hash))
+    else if (conflict)
     {
-        handle_store(error::duplicate, index_list());
+        handle_store(conflict, index_list());
     }
     else
     {
-        pool_.push_back(tx_entry);
+        if (finished)
+            tx_entry.fee = finished->fee();
+        add_entry(tx_entry);
         handle_store(std::error_code(), unconfirmed);
+        resubmit_orphans(tx_entry.hash);
+    }
+}
+
+void transaction_pool::add_orphan(const transaction_entry_info& tx_entry,
+    size_t missing_input, peer_cost_ptr cost)
+{
+    if (orphans_.count(tx_entry.hash) ||
+        tx_entry.raw_tx.size() > max_orphan_size)
+    {
+        return;
+    }
+    expire_orphans();
+    if (orphans_.size() >= max_orphans)
+    {
+        auto oldest = orphans_.begin();
+        for (auto it = orphans_.begin(); it != orphans_.end(); ++it)
+            if (it->second.added < oldest->second.added)
+                oldest = it;
+        remove_orphan(oldest);
+    }
+    const hash_digest& missing_parent =
+        tx_entry.spent[missing_input].hash;
+    orphans_.emplace(tx_entry.hash, orphan_entry{tx_entry, cost,
+        missing_parent, microsec_clock::universal_time()});
+    orphans_by_parent_.emplace(missing_parent, tx_entry.hash);
+    // The parent may have come in while this was being validated
+    if (tx_exists(missing_parent))
+        resubmit_orphans(missing_parent);
+}
+
+void transaction_pool::remove_orphan(orphan_map::iterator it)
+{
+    auto range = orphans_by_parent_.equal_range(it->second.missing_parent);
+    for (auto parent = range.first; parent != range.second; ++parent)
+        if (parent->second == it->first)
+        {
+            orphans_by_parent_.erase(parent);
+            break;
+        }
+    orphans_.erase(it);
+}
+
+void transaction_pool::expire_orphans()
+{
+    const boost::posix_time::ptime cutoff =
+        microsec_clock::universal_time() - max_orphan_age;
+    for (auto it = orphans_.begin(); it != orphans_.end(); )
+    {
+        if (it->second.added < cutoff)
+        {
+            auto expired = it++;
+            remove_orphan(expired);
+        }
+        else
+            ++it;
+    }
+}
+
+void handle_orphan_store(const std::error_code& ec,
+    const hash_digest& tx_hash)
+{
+    // input_not_found means it's waiting on another parent now
+    if (ec && ec != error::input_not_found)
+        log_debug(log_domain::validation) << "Orphan transaction "
+            << pretty_hex(tx_hash) << " rejected: " << ec.message();
+}
+void transaction_pool::resubmit_orphans(const hash_digest& parent_hash)
+{
+    auto range = orphans_by_parent_.equal_range(parent_hash);
+    if (range.first == range.second)
+        return;
+    std::vector<orphan_entry> ready;
+    for (auto parent = range.first; parent != range.second; ++parent)
+    {
+        auto it = orphans_.find(parent->second);
+        BITCOIN_ASSERT(it != orphans_.end());
+        ready.push_back(std::move(it->second));
+        orphans_.erase(it);
     }
+    orphans_by_parent_.erase(range.first, range.second);
+    for (const orphan_entry& orphan: ready)
+        store(orphan.entry.tx(), orphan.entry.handle_confirm,
+            std::bind(handle_orphan_store, _1, orphan.entry.hash),
+            orphan.cost);
 }
 
 bool transaction_pool::tx_exists(const hash_digest& tx_hash)
 {
-    for (const transaction_entry_info& entry: pool_)
-        if (entry.hash == tx_hash)
-            return true;
-    return false;
+    return index_.hashes.count(tx_hash) != 0;
+}
+
+void transaction_pool::add_entry(const transaction_entry_info& tx_entry)
+{
+    // circular_buffer silently overwrites the oldest when full
+    if (pool_.full())
+        index_.remove(pool_.front());
+    pool_.push_back(tx_entry);
+    index_.add(tx_entry);
+}
+
+void transaction_pool::count_stage(validation_stage stage)
+{
+    std::lock_guard<std::mutex> lock(counts_mutex_);
+    ++counts_[static_cast<size_t>(stage)];
+}
+validation_stage_counts transaction_pool::validation_counts() const
+{
+    std::lock_guard<std::mutex> lock(counts_mutex_);
+    return counts_;
 }
 
 void transaction_pool::fetch(const hash_digest& transaction_hash,
@@ -92,12 +288,27 @@ void transaction_pool::fetch(const hash_digest& transaction_hash,
             for (const transaction_entry_info& entry: pool_)
                 if (entry.hash == transaction_hash)
                 {
-                    handle_fetch(std::error_code(), entry.tx);
+                    handle_fetch(std::error_code(), entry.tx());
                     return;
                 }
             handle_fetch(error::not_found, message::transaction());
         });
 }
+void transaction_pool::fetch_raw(const hash_digest& transaction_hash,
+    fetch_raw_handler handle_fetch)
+{
+    strand_.post(
+        [this, transaction_hash, handle_fetch]()
+        {
+            for (const transaction_entry_info& entry: pool_)
+                if (entry.hash == transaction_hash)
+                {
+                    handle_fetch(std::error_code(), entry.raw_tx);
+                    return;
+                }
+            handle_fetch(error::not_found, data_chunk());
+        });
+}
 
 void transaction_pool::exists(const hash_digest& transaction_hash,
     exists_handler handle_exists)
@@ -109,6 +320,161 @@ void transaction_pool::exists(const hash_digest& transaction_hash,
         });
 }
 
+void transaction_pool::visit(visit_handler handle_visit)
+{
+    strand_.post(
+        [this, handle_visit]()
+        {
+            handle_visit(pool_);
+        });
+}
+
+void transaction_pool::save(
+    const std::string& path, save_handler handle_save)
+{
+    strand_.post(
+        std::bind(&transaction_pool::do_save, this, path, handle_save));
+}
+void transaction_pool::do_save(
+    const std::string& path, save_handler handle_save)
+{
+    serializer file;
+    file.write_4_bytes(pool_file_magic);
+    file.write_4_bytes(pool_file_version);
+    file.write_variable_uint(pool_.size());
+    // Oldest first, so parents are loaded before their children
+    for (const transaction_entry_info& entry: pool_)
+    {
+        file.write_4_bytes(entry.arrival_time);
+        file.write_variable_uint(entry.fee);
+        file.write_variable_uint(entry.raw_tx.size());
+        file.write_data(entry.raw_tx);
+    }
+    const data_chunk data = file.data();
+    const std::string temp_path = path + ".new";
+    {
+        std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(data.data()), data.size());
+        if (!out)
+        {
+            log_error(log_domain::validation)
+                << "Couldn't write transaction pool to " << temp_path;
+            handle_save(error::pool_save_failed);
+            return;
+        }
+    }
+    if (std::rename(temp_path.c_str(), path.c_str()) != 0)
+    {
+        std::remove(temp_path.c_str());
+        handle_save(error::pool_save_failed);
+        return;
+    }
+    handle_save(std::error_code());
+}
+
+void transaction_pool::load(
+    const std::string& path, load_handler handle_load)
+{
+    strand_.post(
+        std::bind(&transaction_pool::do_load, this, path, handle_load));
+}
+static void handle_confirm_loaded(const std::error_code&)
+{
+    // Whoever stored it before the restart isn't around to hear
+}
+void transaction_pool::do_load(
+    const std::string& path, load_handler handle_load)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+    {
+        handle_load(error::not_found, 0);
+        return;
+    }
+    const data_chunk data((std::istreambuf_iterator<char>(in)),
+        std::istreambuf_iterator<char>());
+    std::vector<loaded_entry> loaded;
+    try
+    {
+        deserializer file(data);
+        if (file.read_4_bytes() != pool_file_magic ||
+            file.read_4_bytes() != pool_file_version)
+        {
+            handle_load(error::bad_stream, 0);
+            return;
+        }
+        const uint64_t count = file.read_variable_uint();
+        // Don't trust the count for the allocation
+        loaded.reserve(std::min<uint64_t>(count, pool_.capacity()));
+        for (uint64_t i = 0; i < count; ++i)
+        {
+            loaded_entry entry;
+            entry.arrival_time = file.read_4_bytes();
+            // Validation works the fee out again
+            file.read_variable_uint();
+            const data_chunk raw_tx =
+                file.read_data(file.read_variable_uint());
+            satoshi_load(raw_tx.begin(), raw_tx.end(), entry.tx);
+            loaded.push_back(std::move(entry));
+        }
+    }
+    catch (const end_of_stream&)
+    {
+        handle_load(error::bad_stream, 0);
+        return;
+    }
+    auto state = std::make_shared<load_state>();
+    state->handle_load = handle_load;
+    // A transaction goes in the batch after the last of its parents.
+    // The file is in arrival order and a child never arrives before
+    // its parent, so parents are always seen first.
+    std::unordered_map<hash_digest, size_t> generation;
+    for (loaded_entry& entry: loaded)
+    {
+        size_t batch = 0;
+        for (const message::transaction_input& input: entry.tx.inputs)
+        {
+            auto parent = generation.find(input.previous_output.hash);
+            if (parent != generation.end())
+                batch = std::max(batch, parent->second + 1);
+        }
+        generation.emplace(hash_transaction(entry.tx), batch);
+        if (batch == state->batches.size())
+            state->batches.emplace_back();
+        state->batches[batch].push_back(std::move(entry));
+    }
+    load_batch(state);
+}
+// Transactions in a batch don't depend on each other, so their
+// storage lookups can all be in flight together.
+void transaction_pool::load_batch(load_state_ptr state)
+{
+    if (state->batch == state->batches.size())
+    {
+        state->handle_load(std::error_code(), state->accepted);
+        return;
+    }
+    const loaded_batch& batch = state->batches[state->batch];
+    state->pending = batch.size();
+    for (const loaded_entry& entry: batch)
+        do_store(entry.tx, handle_confirm_loaded,
+            strand_.wrap(std::bind(&transaction_pool::handle_load_store,
+                this, _1, state)),
+            peer_cost_ptr(), entry.arrival_time);
+}
+void transaction_pool::handle_load_store(const std::error_code& ec,
+    load_state_ptr state)
+{
+    if (!ec)
+        ++state->accepted;
+    if (--state->pending != 0)
+        return;
+    ++state->batch;
+    // Validation may finish without leaving the strand. Don't recurse.
+    strand_.post(
+        std::bind(&transaction_pool::load_batch, this, state));
+}
+
 void transaction_pool::reorganize(const std::error_code& ec,
     size_t fork_point,
     const blockchain::block_list& new_blocks,
@@ -118,6 +484,12 @@ void transaction_pool::reorganize(const std::error_code& ec,
         resubmit_all();
     else
         takeout_confirmed(new_blocks);
+    // Parents turning up in a block free their orphans too.
+    // Skip hashing every block transaction when there are none.
+    if (!orphans_by_parent_.empty())
+        for (auto new_block: new_blocks)
+            for (const message::transaction& new_tx: new_block->transactions)
+                resubmit_orphans(hash_transaction(new_tx));
     // new blocks come in - remove txs in new
     // old blocks taken out - resubmit txs in old
     chain_.subscribe_reorganize(
@@ -134,9 +506,10 @@ void handle_resubmit(const std::error_code& ec,
 void transaction_pool::resubmit_all()
 {
     for (const transaction_entry_info& entry: pool_)
-        store(entry.tx, entry.handle_confirm,
+        store(entry.tx(), entry.handle_confirm,
             std::bind(handle_resubmit, _1, entry.handle_confirm));
     pool_.clear();
+    index_ = pool_index();
 }
 
 void transaction_pool::takeout_confirmed(
@@ -152,11 +525,122 @@ void transaction_pool::try_delete(const hash_digest& tx_hash)
         if (it->hash == tx_hash)
         {
             auto handle_confirm = it->handle_confirm;
+            index_.remove(*it);
             pool_.erase(it);
             handle_confirm(std::error_code());
             return;
         }
 }
 
+#include <boost/asio/yield.hpp>
+
+class fetch_transaction_frame
+  : public async_frame<fetch_transaction_frame>
+{
+public:
+    fetch_transaction_frame(transaction_pool& pool, blockchain& chain,
+        const hash_digest& tx_hash,
+        transaction_pool::fetch_handler handle)
+      : pool_(pool), chain_(chain), tx_hash_(tx_hash), handle_(handle) {}
+
+    void operator()()
+    {
+        reenter (this)
+        {
+            yield pool_.fetch(tx_hash_, resume(tx_));
+            if (error())
+            {
+                yield chain_.fetch_transaction(tx_hash_, resume(tx_));
+            }
+            if (error())
+                handle_(error(), message::transaction());
+            else
+                handle_(std::error_code(), tx_);
+        }
+    }
+
+private:
+    transaction_pool& pool_;
+    blockchain& chain_;
+    const hash_digest tx_hash_;
+    transaction_pool::fetch_handler handle_;
+
+    message::transaction tx_;
+};
+
+void fetch_transaction(transaction_pool& pool, blockchain& chain,
+    const hash_digest& tx_hash, transaction_pool::fetch_handler handle_fetch)
+{
+    (new fetch_transaction_frame(pool, chain, tx_hash, handle_fetch))->start();
+}
+
+typedef transaction_pool_fetch_handler_outputs handler_outputs;
+
+class fetch_previous_outputs_frame
+  : public async_frame<fetch_previous_outputs_frame>
+{
+public:
+    fetch_previous_outputs_frame(transaction_pool& pool, blockchain& chain,
+        const message::transaction& tx, handler_outputs handle)
+      : pool_(pool), chain_(chain), tx_(tx), handle_(handle) {}
+
+    void operator()()
+    {
+        reenter (this)
+        {
+            previous_txs_.resize(tx_.inputs.size());
+            yield
+            {
+                begin_join(tx_.inputs.size());
+                for (size_t i = 0; i < tx_.inputs.size(); ++i)
+                    fetch_transaction(pool_, chain_,
+                        tx_.inputs[i].previous_output.hash,
+                        join(previous_txs_[i]));
+                end_join();
+            }
+            if (error())
+            {
+                handle_(error::input_not_found,
+                    message::transaction_output_list());
+                yield break;
+            }
+            finish();
+        }
+    }
+
+private:
+    void finish()
+    {
+        message::transaction_output_list outputs;
+        for (size_t i = 0; i < tx_.inputs.size(); ++i)
+        {
+            const uint32_t index = tx_.inputs[i].previous_output.index;
+            if (index >= previous_txs_[i].outputs.size())
+            {
+                handle_(error::input_not_found,
+                    message::transaction_output_list());
+                return;
+            }
+            outputs.push_back(previous_txs_[i].outputs[index]);
+        }
+        handle_(std::error_code(), outputs);
+    }
+
+    transaction_pool& pool_;
+    blockchain& chain_;
+    const message::transaction tx_;
+    handler_outputs handle_;
+
+    message::transaction_list previous_txs_;
+};
+
+void fetch_previous_outputs(transaction_pool& pool, blockchain& chain,
+    const message::transaction& tx, handler_outputs handle_fetch)
+{
+    (new fetch_previous_outputs_frame(pool, chain, tx, handle_fetch))->start();
+}
+
+#include <boost/asio/unyield.hpp>
+
 } // namespace libbitcoin
 
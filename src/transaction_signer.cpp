@@ -0,0 +1,164 @@
+#include <bitcoin/transaction_signer.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#include <bitcoin/constants.hpp>
+#include <bitcoin/format.hpp>
+#include <bitcoin/utility/logger.hpp>
+#include <bitcoin/utility/serializer.hpp>
+#include <bitcoin/utility/sha256.hpp>
+
+namespace libbitcoin {
+
+// Each entry in inputs_ is the outpoint hash and index, then sequence
+constexpr size_t outpoint_size = 32 + 4;
+constexpr size_t sequence_size = 4;
+
+transaction_signer::transaction_signer(message::transaction& tx)
+  : tx_(tx)
+{
+    serializer head;
+    head.write_4_bytes(tx_.version);
+    head.write_variable_uint(tx_.inputs.size());
+    head_ = head.data();
+    serializer inputs;
+    for (const message::transaction_input& input: tx_.inputs)
+    {
+        inputs.write_hash(input.previous_output.hash);
+        inputs.write_4_bytes(input.previous_output.index);
+        inputs.write_4_bytes(input.sequence);
+    }
+    inputs_ = inputs.data();
+    serializer tail;
+    tail.write_variable_uint(tx_.outputs.size());
+    for (const message::transaction_output& output: tx_.outputs)
+    {
+        tail.write_8_bytes(output.value);
+        data_chunk raw_script = save_script(output.output_script);
+        tail.write_variable_uint(raw_script.size());
+        tail.write_data(raw_script);
+    }
+    tail.write_4_bytes(tx_.locktime);
+    tail_ = tail.data();
+}
+
+hash_digest transaction_signer::signature_hash(uint32_t input_index,
+    const script& script_code, uint32_t hash_type) const
+{
+    data_chunk preimage;
+    return signature_hash(input_index, script_code, hash_type, preimage);
+}
+
+hash_digest transaction_signer::signature_hash(uint32_t input_index,
+    const script& script_code, uint32_t hash_type,
+    data_chunk& preimage) const
+{
+    // none, single and anyone_can_pay rewrite the outputs or inputs,
+    // so there's nothing to share. Take the slow path.
+    if ((hash_type & 0x1f) == sighash::none ||
+        (hash_type & 0x1f) == sighash::single ||
+        (hash_type & sighash::anyone_can_pay))
+    {
+        return script::generate_signature_hash(
+            tx_, input_index, script_code, hash_type);
+    }
+    if (input_index >= tx_.inputs.size())
+        return null_hash;
+    const data_chunk raw_script_code = save_script(script_code);
+    serializer script_length;
+    script_length.write_variable_uint(raw_script_code.size());
+    const data_chunk raw_length = script_length.data();
+    preimage.clear();
+    preimage.reserve(head_.size() + inputs_.size() + tx_.inputs.size() +
+        raw_length.size() + raw_script_code.size() + tail_.size() + 4);
+    extend_data(preimage, head_);
+    auto input = inputs_.begin();
+    for (uint32_t i = 0; i < tx_.inputs.size(); ++i)
+    {
+        // Every other input's script is blanked
+        preimage.insert(preimage.end(), input, input + outpoint_size);
+        if (i == input_index)
+        {
+            extend_data(preimage, raw_length);
+            extend_data(preimage, raw_script_code);
+        }
+        else
+            preimage.push_back(0);
+        input += outpoint_size;
+        preimage.insert(preimage.end(), input, input + sequence_size);
+        input += sequence_size;
+    }
+    extend_data(preimage, tail_);
+    extend_data(preimage, uncast_type(hash_type));
+    return generate_sha256_hash(preimage);
+}
+
+bool transaction_signer::sign_input(uint32_t input_index,
+    const signing_input& input, uint32_t hash_type, data_chunk& preimage,
+    script& input_script) const
+{
+    const payment_type type = input.previous_output_script.type();
+    if (type != payment_type::pubkey && type != payment_type::pubkey_hash)
+    {
+        log_error() << "transaction_signer: input " << input_index
+            << " spends an output type we can't sign";
+        return false;
+    }
+    const hash_digest tx_hash = signature_hash(input_index,
+        input.previous_output_script, hash_type, preimage);
+    if (tx_hash == null_hash)
+        return false;
+    data_chunk signature = input.key.sign(tx_hash);
+    if (signature.empty())
+        return false;
+    signature.push_back(hash_type);
+    input_script = script();
+    input_script.push_operation({opcode::special, signature});
+    if (type == payment_type::pubkey_hash)
+        input_script.push_operation(
+            {opcode::special, input.key.public_key()});
+    return true;
+}
+
+bool transaction_signer::sign(const signing_input_list& inputs,
+    uint32_t hash_type, size_t number_threads)
+{
+    if (inputs.size() != tx_.inputs.size())
+        return false;
+    if (number_threads == 0)
+        number_threads = std::max(std::thread::hardware_concurrency(), 1u);
+    number_threads = std::min(number_threads, inputs.size());
+    std::vector<script> input_scripts(inputs.size());
+    std::atomic<size_t> next_input(0);
+    std::atomic<bool> success(true);
+    // Workers take the next unsigned input until none are left
+    auto sign_inputs =
+        [&]()
+        {
+            data_chunk preimage;
+            for (size_t i = next_input++; i < inputs.size() && success;
+                i = next_input++)
+            {
+                if (!sign_input(i, inputs[i], hash_type,
+                        preimage, input_scripts[i]))
+                    success = false;
+            }
+        };
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < number_threads; ++i)
+        threads.push_back(std::thread(sign_inputs));
+    sign_inputs();
+    for (std::thread& worker: threads)
+        worker.join();
+    if (!success)
+        return false;
+    // Only now, since the slow sighash path reads the transaction
+    for (size_t i = 0; i < inputs.size(); ++i)
+        tx_.inputs[i].input_script = std::move(input_scripts[i]);
+    return true;
+}
+
+} // namespace libbitcoin
+
@@ -0,0 +1,196 @@
+#include <bitcoin/tx_request_tracker.hpp>
+
+#include <algorithm>
+
+#include <bitcoin/format.hpp>
+#include <bitcoin/utility/logger.hpp>
+
+namespace libbitcoin {
+
+using std::placeholders::_1;
+using boost::posix_time::microsec_clock;
+using boost::posix_time::seconds;
+
+// How long a peer gets to answer before we ask the next announcer
+const boost::posix_time::time_duration request_timeout = seconds(30);
+// How often timed out requests and waiting hashes are looked at
+const boost::posix_time::time_duration check_interval = seconds(2);
+constexpr size_t max_in_flight_per_peer = 100;
+constexpr size_t max_announcers = 8;
+// Past this, new hashes are ignored until some are resolved
+constexpr size_t max_tracked_requests = 50000;
+
+static void handle_send_tx_request(const std::error_code& ec)
+{
+    // Failing sends stop the channel, and remove_peer() moves its
+    // requests on.
+}
+
+tx_request_tracker::tx_request_tracker(async_service& service,
+    io_service::strand& async_strand)
+  : strand_(async_strand), timer_(service.get_service()), stopped_(true)
+{
+}
+
+void tx_request_tracker::start()
+{
+    strand_.dispatch(
+        [this]()
+        {
+            stopped_ = false;
+            set_timer();
+        });
+}
+void tx_request_tracker::stop()
+{
+    strand_.dispatch(
+        [this]()
+        {
+            stopped_ = true;
+            boost::system::error_code ec;
+            timer_.cancel(ec);
+        });
+}
+
+void tx_request_tracker::announced(
+    const hash_digest& tx_hash, channel_ptr node)
+{
+    // remove_peer() has been or is about to be called for it. Don't
+    // hang on to it again afterwards.
+    if (node->stopped())
+        return;
+    auto it = requests_.find(tx_hash);
+    if (it == requests_.end())
+    {
+        if (requests_.size() >= max_tracked_requests)
+            return;
+        it = requests_.emplace(tx_hash, tx_request()).first;
+    }
+    tx_request& entry = it->second;
+    if (entry.requested_from == node)
+        return;
+    channel_ptr_list& announcers = entry.announcers;
+    if (announcers.size() < max_announcers &&
+        std::find(announcers.begin(), announcers.end(), node) ==
+            announcers.end())
+    {
+        announcers.push_back(node);
+    }
+    if (!entry.requested_from)
+        request(tx_hash, entry);
+}
+
+void tx_request_tracker::received(
+    const hash_digest& tx_hash, channel_ptr node)
+{
+    auto it = requests_.find(tx_hash);
+    if (it == requests_.end())
+        return;
+    if (it->second.requested_from)
+        release(it->second.requested_from);
+    requests_.erase(it);
+}
+
+void tx_request_tracker::remove_peer(channel_ptr node)
+{
+    in_flight_.erase(node);
+    for (auto it = requests_.begin(); it != requests_.end(); )
+    {
+        tx_request& entry = it->second;
+        channel_ptr_list& announcers = entry.announcers;
+        announcers.erase(
+            std::remove(announcers.begin(), announcers.end(), node),
+            announcers.end());
+        if (entry.requested_from == node)
+        {
+            entry.requested_from.reset();
+            // Nobody else has it
+            if (announcers.empty())
+            {
+                it = requests_.erase(it);
+                continue;
+            }
+            request(it->first, entry);
+        }
+        else if (!entry.requested_from && announcers.empty())
+        {
+            it = requests_.erase(it);
+            continue;
+        }
+        ++it;
+    }
+}
+
+size_t tx_request_tracker::size() const
+{
+    return requests_.size();
+}
+
+bool tx_request_tracker::request(
+    const hash_digest& tx_hash, tx_request& entry)
+{
+    channel_ptr_list& announcers = entry.announcers;
+    for (auto it = announcers.begin(); it != announcers.end(); ++it)
+    {
+        size_t& in_flight = in_flight_[*it];
+        if (in_flight >= max_in_flight_per_peer)
+            continue;
+        ++in_flight;
+        entry.requested_from = *it;
+        entry.expires = microsec_clock::universal_time() + request_timeout;
+        announcers.erase(it);
+        message::get_data request_tx;
+        request_tx.inventories.push_back(
+            {message::inventory_type::transaction, tx_hash});
+        entry.requested_from->send(request_tx, handle_send_tx_request);
+        return true;
+    }
+    return false;
+}
+
+void tx_request_tracker::release(channel_ptr node)
+{
+    auto it = in_flight_.find(node);
+    if (it == in_flight_.end())
+        return;
+    // Don't keep idle channels alive
+    if (--it->second == 0)
+        in_flight_.erase(it);
+}
+
+void tx_request_tracker::set_timer()
+{
+    timer_.expires_from_now(check_interval);
+    timer_.async_wait(strand_.wrap(
+        std::bind(&tx_request_tracker::handle_timer, this, _1)));
+}
+
+void tx_request_tracker::handle_timer(const boost::system::error_code& ec)
+{
+    if (ec == boost::asio::error::operation_aborted || stopped_)
+        return;
+    const ptime now = microsec_clock::universal_time();
+    for (auto it = requests_.begin(); it != requests_.end(); )
+    {
+        tx_request& entry = it->second;
+        if (entry.requested_from && entry.expires <= now)
+        {
+            log_debug(log_domain::session) << "Request for transaction "
+                << pretty_hex(it->first) << " timed out";
+            release(entry.requested_from);
+            entry.requested_from.reset();
+        }
+        if (!entry.requested_from && !request(it->first, entry) &&
+            entry.announcers.empty())
+        {
+            // Everyone who announced it was asked
+            it = requests_.erase(it);
+            continue;
+        }
+        ++it;
+    }
+    set_timer();
+}
+
+} // namespace libbitcoin
+
@@ -53,6 +53,13 @@ data_chunk elliptic_curve_key::public_key() const
     return pubkey;
 }
 
+void elliptic_curve_key::set_compressed(bool compressed)
+{
+    BITCOIN_ASSERT(key_ != nullptr);
+    EC_KEY_set_conv_form(key_, compressed ?
+        POINT_CONVERSION_COMPRESSED : POINT_CONVERSION_UNCOMPRESSED);
+}
+
 bool elliptic_curve_key::verify(hash_digest hash, const data_chunk& signature)
 {
     BITCOIN_ASSERT(key_ != nullptr);
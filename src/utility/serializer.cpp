@@ -10,6 +10,14 @@
 
 namespace libbitcoin {
 
+// Same bytes as uncast_type() without the temporary chunk
+template <typename T>
+void write_little_endian(data_chunk& data, T value)
+{
+    for (size_t i = 0; i < sizeof(T); ++i)
+        data.push_back(static_cast<uint8_t>(value >> (8 * i)));
+}
+
 void serializer::write_byte(uint8_t v)
 {
     data_.push_back(v);
@@ -17,17 +25,17 @@ void serializer::write_byte(uint8_t v)
 
 void serializer::write_2_bytes(uint16_t v)
 {
-    extend_data(data_, uncast_type(v));
+    write_little_endian(data_, v);
 }
 
 void serializer::write_4_bytes(uint32_t v)
 {
-    extend_data(data_, uncast_type(v));
+    write_little_endian(data_, v);
 }
 
 void serializer::write_8_bytes(uint64_t v)
 {
-    extend_data(data_, uncast_type(v));
+    write_little_endian(data_, v);
 }
 
 void serializer::write_variable_uint(uint64_t v)
@@ -106,8 +114,20 @@ template<typename T, typename Iterator>
 T read_data_impl(Iterator& begin, Iterator end, bool reverse=false)
 {
     check_distance(begin, end, sizeof(T));
-    data_chunk chunk(begin, begin + sizeof(T));
-    T val = cast_chunk<T>(chunk, reverse);
+    // Same as cast_chunk() without copying the bytes out first
+    #ifdef BOOST_LITTLE_ENDIAN
+        // do nothing
+    #elif BOOST_BIG_ENDIAN
+        reverse = !reverse;
+    #else
+        #error "Endian isn't defined!"
+    #endif
+    T val = 0;
+    for (size_t i = 0; i < sizeof(T); ++i)
+    {
+        const size_t position = reverse ? sizeof(T) - 1 - i : i;
+        val += static_cast<T>(begin[i]) << (position * 8);
+    }
     begin += sizeof(T);
     return val;
 }
@@ -177,9 +197,8 @@ void read_bytes(Iterator& begin, const Iterator& end,
 data_chunk deserializer::read_data(uint64_t n_bytes)
 {
     check_distance(begin_, end_, n_bytes);
-    data_chunk raw_bytes;
-    for (uint64_t i = 0; i < n_bytes; ++i)
-        raw_bytes.push_back(read_byte());
+    data_chunk raw_bytes(begin_, begin_ + n_bytes);
+    begin_ += n_bytes;
     return raw_bytes;
 }
 
@@ -0,0 +1,91 @@
+#include <bitcoin/utility/token_bucket.hpp>
+
+#include <algorithm>
+
+namespace libbitcoin {
+
+using boost::posix_time::microsec_clock;
+using boost::posix_time::microseconds;
+using boost::posix_time::time_duration;
+
+token_bucket::token_bucket(uint64_t rate, uint64_t burst)
+{
+    set_rate(rate, burst);
+}
+
+void token_bucket::set_rate(uint64_t rate, uint64_t burst)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    rate_ = rate;
+    burst_ = burst ? burst : rate;
+    tokens_ = burst_;
+    last_refill_ = microsec_clock::universal_time();
+}
+
+bool token_bucket::unlimited() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return rate_ == 0;
+}
+uint64_t token_bucket::burst() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return burst_;
+}
+
+void token_bucket::refill(ptime now)
+{
+    if (tokens_ >= static_cast<int64_t>(burst_))
+    {
+        last_refill_ = now;
+        return;
+    }
+    const int64_t elapsed = (now - last_refill_).total_microseconds();
+    if (elapsed <= 0)
+        return;
+    // Past this the bucket is full anyway. Stopping here also keeps the
+    // multiplies below from overflowing after a long idle spell.
+    const uint64_t missing = static_cast<int64_t>(burst_) - tokens_;
+    const int64_t fill_time =
+        missing / rate_ * 1000000 + missing % rate_ * 1000000 / rate_;
+    if (elapsed >= fill_time)
+    {
+        tokens_ = burst_;
+        last_refill_ = now;
+        return;
+    }
+    const int64_t added = elapsed * rate_ / 1000000;
+    // Only move the clock on by what we credited so no time is lost
+    // to rounding on frequent calls.
+    if (added == 0)
+        return;
+    tokens_ = std::min<int64_t>(tokens_ + added, burst_);
+    last_refill_ += microseconds(added * 1000000 / rate_);
+}
+
+time_duration token_bucket::wait_time(uint64_t reserve)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (rate_ == 0)
+        return time_duration();
+    refill(microsec_clock::universal_time());
+    // A reserve above the burst could never be met
+    const int64_t needed = std::min(reserve, burst_);
+    if (tokens_ >= needed)
+        return time_duration();
+    // Round up so we don't wake just before the tokens arrive
+    const int64_t missing = needed - tokens_;
+    return microseconds((missing * 1000000 + rate_ - 1) / rate_);
+}
+
+void token_bucket::consume(uint64_t bytes)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (rate_ == 0)
+        return;
+    refill(microsec_clock::universal_time());
+    tokens_ -= bytes;
+}
+
+} // namespace libbitcoin
+
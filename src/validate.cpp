@@ -11,47 +11,225 @@
 #include <bitcoin/satoshi_serialize.hpp>
 #include <bitcoin/error.hpp>
 #include <bitcoin/utility/assert.hpp>
+#include <bitcoin/utility/async_frame.hpp>
 #include <bitcoin/utility/logger.hpp>
 
 namespace libbitcoin {
 
-using std::placeholders::_1;
-using std::placeholders::_2;
-using std::placeholders::_3;
-using std::placeholders::_4;
-
 namespace posix_time = boost::posix_time;
 
 constexpr size_t max_block_size = 1000000;
 constexpr size_t max_block_script_sig_operations = max_block_size / 50;
 
+// Relay policy for memory pool transactions. Blocks aren't held to these.
+constexpr size_t max_standard_transaction_size = 100000;
+constexpr size_t max_standard_sig_operations =
+    max_block_script_sig_operations / 5;
+// Enough for a 3 of 3 multisig spend with compressed keys
+constexpr size_t max_standard_input_script_size = 1650;
+// Outputs worth less than this cost more in fees to spend than they hold
+constexpr uint64_t dust_threshold = 546;
+
+size_t tx_legacy_sigops_count(const message::transaction& tx);
+
+// Adds the time until it goes out of scope to a validation_cost
+class cost_timer
+{
+public:
+    cost_timer(validation_cost& cost)
+      : cost_(cost), start_(posix_time::microsec_clock::universal_time())
+    {
+    }
+    ~cost_timer()
+    {
+        cost_.cpu_time +=
+            posix_time::microsec_clock::universal_time() - start_;
+    }
+
+private:
+    validation_cost& cost_;
+    const posix_time::ptime start_;
+};
+
+#include <boost/asio/yield.hpp>
+
+class validate_transaction::validate_frame
+  : public async_frame<validate_transaction::validate_frame>
+{
+public:
+    validate_frame(validate_transaction_ptr validate)
+      : validate_(validate), strand_(validate->strand_),
+        chain_(validate->chain_), tx_(validate->tx_),
+        cost_(*validate->cost_) {}
+
+    void operator()()
+    {
+        cost_timer timer(cost_);
+        // Every fetch resumes us inside the pool's strand, so reading
+        // the pool and calling handle_validate_ are safe.
+        reenter (this)
+        {
+            validate_->stage_ = validation_stage::chain_duplicate;
+            ++cost_.storage_lookups;
+            yield chain_.fetch_transaction(validate_->tx_hash_,
+                strand_.wrap(resume()));
+            if (error() != error::not_found)
+            {
+                finish(error::duplicate);
+                yield break;
+            }
+
+            // Conflicts with memory txs were checked in basic_checks()
+            // and we already know it is not a coinbase tx.
+            validate_->stage_ = validation_stage::inputs;
+            ++cost_.storage_lookups;
+            yield chain_.fetch_last_depth(
+                strand_.wrap(resume(last_block_depth_)));
+            if (error())
+            {
+                finish(error());
+                yield break;
+            }
+
+            BITCOIN_ASSERT(tx_.inputs.size() > 0);
+            for (current_input_ = 0; current_input_ < tx_.inputs.size();
+                ++current_input_)
+            {
+                // The parent's block depth is needed for checking
+                // coinbase maturity.
+                ++cost_.storage_lookups;
+                yield chain_.fetch_transaction_index(previous_hash(),
+                    strand_.wrap(resume(parent_depth_)));
+                if (error())
+                {
+                    // Not in the blockchain, so it must be in the pool
+                    if (!validate_->fetch(previous_hash(), previous_tx_))
+                    {
+                        finish(error::input_not_found,
+                            index_list{current_input_});
+                        yield break;
+                    }
+                    // Memory pool transactions can never be a coinbase
+                    // so parent_depth_ doesn't matter.
+                    BITCOIN_ASSERT(!is_coinbase(previous_tx_));
+                    parent_depth_ = 0;
+                    unconfirmed_.push_back(current_input_);
+                }
+                else
+                {
+                    ++cost_.storage_lookups;
+                    yield chain_.fetch_transaction(previous_hash(),
+                        strand_.wrap(resume(previous_tx_)));
+                    if (error())
+                    {
+                        finish(error::input_not_found,
+                            index_list{current_input_});
+                        yield break;
+                    }
+                }
+                if (!connect_input(tx_, current_input_, previous_tx_,
+                    parent_depth_, last_block_depth_, value_in_))
+                {
+                    finish(error::validate_inputs_failed);
+                    yield break;
+                }
+                // connect_input() passed, so make sure no transaction
+                // in the blockchain already spent this output.
+                // basic_checks() already looked in the pool.
+                ++cost_.storage_lookups;
+                yield chain_.fetch_spend(
+                    tx_.inputs[current_input_].previous_output,
+                    strand_.wrap(resume()));
+                if (error() != error::unspent_output)
+                {
+                    finish(error::double_spend);
+                    yield break;
+                }
+            }
+
+            validate_->fee_ = 0;
+            tally_fees(tx_, value_in_, validate_->fee_);
+            // Who cares?
+            // Fuck the police
+            // Every tx equal!
+            validate_->stage_ = validation_stage::accepted;
+            finish(std::error_code(), unconfirmed_);
+        }
+    }
+
+private:
+    const hash_digest& previous_hash() const
+    {
+        return tx_.inputs[current_input_].previous_output.hash;
+    }
+
+    void finish(const std::error_code& ec,
+        const index_list& unconfirmed=index_list())
+    {
+        validate_->handle_validate_(ec, unconfirmed);
+    }
+
+    // Keeps the validation alive until the last step
+    const validate_transaction_ptr validate_;
+    io_service::strand& strand_;
+    blockchain& chain_;
+    const message::transaction& tx_;
+    validation_cost& cost_;
+
+    size_t last_block_depth_;
+    uint64_t value_in_ = 0;
+    size_t current_input_;
+    size_t parent_depth_;
+    message::transaction previous_tx_;
+    index_list unconfirmed_;
+};
+
+#include <boost/asio/unyield.hpp>
+
 validate_transaction::validate_transaction(
     blockchain& chain, const message::transaction& tx,
-    const pool_buffer& pool, io_service::strand& async_strand)
+    const pool_buffer& pool, const pool_index& index,
+    io_service::strand& async_strand)
   : strand_(async_strand), chain_(chain),
-    tx_(tx), tx_hash_(hash_transaction(tx)), pool_(pool)
+    tx_(tx), tx_hash_(hash_transaction(tx)), pool_(pool), index_(index),
+    stage_(validation_stage::format), fee_(0),
+    cost_(std::make_shared<validation_cost>())
 {
 }
 
+validation_cost_ptr validate_transaction::cost() const
+{
+    return cost_;
+}
+uint64_t validate_transaction::fee() const
+{
+    return fee_;
+}
+validation_stage validate_transaction::stage() const
+{
+    return stage_;
+}
+
 void validate_transaction::start(validate_handler handle_validate)
 {
     handle_validate_ = handle_validate;
-    std::error_code ec = basic_checks();
+    std::error_code ec;
+    {
+        cost_timer timer(*cost_);
+        cost_->bytes = satoshi_raw_size(tx_);
+        ec = basic_checks();
+    }
     if (ec)
     {
         handle_validate_(ec, index_list());
         return;
     }
-
-    // Check for duplicates in the blockchain
-    chain_.fetch_transaction(tx_hash_,
-        strand_.wrap(std::bind(
-            &validate_transaction::handle_duplicate_check,
-                shared_from_this(), _1)));
+    (new validate_frame(shared_from_this()))->start();
 }
 
-std::error_code validate_transaction::basic_checks() const
+std::error_code validate_transaction::basic_checks()
 {
+    stage_ = validation_stage::format;
     std::error_code ec;
     ec = check_transaction(tx_);
     if (ec)
@@ -63,157 +241,70 @@ std::error_code validate_transaction::basic_checks() const
     // Ummm...
     //if ((int64)nLockTime > INT_MAX)
 
+    if (cost_->bytes > max_standard_transaction_size)
+        return error::is_not_standard;
+
+    stage_ = validation_stage::standard;
     if (!is_standard())
         return error::is_not_standard;
 
-    // Check for conflicts
-    if (fetch(tx_hash_))
-        return error::duplicate;
-    // Check for blockchain duplicates done next in start() after
-    // this function exits.
+    stage_ = validation_stage::sigops;
+    if (tx_legacy_sigops_count(tx_) > max_standard_sig_operations)
+        return error::is_not_standard;
 
+    // The fee needs the previous outputs, so it waits for check_fees()
+    stage_ = validation_stage::dust;
+    for (const message::transaction_output& output: tx_.outputs)
+        if (output.value < dust_threshold)
+            return error::is_not_standard;
+
+    stage_ = validation_stage::pool_conflict;
+    message::output_point_list spent;
+    spent.reserve(tx_.inputs.size());
+    for (const message::transaction_input& input: tx_.inputs)
+        spent.push_back(input.previous_output);
+    ec = pool_conflict(index_, tx_hash_, spent);
+    if (ec)
+        return ec;
+    // Blockchain duplicates are checked next by validate_frame
     return std::error_code();
 }
 
 bool validate_transaction::is_standard() const
 {
+    for (const message::transaction_output& output: tx_.outputs)
+        if (output.output_script.type() == payment_type::non_standard)
+            return false;
+    // Input scripts only push data for the output script to use
+    for (const message::transaction_input& input: tx_.inputs)
+    {
+        if (script_size(input.input_script) >
+            max_standard_input_script_size)
+        {
+            return false;
+        }
+        for (const operation& op: input.input_script.operations())
+            if (static_cast<byte>(op.code) >
+                static_cast<byte>(opcode::op_16))
+            {
+                return false;
+            }
+    }
     return true;
 }
 
-const message::transaction* validate_transaction::fetch(
-    const hash_digest& tx_hash) const
+bool validate_transaction::fetch(const hash_digest& tx_hash,
+    message::transaction& tx) const
 {
     for (const transaction_entry_info& entry: pool_)
         if (entry.hash == tx_hash)
-            return &entry.tx;
-    return nullptr;
-}
-
-void validate_transaction::handle_duplicate_check(const std::error_code& ec)
-{
-    if (ec != error::not_found)
-    {
-        handle_validate_(error::duplicate, index_list());
-        return;
-    }
-    // Check for conflicts with memory txs
-    for (size_t input_index = 0; input_index < tx_.inputs.size(); 
-        ++input_index)
-    {
-        const message::output_point& previous_output =
-            tx_.inputs[input_index].previous_output;
-        if (is_spent(previous_output))
         {
-            handle_validate_(error::double_spend, index_list());
-            return;
+            tx = entry.tx();
+            return true;
         }
-    }
-    // Check inputs
-
-    // We already know it is not a coinbase tx
-
-    chain_.fetch_last_depth(strand_.wrap(std::bind(
-        &validate_transaction::set_last_depth, shared_from_this(), _1, _2)));
-}
- 
-bool validate_transaction::is_spent(const message::output_point outpoint) const
-{
-    for (const transaction_entry_info& entry: pool_)
-        for (const message::transaction_input current_input: entry.tx.inputs)
-            if (current_input.previous_output == outpoint)
-                return true;
     return false;
 }
 
-void validate_transaction::set_last_depth(
-    const std::error_code& ec, size_t last_depth)
-{
-    if (ec)
-    {
-        handle_validate_(ec, index_list());
-        return;
-    }
-    // Used for checking coinbase maturity
-    last_block_depth_ = last_depth;
-    value_in_ = 0;
-    BITCOIN_ASSERT(tx_.inputs.size() > 0);
-    current_input_ = 0;
-    // Begin looping through the inputs, fetching the previous tx
-    next_previous_transaction();
-}
-
-void validate_transaction::next_previous_transaction()
-{
-    BITCOIN_ASSERT(current_input_ < tx_.inputs.size());
-    // First we fetch the parent block depth for a transaction.
-    // Needed for checking the coinbase maturity.
-    chain_.fetch_transaction_index(
-        tx_.inputs[current_input_].previous_output.hash,
-        strand_.wrap(std::bind(
-            &validate_transaction::previous_tx_index,
-                shared_from_this(), _1, _2)));
-}
-
-void validate_transaction::previous_tx_index(
-    const std::error_code& ec, size_t parent_depth)
-{
-    if (ec)
-    {
-        search_pool_previous_tx();
-    }
-    else
-    {
-        // Now fetch actual transaction body
-        BITCOIN_ASSERT(current_input_ < tx_.inputs.size());
-        chain_.fetch_transaction(
-            tx_.inputs[current_input_].previous_output.hash,
-            strand_.wrap(std::bind(
-                &validate_transaction::handle_previous_tx,
-                    shared_from_this(), _1, _2, parent_depth)));
-    }
-}
-
-void validate_transaction::search_pool_previous_tx()
-{
-    const hash_digest& previous_tx_hash =
-        tx_.inputs[current_input_].previous_output.hash;
-    const message::transaction* previous_tx = fetch(previous_tx_hash);
-    if (!previous_tx)
-    {
-        handle_validate_(error::input_not_found,
-            index_list{current_input_});
-        return;
-    }
-    BITCOIN_ASSERT(!is_coinbase(*previous_tx));
-    // parent_depth ignored here as memory pool transactions can
-    // never be a coinbase transaction.
-    handle_previous_tx(std::error_code(), *previous_tx, 0);
-    unconfirmed_.push_back(current_input_);
-}
-
-void validate_transaction::handle_previous_tx(const std::error_code& ec,
-    const message::transaction& previous_tx, size_t parent_depth)
-{
-    if (ec)
-    {
-        handle_validate_(error::input_not_found,
-            index_list{current_input_});
-        return;
-    }
-    // Should check for are inputs standard here...
-    if (!connect_input(tx_, current_input_, previous_tx,
-        parent_depth, last_block_depth_, value_in_))
-    {
-        handle_validate_(error::validate_inputs_failed, index_list());
-        return;
-    }
-    // Search for double spends...
-    chain_.fetch_spend(tx_.inputs[current_input_].previous_output,
-        strand_.wrap(std::bind(
-            &validate_transaction::check_double_spend,
-                shared_from_this(), _1)));
-}
-
 bool validate_transaction::connect_input(
     const message::transaction& tx, size_t current_input,
     const message::transaction& previous_tx, size_t parent_depth,
@@ -244,28 +335,6 @@ bool validate_transaction::connect_input(
     return true;
 }
 
-void validate_transaction::check_double_spend(const std::error_code& ec)
-{
-    if (ec == error::unspent_output)
-    {
-        // End of connect_input checks
-        ++current_input_;
-        if (current_input_ == tx_.inputs.size())
-            check_fees();
-        else
-        {
-            BITCOIN_ASSERT(current_input_ < tx_.inputs.size());
-            // Keep looping
-            next_previous_transaction();
-        }
-    }
-    else
-    {
-        BITCOIN_ASSERT(!ec || ec != error::unspent_output);
-        handle_validate_(error::double_spend, index_list());
-    }
-}
-
 bool validate_transaction::tally_fees(const message::transaction& tx,
     uint64_t value_in, uint64_t& total_fees)
 {
@@ -279,16 +348,6 @@ bool validate_transaction::tally_fees(const message::transaction& tx,
     return true;
 }
 
-void validate_transaction::check_fees()
-{
-    uint64_t fee = 0;
-    tally_fees(tx_, value_in_, fee);
-    // Who cares?
-    // Fuck the police
-    // Every tx equal!
-    handle_validate_(std::error_code(), unconfirmed_);
-}
-
 std::error_code validate_transaction::check_transaction(
     const message::transaction& tx)
 {
@@ -301,7 +360,7 @@ std::error_code validate_transaction::check_transaction(
 
     // Check for negative or overflow output values
     uint64_t total_output_value = 0;
-    for (message::transaction_output output: tx.outputs)
+    for (const message::transaction_output& output: tx.outputs)
     {
         if (output.value > max_money())
             return error::output_value_overflow;
@@ -313,13 +372,13 @@ std::error_code validate_transaction::check_transaction(
     if (is_coinbase(tx))
     {
         const script& coinbase_script = tx.inputs[0].input_script;
-        size_t coinbase_script_size = save_script(coinbase_script).size();
+        size_t coinbase_script_size = script_size(coinbase_script);
         if (coinbase_script_size < 2 || coinbase_script_size > 100)
             return error::invalid_coinbase_script_size;
     }
     else
     {
-        for (message::transaction_input input: tx.inputs)
+        for (const message::transaction_input& input: tx.inputs)
             if (previous_output_is_null(input.previous_output))
                 return error::previous_output_null;
     }
@@ -384,7 +443,7 @@ std::error_code validate_block::check_block()
     }
 
     std::set<hash_digest> unique_txs;
-    for (message::transaction tx: current_block_.transactions)
+    for (const message::transaction& tx: current_block_.transactions)
     {
         std::error_code ec = validate_transaction::check_transaction(tx);
         if (ec)
@@ -454,12 +513,12 @@ inline size_t count_script_sigops(
 size_t tx_legacy_sigops_count(const message::transaction& tx)
 {
     size_t total_sigs = 0;
-    for (message::transaction_input input: tx.inputs)
+    for (const message::transaction_input& input: tx.inputs)
     {
         const operation_stack& operations = input.input_script.operations();
         total_sigs += count_script_sigops(operations, false);
     }
-    for (message::transaction_output output: tx.outputs)
+    for (const message::transaction_output& output: tx.outputs)
     {
         const operation_stack& operations = output.output_script.operations();
         total_sigs += count_script_sigops(operations, false);
@@ -469,7 +528,7 @@ size_t tx_legacy_sigops_count(const message::transaction& tx)
 size_t validate_block::legacy_sigops_count()
 {
     size_t total_sigs = 0;
-    for (message::transaction tx: current_block_.transactions)
+    for (const message::transaction& tx: current_block_.transactions)
         total_sigs += tx_legacy_sigops_count(tx);
     return total_sigs;
 }
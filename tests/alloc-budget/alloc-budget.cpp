@@ -0,0 +1,176 @@
+// Counts heap allocations made by each stage of handling a block and
+// fails if any stage goes over its budget. Copies which sneak into these
+// paths (a range-for taking transactions by value...) show up here.
+//
+// Budgets are for block 44987 on testnet from tests/bip16 (74 txs) with
+// about 10% headroom, measured with asserts enabled. Lower them when a
+// change makes a stage cheaper. Run ./make.sh from this directory.
+
+#include <bitcoin/bitcoin.hpp>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+using namespace bc;
+
+extern data_chunk raw_block44987;
+extern data_chunk raw_block44989;
+
+// Instrumented allocator. Every operator new in the program goes
+// through here while counting is switched on.
+bool counting = false;
+size_t allocations = 0, allocated_bytes = 0;
+
+void* operator new(size_t size)
+{
+    if (counting)
+    {
+        ++allocations;
+        allocated_bytes += size;
+    }
+    void* ptr = std::malloc(size ? size : 1);
+    if (!ptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+void operator delete[](void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+struct budget
+{
+    size_t allocations, bytes;
+};
+
+bool passed = true;
+
+template <typename Stage>
+void check_stage(const std::string& name, budget limit, Stage stage)
+{
+    allocations = allocated_bytes = 0;
+    counting = true;
+    stage();
+    counting = false;
+    const bool within = allocations <= limit.allocations &&
+        allocated_bytes <= limit.bytes;
+    std::cout << (within ? "ok   " : "FAIL ") << name << ": "
+        << allocations << " allocations (budget " << limit.allocations
+        << "), " << allocated_bytes << " bytes (budget " << limit.bytes
+        << ")" << std::endl;
+    if (!within)
+        passed = false;
+}
+
+// Just enough of a blockchain to run validate_block over a block whose
+// previous transactions we mostly don't have.
+class validate_block_stub
+  : public validate_block
+{
+public:
+    validate_block_stub(size_t depth, const message::block& current_block)
+      : validate_block(depth, current_block),
+        current_block_(current_block) {}
+
+    uint32_t previous_block_bits()
+    {
+        return current_block_.bits;
+    }
+    uint64_t actual_timespan(const uint64_t interval)
+    {
+        return target_timespan;
+    }
+    uint64_t median_time_past()
+    {
+        return current_block_.timestamp - 1;
+    }
+    bool transaction_exists(const hash_digest& tx_hash)
+    {
+        return false;
+    }
+    bool is_output_spent(const message::output_point& outpoint)
+    {
+        return false;
+    }
+    bool fetch_transaction(message::transaction& tx,
+        size_t& previous_depth, const hash_digest& tx_hash)
+    {
+        return false;
+    }
+    bool is_output_spent(const message::output_point& previous_output,
+        size_t index_in_parent, size_t input_index)
+    {
+        return false;
+    }
+
+private:
+    const message::block& current_block_;
+};
+
+int main()
+{
+    message::block blk, spender;
+    satoshi_load(raw_block44989.begin(), raw_block44989.end(), spender);
+
+    check_stage("decode", {10400, 790000},
+        [&]
+        {
+            satoshi_load(raw_block44987.begin(), raw_block44987.end(), blk);
+        });
+
+    check_stage("hash", {2600, 350000},
+        [&]
+        {
+            hash_block_header(blk);
+            for (const message::transaction& tx: blk.transactions)
+                hash_transaction(tx);
+            generate_merkle_root(blk.transactions);
+        });
+
+    std::error_code ec;
+    check_stage("validate block", {3900, 515000},
+        [&]
+        {
+            validate_block_stub validate(44987, blk);
+            ec = validate.start();
+        });
+    // Runs every check up to the inputs, which spend earlier blocks.
+    if (ec != error::validate_inputs_failed)
+    {
+        std::cout << "FAIL validate block: " << ec.message() << std::endl;
+        passed = false;
+    }
+
+    bool spent = false;
+    check_stage("run p2sh input script", {200, 21000},
+        [&]
+        {
+            const message::transaction& tx = spender.transactions[16];
+            script output_script =
+                blk.transactions[1].outputs[1].output_script;
+            spent = output_script.run(tx.inputs[0].input_script, tx, 0);
+        });
+    if (!spent)
+    {
+        std::cout << "FAIL run p2sh input script: rejected" << std::endl;
+        passed = false;
+    }
+
+    // The blockchain stores blocks in their wire form
+    check_stage("serialize for storage", {330, 152000},
+        [&]
+        {
+            data_chunk raw_block(satoshi_raw_size(blk));
+            satoshi_save(blk, raw_block.begin());
+        });
+
+    return passed ? 0 : 1;
+}
+
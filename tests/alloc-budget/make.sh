@@ -0,0 +1 @@
+g++ -std=c++11 -o alloc-budget alloc-budget.cpp ../bip16/raw_block4498*.cpp `pkg-config --libs --cflags libbitcoin` && ./alloc-budget
@@ -0,0 +1,155 @@
+#include "../src/blockchain/bdb/bdb_chain_keeper.hpp"
+#include "../src/blockchain/bdb/bdb_common.hpp"
+#include <bitcoin/constants.hpp>
+#include <bitcoin/utility/assert.hpp>
+#include <bitcoin/transaction.hpp>
+#include <boost/filesystem.hpp>
+#include <cstring>
+using namespace libbitcoin;
+
+// Blocks within this many of the tip are kept in full
+constexpr size_t prune_window = 2;
+
+int compare_uint32(DB*, const DBT* dbt1, const DBT* dbt2)
+{
+    uint32_t value1, value2;
+    memcpy(&value1, dbt1->data, sizeof(value1));
+    memcpy(&value2, dbt2->data, sizeof(value2));
+    return value1 < value2 ? -1 : (value1 > value2 ? 1 : 0);
+}
+
+int get_tx_number_hash(Db*, const Dbt*, const Dbt* data, Dbt* second_key)
+{
+    second_key->set_data(data->get_data());
+    second_key->set_size(data->get_size());
+    return 0;
+}
+
+message::transaction make_coinbase(uint8_t tag)
+{
+    message::transaction tx;
+    tx.version = 1;
+    tx.locktime = 0;
+    message::transaction_input input;
+    input.previous_output.hash = null_hash;
+    input.previous_output.index = std::numeric_limits<uint32_t>::max();
+    input.input_script = coinbase_script(data_chunk{tag});
+    input.sequence = std::numeric_limits<uint32_t>::max();
+    tx.inputs.push_back(input);
+    tx.outputs.push_back(message::transaction_output{50, script()});
+    return tx;
+}
+
+message::transaction make_spend(const hash_digest& previous_hash)
+{
+    message::transaction tx;
+    tx.version = 1;
+    tx.locktime = 0;
+    tx.inputs.push_back(message::transaction_input{
+        message::output_point{previous_hash, 0}, script(),
+        std::numeric_limits<uint32_t>::max()});
+    tx.outputs.push_back(message::transaction_output{40, script()});
+    return tx;
+}
+
+block_detail_ptr make_block(const message::transaction_list& txs)
+{
+    message::block block;
+    block.version = 1;
+    block.previous_block_hash = null_hash;
+    block.merkle = null_hash;
+    block.timestamp = 0;
+    block.bits = 0;
+    block.nonce = 0;
+    block.transactions = txs;
+    return std::make_shared<block_detail>(block);
+}
+
+int main()
+{
+    const std::string prefix = "prune-test-db";
+    boost::filesystem::remove_all(prefix);
+    boost::filesystem::create_directory(prefix);
+    DbEnv env(DB_CXX_NO_EXCEPTIONS);
+    int ret = env.open(prefix.c_str(), DB_CREATE|DB_INIT_LOCK|
+        DB_INIT_LOG|DB_INIT_TXN|DB_INIT_MPOOL|DB_THREAD, 0);
+    BITCOIN_ASSERT(ret == 0);
+    Db db_blocks(&env, 0), db_txs(&env, 0), db_tx_numbers(&env, 0),
+        db_tx_numbers_hash(&env, 0), db_spends(&env, 0),
+        db_address(&env, 0), db_sequence(&env, 0);
+    db_blocks.set_bt_compare(compare_uint32);
+    db_tx_numbers.set_bt_compare(compare_uint32);
+    db_address.set_flags(DB_DUP);
+    const uint32_t flags = DB_CREATE|DB_THREAD;
+    txn_guard txn(&env);
+    ret = db_blocks.open(txn.get(), "blocks", "block-data",
+            DB_BTREE, flags, 0) |
+        db_txs.open(txn.get(), "transactions", "tx",
+            DB_BTREE, flags, 0) |
+        db_tx_numbers.open(txn.get(), "transactions", "tx-number",
+            DB_BTREE, flags, 0) |
+        db_tx_numbers_hash.open(txn.get(), "transactions", "tx-number-hash",
+            DB_BTREE, flags, 0) |
+        db_spends.open(txn.get(), "transactions", "spends",
+            DB_BTREE, flags, 0) |
+        db_address.open(txn.get(), "address", "address",
+            DB_BTREE, flags, 0) |
+        db_sequence.open(txn.get(), "meta", "sequence",
+            DB_BTREE, flags, 0);
+    BITCOIN_ASSERT(ret == 0);
+    db_tx_numbers.associate(txn.get(), &db_tx_numbers_hash,
+        get_tx_number_hash, 0);
+    txn.commit();
+
+    bdb_common_ptr common = std::make_shared<bdb_common>(&env,
+        &db_blocks, nullptr, &db_txs, &db_tx_numbers, &db_tx_numbers_hash,
+        &db_spends, &db_address, &db_sequence);
+    bdb_chain_keeper keeper(common, &env, &db_blocks, nullptr,
+        &db_txs, &db_spends, &db_address, prune_window);
+    keeper.start();
+
+    // spent is spent by spend at depth 1, kept is never spent
+    const message::transaction spent = make_coinbase(0);
+    const message::transaction kept = make_coinbase(1);
+    const hash_digest spent_hash = hash_transaction(spent),
+        kept_hash = hash_transaction(kept);
+    const message::transaction spend = make_spend(spent_hash);
+    const message::output_point spent_output{spent_hash, 0};
+    message::input_point input_spend;
+
+    keeper.add(make_block({spent}));
+    keeper.add(make_block({kept, spend}));
+    keeper.add(make_block({make_coinbase(2)}));
+    // Depth 0 left the window but its spender at depth 1 is still inside
+    BITCOIN_ASSERT(!common->transaction_pruned(keeper.txn(), spent_hash));
+    bool found = common->fetch_spend(keeper.txn(), spent_output, input_spend);
+    BITCOIN_ASSERT(found);
+
+    keeper.add(make_block({make_coinbase(3)}));
+    // Now every output of spent is spent below the window
+    BITCOIN_ASSERT(common->transaction_pruned(keeper.txn(), spent_hash));
+    BITCOIN_ASSERT(!common->fetch_proto_transaction(
+        keeper.txn(), spent_hash).IsInitialized());
+    found = common->fetch_spend(keeper.txn(), spent_output, input_spend);
+    BITCOIN_ASSERT(!found);
+    // Unspent outputs keep their transactions
+    BITCOIN_ASSERT(!common->transaction_pruned(keeper.txn(), kept_hash));
+    BITCOIN_ASSERT(common->fetch_proto_transaction(
+        keeper.txn(), kept_hash).IsInitialized());
+    BITCOIN_ASSERT(!common->transaction_pruned(
+        keeper.txn(), hash_transaction(spend)));
+    // Headers below the window survive
+    BITCOIN_ASSERT(common->fetch_proto_block(keeper.txn(), 0).IsInitialized());
+
+    keeper.stop();
+    db_sequence.close(0);
+    db_address.close(0);
+    db_spends.close(0);
+    db_tx_numbers_hash.close(0);
+    db_tx_numbers.close(0);
+    db_txs.close(0);
+    db_blocks.close(0);
+    env.close(0);
+    boost::filesystem::remove_all(prefix);
+    return 0;
+}
@@ -0,0 +1,144 @@
+// Opens 10k loopback connections and reports the memory and setup time
+// each channel costs. Both ends live in this process, so that's 20k
+// channels. Needs about 20k file descriptors:
+//
+//   g++ -std=c++11 -o channel-bench channel-bench.cpp \
+//       `pkg-config --libs --cflags libbitcoin`
+//   ulimit -n 21000 && ./channel-bench
+
+#include <bitcoin/bitcoin.hpp>
+#include <sys/resource.h>
+#include <unistd.h>
+#include <chrono>
+#include <fstream>
+#include <future>
+#include <iostream>
+using namespace bc;
+using std::placeholders::_1;
+using std::placeholders::_2;
+
+constexpr size_t connection_count = 10000;
+constexpr uint16_t bench_port = 18555;
+
+size_t resident_bytes()
+{
+    size_t total_pages = 0, resident_pages = 0;
+    std::ifstream statm("/proc/self/statm");
+    statm >> total_pages >> resident_pages;
+    return resident_pages * sysconf(_SC_PAGESIZE);
+}
+
+class bench
+{
+public:
+    bench(async_service& service)
+      : net_(service), strand_(service.get_service()) {}
+
+    void run(acceptor_ptr accept, std::promise<void>& done)
+    {
+        accept_ = accept;
+        done_ = &done;
+        accept_->accept(strand_.wrap(
+            std::bind(&bench::handle_accept, this, _1, _2)));
+        const tcp::endpoint endpoint(
+            boost::asio::ip::address_v4::loopback(), bench_port);
+        for (size_t i = 0; i < connection_count; ++i)
+            net_.connect(endpoint, strand_.wrap(
+                std::bind(&bench::handle_connect, this, _1, _2)));
+    }
+
+    void stop_all()
+    {
+        for (channel_ptr node: channels_)
+            node->stop();
+    }
+
+    size_t failures = 0;
+
+private:
+    void handle_accept(const std::error_code& ec, channel_ptr node)
+    {
+        if (ec)
+            ++failures;
+        else
+            channels_.push_back(node);
+        if (++accepted_ < connection_count)
+            accept_->accept(strand_.wrap(
+                std::bind(&bench::handle_accept, this, _1, _2)));
+        check_done();
+    }
+    void handle_connect(const std::error_code& ec, channel_ptr node)
+    {
+        if (ec)
+            ++failures;
+        else
+            channels_.push_back(node);
+        ++connected_;
+        check_done();
+    }
+    void check_done()
+    {
+        if (accepted_ == connection_count && connected_ == connection_count)
+            done_->set_value();
+    }
+
+    network net_;
+    io_service::strand strand_;
+    acceptor_ptr accept_;
+    std::promise<void>* done_ = nullptr;
+    size_t accepted_ = 0, connected_ = 0;
+    std::vector<channel_ptr> channels_;
+};
+
+int main()
+{
+    rlimit limit;
+    getrlimit(RLIMIT_NOFILE, &limit);
+    limit.rlim_cur = std::min<rlim_t>(limit.rlim_max,
+        2 * connection_count + 100);
+    setrlimit(RLIMIT_NOFILE, &limit);
+    if (limit.rlim_cur < 2 * connection_count + 100)
+    {
+        log_error() << "Only " << limit.rlim_cur
+            << " file descriptors. Raise ulimit -n.";
+        return 1;
+    }
+
+    async_service service(1);
+    bench test(service);
+    network net(service);
+    std::promise<acceptor_ptr> listening;
+    net.listen(bench_port,
+        [&](const std::error_code& ec, acceptor_ptr accept)
+        {
+            if (ec)
+                log_error() << "Listen: " << ec.message();
+            listening.set_value(accept);
+        });
+    acceptor_ptr accept = listening.get_future().get();
+    if (!accept)
+        return 1;
+
+    const size_t memory_before = resident_bytes();
+    const auto start = std::chrono::steady_clock::now();
+    std::promise<void> done;
+    test.run(accept, done);
+    done.get_future().wait();
+    const auto elapsed = std::chrono::duration_cast<
+        std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    const size_t memory_used = resident_bytes() - memory_before;
+
+    const size_t channel_count = 2 * connection_count;
+    std::cout << channel_count << " channels ("
+        << test.failures << " failed) in "
+        << elapsed.count() / 1000 << " ms" << std::endl;
+    std::cout << memory_used / channel_count << " bytes and "
+        << elapsed.count() / channel_count
+        << " us per channel" << std::endl;
+
+    test.stop_all();
+    service.stop();
+    service.join();
+    return 0;
+}
+
@@ -1,75 +1,51 @@
 #include <bitcoin/bitcoin.hpp>
-#include <bitcoin/blockchain/bdb_blockchain.hpp>
+#include <iostream>
+#include <boost/asio/yield.hpp>
 using namespace bc;
 
-class fetch_block_t
-  : private coroutine,
-    public std::enable_shared_from_this<fetch_block_t>
+class fetch_last_spend
+  : public async_frame<fetch_last_spend>
 {
 public:
-    fetch_block_t(blockchain_ptr chain)
-      : blockchain_(chain) {}
-
-    struct stack_t
+    fetch_last_spend(blockchain& chain)
+      : chain_(chain)
     {
-        size_t last;
-        message::block blk;
-        message::input_point inp;
-    };
-    typedef std::shared_ptr<stack_t> stack_ptr;
-
-    void run(const std::error_code& ec = std::error_code(),
-        stack_ptr stack = std::make_shared<stack_t>());
-private:
-    blockchain_ptr blockchain_;
-};
+        outpoint_.hash = hash_from_pretty<hash_digest>(
+            "f4184fc596403b9d638783cf57adfe4c75c605f6356fbc91338530e9831e9e16");
+        outpoint_.index = 1;
+    }
 
-void fetch_block_t::run(const std::error_code& ec, stack_ptr stack)
-{
-    auto this_ptr = shared_from_this();
-    message::output_point outpoint;
-    outpoint.hash = hash_from_pretty<hash_digest>("f4184fc596403b9d638783cf57adfe4c75c605f6356fbc91338530e9831e9e16");
-    outpoint.index = 1;
-    reenter(this)
+    void operator()()
     {
-        yield
+        reenter (this)
         {
-            auto count = std::make_shared<atomic_counter>(0);
-            for (size_t i = 0; i < 4; ++i)
-                blockchain_->fetch_last_depth(
-                    [this_ptr, stack, count](
-                        const std::error_code& ec, size_t depth)
-                    {
-                        stack->last = depth;
-                        ++(*count);
-                        if (*count == 4)
-                            this_ptr->run(ec, stack);
-                    });
-        }
-        log_debug() << stack->last;
-        yield blockchain_->fetch_block_header(stack->last,
-            [this_ptr, stack](const std::error_code& ec,
-                const message::block& blk)
-            {
-                stack->blk = blk;
-                this_ptr->run(ec, stack);
-            });
-        log_debug() << pretty_hex(hash_block_header(stack->blk));
-        yield blockchain_->fetch_spend(outpoint,
-            [this_ptr, stack](const std::error_code& ec,
-                const message::input_point& inp)
+            yield chain_.fetch_last_depth(resume(last_depth_));
+            if (error())
             {
-                stack->inp = inp;
-                this_ptr->run(ec, stack);
-            });
-        if (!ec)
-            log_debug() << pretty_hex(stack->inp.hash);
-        else
-            log_error() << ec.message();
+                log_error() << "Last depth: " << error().message();
+                yield break;
+            }
+            log_debug() << last_depth_;
+            yield chain_.fetch_block_header(last_depth_, resume(block_));
+            log_debug() << pretty_hex(hash_block_header(block_));
+            yield chain_.fetch_spend(outpoint_, resume(spend_));
+            if (!error())
+                log_debug() << pretty_hex(spend_.hash);
+            else
+                log_error() << error().message();
+        }
     }
-}
 
-void blockchain_started(const std::error_code& ec, blockchain_ptr)
+private:
+    blockchain& chain_;
+    message::output_point outpoint_;
+
+    size_t last_depth_;
+    message::block block_;
+    message::input_point spend_;
+};
+
+void blockchain_started(const std::error_code& ec)
 {
     if (ec)
         log_error() << "Error: " << ec.message();
@@ -77,15 +53,19 @@ void blockchain_started(const std::error_code& ec, blockchain_ptr)
         log_info() << "Blockchain initialized!";
 }
 
-
 int main()
 {
     async_service service(1);
-    blockchain_ptr chain =
-        bdb_blockchain::create(service, "database", blockchain_started);
-    auto f = std::make_shared<fetch_block_t>(chain);
-    f->run();
+    bdb_blockchain chain(service);
+    chain.start("database", blockchain_started);
+    // Deletes itself once finished
+    (new fetch_last_spend(chain))->start();
     std::cin.get();
+    service.stop();
+    service.join();
+    chain.stop();
     return 0;
 }
 
+#include <boost/asio/unyield.hpp>
+
@@ -0,0 +1,85 @@
+#include <bitcoin/bitcoin.hpp>
+#include <iostream>
+using namespace bc;
+
+void blockchain_started(const std::error_code& ec)
+{
+    if (ec)
+        log_error() << "Blockchain error: " << ec.message();
+    else
+        log_info() << "Blockchain initialized!";
+}
+
+void server_started(const std::error_code& ec)
+{
+    if (ec)
+        log_error() << "Query server error: " << ec.message();
+    else
+        log_info() << "Query server started!";
+}
+
+void recv_last_depth(const std::error_code& ec, size_t depth)
+{
+    if (ec)
+        log_error() << "Last depth: " << ec.message();
+    else
+        log_info() << "Last depth: " << depth;
+}
+
+void recv_genesis(const std::error_code& ec, const message::block& blk)
+{
+    if (ec)
+    {
+        log_error() << "Genesis: " << ec.message();
+        return;
+    }
+    BITCOIN_ASSERT(hash_block_header(blk) ==
+        hash_block_header(genesis_block()));
+    log_info() << "Genesis: " << hash_block_header(blk);
+}
+
+void recv_headers(const std::error_code& ec,
+    const query_client::block_header_list& headers, bool more)
+{
+    if (ec)
+        log_error() << "Headers: " << ec.message();
+    log_info() << "Headers: received " << headers.size()
+        << (more ? " (more to come)" : " (finished)");
+}
+
+int main()
+{
+    async_service service(1);
+    bdb_blockchain chain(service);
+    chain.start("database", blockchain_started);
+    transaction_pool txpool(service, chain);
+    txpool.start();
+    query_server server(service, chain, txpool);
+    server.start("query.sock", server_started);
+
+    query_client client(service);
+    client.connect("query.sock",
+        [&client](const std::error_code& ec)
+        {
+            if (ec)
+            {
+                log_error() << "Connect: " << ec.message();
+                return;
+            }
+            // Pipelined over the one connection. The duplicate lookups
+            // are batched together by the server.
+            client.fetch_last_depth(recv_last_depth);
+            client.fetch_last_depth(recv_last_depth);
+            client.fetch_block_header(0, recv_genesis);
+            client.fetch_block_headers(0, 2000, recv_headers);
+        });
+
+    std::cin.get();
+    client.stop();
+    server.stop();
+    service.stop();
+    service.join();
+    chain.stop();
+    return 0;
+}
+
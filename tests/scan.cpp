@@ -0,0 +1,73 @@
+#include <bitcoin/bitcoin.hpp>
+#include <atomic>
+#include <iostream>
+using namespace bc;
+
+class output_counter
+  : public scan_visitor
+{
+public:
+    output_counter()
+      : transactions(0), outputs(0), value(0)
+    {
+    }
+
+    bool visit_transaction(size_t, size_t, const hash_digest&,
+        const message::transaction&)
+    {
+        ++transactions;
+        return true;
+    }
+    bool visit_output(const hash_digest&, size_t,
+        const message::transaction_output& output)
+    {
+        ++outputs;
+        value += output.value;
+        return true;
+    }
+
+    std::atomic<size_t> transactions, outputs;
+    std::atomic<uint64_t> value;
+};
+
+void blockchain_started(const std::error_code& ec)
+{
+    if (ec)
+        log_error() << "Blockchain error: " << ec.message();
+    else
+        log_info() << "Blockchain initialized!";
+}
+
+void scan_progress(size_t scanned, size_t total)
+{
+    log_info() << "Scanned " << scanned << " / " << total;
+}
+
+int main()
+{
+    async_service service(1);
+    bdb_blockchain chain(service);
+    chain.start("database", blockchain_started);
+
+    // Give the scan its own threads
+    async_service scan_service(4);
+    output_counter counter;
+    chain.scan(scan_service, 4, counter, scan_progress,
+        [&counter](const std::error_code& ec)
+        {
+            if (ec)
+                log_error() << "Scan: " << ec.message();
+            log_info() << "Transactions: " << counter.transactions;
+            log_info() << "Outputs: " << counter.outputs;
+            log_info() << "Total value: " << counter.value;
+        });
+
+    std::cin.get();
+    scan_service.stop();
+    scan_service.join();
+    service.stop();
+    service.join();
+    chain.stop();
+    return 0;
+}
+
@@ -0,0 +1,272 @@
+#include <bitcoin/constants.hpp>
+#include <bitcoin/format.hpp>
+#include <bitcoin/messages.hpp>
+#include <bitcoin/script.hpp>
+#include <bitcoin/utility/assert.hpp>
+#include <bitcoin/utility/ripemd.hpp>
+using namespace libbitcoin;
+
+operation push(const data_chunk& data)
+{
+    if (data.empty())
+        return operation{opcode::zero, data};
+    else if (data.size() <= 75)
+        return operation{opcode::special, data};
+    else if (data.size() <= 0xff)
+        return operation{opcode::pushdata1, data};
+    return operation{opcode::pushdata2, data};
+}
+
+operation op(opcode code)
+{
+    return operation{code, data_chunk()};
+}
+
+void repeat(script& target, const operation& oper, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+        target.push_operation(oper);
+}
+
+bool run(script output, const script& input, bool bip16_enabled=true)
+{
+    message::transaction tx;
+    return output.run(input, tx, 0, bip16_enabled);
+}
+
+void test_unexecuted_branches()
+{
+    // Skipped operations run nothing, so the script is still true
+    script skipped;
+    skipped.push_operation(op(opcode::zero));
+    skipped.push_operation(op(opcode::if_));
+    skipped.push_operation(op(opcode::return_));
+    skipped.push_operation(op(opcode::endif));
+    skipped.push_operation(op(opcode::op_1));
+    BITCOIN_ASSERT(run(skipped, script()));
+    // But disabled opcodes fail the script even when never reached
+    for (opcode disabled: {opcode::cat, opcode::mul, opcode::verif})
+    {
+        script output;
+        output.push_operation(op(opcode::zero));
+        output.push_operation(op(opcode::if_));
+        output.push_operation(op(disabled));
+        output.push_operation(op(opcode::endif));
+        output.push_operation(op(opcode::op_1));
+        BITCOIN_ASSERT(!run(output, script()));
+    }
+    // Unbalanced conditionals
+    script unclosed;
+    unclosed.push_operation(op(opcode::op_1));
+    unclosed.push_operation(op(opcode::if_));
+    unclosed.push_operation(op(opcode::op_1));
+    BITCOIN_ASSERT(!run(unclosed, script()));
+}
+
+void test_push_size()
+{
+    script largest;
+    largest.push_operation(push(data_chunk(520, 1)));
+    BITCOIN_ASSERT(run(largest, script()));
+    script too_large;
+    too_large.push_operation(push(data_chunk(521, 1)));
+    BITCOIN_ASSERT(!run(too_large, script()));
+}
+
+void test_script_size()
+{
+    // Each push of 520 bytes takes 523 bytes serialized
+    script largest;
+    repeat(largest, push(data_chunk(520, 1)), 19);
+    BITCOIN_ASSERT(script_size(largest) <= 10000);
+    BITCOIN_ASSERT(run(largest, script()));
+    script too_large;
+    repeat(too_large, push(data_chunk(520, 1)), 20);
+    BITCOIN_ASSERT(script_size(too_large) > 10000);
+    BITCOIN_ASSERT(!run(too_large, script()));
+    // The limit applies to the input script too
+    script output;
+    output.push_operation(op(opcode::op_1));
+    BITCOIN_ASSERT(!run(output, too_large));
+}
+
+void test_operation_count()
+{
+    // Pushes, including op_1 to op_16, are not counted
+    script most;
+    repeat(most, op(opcode::nop), 201);
+    repeat(most, op(opcode::op_1), 300);
+    BITCOIN_ASSERT(run(most, script()));
+    script too_many;
+    repeat(too_many, op(opcode::nop), 202);
+    too_many.push_operation(op(opcode::op_1));
+    BITCOIN_ASSERT(!run(too_many, script()));
+    // Operations in branches that aren't executed still count
+    script skipped;
+    skipped.push_operation(op(opcode::zero));
+    skipped.push_operation(op(opcode::if_));
+    repeat(skipped, op(opcode::nop), 200);
+    skipped.push_operation(op(opcode::endif));
+    skipped.push_operation(op(opcode::op_1));
+    BITCOIN_ASSERT(!run(skipped, script()));
+}
+
+// A checkmultisig with no signatures, which always passes
+script multisig(size_t nops, size_t keys)
+{
+    script output;
+    repeat(output, op(opcode::nop), nops);
+    // Number of signatures
+    output.push_operation(op(opcode::zero));
+    for (size_t i = 0; i < keys; ++i)
+        output.push_operation(push(data_chunk{static_cast<uint8_t>(i)}));
+    output.push_operation(push(data_chunk{static_cast<uint8_t>(keys)}));
+    output.push_operation(op(opcode::checkmultisig));
+    return output;
+}
+
+void test_checkmultisig_count()
+{
+    BITCOIN_ASSERT(run(multisig(0, 20), script()));
+    BITCOIN_ASSERT(!run(multisig(0, 21), script()));
+    // Each public key counts as an operation, so 180 nops
+    // + checkmultisig + 20 keys is exactly the limit
+    BITCOIN_ASSERT(run(multisig(180, 20), script()));
+    BITCOIN_ASSERT(!run(multisig(181, 20), script()));
+    // Keys only count when checkmultisig runs
+    BITCOIN_ASSERT(run(multisig(181, 1), script()));
+}
+
+script pay_to_script_hash(const script& redeem)
+{
+    const short_hash hash = generate_ripemd_hash(save_script(redeem));
+    script output;
+    output.push_operation(op(opcode::hash160));
+    output.push_operation(push(data_chunk(hash.begin(), hash.end())));
+    output.push_operation(op(opcode::equal));
+    BITCOIN_ASSERT(output.type() == payment_type::script_hash);
+    return output;
+}
+
+void test_p2sh()
+{
+    script redeem_true;
+    redeem_true.push_operation(op(opcode::op_1));
+    script input;
+    input.push_operation(push(save_script(redeem_true)));
+    BITCOIN_ASSERT(run(pay_to_script_hash(redeem_true), input));
+
+    // Hash matches but the redeem script itself fails
+    script redeem_false;
+    redeem_false.push_operation(op(opcode::zero));
+    input = script();
+    input.push_operation(push(save_script(redeem_false)));
+    const script output_false = pay_to_script_hash(redeem_false);
+    BITCOIN_ASSERT(!run(output_false, input));
+    BITCOIN_ASSERT(run(output_false, input, false));
+
+    // Inputs spending a script hash may only push
+    input = script();
+    input.push_operation(op(opcode::nop));
+    input.push_operation(push(save_script(redeem_true)));
+    BITCOIN_ASSERT(!run(pay_to_script_hash(redeem_true), input));
+    BITCOIN_ASSERT(run(pay_to_script_hash(redeem_true), input, false));
+
+    // Redeem scripts go through the same limits
+    script redeem_disabled;
+    redeem_disabled.push_operation(op(opcode::zero));
+    redeem_disabled.push_operation(op(opcode::if_));
+    redeem_disabled.push_operation(op(opcode::cat));
+    redeem_disabled.push_operation(op(opcode::endif));
+    redeem_disabled.push_operation(op(opcode::op_1));
+    input = script();
+    input.push_operation(push(save_script(redeem_disabled)));
+    BITCOIN_ASSERT(!run(pay_to_script_hash(redeem_disabled), input));
+}
+
+// Hashes data with code and compares against the expected hex digest
+bool hash_matches(opcode code, const std::string& data,
+    const std::string& expected)
+{
+    script output;
+    output.push_operation(push(data_chunk(data.begin(), data.end())));
+    output.push_operation(op(code));
+    output.push_operation(push(bytes_from_pretty(expected)));
+    output.push_operation(op(opcode::equal));
+    return run(output, script());
+}
+
+void test_hashes()
+{
+    BITCOIN_ASSERT(hash_matches(opcode::ripemd160, "",
+        "9c1185a5c5e9fc54612808977ee8f548b2258d31"));
+    BITCOIN_ASSERT(hash_matches(opcode::ripemd160, "abc",
+        "8eb208f7e05d987a9b044a8e98c6b087f15a0bfc"));
+    BITCOIN_ASSERT(hash_matches(opcode::sha1, "",
+        "da39a3ee5e6b4b0d3255bfef95601890afd80709"));
+    BITCOIN_ASSERT(hash_matches(opcode::sha1, "abc",
+        "a9993e364706816aba3e25717850c26c9cd0d89d"));
+    BITCOIN_ASSERT(hash_matches(opcode::sha256, "",
+        "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855"));
+    BITCOIN_ASSERT(hash_matches(opcode::sha256, "abc",
+        "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"));
+    BITCOIN_ASSERT(hash_matches(opcode::hash160, "",
+        "b472a266d0bd89c13706a4132ccfb16f7c3b9fcb"));
+    BITCOIN_ASSERT(hash_matches(opcode::hash160, "abc",
+        "bb1be98c142444d7a56aa3981c3942a978e4dc33"));
+    BITCOIN_ASSERT(hash_matches(opcode::hash256, "",
+        "5df6e0e2761359d30a8275058e299fcc0381534545f55cf43e41983f5d4c9456"));
+    BITCOIN_ASSERT(hash_matches(opcode::hash256, "abc",
+        "4f8b42c22dd3729b519ba6f68d2da7cc5b2d606d05daed5ad5128cc03e6c6358"));
+    // Data longer than a stack item holds inline
+    const std::string long_data(100, 'a');
+    BITCOIN_ASSERT(hash_matches(opcode::sha256, long_data,
+        "2816597888e4a0d3a36b82b83316ab32680eb8f00f8cd3b904d681246d285a0e"));
+    BITCOIN_ASSERT(!hash_matches(opcode::sha256, "abd",
+        "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"));
+}
+
+void test_empty_signature()
+{
+    const data_chunk pubkey = bytes_from_pretty(
+        "043673c18406d792e79228deff1ed9e37e624a930a187c6e43980ae0ebc47d5a"
+        "84cf055a357a7360e2b4488048db7d28080d333857a81e1c40661c8f61d379c95c");
+    message::transaction tx;
+    tx.version = 1;
+    tx.locktime = 0;
+    tx.inputs.push_back(message::transaction_input{
+        message::output_point{null_hash, 0}, script(), 0xffffffff});
+    // An empty signature fails the check but not the script
+    script input;
+    input.push_operation(push(data_chunk()));
+    input.push_operation(push(pubkey));
+    script checksig;
+    checksig.push_operation(op(opcode::checksig));
+    BITCOIN_ASSERT(!checksig.run(input, tx, 0));
+    checksig.push_operation(op(opcode::not_));
+    BITCOIN_ASSERT(checksig.run(input, tx, 0));
+    // Same for checkmultisig
+    script multisig_input;
+    multisig_input.push_operation(push(data_chunk()));
+    multisig_input.push_operation(op(opcode::op_1));
+    multisig_input.push_operation(push(pubkey));
+    multisig_input.push_operation(op(opcode::op_1));
+    script checkmultisig;
+    checkmultisig.push_operation(op(opcode::checkmultisig));
+    BITCOIN_ASSERT(!checkmultisig.run(multisig_input, tx, 0));
+    checkmultisig.push_operation(op(opcode::not_));
+    BITCOIN_ASSERT(checkmultisig.run(multisig_input, tx, 0));
+}
+
+int main()
+{
+    test_unexecuted_branches();
+    test_push_size();
+    test_script_size();
+    test_operation_count();
+    test_checkmultisig_count();
+    test_p2sh();
+    test_hashes();
+    test_empty_signature();
+    return 0;
+}
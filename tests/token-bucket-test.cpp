@@ -0,0 +1,81 @@
+#include <bitcoin/utility/assert.hpp>
+#include <bitcoin/utility/token_bucket.hpp>
+#include <thread>
+using namespace libbitcoin;
+using boost::posix_time::milliseconds;
+using boost::posix_time::time_duration;
+
+void test_unlimited()
+{
+    token_bucket bucket;
+    BITCOIN_ASSERT(bucket.unlimited());
+    bucket.consume(1000000000);
+    BITCOIN_ASSERT(bucket.wait_time(1000000000).is_zero());
+}
+
+void test_burst_and_debt()
+{
+    // 1000 bytes a second, burst defaults to one second's worth
+    token_bucket bucket(1000);
+    BITCOIN_ASSERT(!bucket.unlimited());
+    BITCOIN_ASSERT(bucket.burst() == 1000);
+    BITCOIN_ASSERT(bucket.wait_time().is_zero());
+    // A send bigger than the burst still goes, then we owe for it
+    bucket.consume(1500);
+    const time_duration wait = bucket.wait_time();
+    BITCOIN_ASSERT(wait > milliseconds(400) && wait <= milliseconds(500));
+    // Waiting for a reserve takes longer, but never beyond the burst
+    BITCOIN_ASSERT(bucket.wait_time(500) > wait);
+    BITCOIN_ASSERT(bucket.wait_time(5000) == bucket.wait_time(1000));
+}
+
+void test_refill()
+{
+    token_bucket bucket(100000, 1000);
+    bucket.consume(1000);
+    BITCOIN_ASSERT(!bucket.wait_time(1000).is_zero());
+    // 10ms at 100000 bytes a second is the whole burst
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    BITCOIN_ASSERT(bucket.wait_time(1000).is_zero());
+    // Never fills beyond the burst however long it sits
+    bucket.consume(1001);
+    BITCOIN_ASSERT(!bucket.wait_time().is_zero());
+}
+
+void test_high_rate()
+{
+    // Big enough that crediting a long idle spell in one go would
+    // overflow, if the refill weren't capped at the burst
+    const uint64_t rate = 100000000000;
+    token_bucket bucket(rate, rate);
+    bucket.consume(rate);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    const time_duration wait = bucket.wait_time(rate);
+    BITCOIN_ASSERT(wait > milliseconds(0) && wait <= milliseconds(950));
+    bucket.consume(2 * rate);
+    BITCOIN_ASSERT(bucket.wait_time() > milliseconds(1000));
+}
+
+void test_set_rate()
+{
+    token_bucket bucket(1000);
+    bucket.consume(5000);
+    BITCOIN_ASSERT(!bucket.wait_time().is_zero());
+    // Starts again with a full bucket
+    bucket.set_rate(2000, 4000);
+    BITCOIN_ASSERT(bucket.burst() == 4000);
+    BITCOIN_ASSERT(bucket.wait_time(4000).is_zero());
+    bucket.set_rate(0);
+    BITCOIN_ASSERT(bucket.unlimited());
+}
+
+int main()
+{
+    test_unlimited();
+    test_burst_and_debt();
+    test_refill();
+    test_high_rate();
+    test_set_rate();
+    return 0;
+}
+
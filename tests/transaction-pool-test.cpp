@@ -0,0 +1,299 @@
+#include <bitcoin/bitcoin.hpp>
+#include <bitcoin/utility/assert.hpp>
+#include <future>
+using namespace libbitcoin;
+
+// Anyone can spend the outputs of the chain transaction, so nothing
+// needs signing.
+message::transaction chain_tx;
+hash_digest chain_tx_hash;
+constexpr uint32_t chain_tx_outputs = 2100;
+
+// Blockchain holding only chain_tx, answering straight away
+class stub_chain
+  : public blockchain
+{
+public:
+    void store(const message::block&, store_block_handler) {}
+    void fetch_block_header(size_t, fetch_handler_block_header) {}
+    void fetch_block_header(const hash_digest&,
+        fetch_handler_block_header) {}
+    void fetch_block_transaction_hashes(size_t,
+        fetch_handler_block_transaction_hashes) {}
+    void fetch_block_transaction_hashes(const hash_digest&,
+        fetch_handler_block_transaction_hashes) {}
+    void fetch_block_depth(const hash_digest&,
+        fetch_handler_block_depth) {}
+    void fetch_last_depth(fetch_handler_last_depth handle_fetch)
+    {
+        handle_fetch(std::error_code(), 1000);
+    }
+    void fetch_transaction(const hash_digest& tx_hash,
+        fetch_handler_transaction handle_fetch)
+    {
+        if (tx_hash == chain_tx_hash)
+            handle_fetch(std::error_code(), chain_tx);
+        else
+            handle_fetch(error::not_found, message::transaction());
+    }
+    void fetch_transaction_index(const hash_digest& tx_hash,
+        fetch_handler_transaction_index handle_fetch)
+    {
+        if (tx_hash == chain_tx_hash)
+            handle_fetch(std::error_code(), 10, 1);
+        else
+            handle_fetch(error::not_found, 0, 0);
+    }
+    void fetch_spend(const message::output_point&,
+        fetch_handler_spend handle_fetch)
+    {
+        handle_fetch(error::unspent_output, message::input_point());
+    }
+    void fetch_outputs(const payment_address&, fetch_handler_outputs) {}
+    void subscribe_reorganize(reorganize_handler handle_reorganize)
+    {
+        reorganize = handle_reorganize;
+    }
+
+    reorganize_handler reorganize;
+};
+
+void make_chain_tx()
+{
+    chain_tx.version = 1;
+    chain_tx.locktime = 0;
+    message::transaction_input input;
+    input.previous_output.hash = hash_digest{{1}};
+    input.previous_output.index = 0;
+    input.input_script.push_operation({opcode::special, data_chunk(4, 1)});
+    input.sequence = 0xffffffff;
+    chain_tx.inputs.push_back(input);
+    script anyone;
+    anyone.push_operation({opcode::op_1, data_chunk()});
+    for (uint32_t i = 0; i < chain_tx_outputs; ++i)
+        chain_tx.outputs.push_back({1000, anyone});
+    chain_tx_hash = hash_transaction(chain_tx);
+}
+
+script pay_to_hash()
+{
+    script output;
+    output.push_operation({opcode::dup, data_chunk()});
+    output.push_operation({opcode::hash160, data_chunk()});
+    output.push_operation({opcode::special, data_chunk(20, 2)});
+    output.push_operation({opcode::equalverify, data_chunk()});
+    output.push_operation({opcode::checksig, data_chunk()});
+    return output;
+}
+
+// Spends chain_tx output index, paying value to a standard script
+message::transaction spend(uint32_t index, uint64_t value)
+{
+    message::transaction tx;
+    tx.version = 1;
+    tx.locktime = 0;
+    message::transaction_input input;
+    input.previous_output.hash = chain_tx_hash;
+    input.previous_output.index = index;
+    input.sequence = 0xffffffff;
+    tx.inputs.push_back(input);
+    tx.outputs.push_back({value, pay_to_hash()});
+    return tx;
+}
+
+transaction_entry_info entry_for(const message::transaction& tx)
+{
+    message::output_point_list spent;
+    for (const message::transaction_input& input: tx.inputs)
+        spent.push_back(input.previous_output);
+    return transaction_entry_info{hash_transaction(tx), data_chunk(),
+        spent, nullptr, 0, 0};
+}
+
+void test_pool_conflict()
+{
+    const message::transaction tx = spend(0, 900);
+    const transaction_entry_info entry = entry_for(tx);
+    pool_index index;
+    BITCOIN_ASSERT(!pool_conflict(index, entry.hash, entry.spent));
+    index.add(entry);
+    BITCOIN_ASSERT(pool_conflict(index, entry.hash, entry.spent) ==
+        error::duplicate);
+    // Same outpoint, different transaction
+    const transaction_entry_info rival = entry_for(spend(0, 800));
+    BITCOIN_ASSERT(pool_conflict(index, rival.hash, rival.spent) ==
+        error::double_spend);
+    const transaction_entry_info other = entry_for(spend(1, 900));
+    BITCOIN_ASSERT(!pool_conflict(index, other.hash, other.spent));
+    index.remove(entry);
+    BITCOIN_ASSERT(!pool_conflict(index, rival.hash, rival.spent));
+    BITCOIN_ASSERT(index.hashes.empty() && index.spent.empty());
+}
+
+std::error_code store(transaction_pool& pool,
+    const message::transaction& tx)
+{
+    std::promise<std::error_code> stored;
+    pool.store(tx, [](const std::error_code&) {},
+        [&stored](const std::error_code& ec, const index_list&)
+        {
+            stored.set_value(ec);
+        });
+    return stored.get_future().get();
+}
+
+bool exists(transaction_pool& pool, const message::transaction& tx)
+{
+    std::promise<bool> found;
+    pool.exists(hash_transaction(tx),
+        [&found](bool exists)
+        {
+            found.set_value(exists);
+        });
+    return found.get_future().get();
+}
+
+size_t pool_size(transaction_pool& pool)
+{
+    std::promise<size_t> size;
+    pool.visit(
+        [&size](const pool_buffer& buffer)
+        {
+            size.set_value(buffer.size());
+        });
+    return size.get_future().get();
+}
+
+void reorganize(transaction_pool& pool, stub_chain& chain,
+    const message::transaction_list& confirmed, bool replaced)
+{
+    auto block = std::make_shared<message::block>();
+    block->transactions = confirmed;
+    blockchain::block_list replaced_blocks;
+    if (replaced)
+        replaced_blocks.push_back(std::make_shared<message::block>());
+    BITCOIN_ASSERT(chain.reorganize);
+    chain.reorganize(std::error_code(), 0, {block}, replaced_blocks);
+    // The first runs after the reorganize on the pool strand, and the
+    // second after any stores it queued up
+    pool_size(pool);
+    pool_size(pool);
+}
+
+void test_index_after_changes()
+{
+    async_service service(1);
+    stub_chain chain;
+    transaction_pool pool(service, chain);
+    pool.start();
+
+    // One more than the pool holds, so the first is dropped
+    message::transaction_list stored;
+    for (uint32_t i = 0; i <= 2000; ++i)
+    {
+        stored.push_back(spend(i, 900));
+        const std::error_code ec = store(pool, stored.back());
+        BITCOIN_ASSERT(!ec);
+    }
+    BITCOIN_ASSERT(pool_size(pool) == 2000);
+    BITCOIN_ASSERT(!exists(pool, stored[0]));
+    BITCOIN_ASSERT(exists(pool, stored[1]));
+    std::error_code ec = store(pool, stored[1]);
+    BITCOIN_ASSERT(ec == error::duplicate);
+    ec = store(pool, spend(1, 800));
+    BITCOIN_ASSERT(ec == error::double_spend);
+    // The dropped transaction's outpoint is free again
+    const message::transaction replacement = spend(0, 800);
+    ec = store(pool, replacement);
+    BITCOIN_ASSERT(!ec);
+    BITCOIN_ASSERT(exists(pool, replacement));
+    BITCOIN_ASSERT(!exists(pool, stored[1]));
+    BITCOIN_ASSERT(pool_size(pool) == 2000);
+
+    // Confirmed in a block: gone, and its outpoint too
+    reorganize(pool, chain, {stored[2]}, false);
+    BITCOIN_ASSERT(!exists(pool, stored[2]));
+    BITCOIN_ASSERT(pool_size(pool) == 1999);
+    ec = store(pool, spend(2, 800));
+    BITCOIN_ASSERT(!ec);
+
+    // Everything goes through validation again and is indexed anew
+    reorganize(pool, chain, {}, true);
+    BITCOIN_ASSERT(pool_size(pool) == 2000);
+    BITCOIN_ASSERT(exists(pool, replacement));
+    BITCOIN_ASSERT(exists(pool, stored[3]));
+    ec = store(pool, stored[3]);
+    BITCOIN_ASSERT(ec == error::duplicate);
+    ec = store(pool, spend(3, 800));
+    BITCOIN_ASSERT(ec == error::double_spend);
+
+    service.stop();
+    service.join();
+}
+
+// Runs validation by itself, with index standing in for the pool
+void check_stage(const message::transaction& tx, const pool_index& index,
+    validation_stage stage)
+{
+    async_service service(1);
+    io_service::strand strand(service.get_service());
+    stub_chain chain;
+    pool_buffer buffer(1);
+    auto validate = std::make_shared<validate_transaction>(
+        chain, tx, buffer, index, strand);
+    std::promise<std::error_code> validated;
+    strand.post(
+        [&]()
+        {
+            validate->start(
+                [&validated](const std::error_code& ec, const index_list&)
+                {
+                    validated.set_value(ec);
+                });
+        });
+    const std::error_code ec = validated.get_future().get();
+    BITCOIN_ASSERT(ec);
+    BITCOIN_ASSERT(validate->stage() == stage);
+    BITCOIN_ASSERT(validate->cost()->storage_lookups == 0);
+    service.stop();
+    service.join();
+}
+
+void test_cheap_stages()
+{
+    pool_index empty;
+    message::transaction no_inputs = spend(0, 900);
+    no_inputs.inputs.clear();
+    check_stage(no_inputs, empty, validation_stage::format);
+
+    message::transaction nonstandard = spend(0, 900);
+    nonstandard.outputs[0].output_script = script();
+    nonstandard.outputs[0].output_script.push_operation(
+        {opcode::nop, data_chunk()});
+    check_stage(nonstandard, empty, validation_stage::standard);
+
+    message::transaction not_push = spend(0, 900);
+    not_push.inputs[0].input_script.push_operation(
+        {opcode::checksig, data_chunk()});
+    check_stage(not_push, empty, validation_stage::standard);
+
+    // Every standard output type has at most one sigop, so nothing
+    // under the size limit reaches the sigops stage.
+    message::transaction dust = spend(0, 900);
+    dust.outputs.push_back({1, pay_to_hash()});
+    check_stage(dust, empty, validation_stage::dust);
+
+    pool_index index;
+    index.add(entry_for(spend(0, 900)));
+    check_stage(spend(0, 900), index, validation_stage::pool_conflict);
+    check_stage(spend(0, 800), index, validation_stage::pool_conflict);
+}
+
+int main()
+{
+    make_chain_tx();
+    test_pool_conflict();
+    test_index_after_changes();
+    test_cheap_stages();
+    return 0;
+}
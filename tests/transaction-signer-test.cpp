@@ -0,0 +1,113 @@
+#include <bitcoin/bitcoin.hpp>
+#include <bitcoin/utility/assert.hpp>
+using namespace libbitcoin;
+
+script pay_to_pubkey_hash(const elliptic_curve_key& key)
+{
+    script output;
+    output.push_operation({opcode::dup, data_chunk()});
+    output.push_operation({opcode::hash160, data_chunk()});
+    const short_hash key_hash = generate_ripemd_hash(key.public_key());
+    output.push_operation({opcode::special,
+        data_chunk(key_hash.begin(), key_hash.end())});
+    output.push_operation({opcode::equalverify, data_chunk()});
+    output.push_operation({opcode::checksig, data_chunk()});
+    return output;
+}
+
+script pay_to_pubkey(const elliptic_curve_key& key)
+{
+    script output;
+    output.push_operation({opcode::special, key.public_key()});
+    output.push_operation({opcode::checksig, data_chunk()});
+    return output;
+}
+
+// Three inputs and two outputs, so sighash::single has an input
+// without a matching output.
+message::transaction make_tx()
+{
+    message::transaction tx;
+    tx.version = 1;
+    tx.locktime = 0;
+    for (uint8_t i = 0; i < 3; ++i)
+    {
+        message::transaction_input input;
+        input.previous_output.hash = hash_digest{{i, 0xaa}};
+        input.previous_output.index = i;
+        input.sequence = 0xffffffff - i;
+        tx.inputs.push_back(input);
+    }
+    elliptic_curve_key key;
+    key.new_key_pair();
+    tx.outputs.push_back({50000, pay_to_pubkey_hash(key)});
+    tx.outputs.push_back({20000, pay_to_pubkey(key)});
+    return tx;
+}
+
+const uint32_t hash_types[] = {
+    sighash::all, sighash::none, sighash::single,
+    sighash::all | sighash::anyone_can_pay,
+    sighash::none | sighash::anyone_can_pay,
+    sighash::single | sighash::anyone_can_pay};
+
+void test_signature_hash()
+{
+    message::transaction tx = make_tx();
+    elliptic_curve_key key;
+    key.new_key_pair();
+    const script script_code = pay_to_pubkey_hash(key);
+    transaction_signer signer(tx);
+    for (uint32_t hash_type: hash_types)
+        for (uint32_t i = 0; i < tx.inputs.size(); ++i)
+        {
+            const hash_digest fast =
+                signer.signature_hash(i, script_code, hash_type);
+            const hash_digest slow = script::generate_signature_hash(
+                tx, i, script_code, hash_type);
+            BITCOIN_ASSERT(fast == slow);
+        }
+}
+
+void test_sign(uint32_t hash_type)
+{
+    message::transaction tx = make_tx();
+    // Two pay-to-pubkey-hash inputs and a pay-to-pubkey one
+    signing_input_list keys(tx.inputs.size());
+    for (size_t i = 0; i < keys.size(); ++i)
+    {
+        keys[i].key.new_key_pair();
+        keys[i].previous_output_script = i == 2 ?
+            pay_to_pubkey(keys[i].key) : pay_to_pubkey_hash(keys[i].key);
+    }
+    transaction_signer signer(tx);
+    const bool signed_all = signer.sign(keys, hash_type);
+    BITCOIN_ASSERT(signed_all);
+    for (uint32_t i = 0; i < tx.inputs.size(); ++i)
+    {
+        script output_script = keys[i].previous_output_script;
+        const bool valid = output_script.run(
+            tx.inputs[i].input_script, tx, i);
+        BITCOIN_ASSERT(valid);
+    }
+    // Signing every output, so changing one breaks every signature
+    if (hash_type != sighash::all)
+        return;
+    tx.outputs[0].value -= 1;
+    for (uint32_t i = 0; i < tx.inputs.size(); ++i)
+    {
+        script output_script = keys[i].previous_output_script;
+        const bool valid = output_script.run(
+            tx.inputs[i].input_script, tx, i);
+        BITCOIN_ASSERT(!valid);
+    }
+}
+
+int main()
+{
+    test_signature_hash();
+    test_sign(sighash::all);
+    test_sign(sighash::all | sighash::anyone_can_pay);
+    test_sign(sighash::none);
+    return 0;
+}